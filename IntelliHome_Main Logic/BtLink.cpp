@@ -0,0 +1,103 @@
+//-------------------------------------
+#include "BtLink.h"
+#include "rtos/ThisThread.h"
+#include <chrono>
+
+using namespace std::chrono;
+
+// Time for the module to see a KEY change
+#define BT_LINK_KEY_MS 50
+
+static const int btLinkRates[BT_LINK_RATE_COUNT] = BT_LINK_RATES;
+
+BtLink::BtLink(mbed::FileHandle *uart, mbed::Callback<void(int)> setBaud, mbed::Callback<void(int)> key)
+    : _parser(uart, "\r\n", 64, BT_LINK_AT_TIMEOUT_MS), _setBaud(setBaud), _key(key)
+{
+    _found = false;
+    _changed = false;
+}
+
+int BtLink::setup(int storedBaud, int wantedBaud)
+{
+    int baud = storedBaud > 0 ? storedBaud : 9600;
+    _found = false;
+    _changed = false;
+
+    // KEY raised after power up: AT commands at the data rate
+    if (_key) {
+        _key(1);
+        rtos::ThisThread::sleep_for(milliseconds(BT_LINK_KEY_MS));
+    }
+
+    int current = find(baud);
+    if (current == 0) {
+        // Not in command mode or not there at all, keep the last rate
+        _setBaud(baud);
+    } else {
+        _found = true;
+        baud = current;
+        if (current != wantedBaud) {
+            if (moveTo(wantedBaud)) {
+                baud = wantedBaud;
+            } else {
+                // The module may or may not have taken the new rate
+                int now = find(wantedBaud);
+                if (now != 0) {
+                    baud = now;
+                } else {
+                    _setBaud(baud);
+                }
+            }
+            _changed = (baud != current);
+        }
+    }
+
+    if (_key) {
+        _key(0);
+    }
+    return baud;
+}
+
+bool BtLink::found() const
+{
+    return _found;
+}
+
+bool BtLink::changed() const
+{
+    return _changed;
+}
+
+bool BtLink::answersAt(int baud)
+{
+    _setBaud(baud);
+    _parser.flush();
+    return _parser.send("AT") && _parser.recv("OK");
+}
+
+// Returns the rate the module answers at, 0 if none
+int BtLink::find(int firstBaud)
+{
+    if (answersAt(firstBaud)) return firstBaud;
+    for (int i = 0; i < BT_LINK_RATE_COUNT; i++) {
+        if (btLinkRates[i] != firstBaud && answersAt(btLinkRates[i])) return btLinkRates[i];
+    }
+    return 0;
+}
+
+bool BtLink::moveTo(int baud)
+{
+    // No parity, one stop bit
+    if (!_parser.send("AT+UART=%d,0,0", baud) || !_parser.recv("OK")) return false;
+    if (!_parser.send("AT+RESET") || !_parser.recv("OK")) return false;
+
+    // KEY low while it restarts, so it comes back in data mode at the new
+    // rate rather than in full command mode
+    if (_key) _key(0);
+    rtos::ThisThread::sleep_for(milliseconds(BT_LINK_RESET_MS));
+    if (_key) {
+        _key(1);
+        rtos::ThisThread::sleep_for(milliseconds(BT_LINK_KEY_MS));
+    }
+    return answersAt(baud);
+}
@@ -0,0 +1,71 @@
+//-------------------------------------
+//BtLink.h
+#ifndef BtLink_h
+#define BtLink_h
+#include "platform/ATCmdParser.h"
+#include "platform/Callback.h"
+#include "platform/FileHandle.h"
+
+// Rates tried when looking for the module, the HC-05 factory default first
+#define BT_LINK_RATES { 9600, 38400, 57600, 115200, 230400, 460800 }
+#define BT_LINK_RATE_COUNT 6
+
+// Time for the module to answer one AT command
+#define BT_LINK_AT_TIMEOUT_MS 200
+// Time for the module to come back after AT+RESET
+#define BT_LINK_RESET_MS 1000
+
+/**
+* Boot-time setup of the HC-05 serial link. The module only answers AT
+* commands in command mode, with its KEY pin held high; in data mode the
+* commands go to the paired phone and nothing answers, so the link stays at
+* the rate it had.
+*
+* The UART is reached through a FileHandle and a function changing its baud
+* rate, so the dialogue can be run against a fake module, as the host unit
+* test in tests/UNITTESTS/BtLink does.
+*/
+class BtLink
+{
+public:
+/**
+* Constructor
+*
+* @param uart: UART the module is on.
+* @param setBaud: Changes the baud rate of the UART.
+* @param key: Drives the KEY pin of the module, may be null when KEY is not
+* wired to the MCU.
+*/
+BtLink(mbed::FileHandle *uart, mbed::Callback<void(int)> setBaud, mbed::Callback<void(int)> key = nullptr);
+/**
+* Finds the rate the module is at and moves it to the wanted one. The stored
+* rate is tried first, then BT_LINK_RATES. The module is switched with
+* AT+UART and AT+RESET and checked at the new rate; when it does not answer
+* there it is looked for again, so the link ends at a rate both sides use.
+*
+* @param storedBaud: Rate saved by the last successful setup, 0 if none.
+* @param wantedBaud: Rate to move the module to.
+* @return: The rate the UART is left at. When the module never answers this
+* is storedBaud, or 9600 if there is none.
+*/
+int setup(int storedBaud, int wantedBaud);
+/**
+* @return: True if the module answered during the last setup().
+*/
+bool found() const;
+/**
+* @return: True if the last setup() changed the rate of the module.
+*/
+bool changed() const;
+private:
+mbed::ATCmdParser _parser;
+mbed::Callback<void(int)> _setBaud;
+mbed::Callback<void(int)> _key;
+bool _found;
+bool _changed;
+
+bool answersAt(int baud);
+int find(int firstBaud);
+bool moveTo(int baud);
+};
+#endif
@@ -0,0 +1,122 @@
+//-------------------------------------
+#include "ConfigStore.h"
+#include <stddef.h>
+#include <string.h>
+
+#define CONFIG_KEY "cfg"
+
+ConfigStore::ConfigStore(mbed::BlockDevice *bd) : _store(bd)
+{
+    _ready = false;
+    _dirty = false;
+    _loadTimeUs = 0;
+    _writes = 0;
+    _failures = 0;
+    loadDefaults();
+}
+
+int ConfigStore::init()
+{
+    Timer loadTimer;
+    loadTimer.start();
+
+    int err = _store.init();
+    if (err == MBED_SUCCESS) {
+        _ready = true;
+
+        // One read for the whole configuration, then validate it
+        AppConfig stored;
+        size_t actual = 0;
+        err = _store.get(CONFIG_KEY, &stored, sizeof(stored), &actual);
+        if (err == MBED_SUCCESS && actual == sizeof(AppConfig) &&
+            stored.schema == CONFIG_SCHEMA_VERSION && stored.size == sizeof(AppConfig))
+        {
+            _config = stored;
+        } else if (err == MBED_SUCCESS && actual == stored.size && actual < sizeof(AppConfig) &&
+                   stored.schema < CONFIG_SCHEMA_VERSION && actual >= offsetof(AppConfig, securityPin))
+        {
+            // Older layout: its fields over the defaults of the newer ones
+            memcpy(&_config, &stored, actual);
+            _config.schema = CONFIG_SCHEMA_VERSION;
+            _config.size = sizeof(AppConfig);
+        } else if (err == MBED_SUCCESS || err == MBED_ERROR_ITEM_NOT_FOUND) {
+            // Unknown layout or first boot: keep the defaults
+            err = MBED_SUCCESS;
+        }
+    }
+
+    _loadTimeUs = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(loadTimer.elapsed_time()).count();
+    return err;
+}
+
+const AppConfig &ConfigStore::get() const
+{
+    return _config;
+}
+
+AppConfig &ConfigStore::edit()
+{
+    if (!_dirty) {
+        _dirty = true;
+        _pendingTimer.reset();
+        _pendingTimer.start();
+    }
+    _quietTimer.reset();
+    _quietTimer.start();
+    return _config;
+}
+
+int ConfigStore::sync(bool force)
+{
+    if (!_dirty || !_ready) return 0;
+    if (!force &&
+        _quietTimer.elapsed_time() < std::chrono::milliseconds(CONFIG_QUIET_MS) &&
+        _pendingTimer.elapsed_time() < std::chrono::milliseconds(CONFIG_MAX_DELAY_MS))
+    {
+        return 0;
+    }
+
+    int err = _store.set(CONFIG_KEY, &_config, sizeof(_config), 0);
+    if (err != MBED_SUCCESS) {
+        // Still dirty, retried once the quiet delay is over again
+        _failures++;
+        _quietTimer.reset();
+        _pendingTimer.reset();
+        return err;
+    }
+
+    _dirty = false;
+    _quietTimer.stop();
+    _pendingTimer.stop();
+    _writes++;
+    return MBED_SUCCESS;
+}
+
+uint32_t ConfigStore::loadTimeUs() const
+{
+    return _loadTimeUs;
+}
+
+uint32_t ConfigStore::writes() const
+{
+    return _writes;
+}
+
+uint32_t ConfigStore::failures() const
+{
+    return _failures;
+}
+
+void ConfigStore::loadDefaults()
+{
+    memset(&_config, 0, sizeof(_config));
+    _config.schema = CONFIG_SCHEMA_VERSION;
+    _config.size = sizeof(AppConfig);
+    memcpy(_config.securityPin, "1234", 4);
+    _config.hotTemperature = 28.0f;
+    _config.rainLevel = 0.6f;
+    _config.dayLightBelow = 0.7f;
+    _config.nightLightAbove = 0.4f;
+    _config.intruderDistance = 100.0f;
+    _config.intruderJump = 100.0f;
+}
@@ -0,0 +1,105 @@
+//-------------------------------------
+//ConfigStore.h
+#ifndef ConfigStore_h
+#define ConfigStore_h
+#undef __ARM_FP
+#include "mbed.h"
+#include "tdbstore/TDBStore.h"
+
+// Bump whenever AppConfig changes layout. Fields are only ever appended: an
+// older, shorter blob is read over the defaults, any other is ignored.
+#define CONFIG_SCHEMA_VERSION 2
+
+// Batching of writes: a change is written once no other change arrived for
+// CONFIG_QUIET_MS, or at the latest CONFIG_MAX_DELAY_MS after the first one.
+#define CONFIG_QUIET_MS 5000
+#define CONFIG_MAX_DELAY_MS 30000
+
+/**
+* Everything that has to survive a reset, stored as a single TDBStore value.
+*/
+struct AppConfig
+{
+    uint16_t schema;          // CONFIG_SCHEMA_VERSION
+    uint16_t size;            // sizeof(AppConfig)
+    char securityPin[4];
+    float hotTemperature;     // Celsius above which the AC turns on
+    float rainLevel;          // Rain sensor level that closes the window
+    float dayLightBelow;      // LDR level below which it is day
+    float nightLightAbove;    // LDR level above which it is night
+    float intruderDistance;   // cm, closer than this counts as presence
+    float intruderJump;       // cm, a sudden distance drop larger than this triggers
+    bool overrideAircon;
+    bool airconOn;            // Manual AC state while overrideAircon is set
+    bool overrideWindow;
+    bool windowOpen;          // Manual window state while overrideWindow is set
+    // Schema 2
+    uint32_t btBaud;          // Rate the Bluetooth module was set to, 0 if never set up
+};
+
+class ConfigStore
+{
+public:
+/**
+* Constructor
+*
+* @param bd: Block device reserved for the configuration, at least two erase
+* blocks so TDBStore can keep two areas.
+*/
+ConfigStore(mbed::BlockDevice *bd);
+/**
+* Mounts the store and loads the whole configuration with a single read.
+* A missing, truncated or older configuration falls back to the defaults.
+*
+* @return: 0 on success, a negative error code if the store cannot be
+* mounted. The defaults are loaded in either case.
+*/
+int init();
+/**
+* @return: The configuration in RAM.
+*/
+const AppConfig &get() const;
+/**
+* Gives write access to the configuration in RAM and schedules it to be
+* written back by sync().
+*
+* @return: The configuration in RAM.
+*/
+AppConfig &edit();
+/**
+* Writes the configuration back if it changed and the batching delay is over.
+* Call it from the main loop.
+*
+* @param force: Write now if anything changed, ignoring the batching delay.
+* @return: 0 if nothing had to be written or the write succeeded, a negative
+* error code otherwise. A failed write keeps the configuration dirty and is
+* retried CONFIG_QUIET_MS later.
+*/
+int sync(bool force = false);
+/**
+* @return: Time init() took to mount the store and load the configuration, in
+* microseconds.
+*/
+uint32_t loadTimeUs() const;
+/**
+* @return: Number of successful flash writes since boot.
+*/
+uint32_t writes() const;
+/**
+* @return: Number of failed flash writes since boot.
+*/
+uint32_t failures() const;
+private:
+TDBStore _store;
+AppConfig _config;
+bool _ready;
+bool _dirty;
+Timer _quietTimer;    // Since the last change
+Timer _pendingTimer;  // Since the first unsaved change
+uint32_t _loadTimeUs;
+uint32_t _writes;
+uint32_t _failures;
+
+void loadDefaults();
+};
+#endif
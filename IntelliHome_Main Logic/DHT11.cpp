@@ -16,6 +16,13 @@ void DHT11::setDelay(unsigned long delay)
 }
 
 int DHT11::readRawData(byte data[5])
+{
+    startRead();
+    thread_sleep_for(20); 
+    return finishRawData(data);
+}
+
+void DHT11::startRead()
 {
     DigitalInOut pin_DHT11(_pin);
     pin_DHT11.output(); 
@@ -26,7 +33,12 @@ int DHT11::readRawData(byte data[5])
     
     // --- START SIGNAL ---
     pin_DHT11 = 0;        
-    thread_sleep_for(20); 
+}
+
+int DHT11::finishRawData(byte data[5])
+{
+    // Take the line over still low, startRead left it driven low
+    DigitalInOut pin_DHT11(_pin, PIN_OUTPUT, PullNone, 0);
     pin_DHT11 = 1;        
     wait_us(30);          
     pin_DHT11.input();    
@@ -98,9 +110,16 @@ int DHT11::readHumidity()
 }
 
 int DHT11::readTemperatureHumidity(int &temperature, int &humidity)
+{
+    startRead();
+    thread_sleep_for(20); 
+    return finishRead(temperature, humidity);
+}
+
+int DHT11::finishRead(int &temperature, int &humidity)
 {
     byte data[5];
-    int error = readRawData(data);
+    int error = finishRawData(data);
     if (error != 0) return error;
 
     int humRaw = (data[0] << 8) | data[1];
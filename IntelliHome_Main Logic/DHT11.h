@@ -51,6 +51,22 @@ stored.
 checksum error.
 */
 int readTemperatureHumidity(int &temperature, int &humidity);
+/**
+* Starts a reading without waiting for the start signal.
+* Pulls the data line low, call finishRead at least 18 milliseconds later.
+*/
+void startRead();
+/**
+* Ends the start signal and reads the temperature and humidity.
+* Blocks for the about 5 milliseconds the sensor takes to send its data.
+*
+* @param temperature: Reference to a variable where the temperature value will be
+stored.
+* @param humidity: Reference to a variable where the humidity value will be stored.
+* @return: 0 if the reading is successful, DHT11::ERROR_TIMEOUT or
+DHT11::ERROR_CHECKSUM otherwise.
+*/
+int finishRead(int &temperature, int &humidity);
 // Constants to represent error codes.
 static const int ERROR_CHECKSUM = 254; // Error code indicating checksum mismatch.
 static const int ERROR_TIMEOUT = 253; // Error code indicating a timeout occurred
@@ -80,6 +96,14 @@ occurs,
 * or DHT11::ERROR_CHECKSUM if a checksum error occurs.
 */
 int readRawData(byte data[5]);
+/**
+* Private method to read raw data once the start signal has been held long enough.
+*
+* @param data: Array to store the raw data read from the sensor.
+* @return: 0 if the reading is successful, DHT11::ERROR_TIMEOUT or
+DHT11::ERROR_CHECKSUM otherwise.
+*/
+int finishRawData(byte data[5]);
 };
 #endif
 //-------------------------------------
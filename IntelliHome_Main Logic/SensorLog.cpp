@@ -0,0 +1,310 @@
+//-------------------------------------
+#include "SensorLog.h"
+#include <string.h>
+
+using namespace mbed;
+
+#define SEGMENT_MAGIC 0x31474C53 // "SLG1"
+#define NO_TIMESTAMP 0xFFFFFFFF
+
+// Written once at the start of every segment, right after it is erased.
+// Sequence numbers start at 1 and grow by one per segment, which gives the
+// order of the segments in the ring; 0 marks a segment without a valid header.
+struct SegmentHeader
+{
+    uint32_t magic;
+    uint32_t sequence;
+    uint16_t erases;
+    uint16_t check;
+};
+
+static uint8_t recordCheck(const SensorRecord &record)
+{
+    const uint8_t *bytes = (const uint8_t *)&record;
+    uint8_t sum = 0xA5;
+    for (unsigned i = 0; i < sizeof(SensorRecord) - 1; i++) {
+        sum += bytes[i];
+    }
+    return sum;
+}
+
+static uint16_t headerCheck(const SegmentHeader &header)
+{
+    return (uint16_t)~(header.sequence ^ (header.sequence >> 16) ^ header.erases);
+}
+
+static bool isValid(const SensorRecord &record)
+{
+    return record.timestamp != NO_TIMESTAMP && record.check == recordCheck(record);
+}
+
+SensorLog::SensorLog(BlockDevice *bd) : _bd(bd)
+{
+    _segmentSize = 0;
+    _recordsPerSegment = 0;
+    _segments = 0;
+    _head = 0;
+    _oldest = 0;
+    _used = 0;
+    _headCount = 0;
+    _lastTimestamp = 0;
+    _eraseValue = -1;
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+int SensorLog::init()
+{
+    int err = _bd->init();
+    if (err != 0) return err;
+
+    _segmentSize = _bd->get_erase_size();
+    if (sizeof(SensorRecord) % _bd->get_program_size() != 0 ||
+        _segmentSize < sizeof(SegmentHeader) + 2 * sizeof(SensorRecord))
+    {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+    _segments = _bd->size() / _segmentSize;
+    if (_segments > SENSOR_LOG_MAX_SEGMENTS) _segments = SENSOR_LOG_MAX_SEGMENTS;
+    if (_segments < 2) return BD_ERROR_DEVICE_ERROR;
+    _recordsPerSegment = (_segmentSize - sizeof(SegmentHeader)) / sizeof(SensorRecord);
+    _eraseValue = _bd->get_erase_value();
+
+    // --- Rebuild the sequence index from the segment headers ---
+    bool found = false;
+    for (uint32_t s = 0; s < _segments; s++) {
+        SegmentHeader header;
+        err = _bd->read(&header, (bd_addr_t)s * _segmentSize, sizeof(header));
+        if (err != 0) return err;
+        if (header.magic == SEGMENT_MAGIC && header.check == headerCheck(header)) {
+            _sequence[s] = header.sequence;
+            if (header.erases > _stats.maxErases) _stats.maxErases = header.erases;
+            if (!found || header.sequence > _sequence[_head]) _head = s;
+            found = true;
+        } else {
+            _sequence[s] = 0;
+        }
+        _firstTimestamp[s] = NO_TIMESTAMP;
+    }
+    _used = 0;
+    _headCount = 0;
+    _lastTimestamp = 0;
+    if (!found) return 0;
+
+    // Walk back from the newest segment while the sequence stays contiguous
+    _oldest = _head;
+    _used = 1;
+    while (_used < _segments) {
+        uint32_t prev = (_oldest + _segments - 1) % _segments;
+        if (_sequence[prev] == 0 || _sequence[prev] != _sequence[_oldest] - 1) break;
+        _oldest = prev;
+        _used++;
+    }
+
+    // Slots are programmed in order, so the first erased slot of the head
+    // segment is found by binary search.
+    uint32_t lo = 0, hi = _recordsPerSegment;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        SensorRecord record;
+        err = readSlot(_head, mid, record);
+        if (err != 0) return err;
+        if (isErased(record)) hi = mid;
+        else lo = mid + 1;
+    }
+    _headCount = lo;
+
+    // --- Sparse time index: first valid timestamp of every segment ---
+    for (uint32_t order = 0; order < _used; order++) {
+        uint32_t segment = segmentAt(order);
+        uint32_t slots = slotsIn(order);
+        for (uint32_t slot = 0; slot < slots; slot++) {
+            SensorRecord record;
+            err = readSlot(segment, slot, record);
+            if (err != 0) return err;
+            if (isValid(record)) {
+                _firstTimestamp[segment] = record.timestamp;
+                break;
+            }
+        }
+    }
+
+    // Newest valid record gives the timestamp floor for new appends
+    for (uint32_t position = size(); position > 0; position--) {
+        SensorRecord record;
+        if (read(position - 1, record) == 0) {
+            _lastTimestamp = record.timestamp;
+            break;
+        }
+    }
+    return 0;
+}
+
+int SensorLog::append(SensorRecord &record)
+{
+    int err;
+    if (_used == 0) {
+        err = startSegment(0, 1);
+        if (err != 0) return err;
+        _head = 0;
+        _oldest = 0;
+        _used = 1;
+    } else if (_headCount == _recordsPerSegment) {
+        // Rotate to the next segment. Once the device is full that is the
+        // oldest one, so every segment is erased in turn.
+        uint32_t next = (_head + 1) % _segments;
+        uint32_t sequence = _sequence[_head] + 1;
+        if (_used == _segments) {
+            _oldest = (_oldest + 1) % _segments;
+            _used--;
+        }
+        err = startSegment(next, sequence);
+        if (err != 0) return err;
+        _head = next;
+        _used++;
+    }
+
+    if (record.timestamp < _lastTimestamp) record.timestamp = _lastTimestamp;
+    record.check = recordCheck(record);
+
+    // The slot is consumed even if programming fails, a half-programmed
+    // slot cannot be programmed again without an erase.
+    uint32_t slot = _headCount++;
+    err = _bd->program(&record, slotAddress(_head, slot), sizeof(SensorRecord));
+    if (err != 0) return err;
+
+    if (_firstTimestamp[_head] == NO_TIMESTAMP) _firstTimestamp[_head] = record.timestamp;
+    _lastTimestamp = record.timestamp;
+    _stats.appended++;
+    _stats.programmed += sizeof(SensorRecord);
+    return 0;
+}
+
+uint32_t SensorLog::seek(uint32_t timestamp)
+{
+    if (_used == 0) return 0;
+
+    // Last segment starting before the timestamp, so that a run of equal
+    // timestamps across a segment boundary is found from its start
+    uint32_t lo = 0, hi = _used;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (firstTimestampFrom(mid) < timestamp) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo == 0) return 0;
+    uint32_t order = lo - 1;
+
+    // First record inside it that is not older than the timestamp. A torn
+    // record is treated as older so the search moves past it.
+    uint32_t segment = segmentAt(order);
+    lo = 0;
+    hi = slotsIn(order);
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        SensorRecord record;
+        if (readSlot(segment, mid, record) != 0) return size();
+        if (!isValid(record) || record.timestamp < timestamp) lo = mid + 1;
+        else hi = mid;
+    }
+    return order * _recordsPerSegment + lo;
+}
+
+int SensorLog::read(uint32_t position, SensorRecord &record)
+{
+    if (position >= size()) return -1;
+    int err = readSlot(segmentAt(position / _recordsPerSegment),
+                       position % _recordsPerSegment, record);
+    if (err != 0) return err;
+    return isValid(record) ? 0 : -1;
+}
+
+uint32_t SensorLog::size() const
+{
+    if (_used == 0) return 0;
+    return (_used - 1) * _recordsPerSegment + _headCount;
+}
+
+uint32_t SensorLog::lastTimestamp() const
+{
+    return _lastTimestamp;
+}
+
+const SensorLogStats &SensorLog::stats() const
+{
+    return _stats;
+}
+
+uint32_t SensorLog::segmentAt(uint32_t order) const
+{
+    return (_oldest + order) % _segments;
+}
+
+// A segment without a valid record takes the first timestamp of the next
+// one, which keeps the index sorted for the binary search
+uint32_t SensorLog::firstTimestampFrom(uint32_t order) const
+{
+    for (; order < _used; order++) {
+        uint32_t first = _firstTimestamp[segmentAt(order)];
+        if (first != NO_TIMESTAMP) return first;
+    }
+    return NO_TIMESTAMP;
+}
+
+uint32_t SensorLog::slotsIn(uint32_t order) const
+{
+    return (order == _used - 1) ? _headCount : _recordsPerSegment;
+}
+
+bd_addr_t SensorLog::slotAddress(uint32_t segment, uint32_t slot) const
+{
+    return (bd_addr_t)segment * _segmentSize + sizeof(SegmentHeader) +
+           (bd_addr_t)slot * sizeof(SensorRecord);
+}
+
+int SensorLog::readSlot(uint32_t segment, uint32_t slot, SensorRecord &record)
+{
+    return _bd->read(&record, slotAddress(segment, slot), sizeof(SensorRecord));
+}
+
+bool SensorLog::isErased(const SensorRecord &record) const
+{
+    if (_eraseValue < 0) return !isValid(record);
+
+    const uint8_t *bytes = (const uint8_t *)&record;
+    for (unsigned i = 0; i < sizeof(SensorRecord); i++) {
+        if (bytes[i] != (uint8_t)_eraseValue) return false;
+    }
+    return true;
+}
+
+int SensorLog::startSegment(uint32_t segment, uint32_t sequence)
+{
+    SegmentHeader header;
+    bd_addr_t address = (bd_addr_t)segment * _segmentSize;
+
+    // Carry the erase count over from the header being erased
+    int err = _bd->read(&header, address, sizeof(header));
+    if (err != 0) return err;
+    uint16_t erases = 1;
+    if (header.magic == SEGMENT_MAGIC && header.check == headerCheck(header)) {
+        erases = header.erases + 1;
+    }
+
+    err = _bd->erase(address, _segmentSize);
+    if (err != 0) return err;
+    _stats.erased += _segmentSize;
+
+    header.magic = SEGMENT_MAGIC;
+    header.sequence = sequence;
+    header.erases = erases;
+    header.check = headerCheck(header);
+    err = _bd->program(&header, address, sizeof(header));
+    if (err != 0) return err;
+    _stats.programmed += sizeof(header);
+
+    _sequence[segment] = sequence;
+    _firstTimestamp[segment] = NO_TIMESTAMP;
+    _headCount = 0;
+    if (erases > _stats.maxErases) _stats.maxErases = erases;
+    return 0;
+}
@@ -0,0 +1,127 @@
+//-------------------------------------
+//SensorLog.h
+#ifndef SensorLog_h
+#define SensorLog_h
+#include <stdint.h>
+#include "BlockDevice.h"
+
+// Upper bound on the number of erase blocks the log can manage. The sparse
+// index keeps two words per segment in RAM.
+#define SENSOR_LOG_MAX_SEGMENTS 32
+
+// Bits of SensorRecord::flags
+#define SENSOR_FLAG_RAINING     0x01
+#define SENSOR_FLAG_PERSON_HOME 0x02
+#define SENSOR_FLAG_ALARM       0x04
+#define SENSOR_FLAG_AIRCON      0x08
+
+/**
+* One fixed-size sample as stored in flash. The size is a multiple of the
+* STM32F1 flash program size (4 bytes), so every record is a single program.
+*/
+struct SensorRecord
+{
+    uint32_t timestamp;   // RTC time in seconds, never decreasing within the log
+    int8_t temperature;   // Celsius
+    uint8_t humidity;     // Percent
+    uint16_t light;       // Raw LDR reading (AnalogIn::read_u16)
+    uint16_t rain;        // Raw rain sensor reading (AnalogIn::read_u16)
+    uint8_t flags;        // SENSOR_FLAG_* bits
+    uint8_t check;        // Filled in by SensorLog::append
+};
+
+/**
+* Counters used to judge flash wear and write amplification.
+*/
+struct SensorLogStats
+{
+    uint32_t appended;    // Records appended since boot
+    uint32_t programmed;  // Bytes programmed since boot (records and segment headers)
+    uint32_t erased;      // Bytes erased since boot
+    uint16_t maxErases;   // Highest erase count seen on any segment
+};
+
+class SensorLog
+{
+public:
+/**
+* Constructor
+* The log uses the whole block device. Every erase block of the device becomes
+* one segment holding a header and as many records as fit behind it.
+*
+* @param bd: Block device the log lives on, e.g. a FlashIAPBlockDevice.
+*/
+SensorLog(mbed::BlockDevice *bd);
+/**
+* Initializes the block device and mounts the log.
+* Segment headers are scanned once to rebuild the sparse time index and to
+* find the segment and slot where the next record goes.
+*
+* @return: 0 on success, a negative block device error code otherwise.
+*/
+int init();
+/**
+* Appends a record at the end of the log.
+* When the newest segment is full the oldest segment is erased and reused,
+* so erases rotate evenly over the whole device.
+*
+* @param record: Record to store. Its timestamp is raised to the last stored
+* timestamp if it would go backwards, and its check byte is filled in.
+* @return: 0 on success, a negative block device error code otherwise.
+*/
+int append(SensorRecord &record);
+/**
+* Finds the first record with a timestamp at or after the given time.
+* Takes O(log n) reads: a binary search over the segment index followed by a
+* binary search inside one segment.
+*
+* @param timestamp: Time to seek to.
+* @return: Position of the record, or size() if every record is older.
+*/
+uint32_t seek(uint32_t timestamp);
+/**
+* Reads the record at a position.
+*
+* @param position: Position between 0 (oldest record) and size().
+* @param record: Reference to a record that receives the stored data.
+* @return: 0 on success, -1 if the slot holds a torn write or the position is
+* out of range, or a negative block device error code.
+*/
+int read(uint32_t position, SensorRecord &record);
+/**
+* @return: Position one past the newest record.
+*/
+uint32_t size() const;
+/**
+* @return: Timestamp of the newest record, 0 if the log is empty.
+*/
+uint32_t lastTimestamp() const;
+/**
+* @return: Wear and write amplification counters.
+*/
+const SensorLogStats &stats() const;
+private:
+mbed::BlockDevice *_bd;
+uint32_t _segmentSize;       // Erase block size
+uint32_t _recordsPerSegment;
+uint32_t _segments;          // Segments on the device
+uint32_t _head;              // Segment being appended to
+uint32_t _oldest;            // Oldest segment still holding data
+uint32_t _used;              // Segments holding data, _oldest to _head
+uint32_t _headCount;         // Slots already written in the head segment
+uint32_t _lastTimestamp;
+int _eraseValue;
+SensorLogStats _stats;
+// Sparse index: sequence number and first timestamp of every segment
+uint32_t _sequence[SENSOR_LOG_MAX_SEGMENTS];
+uint32_t _firstTimestamp[SENSOR_LOG_MAX_SEGMENTS];
+
+uint32_t segmentAt(uint32_t order) const;
+uint32_t firstTimestampFrom(uint32_t order) const;
+uint32_t slotsIn(uint32_t order) const;
+mbed::bd_addr_t slotAddress(uint32_t segment, uint32_t slot) const;
+int readSlot(uint32_t segment, uint32_t slot, SensorRecord &record);
+bool isErased(const SensorRecord &record) const;
+int startSegment(uint32_t segment, uint32_t sequence);
+};
+#endif
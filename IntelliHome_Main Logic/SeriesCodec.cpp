@@ -0,0 +1,210 @@
+//-------------------------------------
+#include "SeriesCodec.h"
+#include <string.h>
+
+#define COUNT_BITS 16
+
+static uint32_t zigzag(int32_t value)
+{
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value)
+{
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+SeriesEncoder::SeriesEncoder(uint8_t *buffer, size_t size) : _buffer(buffer)
+{
+    _bits = size * 8;
+    _position = COUNT_BITS;
+    _overflow = false;
+    _count = 0;
+    _previousDelta = 0;
+    memset(&_previous, 0, sizeof(_previous));
+}
+
+bool SeriesEncoder::append(const SensorRecord &record)
+{
+    size_t start = _position;
+
+    if (_count == 0) {
+        writeBits(record.timestamp, 32);
+        writeBits((uint8_t)record.temperature, 8);
+        writeBits(record.humidity, 8);
+        writeBits(record.light, 16);
+        writeBits(record.rain, 16);
+        writeBits(record.flags, 8);
+    } else {
+        uint32_t delta = record.timestamp - _previous.timestamp;
+        writeTimestamp((int32_t)(delta - _previousDelta));
+        writeValue((int32_t)record.temperature - _previous.temperature);
+        writeValue((int32_t)record.humidity - _previous.humidity);
+        writeValue((int32_t)record.light - _previous.light);
+        writeValue((int32_t)record.rain - _previous.rain);
+        uint8_t changed = record.flags ^ _previous.flags;
+        if (changed == 0) {
+            writeBits(0, 1);
+        } else {
+            writeBits(1, 1);
+            writeBits(changed, 8);
+        }
+    }
+
+    if (_overflow) {
+        // Roll back, whatever was written past the old position is ignored
+        _position = start;
+        _overflow = false;
+        return false;
+    }
+
+    if (_count > 0) _previousDelta = record.timestamp - _previous.timestamp;
+    _previous = record;
+    _count++;
+    return true;
+}
+
+size_t SeriesEncoder::finish()
+{
+    // A buffer too short for the count holds no block
+    if (_bits < COUNT_BITS) return 0;
+    _buffer[0] = (uint8_t)(_count >> 8);
+    _buffer[1] = (uint8_t)_count;
+    return (_position + 7) / 8;
+}
+
+uint16_t SeriesEncoder::count() const
+{
+    return _count;
+}
+
+void SeriesEncoder::writeBits(uint32_t value, int bits)
+{
+    while (bits > 0) {
+        if (_position >= _bits) {
+            _overflow = true;
+            return;
+        }
+        bits--;
+        uint8_t mask = 0x80 >> (_position & 7);
+        if ((value >> bits) & 1) _buffer[_position >> 3] |= mask;
+        else _buffer[_position >> 3] &= ~mask;
+        _position++;
+    }
+}
+
+void SeriesEncoder::writeTimestamp(int32_t deltaOfDelta)
+{
+    uint32_t value = zigzag(deltaOfDelta);
+    if (value == 0) {
+        writeBits(0x0, 1);
+    } else if (value < (1u << 7)) {
+        writeBits(0x2, 2);
+        writeBits(value, 7);
+    } else if (value < (1u << 9)) {
+        writeBits(0x6, 3);
+        writeBits(value, 9);
+    } else if (value < (1u << 12)) {
+        writeBits(0xE, 4);
+        writeBits(value, 12);
+    } else {
+        writeBits(0xF, 4);
+        writeBits(value, 32);
+    }
+}
+
+void SeriesEncoder::writeValue(int32_t delta)
+{
+    uint32_t value = zigzag(delta);
+    if (value == 0) {
+        writeBits(0x0, 1);
+    } else if (value < (1u << 3)) {
+        writeBits(0x2, 2);
+        writeBits(value, 3);
+    } else if (value < (1u << 8)) {
+        writeBits(0x6, 3);
+        writeBits(value, 8);
+    } else {
+        writeBits(0x7, 3);
+        writeBits(value, 17);
+    }
+}
+
+SeriesDecoder::SeriesDecoder(const uint8_t *buffer, size_t size) : _buffer(buffer)
+{
+    _bits = size * 8;
+    _position = 0;
+    _overflow = false;
+    _decoded = 0;
+    _previousDelta = 0;
+    memset(&_previous, 0, sizeof(_previous));
+    _count = (uint16_t)readBits(COUNT_BITS);
+    if (_overflow) _count = 0;
+}
+
+bool SeriesDecoder::next(SensorRecord &record)
+{
+    if (_decoded >= _count) return false;
+
+    memset(&record, 0, sizeof(record));
+    if (_decoded == 0) {
+        record.timestamp = readBits(32);
+        record.temperature = (int8_t)readBits(8);
+        record.humidity = (uint8_t)readBits(8);
+        record.light = (uint16_t)readBits(16);
+        record.rain = (uint16_t)readBits(16);
+        record.flags = (uint8_t)readBits(8);
+    } else {
+        uint32_t delta = _previousDelta + (uint32_t)readTimestamp();
+        record.timestamp = _previous.timestamp + delta;
+        record.temperature = (int8_t)(_previous.temperature + readValue());
+        record.humidity = (uint8_t)(_previous.humidity + readValue());
+        record.light = (uint16_t)(_previous.light + readValue());
+        record.rain = (uint16_t)(_previous.rain + readValue());
+        record.flags = _previous.flags;
+        if (readBits(1)) record.flags ^= (uint8_t)readBits(8);
+        _previousDelta = delta;
+    }
+    if (_overflow) return false;
+
+    _previous = record;
+    _decoded++;
+    return true;
+}
+
+uint16_t SeriesDecoder::count() const
+{
+    return _count;
+}
+
+uint32_t SeriesDecoder::readBits(int bits)
+{
+    uint32_t value = 0;
+    while (bits > 0) {
+        if (_position >= _bits) {
+            _overflow = true;
+            return 0;
+        }
+        bits--;
+        value = (value << 1) | ((_buffer[_position >> 3] >> (7 - (_position & 7))) & 1);
+        _position++;
+    }
+    return value;
+}
+
+int32_t SeriesDecoder::readTimestamp()
+{
+    if (readBits(1) == 0) return 0;
+    if (readBits(1) == 0) return unzigzag(readBits(7));
+    if (readBits(1) == 0) return unzigzag(readBits(9));
+    if (readBits(1) == 0) return unzigzag(readBits(12));
+    return unzigzag(readBits(32));
+}
+
+int32_t SeriesDecoder::readValue()
+{
+    if (readBits(1) == 0) return 0;
+    if (readBits(1) == 0) return unzigzag(readBits(3));
+    if (readBits(1) == 0) return unzigzag(readBits(8));
+    return unzigzag(readBits(17));
+}
@@ -0,0 +1,104 @@
+//-------------------------------------
+//SeriesCodec.h
+#ifndef SeriesCodec_h
+#define SeriesCodec_h
+#include <stddef.h>
+#include <stdint.h>
+#include "SensorLog.h"
+
+/*
+* Block layout, bits written most significant first:
+*   count        16 bits, number of records in the block
+*   first record timestamp 32, temperature 8, humidity 8, light 16, rain 16,
+*                flags 8, stored as is
+*   every other record:
+*     timestamp    delta-of-delta, zig-zag coded, in a size bucket:
+*                  '0' | '10'+7 | '110'+9 | '1110'+12 | '1111'+32 bits
+*     temperature, humidity, light, rain
+*                  delta to the previous record, zig-zag coded, in a size bucket:
+*                  '0' | '10'+3 | '110'+8 | '111'+17 bits
+*     flags        XOR with the previous record: '0' | '1'+8 bits
+*/
+
+class SeriesEncoder
+{
+public:
+/**
+* Constructor
+*
+* @param buffer: Memory the block is written to.
+* @param size: Size of the buffer in bytes, at least 13 to hold the count and
+* one record.
+*/
+SeriesEncoder(uint8_t *buffer, size_t size);
+/**
+* Adds a record to the block.
+*
+* @param record: Record to add. Timestamps must not go backwards.
+* @return: true if the record was added, false if the block is full. A record
+* that does not fit leaves the block unchanged.
+*/
+bool append(const SensorRecord &record);
+/**
+* Completes the block.
+*
+* @return: Number of bytes of the buffer in use, 0 if the buffer is too short
+* to hold the record count.
+*/
+size_t finish();
+/**
+* @return: Number of records in the block.
+*/
+uint16_t count() const;
+private:
+uint8_t *_buffer;
+size_t _bits;      // Capacity in bits
+size_t _position;  // Next bit to write
+bool _overflow;
+uint16_t _count;
+SensorRecord _previous;
+uint32_t _previousDelta;
+
+void writeBits(uint32_t value, int bits);
+void writeTimestamp(int32_t deltaOfDelta);
+void writeValue(int32_t delta);
+};
+
+class SeriesDecoder
+{
+public:
+/**
+* Constructor
+*
+* @param buffer: A block produced by SeriesEncoder.
+* @param size: Number of bytes in the block.
+*/
+SeriesDecoder(const uint8_t *buffer, size_t size);
+/**
+* Decodes the next record of the block.
+*
+* @param record: Reference to a record that receives the decoded data. The
+* check byte is left at 0.
+* @return: true if a record was decoded, false at the end of the block or if
+* the block is truncated.
+*/
+bool next(SensorRecord &record);
+/**
+* @return: Number of records in the block.
+*/
+uint16_t count() const;
+private:
+const uint8_t *_buffer;
+size_t _bits;
+size_t _position;
+bool _overflow;
+uint16_t _count;
+uint16_t _decoded;
+SensorRecord _previous;
+uint32_t _previousDelta;
+
+uint32_t readBits(int bits);
+int32_t readTimestamp();
+int32_t readValue();
+};
+#endif
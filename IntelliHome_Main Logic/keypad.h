@@ -1,4 +1,8 @@
 // file : keypad.h 
+#include "platform/Callback.h"
 
 extern char getkey(void); // waits for a keypress and returns the ascii code
 
+// Holds all the rows low between scans, so pressing any key pulls its column
+// low and calls func from interrupt context. A null func stops this.
+extern void keypad_wake(mbed::Callback<void()> func);
@@ -2,24 +2,30 @@
 #include "mbed.h"
 
 // --- CORRECTED PIN MAPPING BASED ON SCAN ---
-DigitalOut Row1(PB_9);
-DigitalOut Row2(PB_14);
-DigitalOut Row3(PB_13);
-DigitalOut Row4(PB_11);
-
-DigitalIn Col1(PB_10);
-DigitalIn Col2(PB_8);
-DigitalIn Col3(PB_12);
+// Rows start High (Inactive), each access is a single GPIOB register access
+GpioOut<PortB, 9> Row1(1);
+GpioOut<PortB, 14> Row2(1);
+GpioOut<PortB, 13> Row3(1);
+GpioOut<PortB, 11> Row4(1);
+GpioPortOut<PortB, decltype(Row1)::mask | decltype(Row2)::mask | decltype(Row3)::mask | decltype(Row4)::mask> Rows(0xFFFF);
+
+// PullUp resistors so unconnected columns read High (1)
+GpioIn<PortB, 10> Col1(PullUp);
+GpioIn<PortB, 8> Col2(PullUp);
+GpioIn<PortB, 12> Col3(PullUp);
 // -------------------------------------------
 
-char getkey(void) {
-    // Enable PullUp resistors so unconnected columns read High (1)
-    Col1.mode(PullUp); 
-    Col2.mode(PullUp); 
-    Col3.mode(PullUp);
-    
-    // Default all rows to High (Inactive)
-    Row1 = 1; Row2 = 1; Row3 = 1; Row4 = 1;
+// The same columns as falling edge interrupts, for keypad_wake
+InterruptIn Col1Irq(PB_10, PullUp);
+InterruptIn Col2Irq(PB_8, PullUp);
+InterruptIn Col3Irq(PB_12, PullUp);
+
+// Rows left after a scan, all low while a wake callback is attached
+uint32_t rowsIdle = 0xFFFF;
+
+static char scan(void) {
+    // Default all rows to High (Inactive), in one store
+    Rows = 0xFFFF;
 
     // --- SCAN ROW 1 (Keys 1, 2, 3) ---
     Row1 = 0; // Activate Row 1
@@ -50,4 +56,18 @@ char getkey(void) {
     Row4 = 1;
 
     return 0; // Return 0 if no key is pressed
+}
+
+char getkey(void) {
+    char key = scan();
+    Rows = rowsIdle;
+    return key;
+}
+
+void keypad_wake(mbed::Callback<void()> func) {
+    Col1Irq.fall(func);
+    Col2Irq.fall(func);
+    Col3Irq.fall(func);
+    rowsIdle = func ? 0 : 0xFFFF;
+    Rows = rowsIdle;
 }
\ No newline at end of file
@@ -3,46 +3,115 @@
 #include "DHT11.h"
 #include "lcd.h"    
 #include "keypad.h" 
+#include "SensorLog.h"
+#include "SeriesCodec.h"
+#include "ConfigStore.h"
+#include "BtLink.h"
+#include "metrics.h"
+#include "profile.h"
+#include "FlashIAPBlockDevice.h"
+#include "platform/SPSCCircularBuffer.h"
+#include "hal/us_ticker_api.h"
+#include "hal/static_pinmap.h"
+#include "platform/StaticFormat.h"
+#include "platform/mbed_mem_trace.h"
 #include <chrono>
 
+#define TRACE_GROUP "main"
+#include "mbed-trace/mbed_trace.h"
+
 using namespace std::chrono;
 
-PwmOut Aircon_En(PB_0);    
-DigitalOut Aircon_In1(PC_1);  
-DigitalOut Aircon_In2(PC_2);  
+// Pin functions are resolved at compile time, a wrong pin does not build
+PwmOut Aircon_En(static_pwm_pinmap<PB_0>::value);    
+GpioOut<PortC, 1> Aircon_In1;  
+GpioOut<PortC, 2> Aircon_In2;  
 
-PwmOut curtainServo(PA_7);    
-PwmOut windowServo(PB_3);     
+PwmOut curtainServo(static_pwm_pinmap<PA_7>::value);    
+PwmOut windowServo(static_pwm_pinmap<PB_3>::value);     
 
 #define DHT11_PIN PB_5  
 DHT11 dht11(DHT11_PIN);
 
 InterruptIn motionSensor(PA_0); 
-AnalogIn ldr(PA_4);  
-AnalogIn rainSensor(PA_5);           
+AnalogIn ldr(static_analogin_pinmap<PA_4>::value);  
+AnalogIn rainSensor(static_analogin_pinmap<PA_5>::value);           
 
-DigitalOut ultrasonicTrigger(PA_1); 
+GpioOut<PortA, 1> ultrasonicTrigger; 
 InterruptIn ultrasonicEcho(PA_6);   
 
-DigitalOut buzzer(PC_0);      
-
-DigitalOut redLed(PB_1);
-DigitalOut blueLed(PB_2); 
-DigitalOut greenLed(PC_3);  
-
-UnbufferedSerial btUART(PB_6, PB_7);  
-UnbufferedSerial voiceUART(PC_10, PC_11); 
+GpioOut<PortC, 0> buzzer;      
+
+GpioOut<PortB, 1> redLed;
+GpioOut<PortB, 2> blueLed; 
+GpioOut<PortC, 3> greenLed;  
+
+// Received by DMA into a ring, one interrupt per burst when the line goes idle
+DmaSerial btUART(static_uart_pinmap<PB_6, PB_7>::value);
+UnbufferedSerial voiceUART(static_uart_pinmap<PC_10, PC_11>::value); 
+
+// HC-05 KEY pin, NC when it is not wired and the module is not set up
+DigitalOut btKey(MBED_CONF_APP_BT_KEY_PIN, 0);
+void setBtBaud(int baud) { btUART.set_baud(baud); }
+void setBtKey(int level) { btKey = level; }
+BtLink btLink(&btUART, setBtBaud,
+              MBED_CONF_APP_BT_KEY_PIN != NC ? mbed::Callback<void(int)>(setBtKey) : nullptr);
+
+// The data areas sit above the image, target.mbed_app_size caps the image at the link
+#if defined(MBED_APP_START) && defined(MBED_APP_SIZE)
+static_assert(MBED_APP_START + MBED_APP_SIZE <= MBED_CONF_APP_CONFIG_STORE_ADDRESS,
+              "the application image overlaps the configuration area");
+#endif
+static_assert(MBED_CONF_APP_CONFIG_STORE_ADDRESS + MBED_CONF_APP_CONFIG_STORE_SIZE <= MBED_CONF_APP_SENSOR_LOG_ADDRESS,
+              "the configuration area overlaps the sensor log");
+
+FlashIAPBlockDevice logFlash(MBED_CONF_APP_SENSOR_LOG_ADDRESS, MBED_CONF_APP_SENSOR_LOG_SIZE);
+SensorLog sensorLog(&logFlash);
+bool sensorLogReady = false;
+
+FlashIAPBlockDevice configFlash(MBED_CONF_APP_CONFIG_STORE_ADDRESS, MBED_CONF_APP_CONFIG_STORE_SIZE);
+ConfigStore config(&configFlash);
+const AppConfig &cfg = config.get();
+
+// Echo edges are timestamped in the ISR and handled from the main loop
+EventQueue eventQueue(0);
+uint32_t echoRiseUs = 0;
+bool echoHigh = false;
+void echo_edges(const EdgeRecord *edges, size_t count);
+EdgeCapture<8> echoCapture(&eventQueue, echo_edges);
+
+// The loops sleep in poll_wait() until one of these or a Bluetooth byte wakes them
+PollEvent queueEvent;   // an event of eventQueue is due
+PollEvent voiceEvent;   // voice bytes in voiceRx
+PollEvent rangingEvent; // time for the next ultrasonic measurement
+PollEvent sensorEvent;  // time for the next DHT11 read
+PollEvent keyEvent;     // a key went down while the alarm waits for the PIN
+Ticker rangingTicker;
+Ticker sensorTicker;
+Timeout queueTimeout;
+
+// Background of eventQueue: sets queueEvent when its next event is due
+void queue_update(int ms) {
+    if (ms < 0) {
+        queueTimeout.detach();
+    } else if (ms == 0) {
+        queueEvent.set();
+    } else {
+        queueTimeout.attach(callback(&queueEvent, &PollEvent::set), milliseconds(ms));
+    }
+}
 
-Timer echoTimer;
 Timer graceTimer;       
 Timer awayTimer;        
-Timer sensorReadTimer;      
 Timer intruderTimer;
 Timer stabilizationTimer; 
 Timer alarmReportTimer; 
+Timer logTimer;
+Timer loopTimer;
 
 bool potentialIntruder = false; 
 volatile float currentDist = 0.0f;
+volatile uint32_t currentDistMm = 0;
 float lastDist = 0.0f; 
 volatile bool alarmTriggered = false; 
 
@@ -57,24 +126,218 @@ bool overrideWindow = false;
 bool windowState = false; 
 bool curtainState = false; 
 
-char securityPin[4] = {'1', '2', '3', '4'};
+// Latest DHT11 result, published by dhtRead for the main loop
+int dhtTemp = 0, dhtHumidity = 0, dhtStatus = 0;
+bool dhtReady = false;
+
+// DHT11 acquisition: the 20 ms start signal is a queue sleep instead of a
+// blocking wait, only the 5 ms bit stream still holds the loop
+class DhtRead : public Coroutine {
+public:
+    DhtRead(EventQueue *queue) : Coroutine(queue) {}
+private:
+    Timer readTimer;
+    uint32_t readStart;
+
+    void run() override {
+        CO_BEGIN();
+        dht11.startRead();
+        CO_AWAIT(sleep_for(20ms));
+        readTimer.reset(); readTimer.start();
+        readStart = profile_cycles();
+        dhtStatus = dht11.finishRead(dhtTemp, dhtHumidity);
+        profile_record(PROFILE_DHT, profile_cycles() - readStart);
+        metrics_observe(HISTOGRAM_DHT_US, (uint32_t)duration_cast<microseconds>(readTimer.elapsed_time()).count());
+        if (dhtStatus == 0) metrics_count(COUNTER_DHT_OK);
+        else if (dhtStatus == DHT11::ERROR_TIMEOUT) metrics_count(COUNTER_DHT_TIMEOUTS);
+        else metrics_count(COUNTER_DHT_CHECKSUMS);
+        dhtReady = true;
+        CO_END();
+    }
+};
+DhtRead dhtRead(&eventQueue);
+
+// Buzzer beep that ends by itself while the caller carries on
+class Beep : public Coroutine {
+public:
+    Beep(EventQueue *queue, EventQueue::duration length) : Coroutine(queue), _length(length) {}
+private:
+    EventQueue::duration _length;
+
+    void run() override {
+        CO_BEGIN();
+        buzzer = 1;
+        CO_AWAIT(sleep_for(_length));
+        buzzer = 0;
+        CO_END();
+    }
+};
+CoroutinePool<Beep, 2> beeps;
+
+
+void logSample(int temp, int humidity, uint16_t light, uint16_t rain) {
+    SensorRecord record;
+    record.timestamp = (uint32_t)time(NULL);
+    record.temperature = (int8_t)temp;
+    record.humidity = (uint8_t)humidity;
+    record.light = light;
+    record.rain = rain;
+    record.flags = 0;
+    if (isRaining) record.flags |= SENSOR_FLAG_RAINING;
+    if (isPersonHome) record.flags |= SENSOR_FLAG_PERSON_HOME;
+    if (alarmTriggered) record.flags |= SENSOR_FLAG_ALARM;
+    if (acState) record.flags |= SENSOR_FLAG_AIRCON;
+    if (sensorLog.append(record) == 0) {
+        metrics_count(COUNTER_LOG_APPENDS);
+    } else {
+        metrics_count(COUNTER_LOG_ERRORS);
+        tr_error("Sensor log write failed");
+    }
+}
+
+// Telemetry line "temp,humidity,rain,raining,dist,home,alarm,ac" from the
+// integer readings, formatted by a writer the compiler builds for the line
+size_t telemetry_line(char (&buffer)[60], int temp, int humidity, uint16_t rainRaw, bool raining,
+                      uint32_t distMm, bool home, bool alarm, bool ac) {
+    return MBED_STATIC_FORMAT("%.1f,%.1f,%.2f,%d,%.1f,%d,%d,%d\r\n")(buffer,
+           Scaled<0>(temp), Scaled<0>(humidity), Fixed<16>(rainRaw), raining, Scaled<1>(distMm),
+           home, alarm, ac);
+}
+
+// Telemetry line while armed: the readings are not taken and sent as "0.0",
+// rain included, so the line keeps the text the app has always parsed
+size_t alarm_line(char (&buffer)[60], uint32_t distMm, bool home, bool ac) {
+    return MBED_STATIC_FORMAT("0.0,0.0,0.0,0,%.1f,%d,1,%d\r\n")(buffer, Scaled<1>(distMm), home, ac);
+}
+
+// Bulk history download: the log is sent as compressed blocks, each framed as
+// 'H', length (little endian, 2 bytes), block. A zero length ends the transfer.
+void sendHistoryBlock(const uint8_t *block, size_t len) {
+    uint8_t header[3] = {'H', (uint8_t)(len & 0xFF), (uint8_t)(len >> 8)};
+    const Span<const uint8_t> frame[] = { header, Span<const uint8_t>(block, len) };
+    btUART.writev(frame);
+}
+
+void sendHistory() {
+    uint8_t block[128];
+    uint32_t position = 0;
+    uint32_t end = sensorLog.size();
+    while (position < end) {
+        SeriesEncoder encoder(block, sizeof(block));
+        while (position < end) {
+            SensorRecord record;
+            if (sensorLog.read(position, record) == 0 && !encoder.append(record)) break;
+            position++;
+        }
+        sendHistoryBlock(block, encoder.finish());
+    }
+    sendHistoryBlock(block, 0);
+}
+
+// Write manual overrides through to the config store so they survive a reset
+void persistOverrides() {
+    bool airconOn = overrideAircon && acState;
+    bool windowOpen = overrideWindow && windowState;
+    if (cfg.overrideAircon != overrideAircon || cfg.airconOn != airconOn ||
+        cfg.overrideWindow != overrideWindow || cfg.windowOpen != windowOpen) {
+        AppConfig &c = config.edit();
+        c.overrideAircon = overrideAircon;
+        c.airconOn = airconOn;
+        c.overrideWindow = overrideWindow;
+        c.windowOpen = windowOpen;
+    }
+}
+
+// An overrun means a byte was lost because the loop did not read the UART in
+// time. The flag is cleared by the read that follows.
+#if defined(TARGET_STM32F1)
+#define countOverrun(uart, counter) do { if ((uart)->SR & USART_SR_ORE) metrics_count(counter); } while (0)
+#else
+#define countOverrun(uart, counter)
+#endif
+
+// Voice module bytes, moved out of the UART register by the RX interrupt so
+// none are lost while the loop is busy
+SPSCCircularBuffer<char, 16> voiceRx;
+
+void voice_rx() {
+    while (voiceUART.readable()) {
+        countOverrun(USART3, COUNTER_VOICE_OVERRUNS);
+        char c; voiceUART.read(&c, 1);
+        if (!voiceRx.push(c)) metrics_count(COUNTER_VOICE_OVERRUNS);
+    }
+    voiceEvent.set();
+}
+
+// Bytes the DMA wrote over before the loop read them
+void countBtOverruns() {
+    static uint32_t counted;
+    uint32_t overruns = btUART.rx_overruns();
+    if (overruns != counted) {
+        metrics_count(COUNTER_BT_OVERRUNS, overruns - counted);
+        counted = overruns;
+    }
+}
+
+// Next byte of a multi-byte Bluetooth command. Sleeps until the byte arrives,
+// btUART wakes poll_wait() when a burst has been received.
+bool readBtByte(char &c, int timeoutMs) {
+    pollfh fh = { &btUART, POLLIN };
+    if (poll_wait(&fh, 1, timeoutMs) == 0) return false;
+    btUART.read(&c, 1);
+    return true;
+}
+
+void sendStats() {
+    uint8_t frame[3 + METRICS_DUMP_SIZE];
+    size_t len = metrics_dump(frame + 3, sizeof(frame) - 3);
+    frame[0] = 'S';
+    frame[1] = (uint8_t)(len & 0xFF);
+    frame[2] = (uint8_t)(len >> 8);
+    btUART.write(frame, 3 + len);
+}
 
+// One 'C' frame per profiled site, a zero length frame ends the transfer
+void sendProfile() {
+    uint8_t frame[3 + PROFILE_DUMP_SIZE];
+    for (int site = 0; site <= PROFILE_SITE_COUNT; site++) {
+        size_t len = profile_dump(site, frame + 3, sizeof(frame) - 3);
+        frame[0] = 'C';
+        frame[1] = (uint8_t)(len & 0xFF);
+        frame[2] = (uint8_t)(len >> 8);
+        btUART.write(frame, 3 + len);
+        if (len == 0) break;
+    }
+    // The table goes to the console between whole binary trace records
+#if MBED_CONF_MBED_TRACE_DEFERRED
+    mbed_trace_deferred_drain(0);
+#endif
+#if MBED_MEM_TRACING_ENABLED
+    mbed_mem_trace_binary_drain(0);
+#endif
+    profile_print();
+}
 
 void resetStabilization() {
     stabilizationTimer.reset();
     stabilizationTimer.start();
 }
 
-void echo_rise() {
-    echoTimer.reset();
-    echoTimer.start();
-}
-
-void echo_fall() {
-    echoTimer.stop();
-    long duration = duration_cast<microseconds>(echoTimer.elapsed_time()).count();
-    if (duration < 30000 && duration > 50) {
-        currentDist = (duration * 0.0343f) / 2.0f;
+// Pairs the captured echo edges into pulse widths, runs from the event queue
+void echo_edges(const EdgeRecord *edges, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        metrics_count(COUNTER_ECHO_EDGES);
+        if (edges[i].rising) {
+            echoRiseUs = edges[i].time_us;
+            echoHigh = true;
+        } else if (echoHigh) {
+            echoHigh = false;
+            uint32_t duration = edges[i].time_us - echoRiseUs;
+            if (duration < 30000 && duration > 50) {
+                currentDist = (duration * 0.0343f) / 2.0f;
+                currentDistMm = duration * 343 / 2000;
+            }
+        }
     }
 }
 
@@ -144,12 +407,12 @@ void unlockSystem() {
     intruderTimer.reset();
     graceTimer.reset(); graceTimer.start();
     
-    printf(">>> System Unlocked via Keypad/Phone. <<<\n");
-    ThisThread::sleep_for(2s); 
+    tr_info(">>> System Unlocked via Keypad/Phone. <<<");
+    eventQueue.dispatch_for(2s); 
 }
 
 void enterSecurityMode() {
-    printf("\n>>> INTRUDER DETECTED! <<<\n");
+    tr_warn(">>> INTRUDER DETECTED! <<<");
     setAircon(false);
     
     redLed = 1;
@@ -159,7 +422,7 @@ void enterSecurityMode() {
     safe_lcd_clear(); lcd_write_cmd(0x80);
     lcd_print("ALARM! ENTER PIN");
     
-    buzzer = 1; ThisThread::sleep_for(500ms); buzzer = 0;
+    beeps.start(&eventQueue, 500ms);
 
     bool accessGranted = false;
     unsigned char inputPass[5];
@@ -168,27 +431,37 @@ void enterSecurityMode() {
     alarmReportTimer.reset();
     alarmReportTimer.start();
 
+    // Sleeps until a Bluetooth byte, a key, a queue event or the next report
+    keyEvent.clear();
+    keypad_wake(callback(&keyEvent, &PollEvent::set));
+    pollfh fhs[] = { { &btUART, POLLIN }, { &keyEvent, POLLIN }, { &queueEvent, POLLIN } };
+
     while (!accessGranted) {
+        int reportMs = (int)duration_cast<milliseconds>(2s - alarmReportTimer.elapsed_time()).count();
+        poll_wait(fhs, 3, reportMs > 0 ? reportMs : 0);
+
+        if (queueEvent.clear()) eventQueue.dispatch_for(0ms);
+
         if (btUART.readable()) {
             char c; btUART.read(&c, 1);
             if (c == 'U') {
-                unlockSystem();
-                return; 
+                accessGranted = true;
+                break;
             }
         }
 
-        if (alarmReportTimer.elapsed_time() > 2s) {
+        if (alarmReportTimer.elapsed_time() >= 2s) {
             alarmReportTimer.reset();
             char buffer[60];
-            int len = sprintf(buffer, "0.0,0.0,0.0,0,%.1f,%d,1,%d\r\n", 
-                  currentDist, isPersonHome, acState);
+            size_t len = alarm_line(buffer, currentDistMm, isPersonHome, acState);
             btUART.write(buffer, len); 
         }
 
+        if (!keyEvent.clear()) continue;
         char key = getkey(); 
         if (key != 0) {
             inputPass[keyIndex] = key;
-            buzzer = 1; ThisThread::sleep_for(50ms); buzzer = 0;
+            beeps.start(&eventQueue, 50ms);
             
             lcd_write_cmd(0xC0 + keyIndex); 
             lcd_write_data('*');
@@ -196,32 +469,64 @@ void enterSecurityMode() {
             keyIndex++;
 
             if (keyIndex == 4) {
-                if (inputPass[0] == securityPin[0] && inputPass[1] == securityPin[1] && 
-                    inputPass[2] == securityPin[2] && inputPass[3] == securityPin[3]) {
-                    unlockSystem();
-                    return;
+                if (inputPass[0] == cfg.securityPin[0] && inputPass[1] == cfg.securityPin[1] && 
+                    inputPass[2] == cfg.securityPin[2] && inputPass[3] == cfg.securityPin[3]) {
+                    accessGranted = true;
+                    break;
                 } else {
                     safe_lcd_clear(); lcd_write_cmd(0x80);
                     lcd_print("WRONG PIN!");
-                    buzzer = 1; ThisThread::sleep_for(200ms); buzzer = 0;
-                    ThisThread::sleep_for(1s);
+                    beeps.start(&eventQueue, 200ms);
+                    eventQueue.dispatch_for(1s);
                     safe_lcd_clear(); lcd_write_cmd(0x80);
                     lcd_print("ALARM! ENTER PIN");
                     keyIndex = 0; 
                 }
             }
-            ThisThread::sleep_for(200ms); 
+            eventQueue.dispatch_for(200ms); 
         }
-        ThisThread::sleep_for(20ms); 
     }
+
+    keypad_wake(nullptr);
+    unlockSystem();
 }
 
 int main() {
+    int configStatus = config.init();
     lcd_init();
-    btUART.baud(9600);
     voiceUART.baud(9600);
     
-    printf("\n--- INITIALIZING HARDWARE ---\n");
+#if MBED_CONF_MBED_TRACE_DEFERRED
+    // Trace lines leave as binary records, decoded on the PC from the ELF file
+    mbed_trace_deferred_time_function_set(us_ticker_read);
+#else
+    mbed_trace_init();
+#endif
+#if MBED_MEM_TRACING_ENABLED
+    // Heap records for mem_trace_analyzer, on the console with the traces
+    mbed_mem_trace_binary_time_function_set(us_ticker_read);
+    mbed_mem_trace_set_callback(mbed_mem_trace_binary_callback);
+#endif
+    tr_info("--- INITIALIZING HARDWARE ---");
+    if (configStatus != 0) tr_warn("Config store unavailable (%d), using defaults", configStatus);
+    tr_info("Config loaded in %lu us", (unsigned long)config.loadTimeUs());
+
+    // Move the Bluetooth link to the fast rate once, later boots find it there.
+    // Without KEY high the module is in data mode and AT commands would go to
+    // the paired phone, so the link only takes its stored rate
+    int btBaud = cfg.btBaud > 0 ? (int)cfg.btBaud : 9600;
+    if (MBED_CONF_APP_BT_KEY_PIN != NC || MBED_CONF_APP_BT_KEY_HARDWIRED) {
+        btBaud = btLink.setup((int)cfg.btBaud, MBED_CONF_APP_BT_BAUD);
+        if (btLink.found() && cfg.btBaud != (uint32_t)btBaud) {
+            config.edit().btBaud = btBaud;
+            config.sync(true);
+        }
+        if (!btLink.found()) tr_warn("Bluetooth module not in AT mode, link at %d baud", btBaud);
+        else tr_info("Bluetooth link at %d baud%s", btBaud, btLink.changed() ? " (changed)" : "");
+    } else {
+        setBtBaud(btBaud);
+        tr_info("Bluetooth link at %d baud, KEY not wired", btBaud);
+    }
 
     curtainServo.period_ms(20); curtainServo.pulsewidth_us(0); 
     windowServo.period_ms(20);  windowServo.pulsewidth_us(1500); 
@@ -229,158 +534,253 @@ int main() {
 
     redLed = 0; greenLed = 0; blueLed = 0;
 
-    ultrasonicEcho.rise(&echo_rise);
-    ultrasonicEcho.fall(&echo_fall);
+    if (cfg.overrideAircon) { overrideAircon = true; setAircon(cfg.airconOn); }
+    if (cfg.overrideWindow) { overrideWindow = true; setWindow(cfg.windowOpen); }
 
-    graceTimer.start(); awayTimer.start(); sensorReadTimer.start(); 
+    echoCapture.attach(ultrasonicEcho);
+    voiceUART.attach(&voice_rx, UnbufferedSerial::RxIrq);
+    btUART.sigio(poll_wake);
+    eventQueue.background(queue_update);
+    // 60 ms lets the echo of one measurement die out before the next trigger
+    rangingTicker.attach(callback(&rangingEvent, &PollEvent::set), 60ms);
+    sensorTicker.attach(callback(&sensorEvent, &PollEvent::set), 2s);
+
+    graceTimer.start(); awayTimer.start(); 
     stabilizationTimer.start(); 
 
     lastDist = 200.0f; 
 
-    printf("--- SYSTEM ONLINE ---\n");
+    sensorLogReady = (sensorLog.init() == 0);
+    if (sensorLogReady) {
+        // Keep the RTC from running behind the log after a power loss
+        if ((uint32_t)time(NULL) < sensorLog.lastTimestamp()) set_time(sensorLog.lastTimestamp());
+        tr_info("Sensor log: %lu records", (unsigned long)sensorLog.size());
+    } else {
+        tr_error("Sensor log unavailable");
+    }
+    logTimer.start();
+    loopTimer.start();
+    profile_init();
+
+    tr_info("--- SYSTEM ONLINE ---");
+
+    // Inputs and timers wake the loop, it sleeps in between
+    pollfh loopFhs[] = {
+        { &btUART, POLLIN }, { &voiceEvent, POLLIN }, { &rangingEvent, POLLIN },
+        { &sensorEvent, POLLIN }, { &queueEvent, POLLIN }
+    };
 
     while(true) {
-        
+        poll_wait(loopFhs, sizeof(loopFhs) / sizeof(loopFhs[0]), -1);
+        loopTimer.reset();
+        PROFILE_SCOPE(PROFILE_LOOP);
+        metrics_count(COUNTER_LOOPS);
+
+        // Echo edges, DHT11 steps and beeps that are due
+        if (queueEvent.clear()) eventQueue.dispatch_for(0ms);
+
         if (alarmTriggered) enterSecurityMode(); 
+
+        // Both stop between records, so the two streams share the console
+#if MBED_CONF_MBED_TRACE_DEFERRED
+        mbed_trace_deferred_drain(16);
+#endif
+#if MBED_MEM_TRACING_ENABLED
+        mbed_mem_trace_binary_drain(48);
+#endif
+
+        persistOverrides();
+        config.sync();
         
-        ultrasonicTrigger = 0; wait_us(2);
-        ultrasonicTrigger = 1; wait_us(10);
-        ultrasonicTrigger = 0;
-        ThisThread::sleep_for(30ms); 
-
-        if (currentDist > 0.1f) {
-            bool noiseDetected = (stabilizationTimer.elapsed_time() < 2s);
-            bool trigger = false;
-            if (!noiseDetected && graceTimer.elapsed_time() > 5s) {
-                 if ((lastDist - currentDist) > 100.0f) trigger = true;
-            }
-            if (!isPersonHome && currentDist < 100.0f) {
-                if (!noiseDetected) trigger = true;
-            }
-            if (trigger && !potentialIntruder) {
-                potentialIntruder = true;
-                intruderTimer.reset(); intruderTimer.start();
-            }
-            if (potentialIntruder) {
-                if (currentDist < 100.0f) {
-                    if (intruderTimer.elapsed_time() > 2s) {
-                        if (!alarmTriggered) {
-                            alarmTriggered = true;
-                            potentialIntruder = false; 
-                            intruderTimer.stop();
+        if (rangingEvent.clear()) {
+            // The echo of the previous trigger has been paired by now
+            {
+                PROFILE_SCOPE(PROFILE_INTRUDER);
+                if (currentDist > 0.1f) {
+                    bool noiseDetected = (stabilizationTimer.elapsed_time() < 2s);
+                    bool trigger = false;
+                    if (!noiseDetected && graceTimer.elapsed_time() > 5s) {
+                         if ((lastDist - currentDist) > cfg.intruderJump) trigger = true;
+                    }
+                    if (!isPersonHome && currentDist < cfg.intruderDistance) {
+                        if (!noiseDetected) trigger = true;
+                    }
+                    if (trigger && !potentialIntruder) {
+                        potentialIntruder = true;
+                        intruderTimer.reset(); intruderTimer.start();
+                    }
+                    if (potentialIntruder) {
+                        if (currentDist < cfg.intruderDistance) {
+                            if (intruderTimer.elapsed_time() > 2s) {
+                                if (!alarmTriggered) {
+                                    alarmTriggered = true;
+                                    potentialIntruder = false; 
+                                    intruderTimer.stop();
+                                }
+                            }
+                        } else {
+                            potentialIntruder = false;
+                            intruderTimer.stop(); intruderTimer.reset();
                         }
                     }
+                    if (!potentialIntruder) lastDist = currentDist;
+                }
+
+                if (currentDist > cfg.intruderDistance) {
+                    if (awayTimer.elapsed_time() > 3s) isPersonHome = false; 
                 } else {
-                    potentialIntruder = false;
-                    intruderTimer.stop(); intruderTimer.reset();
+                    awayTimer.reset();
                 }
             }
-            if (!potentialIntruder) lastDist = currentDist;
-        }
 
-        if (currentDist > 100.0f) {
-            if (awayTimer.elapsed_time() > 3s) isPersonHome = false; 
-        } else {
-            awayTimer.reset();
+            {
+                PROFILE_SCOPE(PROFILE_RANGING);
+                ultrasonicTrigger = 0; wait_us(2);
+                ultrasonicTrigger = 1; wait_us(10);
+                ultrasonicTrigger = 0;
+                metrics_gauge(GAUGE_ECHO_OVERRUNS, echoCapture.overruns());
+            }
         }
 
-        if (btUART.readable()) {
-            char c; btUART.read(&c, 1);
-            if(c=='1') { setAircon(true); overrideAircon = true; } 
-            if(c=='2') { setAircon(false); overrideAircon = true; } 
-            if(c=='8') { overrideAircon = false; }
-            if(c=='3') { setWindow(true); overrideWindow = true; }
-            if(c=='4') { setWindow(false); overrideWindow = false; }
-            if(c=='5') setCurtain(true);
-            if(c=='6') setCurtain(false);
-            if(c=='P') {
-                 safe_lcd_clear(); lcd_write_cmd(0x80); lcd_print("Updating PIN...");
-                 for(int i=0; i<4; i++) {
-                     int timeout = 0;
-                     while(!btUART.readable() && timeout < 500) { ThisThread::sleep_for(10ms); timeout++; }
-                     if(btUART.readable()) { char d; btUART.read(&d, 1); securityPin[i] = d; }
-                 }
-                 safe_lcd_clear(); lcd_write_cmd(0x80); lcd_print("PIN Updated!");
-                 ThisThread::sleep_for(2s);
+        {
+            PROFILE_SCOPE(PROFILE_UART);
+            if (btUART.readable()) {
+                countBtOverruns();
+                char c; btUART.read(&c, 1);
+                metrics_count(COUNTER_BT_BYTES);
+                if(c=='S') sendStats();
+                if(c=='C') sendProfile();
+                if(c=='1') { setAircon(true); overrideAircon = true; } 
+                if(c=='2') { setAircon(false); overrideAircon = true; } 
+                if(c=='8') { overrideAircon = false; }
+                if(c=='3') { setWindow(true); overrideWindow = true; }
+                if(c=='4') { setWindow(false); overrideWindow = false; }
+                if(c=='5') setCurtain(true);
+                if(c=='6') setCurtain(false);
+                if(c=='H' && sensorLogReady) sendHistory();
+                if(c=='T') {
+                     // Two digits: new AC temperature threshold in Celsius
+                     int value = 0, digits = 0;
+                     for(int i=0; i<2; i++) {
+                         char d;
+                         if (readBtByte(d, 5000) && d >= '0' && d <= '9') { value = value * 10 + (d - '0'); digits++; }
+                     }
+                     if (digits == 2) config.edit().hotTemperature = (float)value;
+                }
+                if(c=='P') {
+                     safe_lcd_clear(); lcd_write_cmd(0x80); lcd_print("Updating PIN...");
+                     for(int i=0; i<4; i++) {
+                         char d;
+                         if (readBtByte(d, 5000)) config.edit().securityPin[i] = d;
+                     }
+                     config.sync(true);
+                     safe_lcd_clear(); lcd_write_cmd(0x80); lcd_print("PIN Updated!");
+                     ThisThread::sleep_for(2s);
+                }
             }
-        }
 
-        if (voiceUART.readable()) {
-            char vc; voiceUART.read(&vc, 1);
-            if (vc >= '2' && vc <= '8') {
-                switch(vc) {
-                    case '2': setAircon(true); overrideAircon = true; break;
-                    case '3': setAircon(false); overrideAircon = true; break;
-                    case '4': setCurtain(true); break;
-                    case '5': setCurtain(false); break;
-                    case '6': setWindow(true); overrideWindow = true; break;
-                    case '7': setWindow(false); overrideWindow = false; break;
-                    case '8': overrideAircon = false; break; 
+            // Parsed in place, the bytes after the ring end wrap around in a second region
+            voiceEvent.clear();
+            for (Span<const char> voiceBytes = voiceRx.read_region(); !voiceBytes.empty();
+                 voiceBytes = voiceRx.read_region()) {
+                for (char vc : voiceBytes) {
+                    metrics_count(COUNTER_VOICE_BYTES);
+                    if (vc >= '2' && vc <= '8') {
+                        switch(vc) {
+                            case '2': setAircon(true); overrideAircon = true; break;
+                            case '3': setAircon(false); overrideAircon = true; break;
+                            case '4': setCurtain(true); break;
+                            case '5': setCurtain(false); break;
+                            case '6': setWindow(true); overrideWindow = true; break;
+                            case '7': setWindow(false); overrideWindow = false; break;
+                            case '8': overrideAircon = false; break; 
+                        }
+                    }
                 }
+                voiceRx.commit_read(voiceBytes.size());
             }
         }
 
-        if (sensorReadTimer.elapsed_time() > 2s) {
-            sensorReadTimer.reset();
+        // A read still running when the tick comes waits for the next one
+        if (sensorEvent.clear() && dhtRead.done()) {
+            dhtRead.start();
+        }
+
+        if (dhtReady) {
+            dhtReady = false;
             
             int t = 0, h = 0;
-            dht11.readTemperatureHumidity(t, h); 
+            if (dhtStatus == 0) { t = dhtTemp; h = dhtHumidity; }
             float temp = (float)t;
-            float humidity = (float)h;
             float lightVal = ldr.read();           
-            float rainVal = rainSensor.read();
-            float dist = currentDist;
+            uint16_t rainRaw = rainSensor.read_u16();
+            float rainVal = rainRaw * (1.0f / 0xFFFF);
+            uint32_t distMm = currentDistMm;
+            metrics_gauge(GAUGE_DISTANCE_MM, distMm);
             
             char buffer[60];
-            int len = sprintf(buffer, "%.1f,%.1f,%.2f,%d,%.1f,%d,%d,%d\r\n", 
-                  temp, humidity, rainVal, isRaining, dist, 
-                  isPersonHome, alarmTriggered, acState);
+            size_t len = telemetry_line(buffer, t, h, rainRaw, isRaining, distMm,
+                                        isPersonHome, alarmTriggered, acState);
             btUART.write(buffer, len); 
 
-            if (rainVal > 0.6f) { 
-                if (!isRaining) { isRaining = true; setWindow(false); overrideWindow = false; }
-            } else { isRaining = false; }
+            if (sensorLogReady && dhtStatus == 0 &&
+                logTimer.elapsed_time() > seconds(MBED_CONF_APP_SENSOR_LOG_PERIOD)) {
+                logTimer.reset();
+                logSample(t, h, ldr.read_u16(), rainRaw);
+            }
 
-            if (isPersonHome && !alarmTriggered) {
-                if (lightVal < 0.7f) { 
-                    if (isNightMode) { 
-                        setCurtain(false); 
-                        setRoomLight(false); 
-                        isNightMode = false; 
-                    }
-                } 
-                else if (lightVal > 0.4f) { 
-                    if (!isNightMode) { 
-                        setCurtain(true); 
-                        setRoomLight(true); 
-                        isNightMode = true; 
+            {
+                PROFILE_SCOPE(PROFILE_RULES);
+                if (rainVal > cfg.rainLevel) { 
+                    if (!isRaining) { isRaining = true; setWindow(false); overrideWindow = false; }
+                } else { isRaining = false; }
+
+                if (isPersonHome && !alarmTriggered) {
+                    if (lightVal < cfg.dayLightBelow) { 
+                        if (isNightMode) { 
+                            setCurtain(false); 
+                            setRoomLight(false); 
+                            isNightMode = false; 
+                        }
+                    } 
+                    else if (lightVal > cfg.nightLightAbove) { 
+                        if (!isNightMode) { 
+                            setCurtain(true); 
+                            setRoomLight(true); 
+                            isNightMode = true; 
+                        }
                     }
-                }
 
-                if (!overrideAircon) {
-                    if (temp > 28.0f) { setAircon(true); if (!isHot && !overrideWindow) { setWindow(false); isHot = true; } } 
-                    else { setAircon(false); isHot = false; }
+                    if (!overrideAircon) {
+                        if (temp > cfg.hotTemperature) { setAircon(true); if (!isHot && !overrideWindow) { setWindow(false); isHot = true; } } 
+                        else { setAircon(false); isHot = false; }
+                    }
+                } else if (!isPersonHome) {
+                    setAircon(false); 
+                    setRoomLight(false); 
+                    if (!overrideWindow) setWindow(false); 
                 }
-            } else if (!isPersonHome) {
-                setAircon(false); 
-                setRoomLight(false); 
-                if (!overrideWindow) setWindow(false); 
             }
 
-            if (overrideAircon) {
-                safe_lcd_clear(); lcd_write_cmd(0x80); 
-                if (acState) lcd_print("MANUAL AC ON");
-                else lcd_print("MANUAL AC OFF");
-            } else {
-                safe_lcd_clear(); lcd_write_cmd(0x80);
-                if (isPersonHome) {
-                    if (isNightMode) { 
-                        lcd_print("NIGHT MODE"); 
-                    } else { 
-                        lcd_print("DAY MODE"); 
-                    }
-                } else { lcd_print("AWAY - ECO"); }
+            {
+                PROFILE_SCOPE(PROFILE_LCD);
+                if (overrideAircon) {
+                    safe_lcd_clear(); lcd_write_cmd(0x80); 
+                    if (acState) lcd_print("MANUAL AC ON");
+                    else lcd_print("MANUAL AC OFF");
+                } else {
+                    safe_lcd_clear(); lcd_write_cmd(0x80);
+                    if (isPersonHome) {
+                        if (isNightMode) { 
+                            lcd_print("NIGHT MODE"); 
+                        } else { 
+                            lcd_print("DAY MODE"); 
+                        }
+                    } else { lcd_print("AWAY - ECO"); }
+                }
             }
         }
+
+        metrics_observe(HISTOGRAM_LOOP_US, (uint32_t)duration_cast<microseconds>(loopTimer.elapsed_time()).count());
     }
 }
\ No newline at end of file
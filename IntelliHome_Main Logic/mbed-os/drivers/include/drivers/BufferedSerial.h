@@ -125,6 +125,51 @@ public:
      */
     ssize_t read(void *buffer, size_t length) override;
 
+    /** Write the contents of several buffers as one write
+     *
+     *  Follows the semantics of write(). The buffers are copied straight
+     *  into the transmit buffer, in order, so a frame made of a header, a
+     *  payload and a checksum needs no staging buffer.
+     *
+     *  @param iov      The buffers to write from
+     *  @return         The number of bytes written, negative error on failure
+     */
+    ssize_t writev(Span<const Span<const uint8_t>> iov) override;
+
+    /** Read into several buffers as one read
+     *
+     *  Follows the semantics of read(), the available data fills the
+     *  buffers in order.
+     *
+     *  @param iov      The buffers to read in to
+     *  @return         The number of bytes read, negative error on failure
+     */
+    ssize_t readv(Span<const Span<uint8_t>> iov) override;
+
+    /** Get space in the transmit buffer to build data in place
+     *
+     *  The returned space follows the data already queued without wrapping,
+     *  so data written there is sent without any copy. Publish it with
+     *  write_commit(). The mutex is held from write_reserve() to
+     *  write_commit(), which must always follow, with 0 to give the space up.
+     *
+     *  In blocking mode, waits until length contiguous bytes are free. In
+     *  non-blocking mode, returns an empty span when they are not.
+     *
+     *  Not to be called from a critical section.
+     *
+     *  @param length   The space needed, at most the transmit buffer size
+     *  @return         The free contiguous space, at least length bytes, or
+     *                  empty
+     */
+    Span<uint8_t> write_reserve(size_t length);
+
+    /** Send the bytes written at the start of the space of write_reserve()
+     *
+     *  @param length   The number of bytes, at most the size of the space
+     */
+    void write_commit(size_t length);
+
     /** Close a file
      *
      *  @return         0 on success, negative error code on failure
@@ -0,0 +1,296 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2026 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_DMASERIAL_H
+#define MBED_DMASERIAL_H
+
+#include "platform/platform.h"
+
+#if (DEVICE_SERIAL && DEVICE_SERIAL_DMA) || defined(DOXYGEN_ONLY)
+
+#include "platform/FileHandle.h"
+#include "drivers/SerialBase.h"
+#include "hal/serial_dma_api.h"
+#include "platform/PlatformMutex.h"
+#include "platform/NonCopyable.h"
+
+#ifndef MBED_CONF_DRIVERS_UART_SERIAL_DMA_RXBUF_SIZE
+#define MBED_CONF_DRIVERS_UART_SERIAL_DMA_RXBUF_SIZE  256
+#endif
+
+#ifndef MBED_CONF_DRIVERS_UART_SERIAL_DMA_TXBUF_SIZE
+#define MBED_CONF_DRIVERS_UART_SERIAL_DMA_TXBUF_SIZE  256
+#endif
+
+namespace mbed {
+/**
+ * \defgroup drivers_DmaSerial DmaSerial class
+ * \ingroup drivers-public-api-uart
+ * @{
+ */
+
+/** Class providing UART communication through DMA, with the same file
+ *  interface as BufferedSerial
+ *
+ *  The receive buffer is a ring the DMA writes to continuously. The CPU is
+ *  only interrupted when the line goes idle after a burst of bytes, or when
+ *  half of the ring has been written, instead of once per byte. Written data
+ *  is queued in a second ring and sent by DMA, one contiguous block of the
+ *  ring per transfer.
+ *
+ *  The receive ring must hold the bytes that can arrive before the
+ *  application reads them. When it overflows, the oldest bytes are lost and
+ *  counted by rx_overruns().
+ *
+ * Example:
+ * @code
+ * DmaSerial bt(PA_9, PA_10, 115200);
+ *
+ * int main() {
+ *     char frame[64];
+ *     while (1) {
+ *         ssize_t n = bt.read(frame, sizeof frame);   // a whole burst at once
+ *         bt.write(frame, n);
+ *     }
+ * }
+ * @endcode
+ */
+class DmaSerial:
+    private SerialBase,
+    public FileHandle,
+    private NonCopyable<DmaSerial> {
+
+public:
+
+    /** Create a DmaSerial port, connected to the specified transmit and
+     *  receive pins, with a particular baud rate.
+     *  @param tx Transmit pin
+     *  @param rx Receive pin
+     *  @param baud The baud rate of the serial port (optional, defaults to
+     *              MBED_CONF_PLATFORM_DEFAULT_SERIAL_BAUD_RATE)
+     */
+    DmaSerial(
+        PinName tx,
+        PinName rx,
+        int baud = MBED_CONF_PLATFORM_DEFAULT_SERIAL_BAUD_RATE
+    );
+
+    /** Create a DmaSerial port, connected to the specified transmit and
+     *  receive pins, with a particular baud rate.
+     *  @param static_pinmap reference to structure which holds static pinmap
+     *  @param baud The baud rate of the serial port (optional, defaults to
+     *              MBED_CONF_PLATFORM_DEFAULT_SERIAL_BAUD_RATE)
+     */
+    DmaSerial(
+        const serial_pinmap_t &static_pinmap,
+        int baud = MBED_CONF_PLATFORM_DEFAULT_SERIAL_BAUD_RATE
+    );
+
+    ~DmaSerial() override;
+
+    /** Equivalent to POSIX poll(). Derived from FileHandle.
+     *  The events that can be reported are POLLIN and POLLOUT.
+     */
+    short poll(short events) const final;
+
+    /* Resolve ambiguities versus our private SerialBase */
+    using FileHandle::readable;
+    using FileHandle::writable;
+
+    /** Write the contents of a buffer to a file
+     *
+     *  Follows POSIX semantics:
+     *
+     * * if blocking, block until all data is queued
+     * * if no data can be queued, and non-blocking set, return -EAGAIN
+     * * if some data can be queued, and non-blocking set, write partial
+     *
+     *  Called from a critical section, the queued data and the buffer are
+     *  sent before returning.
+     *
+     *  @param buffer   The buffer to write from
+     *  @param length   The number of bytes to write
+     *  @return         The number of bytes written, negative error on failure
+     */
+    ssize_t write(const void *buffer, size_t length) override;
+
+    /** Read the contents of a file into a buffer
+     *
+     *  Follows POSIX semantics:
+     *
+     *  * if no data is available, and non-blocking set return -EAGAIN
+     *  * if no data is available, and blocking set, wait until data is
+     *    available
+     *  * If any data is available, call returns immediately
+     *
+     *  @param buffer   The buffer to read in to
+     *  @param length   The number of bytes to read
+     *  @return         The number of bytes read, negative error on failure
+     */
+    ssize_t read(void *buffer, size_t length) override;
+
+    /** Close a file
+     *
+     *  @return         0 on success, negative error code on failure
+     */
+    int close() override;
+
+    /** Check if the file in an interactive terminal device
+     *
+     *  @return         True if the file is a terminal
+     */
+    int isatty() override;
+
+    /** Not valid for a device type FileHandle, returns -ESPIPE
+     *
+     *  @param offset   The offset from whence to move to
+     *  @param whence   The start of where to seek
+     *  @return         -ESPIPE
+     */
+    off_t seek(off_t offset, int whence) override;
+
+    /** Wait until all the queued data is handed to the peripheral
+     *
+     *  @return         0 on success, negative error code on failure
+     */
+    int sync() override;
+
+    /** Set blocking or non-blocking mode
+     *  The default is blocking.
+     *
+     *  @param blocking true for blocking mode, false for non-blocking mode.
+     */
+    int set_blocking(bool blocking) override
+    {
+        _blocking = blocking;
+        return 0;
+    }
+
+    /** Check current blocking or non-blocking mode for file operations.
+     *
+     *  @return true for blocking mode, false for non-blocking mode.
+     */
+    bool is_blocking() const override
+    {
+        return _blocking;
+    }
+
+    /** Register a callback on state change of the file.
+     *
+     *  The callback is called in interrupt context when received data
+     *  becomes available and when space is freed in a full transmit queue.
+     *  It should be used as a cue to make read/write/poll calls.
+     *
+     *  @param func     Function to call on state change
+     */
+    void sigio(Callback<void()> func) override;
+
+    /** Set the baud rate
+     *
+     *  @param baud   The baud rate
+     */
+    void set_baud(int baud);
+
+    // Expose private SerialBase::Parity as DmaSerial::Parity
+    using SerialBase::Parity;
+    using SerialBase::None;
+    using SerialBase::Odd;
+    using SerialBase::Even;
+    using SerialBase::Forced1;
+    using SerialBase::Forced0;
+
+    /** Set the transmission format used by the serial port
+     *
+     *  @param bits The number of bits in a word (5-8; default = 8)
+     *  @param parity The parity used (None, Odd, Even, Forced1, Forced0;
+     *                default = None)
+     *  @param stop_bits The number of stop bits (1 or 2; default = 1)
+     */
+    void set_format(
+        int bits = 8, Parity parity = DmaSerial::None, int stop_bits = 1
+    );
+
+    /** Number of times received bytes were overwritten before being read
+     *
+     *  @return the count since the port was created
+     */
+    uint32_t rx_overruns() const
+    {
+        return _rx_overruns;
+    }
+
+private:
+
+    /** Register the DMA handler and start reception into the ring
+     */
+    void start();
+
+    void api_lock(void);
+
+    void api_unlock(void);
+
+    /** Account for the bytes the DMA wrote since the last call.
+     *  Called from critical section or interrupt context.
+     */
+    void rx_update();
+
+    /** Start sending the next contiguous block of the transmit ring if the
+     *  DMA is free. Called from critical section or interrupt context.
+     */
+    void tx_start();
+
+    /** Release the block the DMA has sent. Called from critical section or
+     *  interrupt context.
+     */
+    void tx_done();
+
+    /** DMA events of the HAL, id is the DmaSerial */
+    static void dma_irq(uintptr_t id, uint32_t event);
+
+    /** Execute a callback previously registered for state change of the file.
+     */
+    void wake(void);
+
+    /** Ring written by the DMA. _rx_head is where the DMA was last seen,
+     *  _rx_tail the next byte to read and _rx_count the bytes not read.
+     */
+    uint8_t _rxbuf[MBED_CONF_DRIVERS_UART_SERIAL_DMA_RXBUF_SIZE];
+    size_t _rx_head = 0;
+    size_t _rx_tail = 0;
+    size_t _rx_count = 0;
+    uint32_t _rx_overruns = 0;
+
+    /** Ring of the data to send. _tx_tail is the first byte not sent,
+     *  _tx_count the bytes queued and _tx_active those the DMA is sending.
+     */
+    uint8_t _txbuf[MBED_CONF_DRIVERS_UART_SERIAL_DMA_TXBUF_SIZE];
+    size_t _tx_tail = 0;
+    size_t _tx_count = 0;
+    size_t _tx_active = 0;
+
+    PlatformMutex _mutex;
+
+    Callback<void()> _sigio_cb;
+
+    bool _blocking = true;
+};
+
+/** @}*/
+
+} //namespace mbed
+
+#endif //(DEVICE_SERIAL && DEVICE_SERIAL_DMA) || defined(DOXYGEN_ONLY)
+#endif //MBED_DMASERIAL_H
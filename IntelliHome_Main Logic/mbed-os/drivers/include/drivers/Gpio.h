@@ -0,0 +1,359 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2026 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_GPIO_H
+#define MBED_GPIO_H
+
+#include "platform/platform.h"
+
+#if DEVICE_PORTIN || DEVICE_PORTOUT || defined(DOXYGEN_ONLY)
+#include "hal/gpio_api.h"
+#include "hal/port_api.h"
+#endif
+
+#if ((DEVICE_PORTIN || DEVICE_PORTOUT) && defined(GPIO_PORT_ACCESS)) || defined(DOXYGEN_ONLY)
+
+namespace mbed {
+/**
+ * \defgroup drivers_Gpio Gpio classes
+ * \ingroup drivers-public-api-gpio
+ * @{
+ */
+
+/** Compile time GPIO pins
+ *
+ * GpioOut, GpioIn, GpioInOut and GpioPortOut take their port and pins as
+ * template parameters and hold no state, so each access is a constant mask
+ * given to the whole port functions of the target instead of going through
+ * a gpio_t. On STM32 a write is a single store to BSRR and a read a single
+ * load of IDR.
+ *
+ * GpioPortOut changes any set of pins of a port in one atomic store, for
+ * example the data, register select and enable lines of a character LCD.
+ *
+ * The classes are only defined for targets that provide, usually inline in
+ * their gpio_object.h, the two whole port functions below and define
+ * GPIO_PORT_ACCESS to say so:
+ * - void gpio_port_set_reset(PortName port, uint32_t set, uint32_t reset)
+ * - uint32_t gpio_port_read(PortName port)
+ *
+ * Pins are configured with the usual gpio_api functions when the objects
+ * are constructed.
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * Example:
+ * @code
+ * GpioOut<PortA, 5> led;
+ * GpioIn<PortC, 13> button(PullUp);
+ *
+ * int main() {
+ *     while (1) {
+ *         led = !button;
+ *     }
+ * }
+ * @endcode
+ */
+template <PortName Port, int Pin>
+class GpioOut {
+    static_assert(Pin >= 0 && Pin < 32, "Pin must be a pin number of the port");
+
+public:
+    /** Mask of the pin in its port */
+    static constexpr uint32_t mask = 1UL << Pin;
+
+    /** Configure the pin as an output
+     *
+     *  @param value the initial pin value
+     */
+    GpioOut(int value = 0)
+    {
+        gpio_t gpio;
+        gpio_init(&gpio, port_pin(Port, Pin));
+        gpio_write(&gpio, value);
+        gpio_dir(&gpio, PIN_OUTPUT);
+        gpio_mode(&gpio, PullNone);
+    }
+
+    /** Set the output, specified as 0 or 1 (int)
+     *
+     *  @param value 0 for logical 0, any other value for logical 1
+     */
+    void write(int value)
+    {
+        if (value) {
+            gpio_port_set_reset(Port, mask, 0);
+        } else {
+            gpio_port_set_reset(Port, 0, mask);
+        }
+    }
+
+    /** Return the level of the pin, 0 or 1 */
+    int read()
+    {
+        return (gpio_port_read(Port) & mask) ? 1 : 0;
+    }
+
+    /** A shorthand for write() */
+    GpioOut &operator= (int value)
+    {
+        write(value);
+        return *this;
+    }
+
+    /** A shorthand for read() */
+    operator int()
+    {
+        return read();
+    }
+};
+
+template <PortName Port, int Pin>
+constexpr uint32_t GpioOut<Port, Pin>::mask;
+
+/** Compile time digital input, see GpioOut */
+template <PortName Port, int Pin>
+class GpioIn {
+    static_assert(Pin >= 0 && Pin < 32, "Pin must be a pin number of the port");
+
+public:
+    /** Mask of the pin in its port */
+    static constexpr uint32_t mask = 1UL << Pin;
+
+    /** Configure the pin as an input
+     *
+     *  @param pull PullUp, PullDown, PullNone or PullDefault
+     */
+    GpioIn(PinMode pull = PullDefault)
+    {
+        gpio_t gpio;
+        gpio_init(&gpio, port_pin(Port, Pin));
+        gpio_dir(&gpio, PIN_INPUT);
+        gpio_mode(&gpio, pull);
+    }
+
+    /** Return the level of the pin, 0 or 1 */
+    int read()
+    {
+        return (gpio_port_read(Port) & mask) ? 1 : 0;
+    }
+
+    /** Set the input pin mode
+     *
+     *  @param pull PullUp, PullDown, PullNone or PullDefault
+     */
+    void mode(PinMode pull)
+    {
+        gpio_t gpio;
+        gpio_init(&gpio, port_pin(Port, Pin));
+        gpio_mode(&gpio, pull);
+    }
+
+    /** A shorthand for read() */
+    operator int()
+    {
+        return read();
+    }
+};
+
+template <PortName Port, int Pin>
+constexpr uint32_t GpioIn<Port, Pin>::mask;
+
+/** Compile time bidirectional pin, see GpioOut
+ *
+ * Switching direction goes through gpio_dir(), reads and writes are single
+ * port accesses like GpioOut and GpioIn. The output level is kept while the
+ * pin is an input, so output() drives the last written value straight away.
+ */
+template <PortName Port, int Pin>
+class GpioInOut {
+    static_assert(Pin >= 0 && Pin < 32, "Pin must be a pin number of the port");
+
+public:
+    /** Mask of the pin in its port */
+    static constexpr uint32_t mask = 1UL << Pin;
+
+    /** Configure the pin
+     *
+     *  @param direction PIN_INPUT or PIN_OUTPUT
+     *  @param pull      pin mode, PullNone for an output
+     *  @param value     initial output value
+     */
+    GpioInOut(PinDirection direction = PIN_INPUT, PinMode pull = PullDefault, int value = 0)
+    {
+        gpio_t gpio;
+        gpio_init(&gpio, port_pin(Port, Pin));
+        gpio_write(&gpio, value);
+        gpio_dir(&gpio, direction);
+        gpio_mode(&gpio, pull);
+    }
+
+    /** Set the output, specified as 0 or 1 (int) */
+    void write(int value)
+    {
+        if (value) {
+            gpio_port_set_reset(Port, mask, 0);
+        } else {
+            gpio_port_set_reset(Port, 0, mask);
+        }
+    }
+
+    /** Return the level of the pin, 0 or 1 */
+    int read()
+    {
+        return (gpio_port_read(Port) & mask) ? 1 : 0;
+    }
+
+    /** Set as an output */
+    void output()
+    {
+        set_direction(PIN_OUTPUT);
+    }
+
+    /** Set as an input */
+    void input()
+    {
+        set_direction(PIN_INPUT);
+    }
+
+    /** Set the pin mode
+     *
+     *  @param pull PullUp, PullDown, PullNone, OpenDrain or PullDefault
+     */
+    void mode(PinMode pull)
+    {
+        gpio_t gpio;
+        gpio_init(&gpio, port_pin(Port, Pin));
+        gpio_mode(&gpio, pull);
+    }
+
+    /** A shorthand for write() */
+    GpioInOut &operator= (int value)
+    {
+        write(value);
+        return *this;
+    }
+
+    /** A shorthand for read() */
+    operator int()
+    {
+        return read();
+    }
+
+private:
+    void set_direction(PinDirection direction)
+    {
+        gpio_t gpio;
+        gpio_init(&gpio, port_pin(Port, Pin));
+        gpio_dir(&gpio, direction);
+    }
+};
+
+template <PortName Port, int Pin>
+constexpr uint32_t GpioInOut<Port, Pin>::mask;
+
+/** Compile time group of output pins of one port, see GpioOut
+ *
+ * All the pins of Mask change in a single atomic store, unlike PortOut
+ * which reads, modifies and writes the output register.
+ *
+ * Example:
+ * @code
+ * // Data on PA_8 to PA_11, E on PA_12, RS on PA_14
+ * GpioPortOut<PortA, 0x5F00> lcd;
+ *
+ * void lcd_nibble(int rs, uint8_t nibble) {
+ *     uint32_t bus = (nibble << 8) | (rs ? 0x4000 : 0);
+ *     lcd = bus;            // data and RS, E low
+ *     lcd = bus | 0x1000;   // E high
+ *     lcd = bus;            // E low latches the nibble
+ * }
+ * @endcode
+ */
+template <PortName Port, uint32_t Mask>
+class GpioPortOut {
+    static_assert(Mask != 0, "Mask must select at least one pin");
+
+public:
+    /** Mask of the pins in their port */
+    static constexpr uint32_t mask = Mask;
+
+    /** Configure the pins of Mask as outputs
+     *
+     *  @param value the initial value of the pins, bits outside Mask are ignored
+     */
+    GpioPortOut(uint32_t value = 0)
+    {
+        for (int pin = 0; pin < 32; pin++) {
+            if (Mask & (1UL << pin)) {
+                gpio_t gpio;
+                gpio_init(&gpio, port_pin(Port, pin));
+                gpio_write(&gpio, value & (1UL << pin));
+                gpio_dir(&gpio, PIN_OUTPUT);
+                gpio_mode(&gpio, PullNone);
+            }
+        }
+    }
+
+    /** Write all the pins of Mask at once
+     *
+     *  @param value the levels of the pins, bits outside Mask are ignored
+     */
+    void write(uint32_t value)
+    {
+        gpio_port_set_reset(Port, value & Mask, ~value & Mask);
+    }
+
+    /** Drive some pins high and others low at once, leaving the rest unchanged
+     *
+     *  @param set   pins to drive high
+     *  @param reset pins to drive low
+     */
+    void write(uint32_t set, uint32_t reset)
+    {
+        gpio_port_set_reset(Port, set & Mask, reset & Mask);
+    }
+
+    /** Return the levels of the pins of Mask */
+    uint32_t read()
+    {
+        return gpio_port_read(Port) & Mask;
+    }
+
+    /** A shorthand for write() */
+    GpioPortOut &operator= (uint32_t value)
+    {
+        write(value);
+        return *this;
+    }
+
+    /** A shorthand for read() */
+    operator uint32_t()
+    {
+        return read();
+    }
+};
+
+template <PortName Port, uint32_t Mask>
+constexpr uint32_t GpioPortOut<Port, Mask>::mask;
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
+
+#endif
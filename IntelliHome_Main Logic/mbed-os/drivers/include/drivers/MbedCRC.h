@@ -44,11 +44,17 @@ extern SingletonPtr<PlatformMutex> mbed_crc_mutex;
 /** CRC mode selection
  */
 enum class CrcMode {
-    HARDWARE,   /// Use hardware (if available), else table-based computation
+    HARDWARE,   /// Use hardware (if available), else software computation limited by drivers.crc-slice-by
+    SLICE_BY_8, /// Use eight generated tables, taking 8 bytes per step
+    SLICE_BY_4, /// Use four generated tables, taking 4 bytes per step
     TABLE,      /// Use table-based computation (if table available), else bitwise
     BITWISE     /// Always use bitwise manual computation
 };
 
+#ifndef MBED_CRC_SLICE_BY
+#define MBED_CRC_SLICE_BY 0
+#endif
+
 #ifndef DOXYGEN_ONLY
 namespace impl {
 template<uint32_t polynomial, uint8_t width, CrcMode mode>
@@ -67,15 +73,59 @@ constexpr bool have_crc_table(uint32_t polynomial, uint8_t width)
 #endif
 }
 
+/* Slice modes named by the instance are always used, otherwise
+ * drivers.crc-slice-by limits the software acceleration.
+ */
 constexpr CrcMode choose_crc_mode(uint32_t polynomial, uint8_t width, CrcMode mode_limit)
 {
     return
 #if DEVICE_CRC
         mode_limit == CrcMode::HARDWARE && HAL_CRC_IS_SUPPORTED(polynomial, width) ? CrcMode::HARDWARE :
 #endif
-        mode_limit <= CrcMode::TABLE && have_crc_table(polynomial, width) ? CrcMode::TABLE :
+        mode_limit == CrcMode::SLICE_BY_8 || (mode_limit == CrcMode::HARDWARE && MBED_CRC_SLICE_BY >= 8) ? CrcMode::SLICE_BY_8 :
+        mode_limit == CrcMode::SLICE_BY_4 || (mode_limit <= CrcMode::SLICE_BY_4 && MBED_CRC_SLICE_BY >= 4) ? CrcMode::SLICE_BY_4 :
+        mode_limit <= CrcMode::TABLE && (have_crc_table(polynomial, width) || MBED_CRC_SLICE_BY >= 1) ? CrcMode::TABLE :
         CrcMode::BITWISE;
 }
+
+/* Tables of the TABLE and SLICE_BY_N modes for any polynomial, computed by
+ * the compiler. Like the ROM tables, they are for a reflected CRC register.
+ * Row k holds the CRC of a byte followed by k zero bytes, so the lookups of
+ * the bytes of a word do not depend on each other.
+ */
+template<typename T, unsigned rows>
+struct crc_slice_table_t {
+    T row[rows][256];
+};
+
+template<typename T, unsigned rows>
+constexpr crc_slice_table_t<T, rows> make_crc_slice_table(uint32_t reflected_polynomial)
+{
+    crc_slice_table_t<T, rows> table = {};
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ reflected_polynomial : crc >> 1;
+        }
+        table.row[0][i] = (T) crc;
+    }
+    for (unsigned k = 1; k < rows; k++) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t prev = table.row[k - 1][i];
+            table.row[k][i] = (T)((prev >> 8) ^ table.row[0][prev & 0xFF]);
+        }
+    }
+    return table;
+}
+
+/* One copy of the tables per polynomial, only emitted where used */
+template<typename T, uint32_t reflected_polynomial, unsigned rows>
+struct CrcSliceTable {
+    static constexpr crc_slice_table_t<T, rows> table = make_crc_slice_table<T, rows>(reflected_polynomial);
+};
+
+template<typename T, uint32_t reflected_polynomial, unsigned rows>
+constexpr crc_slice_table_t<T, rows> CrcSliceTable<T, reflected_polynomial, rows>::table;
 #endif // DOXYGEN_ONLY
 
 } // namespace impl
@@ -94,10 +144,16 @@ constexpr CrcMode choose_crc_mode(uint32_t polynomial, uint8_t width, CrcMode mo
  *  are not available for the selected polynomial, then CRC is computed at run time bit by bit
  *  for all data input.
  *
+ *  The drivers.crc-slice-by setting trades image size for software speed. At 1, a 256-entry
+ *  table is generated at compile time for polynomials without ROM tables. At 4 or 8, the
+ *  software modes take 4 or 8 bytes per step (slice-by-N) with N generated tables of 256
+ *  entries, N KB for a 32-bit CRC.
+ *
  *  If desired, the mode can be manually limited for a given instance by specifying the mode_limit
  *  template parameter. This might be appropriate to ensure a table is not pulled in for a
  *  non-speed-critical CRC, or to avoid the hardware set-up overhead if you know you will be
- *  calling `compute` with very small data sizes.
+ *  calling `compute` with very small data sizes. CrcMode::SLICE_BY_4 and CrcMode::SLICE_BY_8
+ *  select slicing for one instance, such as a firmware image check, whatever the setting.
  *
  *  @note Synchronization level: Thread safe
  *
@@ -431,7 +487,7 @@ public:
                 /* CRC has MSB in top bit of register */
                 p_crc = _reflect_remainder ? reflect(p_crc) : shift_right(p_crc);
             }
-        } else { // TABLE
+        } else { // TABLE or SLICE_BY_N
             /* CRC has MSB in bottom bit of register */
             if (!_reflect_remainder) {
                 p_crc = reflect_crc(p_crc);
@@ -567,12 +623,12 @@ private:
              * (MSB at top of register).
              */
             return reflect_data ? reflect_crc(initial_xor) : shift_left(initial_xor);
-        } else if (mode == CrcMode::TABLE) {
+        } else if (mode == CrcMode::HARDWARE) {
+            return initial_xor;
+        } else { // TABLE or SLICE_BY_N
             /* For table calculation, CRC value is reflected, to match tables.
              * (MSB at bottom of register). */
             return reflect_crc(initial_xor);
-        } else { // CrcMode::HARDWARE
-            return initial_xor;
         }
     }
 
@@ -786,7 +842,42 @@ private:
     }
 
 #if MBED_CRC_TABLE_SIZE > 0
-    /** CRC computation using ROM tables.
+    /** Process 1 byte with the ROM table.
+     *
+     * @param  p_crc  reflected register value
+     * @param  data_byte  reflected data byte
+     * @return updated register value
+     */
+    template<bool rom = have_crc_table(polynomial, width)>
+    static std::enable_if_t<rom, uint_fast32_t>
+    do_table_byte(uint_fast32_t p_crc, uint_fast32_t data_byte)
+    {
+#if MBED_CRC_TABLE_SIZE == 16
+        p_crc = _crc_table[(data_byte ^ p_crc) & 0xF] ^ (p_crc >> 4);
+        data_byte >>= 4;
+        p_crc = _crc_table[(data_byte ^ p_crc) & 0xF] ^ (p_crc >> 4);
+#else
+        p_crc = _crc_table[(data_byte ^ p_crc) & 0xFF] ^ (p_crc >> 8);
+#endif
+        return p_crc;
+    }
+#endif
+
+    /** Process 1 byte with the generated table, for polynomials without ROM tables.
+     *
+     * @param  p_crc  reflected register value
+     * @param  data_byte  reflected data byte
+     * @return updated register value
+     */
+    template<bool rom = have_crc_table(polynomial, width)>
+    static std::enable_if_t<!rom, uint_fast32_t>
+    do_table_byte(uint_fast32_t p_crc, uint_fast32_t data_byte)
+    {
+        using slice_table = CrcSliceTable<crc_table_t, get_reflected_polynomial(), 1>;
+        return slice_table::table.row[0][(data_byte ^ p_crc) & 0xFF] ^ (p_crc >> 8);
+    }
+
+    /** CRC computation using ROM or generated tables.
     *
     * @param  buffer  data buffer
     * @param  size  size of the data
@@ -807,18 +898,60 @@ private:
             if (reflect) {
                 data_byte = reflect_byte(data_byte);
             }
-#if MBED_CRC_TABLE_SIZE == 16
-            p_crc = _crc_table[(data_byte ^ p_crc) & 0xF] ^ (p_crc >> 4);
-            data_byte >>= 4;
-            p_crc = _crc_table[(data_byte ^ p_crc) & 0xF] ^ (p_crc >> 4);
-#else
-            p_crc = _crc_table[(data_byte ^ p_crc) & 0xFF] ^ (p_crc >> 8);
-#endif
+            p_crc = do_table_byte(p_crc, data_byte);
+        }
+        *crc = p_crc;
+        return 0;
+    }
+
+    /** Load 4 data bytes, first byte at the bottom, reflecting each byte if needed.
+     *
+     * Loading the word most significant byte first and reflecting all of it
+     * reflects the bytes in place, with one RBIT.
+     */
+    static uint32_t load_word(const uint8_t *data, bool reflect_bytes)
+    {
+        if (reflect_bytes) {
+            return reflect(((uint32_t) data[0] << 24) | ((uint32_t) data[1] << 16) |
+                           ((uint32_t) data[2] << 8) | data[3]);
+        }
+        return data[0] | ((uint32_t) data[1] << 8) | ((uint32_t) data[2] << 16) | ((uint32_t) data[3] << 24);
+    }
+
+    /** CRC computation using generated tables, 4 or 8 bytes per step.
+    *
+    * @param  buffer  data buffer
+    * @param  size  size of the data
+    * @param  crc  CRC value is filled in, but the value is not the final
+    * @return  0  on success or a negative error code on failure
+    */
+    template<CrcMode mode_ = mode>
+    std::enable_if_t<mode_ == CrcMode::SLICE_BY_4 || mode_ == CrcMode::SLICE_BY_8, int32_t>
+    do_compute_partial(const uint8_t *data, crc_data_size_t size, uint32_t *crc) const
+    {
+        constexpr unsigned rows = mode == CrcMode::SLICE_BY_8 ? 8 : 4;
+        const auto &table = CrcSliceTable<crc_table_t, get_reflected_polynomial(), rows>::table.row;
+        uint_fast32_t p_crc = *crc;
+        bool reflect = !_reflect_data;
+
+        for (; size >= rows; size -= rows, data += rows) {
+            uint32_t word = load_word(data, reflect) ^ p_crc;
+            p_crc = table[rows - 1][word & 0xFF] ^ table[rows - 2][(word >> 8) & 0xFF] ^
+                    table[rows - 3][(word >> 16) & 0xFF] ^ table[rows - 4][word >> 24];
+            if (rows == 8) {
+                word = load_word(data + 4, reflect);
+                p_crc ^= table[3][word & 0xFF] ^ table[2][(word >> 8) & 0xFF] ^
+                         table[1][(word >> 16) & 0xFF] ^ table[0][word >> 24];
+            }
+        }
+
+        for (; size > 0; size--, data++) {
+            uint_fast32_t data_byte = reflect ? reflect_byte(*data) : *data;
+            p_crc = table[0][(data_byte ^ p_crc) & 0xFF] ^ (p_crc >> 8);
         }
         *crc = p_crc;
         return 0;
     }
-#endif
 
 #ifdef DEVICE_CRC
     /** Hardware CRC computation.
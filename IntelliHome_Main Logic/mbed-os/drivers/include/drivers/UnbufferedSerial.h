@@ -184,6 +184,21 @@ public:
      */
     short poll(short events) const override;
 
+    /** Register a callback on state change of the file
+     *
+     *  The callback is called from the receive interrupt when a character
+     *  arrives. The receive interrupt then stays masked until read() takes
+     *  the character, so the callback runs once per character instead of
+     *  on every interrupt until the character is read. Passing poll_wake
+     *  lets poll_wait() sleep until the serial port has data.
+     *
+     *  sigio() and attach() with RxIrq share the receive interrupt, the
+     *  last one called sets its handler.
+     *
+     *  @param func     Function to call on state change, nullptr to remove it
+     */
+    void sigio(Callback<void()> func) override;
+
     using SerialBase::attach;
     using SerialBase::baud;
     using SerialBase::format;
@@ -211,6 +226,11 @@ public:
      */
     void set_flow_control(Flow type, PinName flow1 = NC, PinName flow2 = NC);
 #endif // DEVICE_SERIAL_FC
+
+private:
+    void _sigio_irq();
+
+    Callback<void()> _sigio_cb;
 };
 
 } // namespace mbed
@@ -18,6 +18,7 @@
 
 #if (DEVICE_SERIAL && DEVICE_INTERRUPTIN)
 
+#include <algorithm>
 #include "platform/mbed_poll.h"
 #include "platform/mbed_thread.h"
 
@@ -149,15 +150,28 @@ ssize_t BufferedSerial::write_unbuffered(const char *buf_ptr, size_t length)
 
 ssize_t BufferedSerial::write(const void *buffer, size_t length)
 {
+    Span<const uint8_t> buf(static_cast<const uint8_t *>(buffer), length);
+    return writev(Span<const Span<const uint8_t>>(&buf, 1));
+}
+
+ssize_t BufferedSerial::writev(Span<const Span<const uint8_t>> iov)
+{
+    size_t length = 0;
     size_t data_written = 0;
-    const char *buf_ptr = static_cast<const char *>(buffer);
+
+    for (Span<const uint8_t> buf : iov) {
+        length += buf.size();
+    }
 
     if (length == 0) {
         return 0;
     }
 
     if (core_util_in_critical_section()) {
-        return write_unbuffered(buf_ptr, length);
+        for (Span<const uint8_t> buf : iov) {
+            write_unbuffered(reinterpret_cast<const char *>(buf.data()), buf.size());
+        }
+        return length;
     }
 
     api_lock();
@@ -165,26 +179,37 @@ ssize_t BufferedSerial::write(const void *buffer, size_t length)
     // Unlike read, we should write the whole thing if blocking. POSIX only
     // allows partial as a side-effect of signal handling; it normally tries to
     // write everything if blocking. Without signals we can always write all.
-    while (data_written < length) {
-
-        if (_txbuf.full()) {
-            if (!_blocking) {
-                break;
+    for (Span<const uint8_t> buf : iov) {
+        const char *buf_ptr = reinterpret_cast<const char *>(buf.data());
+        size_t left = buf.size();
+
+        while (left != 0) {
+
+            if (_txbuf.full()) {
+                if (!_blocking) {
+                    break;
+                }
+                do {
+                    api_unlock();
+                    // Should we have a proper wait?
+                    thread_sleep_for(1);
+                    api_lock();
+                } while (_txbuf.full());
             }
-            do {
-                api_unlock();
-                // Should we have a proper wait?
-                thread_sleep_for(1);
-                api_lock();
-            } while (_txbuf.full());
-        }
 
-        while (data_written < length && !_txbuf.full()) {
-            _txbuf.push(*buf_ptr++);
-            data_written++;
+            // The IRQ only pops, so the free space can only grow meanwhile
+            size_t n = std::min(left, (size_t)(MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE - _txbuf.size()));
+            _txbuf.push(buf_ptr, n);
+            buf_ptr += n;
+            left -= n;
+            data_written += n;
+
+            update_tx_irq();
         }
 
-        update_tx_irq();
+        if (left != 0) {
+            break;
+        }
     }
 
     api_unlock();
@@ -192,11 +217,51 @@ ssize_t BufferedSerial::write(const void *buffer, size_t length)
     return data_written != 0 ? (ssize_t) data_written : (ssize_t) - EAGAIN;
 }
 
+Span<uint8_t> BufferedSerial::write_reserve(size_t length)
+{
+    MBED_ASSERT(length <= MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE);
+
+    api_lock();
+
+    // Free space only becomes contiguous as the data ahead of it is sent
+    Span<char> region = _txbuf.write_region();
+    while (region.size() < length) {
+        if (!_blocking) {
+            return Span<uint8_t>();
+        }
+        api_unlock();
+        thread_sleep_for(1);
+        api_lock();
+        region = _txbuf.write_region();
+    }
+
+    return Span<uint8_t>(reinterpret_cast<uint8_t *>(region.data()), region.size());
+}
+
+void BufferedSerial::write_commit(size_t length)
+{
+    if (length != 0) {
+        _txbuf.commit_write(length);
+        update_tx_irq();
+    }
+
+    api_unlock();
+}
+
 ssize_t BufferedSerial::read(void *buffer, size_t length)
 {
+    Span<uint8_t> buf(static_cast<uint8_t *>(buffer), length);
+    return readv(Span<const Span<uint8_t>>(&buf, 1));
+}
+
+ssize_t BufferedSerial::readv(Span<const Span<uint8_t>> iov)
+{
+    size_t length = 0;
     size_t data_read = 0;
 
-    char *ptr = static_cast<char *>(buffer);
+    for (Span<uint8_t> buf : iov) {
+        length += buf.size();
+    }
 
     if (length == 0) {
         return 0;
@@ -215,9 +280,15 @@ ssize_t BufferedSerial::read(void *buffer, size_t length)
         api_lock();
     }
 
-    while (data_read < length && !_rxbuf.empty()) {
-        _rxbuf.pop(*ptr++);
-        data_read++;
+    for (Span<uint8_t> buf : iov) {
+        if (buf.empty()) {
+            continue;
+        }
+        size_t n = _rxbuf.pop(reinterpret_cast<char *>(buf.data()), buf.size());
+        data_read += n;
+        if (n < buf.size()) {
+            break;
+        }
     }
 
     update_rx_irq();
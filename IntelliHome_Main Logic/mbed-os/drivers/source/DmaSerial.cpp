@@ -0,0 +1,297 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2026 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "drivers/DmaSerial.h"
+
+#if (DEVICE_SERIAL && DEVICE_SERIAL_DMA)
+
+#include <algorithm>
+#include <string.h>
+#include "platform/mbed_critical.h"
+#include "platform/mbed_poll.h"
+#include "platform/mbed_thread.h"
+
+namespace mbed {
+
+DmaSerial::DmaSerial(PinName tx, PinName rx, int baud):
+    SerialBase(tx, rx, baud)
+{
+    start();
+}
+
+DmaSerial::DmaSerial(const serial_pinmap_t &static_pinmap, int baud):
+    SerialBase(static_pinmap, baud)
+{
+    start();
+}
+
+DmaSerial::~DmaSerial()
+{
+    serial_dma_rx_stop(&_serial);
+    while (serial_dma_tx_active(&_serial));
+    serial_dma_handler(&_serial, NULL, 0);
+}
+
+void DmaSerial::start()
+{
+    serial_dma_handler(&_serial, &DmaSerial::dma_irq, reinterpret_cast<uintptr_t>(this));
+    serial_dma_rx_start(&_serial, _rxbuf, sizeof _rxbuf);
+}
+
+void DmaSerial::set_baud(int baud)
+{
+    api_lock();
+    SerialBase::baud(baud);
+    api_unlock();
+}
+
+void DmaSerial::set_format(int bits, Parity parity, int stop_bits)
+{
+    api_lock();
+    SerialBase::format(bits, parity, stop_bits);
+    api_unlock();
+}
+
+int DmaSerial::close()
+{
+    return 0;
+}
+
+int DmaSerial::isatty()
+{
+    return 1;
+}
+
+off_t DmaSerial::seek(off_t offset, int whence)
+{
+    return -ESPIPE;
+}
+
+int DmaSerial::sync()
+{
+    api_lock();
+
+    while (_tx_count != 0) {
+        api_unlock();
+        thread_sleep_for(1);
+        api_lock();
+    }
+
+    api_unlock();
+
+    return 0;
+}
+
+void DmaSerial::sigio(Callback<void()> func)
+{
+    core_util_critical_section_enter();
+    _sigio_cb = func;
+    if (_sigio_cb) {
+        short current_events = poll(0x7FFF);
+        if (current_events) {
+            _sigio_cb();
+        }
+    }
+    core_util_critical_section_exit();
+}
+
+ssize_t DmaSerial::write(const void *buffer, size_t length)
+{
+    size_t data_written = 0;
+    const uint8_t *buf_ptr = static_cast<const uint8_t *>(buffer);
+
+    if (length == 0) {
+        return 0;
+    }
+
+    // No interrupt will come, such as in mbed_error_vprintf: finish the
+    // transfers by polling and send the buffer byte by byte
+    if (core_util_in_critical_section()) {
+        while (_tx_count != 0) {
+            if (!serial_dma_tx_active(&_serial)) {
+                tx_done();
+                tx_start();
+            }
+        }
+        for (; data_written < length; data_written++) {
+            SerialBase::_base_putc(*buf_ptr++);
+        }
+        return length;
+    }
+
+    api_lock();
+
+    while (data_written < length) {
+
+        if (_tx_count == sizeof _txbuf) {
+            if (!_blocking) {
+                break;
+            }
+            do {
+                api_unlock();
+                thread_sleep_for(1);
+                api_lock();
+            } while (_tx_count == sizeof _txbuf);
+        }
+
+        core_util_critical_section_enter();
+        while (data_written < length && _tx_count < sizeof _txbuf) {
+            size_t head = (_tx_tail + _tx_count) % sizeof _txbuf;
+            size_t chunk = std::min({length - data_written, sizeof _txbuf - _tx_count, sizeof _txbuf - head});
+            memcpy(&_txbuf[head], buf_ptr + data_written, chunk);
+            _tx_count += chunk;
+            data_written += chunk;
+        }
+        tx_start();
+        core_util_critical_section_exit();
+    }
+
+    api_unlock();
+
+    return data_written != 0 ? (ssize_t) data_written : (ssize_t) - EAGAIN;
+}
+
+ssize_t DmaSerial::read(void *buffer, size_t length)
+{
+    size_t data_read = 0;
+    uint8_t *ptr = static_cast<uint8_t *>(buffer);
+
+    if (length == 0) {
+        return 0;
+    }
+
+    api_lock();
+
+    // Take the bytes of a burst still in progress too
+    core_util_critical_section_enter();
+    rx_update();
+    while (_rx_count == 0) {
+        core_util_critical_section_exit();
+        if (!_blocking) {
+            api_unlock();
+            return -EAGAIN;
+        }
+        api_unlock();
+        thread_sleep_for(1);
+        api_lock();
+        core_util_critical_section_enter();
+        rx_update();
+    }
+
+    while (data_read < length && _rx_count != 0) {
+        size_t chunk = std::min({length - data_read, _rx_count, sizeof _rxbuf - _rx_tail});
+        memcpy(ptr + data_read, &_rxbuf[_rx_tail], chunk);
+        _rx_tail = (_rx_tail + chunk) % sizeof _rxbuf;
+        _rx_count -= chunk;
+        data_read += chunk;
+    }
+    core_util_critical_section_exit();
+
+    api_unlock();
+
+    return data_read;
+}
+
+void DmaSerial::wake()
+{
+    if (_sigio_cb) {
+        _sigio_cb();
+    }
+}
+
+short DmaSerial::poll(short events) const
+{
+    short revents = 0;
+
+    if (_rx_count != 0) {
+        revents |= POLLIN;
+    }
+
+    if (_tx_count < sizeof _txbuf) {
+        revents |= POLLOUT;
+    }
+
+    return revents;
+}
+
+void DmaSerial::api_lock(void)
+{
+    _mutex.lock();
+}
+
+void DmaSerial::api_unlock(void)
+{
+    _mutex.unlock();
+}
+
+void DmaSerial::rx_update()
+{
+    size_t head = serial_dma_rx_head(&_serial);
+
+    // The HAL reports at least every half ring, so the DMA cannot have
+    // gone round more than once since the last update
+    _rx_count += (head + sizeof _rxbuf - _rx_head) % sizeof _rxbuf;
+    _rx_head = head;
+
+    if (_rx_count > sizeof _rxbuf) {
+        // The oldest unread bytes were overwritten, keep the newest ring
+        _rx_overruns++;
+        _rx_tail = head;
+        _rx_count = sizeof _rxbuf;
+    }
+}
+
+void DmaSerial::tx_start()
+{
+    if (_tx_active == 0 && _tx_count != 0) {
+        _tx_active = std::min(_tx_count, sizeof _txbuf - _tx_tail);
+        serial_dma_tx_start(&_serial, &_txbuf[_tx_tail], _tx_active);
+    }
+}
+
+void DmaSerial::tx_done()
+{
+    _tx_tail = (_tx_tail + _tx_active) % sizeof _txbuf;
+    _tx_count -= _tx_active;
+    _tx_active = 0;
+}
+
+void DmaSerial::dma_irq(uintptr_t id, uint32_t event)
+{
+    DmaSerial *serial = reinterpret_cast<DmaSerial *>(id);
+    bool changed = false;
+
+    if (event & SERIAL_DMA_EVENT_RX) {
+        bool was_empty = serial->_rx_count == 0;
+        serial->rx_update();
+        changed |= was_empty && serial->_rx_count != 0;
+    }
+
+    if ((event & SERIAL_DMA_EVENT_TX_DONE) && serial->_tx_active != 0) {
+        bool was_full = serial->_tx_count == sizeof serial->_txbuf;
+        serial->tx_done();
+        serial->tx_start();
+        changed |= was_full;
+    }
+
+    if (changed) {
+        serial->wake();
+    }
+}
+
+} // namespace mbed
+
+#endif //(DEVICE_SERIAL && DEVICE_SERIAL_DMA)
@@ -25,6 +25,8 @@ SingletonPtr<PlatformMutex> mbed_crc_mutex;
 
 static_assert(MBED_CRC_TABLE_SIZE == 0 || MBED_CRC_TABLE_SIZE == 16 || MBED_CRC_TABLE_SIZE == 256,
               "Configuration setting drivers.crc-table-size must be set to 0, 16 or 256");
+static_assert(MBED_CRC_SLICE_BY == 0 || MBED_CRC_SLICE_BY == 1 || MBED_CRC_SLICE_BY == 4 || MBED_CRC_SLICE_BY == 8,
+              "Configuration setting drivers.crc-slice-by must be set to 0, 1, 4 or 8");
 
 #if MBED_CRC_TABLE_SIZE > 0
 
@@ -76,6 +76,11 @@ ssize_t UnbufferedSerial::read(void *buffer, size_t size)
 
     buf[0] = _base_getc();
 
+    // Unmask the receive interrupt masked by _sigio_irq()
+    if (_sigio_cb && _rx_enabled) {
+        serial_irq_set(&_serial, (SerialIrq)RxIrq, 1);
+    }
+
     unlock();
 
     return 1;
@@ -99,6 +104,29 @@ short UnbufferedSerial::poll(short events) const
     return revents;
 }
 
+void UnbufferedSerial::sigio(Callback<void()> func)
+{
+    core_util_critical_section_enter();
+    _sigio_cb = func;
+    core_util_critical_section_exit();
+
+    // A character already waiting raises the interrupt as soon as it is enabled
+    if (func) {
+        SerialBase::attach(callback(this, &UnbufferedSerial::_sigio_irq), RxIrq);
+    } else {
+        SerialBase::attach(nullptr, RxIrq);
+    }
+}
+
+void UnbufferedSerial::_sigio_irq()
+{
+    // The interrupt stays pending until the character is read
+    serial_irq_set(&_serial, (SerialIrq)RxIrq, 0);
+    if (_sigio_cb) {
+        _sigio_cb();
+    }
+}
+
 int UnbufferedSerial::enable_input(bool enabled)
 {
     SerialBase::enable_input(enabled);
@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "drivers/BufferedSerial.h"
+#include "SerialBase_stub.h"
+#include <chrono>
+#include <string>
+#include <string.h>
+
+using namespace mbed;
+
+// Buffer sizes of this test, CMakeLists.txt
+static const size_t RX_SIZE = 32;
+static const size_t TX_SIZE = 128;
+
+// Blocking calls sleep while the UART sends
+static int sleeps;
+
+static void drain()
+{
+    SerialBase_stub::tx_ready = true;
+    if (SerialBase_stub::irq[SerialBase::TxIrq]) {
+        SerialBase_stub::irq[SerialBase::TxIrq]();
+    }
+    SerialBase_stub::tx_ready = false;
+}
+
+extern "C" void thread_sleep_for(uint32_t millisec)
+{
+    sleeps++;
+    drain();
+}
+
+static std::string pattern(size_t length, char first = 'a')
+{
+    std::string s;
+    for (size_t i = 0; i < length; i++) {
+        s += (char)(first + i % 26);
+    }
+    return s;
+}
+
+static Span<const uint8_t> bytes(const std::string &s)
+{
+    return Span<const uint8_t>(reinterpret_cast<const uint8_t *>(s.data()), s.size());
+}
+
+class TestBufferedSerial : public testing::Test {
+protected:
+    void SetUp()
+    {
+        SerialBase_stub::reset();
+        sleeps = 0;
+        serial = new BufferedSerial(NC, NC);
+    }
+
+    void TearDown()
+    {
+        delete serial;
+    }
+
+    std::string sent()
+    {
+        return std::string(SerialBase_stub::tx.begin(), SerialBase_stub::tx.end());
+    }
+
+    void receive(const std::string &s)
+    {
+        SerialBase_stub::rx.insert(SerialBase_stub::rx.end(), s.begin(), s.end());
+        if (SerialBase_stub::irq[SerialBase::RxIrq]) {
+            SerialBase_stub::irq[SerialBase::RxIrq]();
+        }
+    }
+
+    BufferedSerial *serial;
+};
+
+TEST_F(TestBufferedSerial, write_goes_through_buffer)
+{
+    EXPECT_EQ(5, serial->write("hello", 5));
+    EXPECT_EQ("", sent());
+
+    drain();
+    EXPECT_EQ("hello", sent());
+}
+
+TEST_F(TestBufferedSerial, writev_in_order)
+{
+    std::string header = "S\x05";
+    std::string payload = "12345";
+    std::string crc = "\xAA\x55";
+    const Span<const uint8_t> iov[] = { bytes(header), Span<const uint8_t>(), bytes(payload), bytes(crc) };
+
+    EXPECT_EQ(9, serial->writev(iov));
+    drain();
+    EXPECT_EQ(header + payload + crc, sent());
+}
+
+TEST_F(TestBufferedSerial, writev_nothing)
+{
+    const Span<const uint8_t> iov[] = { Span<const uint8_t>(), Span<const uint8_t>() };
+
+    EXPECT_EQ(0, serial->writev(iov));
+    EXPECT_EQ(0, serial->writev(Span<const Span<const uint8_t>>()));
+}
+
+TEST_F(TestBufferedSerial, writev_non_blocking_partial)
+{
+    std::string first = pattern(TX_SIZE - 10);
+    std::string second = pattern(20, 'A');
+    const Span<const uint8_t> iov[] = { bytes(first), bytes(second) };
+
+    serial->set_blocking(false);
+    EXPECT_EQ((ssize_t)TX_SIZE, serial->writev(iov));
+    EXPECT_EQ(-EAGAIN, serial->writev(iov));
+
+    drain();
+    EXPECT_EQ(first + second.substr(0, 10), sent());
+    EXPECT_EQ(0, sleeps);
+}
+
+TEST_F(TestBufferedSerial, writev_blocking_waits)
+{
+    std::string first = pattern(TX_SIZE);
+    std::string second = pattern(TX_SIZE, 'A');
+    const Span<const uint8_t> iov[] = { bytes(first), bytes(second) };
+
+    EXPECT_EQ((ssize_t)(2 * TX_SIZE), serial->writev(iov));
+    EXPECT_GT(sleeps, 0);
+
+    drain();
+    EXPECT_EQ(first + second, sent());
+}
+
+TEST_F(TestBufferedSerial, readv_scatters)
+{
+    uint8_t header[3];
+    uint8_t payload[8];
+    const Span<uint8_t> iov[] = { header, payload };
+
+    receive(std::string("H\x05\x00" "abcde", 8));
+    EXPECT_EQ(8, serial->readv(iov));
+    EXPECT_EQ(0, memcmp(header, "H\x05\x00", 3));
+    EXPECT_EQ(0, memcmp(payload, "abcde", 5));
+}
+
+TEST_F(TestBufferedSerial, readv_stops_when_empty)
+{
+    uint8_t first[2];
+    uint8_t second[4];
+    const Span<uint8_t> iov[] = { first, second };
+
+    serial->set_blocking(false);
+    EXPECT_EQ(-EAGAIN, serial->readv(iov));
+
+    receive("x");
+    EXPECT_EQ(1, serial->readv(iov));
+    EXPECT_EQ('x', first[0]);
+    EXPECT_EQ(-EAGAIN, serial->readv(iov));
+}
+
+TEST_F(TestBufferedSerial, read_takes_whole_buffer)
+{
+    char buffer[RX_SIZE];
+    std::string data = pattern(RX_SIZE);
+
+    receive(data);
+    EXPECT_EQ((ssize_t)RX_SIZE, serial->read(buffer, sizeof buffer));
+    EXPECT_EQ(data, std::string(buffer, sizeof buffer));
+}
+
+TEST_F(TestBufferedSerial, reserve_commit)
+{
+    Span<uint8_t> space = serial->write_reserve(4);
+    ASSERT_GE(space.size(), 4u);
+    memcpy(space.data(), "ping", 4);
+    serial->write_commit(4);
+
+    drain();
+    EXPECT_EQ("ping", sent());
+}
+
+TEST_F(TestBufferedSerial, reserve_given_up)
+{
+    Span<uint8_t> space = serial->write_reserve(4);
+    ASSERT_GE(space.size(), 4u);
+    memcpy(space.data(), "lost", 4);
+    serial->write_commit(0);
+
+    serial->write("kept", 4);
+    drain();
+    EXPECT_EQ("kept", sent());
+}
+
+TEST_F(TestBufferedSerial, reserve_non_blocking_full)
+{
+    std::string data = pattern(TX_SIZE - 2);
+
+    serial->set_blocking(false);
+    serial->write(data.data(), data.size());
+
+    EXPECT_TRUE(serial->write_reserve(3).empty());
+    serial->write_commit(0);
+    EXPECT_EQ(2u, serial->write_reserve(2).size());
+    serial->write_commit(0);
+}
+
+TEST_F(TestBufferedSerial, reserve_waits_for_contiguous_space)
+{
+    std::string data = pattern(TX_SIZE - 8);
+
+    serial->write(data.data(), data.size());
+
+    // 8 bytes free at the end, the frame only fits once the buffer empties
+    Span<uint8_t> space = serial->write_reserve(16);
+    ASSERT_GE(space.size(), 16u);
+    EXPECT_GT(sleeps, 0);
+    memcpy(space.data(), "0123456789abcdef", 16);
+    serial->write_commit(16);
+
+    drain();
+    EXPECT_EQ(data + "0123456789abcdef", sent());
+}
+
+#define BENCH_FRAMES 20000
+#define BENCH_PAYLOAD 64
+#define FRAME_SIZE (3 + BENCH_PAYLOAD + 2)
+
+static uint16_t checksum(const uint8_t *data, size_t length)
+{
+    uint16_t sum = 0;
+    for (size_t i = 0; i < length; i++) {
+        sum = (uint16_t)((sum << 1 | sum >> 15) ^ data[i]);
+    }
+    return sum;
+}
+
+/** Benchmark sending header, payload and checksum frames.
+ *
+ *  Each frame is sent three ways:
+ *  - formatted into a stack buffer, then write();
+ *  - writev() of the header, the payload and the checksum;
+ *  - built in the transmit buffer between write_reserve() and write_commit().
+ *
+ *  The bytes copied per frame are counted: the staging copy, then the copy
+ *  into the transmit buffer done by write() and writev(), which is one per
+ *  byte written. Only the reserve path copies the payload alone. The bytes
+ *  sent must be the same; the copies are asserted, the time is printed.
+ */
+TEST_F(TestBufferedSerial, benchmark_frame_copies)
+{
+    uint8_t payload[BENCH_PAYLOAD];
+    for (size_t i = 0; i < sizeof payload; i++) {
+        payload[i] = (uint8_t)(i * 7);
+    }
+
+    auto frame_header = [](uint8_t *header, int frame) {
+        header[0] = 'F';
+        header[1] = (uint8_t)frame;
+        header[2] = BENCH_PAYLOAD;
+    };
+
+    size_t copied[3] = { 0, 0, 0 };
+    long long elapsed[3];
+    std::string output[3];
+
+    for (int method = 0; method < 3; method++) {
+        SerialBase_stub::tx.clear();
+        SerialBase_stub::tx.reserve(BENCH_FRAMES * FRAME_SIZE);
+        auto start = std::chrono::steady_clock::now();
+
+        for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+            if (method == 0) {
+                uint8_t buffer[FRAME_SIZE];
+                frame_header(buffer, frame);
+                memcpy(buffer + 3, payload, BENCH_PAYLOAD);
+                uint16_t sum = checksum(buffer, 3 + BENCH_PAYLOAD);
+                buffer[3 + BENCH_PAYLOAD] = (uint8_t)sum;
+                buffer[4 + BENCH_PAYLOAD] = (uint8_t)(sum >> 8);
+                copied[0] += FRAME_SIZE;
+                copied[0] += serial->write(buffer, FRAME_SIZE);
+            } else if (method == 1) {
+                uint8_t header[3];
+                uint8_t trailer[2];
+                frame_header(header, frame);
+                uint16_t sum = checksum(header, 3);
+                for (int i = 0; i < BENCH_PAYLOAD; i++) {
+                    sum = (uint16_t)((sum << 1 | sum >> 15) ^ payload[i]);
+                }
+                trailer[0] = (uint8_t)sum;
+                trailer[1] = (uint8_t)(sum >> 8);
+                const Span<const uint8_t> iov[] = { header, payload, trailer };
+                copied[1] += serial->writev(iov);
+            } else {
+                Span<uint8_t> space = serial->write_reserve(FRAME_SIZE);
+                uint8_t *p = space.data();
+                frame_header(p, frame);
+                memcpy(p + 3, payload, BENCH_PAYLOAD);
+                copied[2] += BENCH_PAYLOAD;
+                uint16_t sum = checksum(p, 3 + BENCH_PAYLOAD);
+                p[3 + BENCH_PAYLOAD] = (uint8_t)sum;
+                p[4 + BENCH_PAYLOAD] = (uint8_t)(sum >> 8);
+                serial->write_commit(FRAME_SIZE);
+            }
+            drain();
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        elapsed[method] = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        output[method] = sent();
+    }
+
+    EXPECT_EQ((size_t)BENCH_FRAMES * FRAME_SIZE, output[0].size());
+    EXPECT_EQ(output[0], output[1]);
+    EXPECT_EQ(output[0], output[2]);
+
+    EXPECT_EQ((size_t)BENCH_FRAMES * 2 * FRAME_SIZE, copied[0]);
+    EXPECT_EQ((size_t)BENCH_FRAMES * FRAME_SIZE, copied[1]);
+    EXPECT_EQ((size_t)BENCH_FRAMES * BENCH_PAYLOAD, copied[2]);
+
+    printf("%d byte frames, bytes copied per frame: staged write %zu, writev %zu, reserve/commit %zu\n",
+           FRAME_SIZE, copied[0] / BENCH_FRAMES, copied[1] / BENCH_FRAMES, copied[2] / BENCH_FRAMES);
+    printf("staged write %5.1f ns/frame, writev %5.1f ns/frame, reserve/commit %5.1f ns/frame\n",
+           (double)elapsed[0] / BENCH_FRAMES, (double)elapsed[1] / BENCH_FRAMES, (double)elapsed[2] / BENCH_FRAMES);
+}
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "drivers/DmaSerial.h"
+#include "platform/mbed_poll.h"
+#include "serial_dma_stub.h"
+#include <string>
+
+using namespace mbed;
+
+// Ring sizes of this test, CMakeLists.txt
+static const size_t RX_SIZE = 64;
+static const size_t TX_SIZE = 32;
+
+// Blocking calls sleep while the DMA moves the data
+static int sleeps;
+
+extern "C" void thread_sleep_for(uint32_t millisec)
+{
+    sleeps++;
+    serial_dma_stub::complete_tx();
+}
+
+static std::string pattern(size_t length, char first = 'a')
+{
+    std::string s;
+    for (size_t i = 0; i < length; i++) {
+        s += (char)(first + i % 26);
+    }
+    return s;
+}
+
+static std::string sent()
+{
+    std::string s;
+    for (const auto &transfer : serial_dma_stub::transfers()) {
+        s.append(transfer.begin(), transfer.end());
+    }
+    return s;
+}
+
+class DmaSerialTest : public testing::Test {
+protected:
+    void SetUp()
+    {
+        serial_dma_stub::reset();
+        sleeps = 0;
+        serial = new DmaSerial(NC, NC);
+        // Called once at registration, the port is writable
+        wakes = 0;
+        serial->sigio(callback(this, &DmaSerialTest::wake));
+        EXPECT_EQ(1, wakes);
+        wakes = 0;
+    }
+
+    void TearDown()
+    {
+        // The destructor waits for the transfer in progress
+        serial_dma_stub::complete_tx_silently();
+        delete serial;
+    }
+
+    void wake()
+    {
+        wakes++;
+    }
+
+    std::string read(size_t length)
+    {
+        char buffer[256];
+        ssize_t n = serial->read(buffer, length);
+        return n > 0 ? std::string(buffer, n) : std::string();
+    }
+
+    DmaSerial *serial;
+    int wakes;
+};
+
+TEST_F(DmaSerialTest, starts_reception)
+{
+    EXPECT_TRUE(serial_dma_stub::rx_running());
+    EXPECT_EQ(POLLOUT, serial->poll(POLLIN | POLLOUT));
+    EXPECT_EQ(0, wakes);
+}
+
+TEST_F(DmaSerialTest, burst_read_at_once)
+{
+    serial_dma_stub::receive("AT+NAME?\r\n", 10);
+
+    EXPECT_EQ(1, wakes);
+    EXPECT_EQ(POLLIN | POLLOUT, serial->poll(POLLIN | POLLOUT));
+    EXPECT_EQ("AT+NAME?\r\n", read(64));
+    EXPECT_EQ(POLLOUT, serial->poll(POLLIN | POLLOUT));
+}
+
+TEST_F(DmaSerialTest, read_takes_burst_in_progress)
+{
+    serial_dma_stub::receive("OK", 2, false);
+
+    // No idle line yet, nothing reported
+    EXPECT_EQ(0, wakes);
+    EXPECT_EQ("OK", read(64));
+}
+
+TEST_F(DmaSerialTest, wake_once_until_read)
+{
+    serial_dma_stub::receive("T", 1);
+    serial_dma_stub::receive("P", 1);
+    EXPECT_EQ(1, wakes);
+
+    EXPECT_EQ("TP", read(64));
+    serial_dma_stub::receive("L", 1);
+    EXPECT_EQ(2, wakes);
+}
+
+TEST_F(DmaSerialTest, partial_read)
+{
+    serial_dma_stub::receive("abcdef", 6);
+
+    EXPECT_EQ("abc", read(3));
+    EXPECT_EQ("def", read(64));
+}
+
+TEST_F(DmaSerialTest, ring_wraps)
+{
+    serial_dma_stub::receive(pattern(50).data(), 50);
+    EXPECT_EQ(pattern(50), read(64));
+
+    // 14 bytes to the end of the ring, then 26 from its start
+    std::string burst = pattern(40, 'A');
+    serial_dma_stub::receive(burst.data(), burst.size());
+    EXPECT_EQ(burst, read(64));
+    EXPECT_EQ(0u, serial->rx_overruns());
+}
+
+TEST_F(DmaSerialTest, half_ring_reported_without_idle)
+{
+    std::string data = pattern(RX_SIZE / 2);
+    serial_dma_stub::receive(data.data(), data.size(), false);
+
+    EXPECT_EQ(1, wakes);
+    EXPECT_EQ(POLLIN, serial->poll(POLLIN) & POLLIN);
+}
+
+TEST_F(DmaSerialTest, overrun_keeps_newest)
+{
+    std::string data = pattern(RX_SIZE + 10);
+    serial_dma_stub::receive(data.data(), data.size());
+
+    EXPECT_EQ(1u, serial->rx_overruns());
+    EXPECT_EQ(data.substr(10), read(RX_SIZE));
+    EXPECT_EQ(POLLOUT, serial->poll(POLLIN | POLLOUT));
+}
+
+TEST_F(DmaSerialTest, non_blocking_read_empty)
+{
+    char c;
+
+    serial->set_blocking(false);
+    EXPECT_EQ(-EAGAIN, serial->read(&c, 1));
+    EXPECT_EQ(0, serial->read(&c, 0));
+}
+
+TEST_F(DmaSerialTest, write_one_transfer)
+{
+    EXPECT_EQ(4, serial->write("PING", 4));
+
+    ASSERT_EQ(1u, serial_dma_stub::transfers().size());
+    EXPECT_EQ("PING", sent());
+    EXPECT_TRUE(serial_dma_stub::tx_active());
+}
+
+TEST_F(DmaSerialTest, writes_queued_behind_transfer)
+{
+    serial->write("one", 3);
+    serial->write("two", 3);
+    serial->write("six", 3);
+
+    ASSERT_EQ(1u, serial_dma_stub::transfers().size());
+    serial_dma_stub::complete_tx();
+
+    // Everything queued meanwhile goes in the next transfer
+    ASSERT_EQ(2u, serial_dma_stub::transfers().size());
+    EXPECT_EQ("onetwosix", sent());
+    serial_dma_stub::complete_tx();
+    EXPECT_FALSE(serial_dma_stub::tx_active());
+    EXPECT_EQ(0, sleeps);
+}
+
+TEST_F(DmaSerialTest, transfer_split_at_ring_end)
+{
+    std::string first = pattern(20);
+    std::string second = pattern(20, 'A');
+
+    serial->write(first.data(), first.size());
+    serial_dma_stub::complete_tx();
+    serial->write(second.data(), second.size());
+    serial_dma_stub::complete_tx();
+
+    ASSERT_EQ(3u, serial_dma_stub::transfers().size());
+    EXPECT_EQ(12u, serial_dma_stub::transfers()[1].size());
+    EXPECT_EQ(8u, serial_dma_stub::transfers()[2].size());
+    EXPECT_EQ(first + second, sent());
+}
+
+TEST_F(DmaSerialTest, non_blocking_write_full)
+{
+    std::string data = pattern(TX_SIZE + 8);
+
+    serial->set_blocking(false);
+    EXPECT_EQ((ssize_t)TX_SIZE, serial->write(data.data(), data.size()));
+    EXPECT_EQ(-EAGAIN, serial->write("x", 1));
+    EXPECT_EQ(0, serial->poll(POLLOUT));
+
+    serial_dma_stub::complete_tx();
+    EXPECT_EQ(1, wakes);
+    EXPECT_EQ(POLLOUT, serial->poll(POLLOUT));
+    EXPECT_EQ(0, sleeps);
+}
+
+TEST_F(DmaSerialTest, blocking_write_waits_for_space)
+{
+    std::string data = pattern(3 * TX_SIZE);
+
+    EXPECT_EQ((ssize_t)data.size(), serial->write(data.data(), data.size()));
+    EXPECT_GT(sleeps, 0);
+
+    serial_dma_stub::complete_tx();
+    EXPECT_EQ(data, sent());
+}
+
+TEST_F(DmaSerialTest, sync_waits_for_transfers)
+{
+    serial->write("abc", 3);
+    EXPECT_EQ(0, serial->sync());
+
+    EXPECT_EQ(1, sleeps);
+    EXPECT_FALSE(serial_dma_stub::tx_active());
+}
+
+TEST_F(DmaSerialTest, stops_on_destruction)
+{
+    delete serial;
+    serial = nullptr;
+
+    EXPECT_FALSE(serial_dma_stub::rx_running());
+    serial_dma_stub::receive("x", 1);
+}
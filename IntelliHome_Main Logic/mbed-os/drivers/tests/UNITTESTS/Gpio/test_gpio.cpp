@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include "drivers/Gpio.h"
+#include "gpio_stub.h"
+#include <type_traits>
+
+using namespace mbed;
+
+// The pins carry no state, the objects are empty
+static_assert(std::is_empty<GpioOut<PortA, 3>>::value, "GpioOut holds no state");
+static_assert(std::is_empty<GpioPortOut<PortA, 0x0F00>>::value, "GpioPortOut holds no state");
+static_assert(GpioInOut<PortB, 5>::mask == 0x20, "pin mask");
+
+// HD44780 in 4-bit mode: data on pins 8 to 11, E on 12, RS on 14
+static const uint32_t LCD_DATA = 0x0F00;
+static const uint32_t LCD_EN = 1UL << 12;
+static const uint32_t LCD_RS = 1UL << 14;
+typedef GpioPortOut<PortA, LCD_DATA | LCD_EN | LCD_RS> LcdBus;
+
+static void lcd_nibble(LcdBus &bus, int rs, uint8_t nibble)
+{
+    uint32_t value = ((uint32_t)(nibble & 0x0F) << 8) | (rs ? LCD_RS : 0);
+    bus = value;
+    gpio_stub::advance_us(1);
+    bus = value | LCD_EN;
+    gpio_stub::advance_us(1);
+    bus = value;
+    gpio_stub::advance_us(1);
+}
+
+class GpioTest : public testing::Test {
+protected:
+    void SetUp()
+    {
+        gpio_stub::reset();
+    }
+};
+
+TEST_F(GpioTest, out)
+{
+    GpioOut<PortA, 3> pin(1);
+
+    EXPECT_EQ(0x8u, gpio_stub::outputs(PortA));
+    EXPECT_EQ(PullNone, gpio_stub::mode(PortA, 3));
+    EXPECT_EQ(1, pin.read());
+
+    unsigned writes = gpio_stub::port_writes();
+    gpio_stub::advance_us(5);
+    pin = 0;
+
+    EXPECT_EQ(writes + 1, gpio_stub::port_writes());
+    EXPECT_EQ(0, pin.read());
+    ASSERT_EQ(2u, gpio_stub::transitions().size());
+    const gpio_stub::Transition &fall = gpio_stub::transitions().back();
+    EXPECT_EQ(5u, fall.time_us);
+    EXPECT_EQ(PortA, fall.port);
+    EXPECT_EQ(0x8u, fall.changed);
+    EXPECT_EQ(0x0u, fall.levels);
+}
+
+TEST_F(GpioTest, in)
+{
+    GpioIn<PortB, 2> pin(PullUp);
+
+    EXPECT_EQ(0x0u, gpio_stub::outputs(PortB));
+    EXPECT_EQ(PullUp, gpio_stub::mode(PortB, 2));
+    EXPECT_EQ(0, pin.read());
+
+    gpio_stub::drive(PortB, 2, 1);
+    EXPECT_EQ(1, (int) pin);
+
+    pin.mode(PullNone);
+    EXPECT_EQ(PullNone, gpio_stub::mode(PortB, 2));
+}
+
+TEST_F(GpioTest, inout)
+{
+    // The DHT11 start signal: drive low, release, the sensor answers
+    GpioInOut<PortB, 5> line(PIN_OUTPUT, PullNone, 1);
+    EXPECT_EQ(1, line.read());
+
+    line = 0;
+    EXPECT_EQ(0, line.read());
+
+    gpio_stub::drive(PortB, 5, 1);
+    line.input();
+    EXPECT_EQ(0x0u, gpio_stub::outputs(PortB));
+    EXPECT_EQ(1, line.read());
+
+    gpio_stub::drive(PortB, 5, 0);
+    EXPECT_EQ(0, line.read());
+
+    // Back to an output, the latch still holds the last written value
+    gpio_stub::drive(PortB, 5, 1);
+    line.output();
+    EXPECT_EQ(0, line.read());
+}
+
+TEST_F(GpioTest, port_out_is_atomic)
+{
+    LcdBus bus;
+    gpio_stub::clear_log();
+
+    bus = LCD_RS | 0x0A00;
+
+    EXPECT_EQ(1u, gpio_stub::port_writes());
+    ASSERT_EQ(1u, gpio_stub::transitions().size());
+    EXPECT_EQ(LCD_RS | 0x0A00, gpio_stub::transitions()[0].changed);
+    EXPECT_EQ(LCD_RS | 0x0A00, bus.read());
+
+    // Only the pins of the mask are written
+    bus = 0xFFFFFFFF;
+    EXPECT_EQ(LCD_DATA | LCD_EN | LCD_RS, gpio_stub::levels(PortA));
+
+    bus.write(0, LCD_EN | 0x0100);
+    EXPECT_EQ(LCD_RS | 0x0E00, (uint32_t) bus);
+    EXPECT_EQ(3u, gpio_stub::port_writes());
+}
+
+TEST_F(GpioTest, port_out_keeps_other_pins)
+{
+    GpioOut<PortA, 0> other(1);
+    LcdBus bus;
+
+    bus = LCD_DATA;
+    EXPECT_EQ(1, other.read());
+    EXPECT_EQ(LCD_DATA | 0x1, gpio_stub::levels(PortA));
+}
+
+TEST_F(GpioTest, lcd_nibble_timing)
+{
+    LcdBus bus;
+    gpio_stub::clear_log();
+
+    lcd_nibble(bus, 1, 0x4);
+    lcd_nibble(bus, 1, 0x1);
+
+    // Check the HD44780 write cycle on the recorded levels: RS and data set
+    // before E rises, E high at least 450 ns, nothing moves while E is high
+    uint64_t last_setup = 0;
+    uint64_t rise = 0;
+    int pulses = 0;
+    for (const gpio_stub::Transition &t : gpio_stub::transitions()) {
+        if (t.changed & LCD_EN) {
+            EXPECT_EQ(LCD_EN, t.changed) << "E changes alone";
+            if (t.levels & LCD_EN) {
+                rise = t.time_us;
+                EXPECT_GE(rise - last_setup, 1u) << "address setup time";
+            } else {
+                EXPECT_GE(t.time_us - rise, 1u) << "E pulse width";
+                pulses++;
+            }
+        } else {
+            EXPECT_FALSE(t.levels & LCD_EN) << "data moved while E is high";
+            last_setup = t.time_us;
+        }
+    }
+    EXPECT_EQ(2, pulses);
+    EXPECT_EQ(LCD_RS | 0x0100, gpio_stub::levels(PortA));
+    EXPECT_EQ(6u, gpio_stub::now_us());
+}
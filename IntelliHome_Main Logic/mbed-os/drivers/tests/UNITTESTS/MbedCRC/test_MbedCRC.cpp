@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include "drivers/MbedCRC.h"
+#include <chrono>
+#include <string.h>
+
+using namespace mbed;
+
+#define POLY_32BIT_CASTAGNOLI   0x1EDC6F41
+#define POLY_24BIT_OPENPGP      0x864CFB
+#define POLY_12BIT_UMTS         0x80F
+
+// The tables are built by the compiler
+static_assert(impl::make_crc_slice_table<uint32_t, 1>(0xEDB88320).row[0][1] == 0x77073096,
+              "CRC-32 table entry");
+static_assert(impl::make_crc_slice_table<uint32_t, 2>(0xEDB88320).row[1][1] == 0x191B3141,
+              "CRC-32 slice table entry");
+
+// drivers.crc-slice-by is 1 here: generated byte tables, slicing only on request
+static_assert(impl::choose_crc_mode(POLY_32BIT_ANSI, 32, CrcMode::HARDWARE) == CrcMode::TABLE, "");
+static_assert(impl::choose_crc_mode(POLY_32BIT_CASTAGNOLI, 32, CrcMode::HARDWARE) == CrcMode::TABLE, "");
+static_assert(impl::choose_crc_mode(POLY_32BIT_ANSI, 32, CrcMode::SLICE_BY_8) == CrcMode::SLICE_BY_8, "");
+static_assert(impl::choose_crc_mode(POLY_16BIT_CCITT, 16, CrcMode::SLICE_BY_4) == CrcMode::SLICE_BY_4, "");
+static_assert(impl::choose_crc_mode(POLY_32BIT_ANSI, 32, CrcMode::BITWISE) == CrcMode::BITWISE, "");
+
+static const char check_string[] = "123456789";
+
+template <typename Crc>
+static uint32_t crc_of(Crc &crc, const void *data, size_t size)
+{
+    uint32_t result = 0;
+    EXPECT_EQ(0, crc.compute(data, size, &result));
+    return result;
+}
+
+template <uint32_t polynomial, uint8_t width>
+static void expect_check_value(uint32_t initial_xor, uint32_t final_xor, bool reflect_data, bool reflect_remainder,
+                               uint32_t check)
+{
+    MbedCRC<polynomial, width, CrcMode::BITWISE> bitwise(initial_xor, final_xor, reflect_data, reflect_remainder);
+    MbedCRC<polynomial, width, CrcMode::TABLE> table(initial_xor, final_xor, reflect_data, reflect_remainder);
+    MbedCRC<polynomial, width, CrcMode::SLICE_BY_4> slice4(initial_xor, final_xor, reflect_data, reflect_remainder);
+    MbedCRC<polynomial, width, CrcMode::SLICE_BY_8> slice8(initial_xor, final_xor, reflect_data, reflect_remainder);
+
+    EXPECT_EQ(check, crc_of(bitwise, check_string, 9));
+    EXPECT_EQ(check, crc_of(table, check_string, 9));
+    EXPECT_EQ(check, crc_of(slice4, check_string, 9));
+    EXPECT_EQ(check, crc_of(slice8, check_string, 9));
+}
+
+// Every length up to a few steps, at every alignment, and in two parts
+template <uint32_t polynomial, uint8_t width>
+static void expect_modes_match(uint32_t initial_xor, uint32_t final_xor, bool reflect_data, bool reflect_remainder)
+{
+    MbedCRC<polynomial, width, CrcMode::BITWISE> bitwise(initial_xor, final_xor, reflect_data, reflect_remainder);
+    MbedCRC<polynomial, width, CrcMode::TABLE> table(initial_xor, final_xor, reflect_data, reflect_remainder);
+    MbedCRC<polynomial, width, CrcMode::SLICE_BY_4> slice4(initial_xor, final_xor, reflect_data, reflect_remainder);
+    MbedCRC<polynomial, width, CrcMode::SLICE_BY_8> slice8(initial_xor, final_xor, reflect_data, reflect_remainder);
+
+    uint8_t data[80];
+    uint32_t seed = polynomial;
+    for (size_t i = 0; i < sizeof(data); i++) {
+        seed = seed * 1664525u + 1013904223u;
+        data[i] = seed >> 24;
+    }
+
+    for (size_t offset = 0; offset < 4; offset++) {
+        for (size_t len = 0; len + offset <= 40; len++) {
+            uint32_t expected = crc_of(bitwise, data + offset, len);
+            EXPECT_EQ(expected, crc_of(table, data + offset, len)) << "len " << len;
+            EXPECT_EQ(expected, crc_of(slice4, data + offset, len)) << "len " << len;
+            EXPECT_EQ(expected, crc_of(slice8, data + offset, len)) << "len " << len;
+        }
+    }
+
+    uint32_t expected = crc_of(bitwise, data, sizeof(data));
+    for (size_t split = 0; split <= sizeof(data); split += 7) {
+        uint32_t crc;
+        slice8.compute_partial_start(&crc);
+        slice8.compute_partial(data, split, &crc);
+        slice8.compute_partial(data + split, sizeof(data) - split, &crc);
+        slice8.compute_partial_stop(&crc);
+        EXPECT_EQ(expected, crc) << "split " << split;
+    }
+}
+
+TEST(TestMbedCRC, check_values)
+{
+    expect_check_value<POLY_32BIT_ANSI, 32>(0xFFFFFFFF, 0xFFFFFFFF, true, true, 0xCBF43926);
+    expect_check_value<POLY_32BIT_ANSI, 32>(0xFFFFFFFF, 0, false, false, 0x0376E6E7);
+    expect_check_value<POLY_32BIT_CASTAGNOLI, 32>(0xFFFFFFFF, 0xFFFFFFFF, true, true, 0xE3069283);
+    expect_check_value<POLY_24BIT_OPENPGP, 24>(0xB704CE, 0, false, false, 0x21CF02);
+    expect_check_value<POLY_16BIT_CCITT, 16>(0xFFFF, 0, false, false, 0x29B1);
+    expect_check_value<POLY_16BIT_IBM, 16>(0, 0, true, true, 0xBB3D);
+    expect_check_value<POLY_12BIT_UMTS, 12>(0, 0, false, true, 0xDAF);
+    expect_check_value<POLY_8BIT_CCITT, 8>(0, 0, false, false, 0xF4);
+    expect_check_value<POLY_7BIT_SD, 7>(0, 0, false, false, 0x75);
+}
+
+TEST(TestMbedCRC, default_instances)
+{
+    MbedCRC<POLY_32BIT_ANSI, 32> crc32;
+    EXPECT_EQ(0xCBF43926u, crc_of(crc32, check_string, 9));
+    MbedCRC<POLY_16BIT_CCITT, 16> ccitt;
+    EXPECT_EQ(0x29B1u, crc_of(ccitt, check_string, 9));
+}
+
+TEST(TestMbedCRC, modes_match_bitwise)
+{
+    for (int reflect = 0; reflect < 4; reflect++) {
+        bool reflect_data = reflect & 1;
+        bool reflect_remainder = reflect & 2;
+        expect_modes_match<POLY_32BIT_ANSI, 32>(0xFFFFFFFF, 0xFFFFFFFF, reflect_data, reflect_remainder);
+        expect_modes_match<POLY_32BIT_CASTAGNOLI, 32>(0x12345678, 0, reflect_data, reflect_remainder);
+        expect_modes_match<POLY_24BIT_OPENPGP, 24>(0xB704CE, 0, reflect_data, reflect_remainder);
+        expect_modes_match<POLY_16BIT_CCITT, 16>(0xFFFF, 0, reflect_data, reflect_remainder);
+        expect_modes_match<POLY_16BIT_IBM, 16>(0, 0xFFFF, reflect_data, reflect_remainder);
+        expect_modes_match<POLY_12BIT_UMTS, 12>(0, 0, reflect_data, reflect_remainder);
+        expect_modes_match<POLY_8BIT_CCITT, 8>(0x55, 0, reflect_data, reflect_remainder);
+        expect_modes_match<POLY_7BIT_SD, 7>(0x2B, 0x7F, reflect_data, reflect_remainder);
+    }
+}
+
+#define BENCH_SIZE      4096
+#define BENCH_ROUNDS    256
+
+template <typename Crc>
+static double bench_mb_per_s(Crc &crc, const uint8_t *data, uint32_t *result)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        crc.compute(data, BENCH_SIZE, result);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return (double) BENCH_SIZE * BENCH_ROUNDS / seconds / 1e6;
+}
+
+/** Benchmark CRC-32 over a firmware-image-sized buffer in each software mode.
+ *
+ *  All modes must agree; the throughput is printed but not asserted, since
+ *  it depends on the host and the optimization level.
+ */
+TEST(TestMbedCRC, benchmark_modes)
+{
+    static uint8_t data[BENCH_SIZE];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 31 + 7);
+    }
+
+    MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::BITWISE> bitwise(0xFFFFFFFF, 0xFFFFFFFF, true, true);
+    MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::TABLE> table(0xFFFFFFFF, 0xFFFFFFFF, true, true);
+    MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::SLICE_BY_4> slice4(0xFFFFFFFF, 0xFFFFFFFF, true, true);
+    MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::SLICE_BY_8> slice8(0xFFFFFFFF, 0xFFFFFFFF, true, true);
+
+    uint32_t r_bitwise, r_table, r_slice4, r_slice8;
+    double mb_bitwise = bench_mb_per_s(bitwise, data, &r_bitwise);
+    double mb_table = bench_mb_per_s(table, data, &r_table);
+    double mb_slice4 = bench_mb_per_s(slice4, data, &r_slice4);
+    double mb_slice8 = bench_mb_per_s(slice8, data, &r_slice8);
+
+    EXPECT_EQ(r_bitwise, r_table);
+    EXPECT_EQ(r_bitwise, r_slice4);
+    EXPECT_EQ(r_bitwise, r_slice8);
+
+    printf("CRC-32 bitwise %6.1f MB/s, table %6.1f MB/s, slice-by-4 %6.1f MB/s, slice-by-8 %6.1f MB/s\n",
+           mb_bitwise, mb_table, mb_slice4, mb_slice8);
+}
@@ -38,6 +38,25 @@ ssize_t BufferedSerial::write(const void *buffer, size_t length)
     return 0;
 }
 
+ssize_t BufferedSerial::writev(Span<const Span<const uint8_t>> iov)
+{
+    return 0;
+}
+
+ssize_t BufferedSerial::readv(Span<const Span<uint8_t>> iov)
+{
+    return 0;
+}
+
+Span<uint8_t> BufferedSerial::write_reserve(size_t length)
+{
+    return Span<uint8_t>();
+}
+
+void BufferedSerial::write_commit(size_t length)
+{
+}
+
 off_t BufferedSerial::seek(off_t offset, int whence)
 {
     return -ESPIPE;
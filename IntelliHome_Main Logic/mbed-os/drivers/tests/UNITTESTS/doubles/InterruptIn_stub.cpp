@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/InterruptIn.h"
+
+namespace mbed {
+
+InterruptIn::InterruptIn(PinName pin)
+{
+}
+
+InterruptIn::InterruptIn(PinName pin, PinMode mode)
+{
+}
+
+InterruptIn::~InterruptIn()
+{
+}
+
+int InterruptIn::read()
+{
+    return 0;
+}
+
+InterruptIn::operator int()
+{
+    return 0;
+}
+
+void InterruptIn::rise(Callback<void()> func)
+{
+    _rise = func;
+}
+
+void InterruptIn::fall(Callback<void()> func)
+{
+    _fall = func;
+}
+
+void InterruptIn::mode(PinMode pull)
+{
+}
+
+void InterruptIn::enable_irq()
+{
+}
+
+void InterruptIn::disable_irq()
+{
+}
+
+}
@@ -16,6 +16,24 @@
  */
 
 #include "drivers/SerialBase.h"
+#include "SerialBase_stub.h"
+
+namespace SerialBase_stub {
+std::deque<char> rx;
+std::vector<char> tx;
+bool tx_ready;
+mbed::Callback<void()> irq[mbed::SerialBase::IrqCnt];
+
+void reset()
+{
+    rx.clear();
+    tx.clear();
+    tx_ready = false;
+    for (auto &handler : irq) {
+        handler = nullptr;
+    }
+}
+}
 
 namespace mbed {
 
@@ -24,6 +42,11 @@ SerialBase::SerialBase(PinName tx, PinName rx, int baud) :
 {
 }
 
+SerialBase::SerialBase(const serial_pinmap_t &static_pinmap, int baud) :
+    _tx_pin(static_pinmap.tx_pin), _rx_pin(static_pinmap.rx_pin)
+{
+}
+
 SerialBase::~SerialBase()
 {
 
@@ -39,17 +62,18 @@ void SerialBase::format(int bits, Parity parity, int stop_bits)
 
 int SerialBase::readable()
 {
-    return 0;
+    return !SerialBase_stub::rx.empty();
 }
 
 
 int SerialBase::writeable()
 {
-    return 0;
+    return SerialBase_stub::tx_ready;
 }
 
 void SerialBase::attach(Callback<void()> func, IrqType type)
 {
+    SerialBase_stub::irq[type] = func;
 }
 
 void SerialBase::_irq_handler(uint32_t id, SerialIrq irq_type)
@@ -58,18 +82,32 @@ void SerialBase::_irq_handler(uint32_t id, SerialIrq irq_type)
 
 int SerialBase::_base_getc()
 {
-    return 0;
+    if (SerialBase_stub::rx.empty()) {
+        return 0;
+    }
+    char c = SerialBase_stub::rx.front();
+    SerialBase_stub::rx.pop_front();
+    return c;
 }
 
 int SerialBase::_base_putc(int c)
 {
-    return 0;
+    SerialBase_stub::tx.push_back((char)c);
+    return c;
 }
 
 void SerialBase::send_break()
 {
 }
 
+void SerialBase::enable_input(bool enable)
+{
+}
+
+void SerialBase::enable_output(bool enable)
+{
+}
+
 void SerialBase::lock()
 {
 }
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_SERIALBASE_STUB_H
+#define MBED_SERIALBASE_STUB_H
+
+#include <deque>
+#include <vector>
+#include "drivers/SerialBase.h"
+
+/* Line of SerialBase_stub.cpp: readable() while rx holds bytes,
+ * writeable() while tx_ready is set, _base_putc() appends to tx. The
+ * handlers given to attach() are kept so a test can raise the interrupts.
+ */
+namespace SerialBase_stub {
+extern std::deque<char> rx;
+extern std::vector<char> tx;
+extern bool tx_ready;
+extern mbed::Callback<void()> irq[mbed::SerialBase::IrqCnt];
+
+/* Empty line, transmitter busy, no handlers */
+void reset();
+}
+
+#endif
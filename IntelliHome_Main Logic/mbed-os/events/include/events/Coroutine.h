@@ -0,0 +1,381 @@
+/*
+ * Copyright (c) 2026 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+#include <new>
+#include <utility>
+#include "events/EventQueue.h"
+#include "platform/NonCopyable.h"
+
+#if DEVICE_INTERRUPTIN || defined(DOXYGEN_ONLY)
+#include "drivers/InterruptIn.h"
+#endif
+#if DEVICE_SERIAL || defined(DOXYGEN_ONLY)
+#include "drivers/UnbufferedSerial.h"
+#endif
+
+/** Start the body of Coroutine::run
+ */
+#define CO_BEGIN() switch (_co_line) { case 0:
+
+/** Suspend the coroutine on a wait and resume after it completes
+ *
+ *  @param wait     Call of one of the Coroutine wait functions
+ *  @note Only one CO_AWAIT per source line
+ */
+#define CO_AWAIT(wait) do { _co_line = __LINE__; wait; return; case __LINE__:; } while (0)
+
+/** Finish the coroutine early
+ */
+#define CO_RETURN() do { _co_line = -1; return; } while (0)
+
+/** End the body of Coroutine::run
+ */
+#define CO_END() } _co_line = -1
+
+namespace events {
+/**
+ * \addtogroup events-public-api
+ * @{
+ */
+
+template <typename T, unsigned N>
+class CoroutinePool;
+
+/**
+ * \defgroup events_Coroutine Coroutine class
+ * @{
+ */
+
+/** Coroutine
+ *
+ *  Sequential code that suspends onto an EventQueue instead of blocking.
+ *
+ *  The body is written in run() between CO_BEGIN() and CO_END(). Each
+ *  CO_AWAIT arms one wait and returns to the dispatch loop; the queue calls
+ *  run() again once the wait completes and execution continues after the
+ *  CO_AWAIT. Waits are completed from interrupt handlers or queue timers,
+ *  and the coroutine is resumed through events embedded in the object, so
+ *  nothing is allocated and an EventQueue(0) is a valid queue.
+ *
+ *  The coroutine is stackless: locals of run() do not survive a CO_AWAIT.
+ *  State that must persist belongs in members of the derived class, which
+ *  makes the object itself the coroutine frame. CoroutinePool provides a
+ *  fixed number of such frames for coroutines started on demand.
+ *
+ * Usage:
+ * @code
+ *  #include "mbed.h"
+ *
+ *  class Blink : public Coroutine {
+ *  public:
+ *      Blink(EventQueue *queue) : Coroutine(queue), _led(LED1) {}
+ *
+ *  private:
+ *      DigitalOut _led;
+ *      int _i;
+ *
+ *      void run() override
+ *      {
+ *          CO_BEGIN();
+ *          for (_i = 0; _i < 3; _i++) {
+ *              _led = 1;
+ *              CO_AWAIT(sleep_for(100ms));
+ *              _led = 0;
+ *              CO_AWAIT(sleep_for(100ms));
+ *          }
+ *          CO_END();
+ *      }
+ *  };
+ *
+ *  EventQueue queue(0);
+ *  Blink blink(&queue);
+ *
+ *  int main()
+ *  {
+ *    blink.start();
+ *    queue.dispatch_forever();
+ *  }
+ * @endcode
+ */
+class Coroutine : private mbed::NonCopyable<Coroutine> {
+public:
+    /** Destroy a coroutine
+     *
+     *  Abandons a wait in progress. The queue must not be dispatching the
+     *  coroutine at the same time.
+     */
+    virtual ~Coroutine();
+
+    /** Start the coroutine from the beginning of its body
+     *
+     *  The body first runs from the dispatch loop, not from this call.
+     *
+     *  @return         False if the coroutine is still running
+     */
+    bool start();
+
+    /** Check if the coroutine has finished
+     *
+     *  @return         True before the first start and after the end of the body
+     */
+    bool done() const;
+
+    /** Complete a wait_signal
+     *
+     *  Safe to call from interrupt context. Does nothing unless the
+     *  coroutine is suspended in wait_signal.
+     */
+    void signal();
+
+protected:
+    /** Create a coroutine
+     *
+     *  @param queue    Event queue to run the body on
+     */
+    Coroutine(EventQueue *queue);
+
+    /** Body of the coroutine, between CO_BEGIN() and CO_END()
+     */
+    virtual void run() = 0;
+
+    /** Wait for a duration
+     *
+     *  @param ms       Time to sleep
+     */
+    void sleep_for(EventQueue::duration ms);
+
+    /** Wait for signal()
+     *
+     *  @param timeout  Longest wait, negative to wait forever
+     */
+    void wait_signal(EventQueue::duration timeout = EventQueue::duration(-1));
+
+#if DEVICE_INTERRUPTIN || defined(DOXYGEN_ONLY)
+    /** Wait for an edge on a pin
+     *
+     *  Replaces the handler of that edge on the pin while waiting. The
+     *  microsecond ticker time of the edge is available from edge_time().
+     *
+     *  @param pin      Interrupt pin to watch
+     *  @param rising   True for a rising edge, false for a falling one
+     *  @param timeout  Longest wait, negative to wait forever
+     */
+    void pin_edge(mbed::InterruptIn &pin, bool rising,
+                  EventQueue::duration timeout = EventQueue::duration(-1));
+#endif
+
+#if DEVICE_SERIAL || defined(DOXYGEN_ONLY)
+    /** Wait for bytes from a serial port
+     *
+     *  Replaces the receive interrupt handler of the port while waiting.
+     *  The number of bytes stored is available from received().
+     *
+     *  @param serial   Serial port to read
+     *  @param buffer   Buffer to fill, must stay valid during the wait
+     *  @param size     Number of bytes to wait for
+     *  @param timeout  Longest wait, negative to wait forever
+     */
+    void uart_bytes(mbed::UnbufferedSerial &serial, void *buffer, size_t size,
+                    EventQueue::duration timeout = EventQueue::duration(-1));
+#endif
+
+    /** Check how the last wait completed
+     *
+     *  @return         True if the last wait ended on its timeout, always
+     *                  true after sleep_for
+     */
+    bool timed_out() const
+    {
+        return _timed_out;
+    }
+
+    /** Time of the edge that completed the last pin_edge
+     *
+     *  @return         Microsecond ticker time
+     */
+    uint32_t edge_time() const
+    {
+        return _edge_time;
+    }
+
+    /** Bytes stored by the last uart_bytes
+     *
+     *  @return         Number of bytes, less than requested on a timeout
+     */
+    size_t received() const
+    {
+        return _received;
+    }
+
+    /** Resume point of the body, managed by the CO_ macros */
+    int _co_line;
+
+private:
+    template <typename T, unsigned N>
+    friend class CoroutinePool;
+
+    // The queue passes the address just past the event to the callback,
+    // which is where the owner is found
+    struct resume_event {
+        struct equeue_event e;
+        Coroutine *self;
+    };
+
+    // Runs the body, posted from interrupts as well as from the queue
+    resume_event _resume;
+    // Timeouts and sleeps, only posted and canceled from the queue
+    resume_event _timer;
+    struct equeue *_equeue;
+    bool _pending;
+    bool _armed;
+    bool _timed_out;
+    uint32_t _edge_time;
+    size_t _received;
+#if DEVICE_INTERRUPTIN
+    mbed::InterruptIn *_pin;
+    bool _rising;
+#endif
+#if DEVICE_SERIAL
+    mbed::UnbufferedSerial *_serial;
+    uint8_t *_rx;
+    size_t _rx_size;
+#endif
+    void (*_release)(Coroutine *co, void *pool);
+    void *_pool;
+
+    void arm(EventQueue::duration timeout);
+    bool complete();
+    void wake();
+    void detach();
+    void on_edge();
+    void on_rx();
+
+    static void resume_thunk(void *p);
+    static void timer_thunk(void *p);
+};
+
+/** @}*/
+
+/**
+ * \defgroup events_CoroutinePool CoroutinePool class
+ * @{
+ */
+
+/** CoroutinePool
+ *
+ *  Fixed number of frames for coroutines that are started on demand.
+ *
+ *  start() constructs a coroutine in a free frame and starts it. The frame
+ *  is destroyed and returned to the pool when the body ends, so no heap is
+ *  involved and the worst case memory use is N frames.
+ *
+ *  @tparam T       Coroutine class, derived from Coroutine
+ *  @tparam N       Number of frames
+ */
+template <typename T, unsigned N>
+class CoroutinePool : private mbed::NonCopyable<CoroutinePool<T, N> > {
+    static_assert(N > 0, "CoroutinePool needs at least one frame");
+
+public:
+    /** Create an empty pool
+     */
+    CoroutinePool() : _used()
+    {
+    }
+
+    /** Destroy the pool and every coroutine still running in it
+     */
+    ~CoroutinePool()
+    {
+        for (unsigned i = 0; i < N; i++) {
+            if (_used[i]) {
+                frame(i)->~T();
+            }
+        }
+    }
+
+    /** Construct and start a coroutine in a free frame
+     *
+     *  @param args     Arguments of the T constructor
+     *  @return         The coroutine, or NULL if every frame is in use
+     */
+    template <typename... ArgTs>
+    T *start(ArgTs &&... args)
+    {
+        for (unsigned i = 0; i < N; i++) {
+            if (!_used[i]) {
+                _used[i] = true;
+                T *co = new (_frames[i]) T(std::forward<ArgTs>(args)...);
+                co->_release = &CoroutinePool::release;
+                co->_pool = this;
+                co->start();
+                return co;
+            }
+        }
+        return NULL;
+    }
+
+    /** Number of frames holding a running coroutine
+     *
+     *  @return         At most N
+     */
+    unsigned in_use() const
+    {
+        unsigned count = 0;
+        for (unsigned i = 0; i < N; i++) {
+            count += _used[i];
+        }
+        return count;
+    }
+
+    /** Number of frames
+     *
+     *  @return         N
+     */
+    static constexpr unsigned capacity()
+    {
+        return N;
+    }
+
+private:
+    alignas(T) unsigned char _frames[N][sizeof(T)];
+    bool _used[N];
+
+    T *frame(unsigned i)
+    {
+        return reinterpret_cast<T *>(_frames[i]);
+    }
+
+    static void release(Coroutine *co, void *pool)
+    {
+        CoroutinePool *self = static_cast<CoroutinePool *>(pool);
+        T *t = static_cast<T *>(co);
+        unsigned i = (reinterpret_cast<unsigned char *>(t) - self->_frames[0]) / sizeof(T);
+        t->~T();
+        self->_used[i] = false;
+    }
+};
+
+/** @}*/
+
+/** @}*/
+
+}
+
+#endif
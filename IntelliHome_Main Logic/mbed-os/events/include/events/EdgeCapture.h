@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2026 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef EDGE_CAPTURE_H
+#define EDGE_CAPTURE_H
+
+#include "events/EventQueue.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_assert.h"
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
+
+#if DEVICE_INTERRUPTIN || defined(DOXYGEN_ONLY)
+#include "drivers/InterruptIn.h"
+#endif
+
+namespace events {
+/**
+ * \addtogroup events-public-api
+ * @{
+ */
+
+/** One captured edge
+ */
+struct EdgeRecord {
+    /** Microsecond ticker time of the edge, wraps every 71 minutes */
+    uint32_t time_us;
+    /** True for a rising edge, false for a falling one */
+    bool rising;
+};
+
+/**
+ * \defgroup events_EdgeCapture EdgeCapture class
+ * @{
+ */
+
+/** EdgeCapture
+ *
+ *  Moves pin edges out of interrupt context without allocating.
+ *
+ *  The interrupt handler only stores the microsecond ticker time and the
+ *  direction of the edge into a preallocated ring of N records, and posts
+ *  the embedded event to the queue unless it is already pending. The
+ *  handler then runs in the context of the queue's dispatch loop with every
+ *  record captured since its last run, so a burst of edges costs a single
+ *  event. The interrupt time is bounded and posting cannot fail for lack
+ *  of queue memory, which also makes an EventQueue(0) a valid target.
+ *
+ *  If the handler falls behind by more than N edges, the newest edges are
+ *  dropped and counted by overruns().
+ *
+ *  @tparam N   Number of records in the ring, a power of two
+ *
+ * Usage:
+ * @code
+ *  #include "mbed.h"
+ *
+ *  InterruptIn echo(PA_6);
+ *  EventQueue queue(0);
+ *
+ *  void on_edges(const EdgeRecord *edges, size_t count) { ... }
+ *
+ *  EdgeCapture<8> capture(&queue, on_edges);
+ *
+ *  int main()
+ *  {
+ *    capture.attach(echo);
+ *    queue.dispatch_forever();
+ *  }
+ * @endcode
+ */
+template <unsigned N>
+class EdgeCapture : private mbed::NonCopyable<EdgeCapture<N> > {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "EdgeCapture ring size must be a power of two");
+
+public:
+    /** Handler of a batch of captured edges, oldest first
+     */
+    typedef mbed::Callback<void(const EdgeRecord *edges, size_t count)> handler_t;
+
+    /** Create an edge capture
+     *
+     *  @param queue    Event queue to dispatch the handler on
+     *  @param handler  Function to call with the captured edges. A batch
+     *                  that wraps around the end of the ring is passed in
+     *                  two calls.
+     */
+    EdgeCapture(EventQueue *queue, handler_t handler)
+        : _e(default_event()), _equeue(&queue->_equeue), _handler(handler),
+          _head(0), _tail(0), _overruns(0), _pending(false)
+#if DEVICE_INTERRUPTIN
+        , _pin(NULL)
+#endif
+    {
+    }
+
+    /** Destroy an edge capture
+     *
+     *  Detaches from the pin. The queue must not be dispatching the handler
+     *  at the same time.
+     */
+    ~EdgeCapture()
+    {
+#if DEVICE_INTERRUPTIN
+        detach();
+#endif
+        if (core_util_atomic_load_bool(&_pending)) {
+            equeue_cancel_user_allocated(_equeue, &_e);
+        }
+    }
+
+#if DEVICE_INTERRUPTIN || defined(DOXYGEN_ONLY)
+    /** Capture both edges of a pin
+     *
+     *  Replaces the pin's rise and fall handlers.
+     *
+     *  @param pin      Interrupt pin to capture
+     */
+    void attach(mbed::InterruptIn &pin)
+    {
+        detach();
+        _pin = &pin;
+        pin.rise(mbed::callback(this, &EdgeCapture::on_rise));
+        pin.fall(mbed::callback(this, &EdgeCapture::on_fall));
+    }
+
+    /** Stop capturing the attached pin
+     *
+     *  Edges captured earlier are still passed to the handler.
+     */
+    void detach()
+    {
+        if (_pin) {
+            _pin->rise(nullptr);
+            _pin->fall(nullptr);
+            _pin = NULL;
+        }
+    }
+#endif
+
+    /** Capture an edge
+     *
+     *  Entry point for edge sources other than InterruptIn, such as the
+     *  interrupt of a timer input capture channel. Must not be called from
+     *  more than one context at a time.
+     *
+     *  @param time_us  Time of the edge in microseconds
+     *  @param rising   True for a rising edge
+     */
+    void capture(uint32_t time_us, bool rising)
+    {
+        uint32_t head = _head;
+        if (head - core_util_atomic_load_u32(&_tail) == N) {
+            core_util_atomic_incr_u32(&_overruns, 1);
+        } else {
+            _ring[head & (N - 1)].time_us = time_us;
+            _ring[head & (N - 1)].rising = rising;
+            core_util_atomic_store_u32(&_head, head + 1);
+        }
+
+        // A pending event has not started draining yet and will see this edge
+        if (!core_util_atomic_exchange_bool(&_pending, true)) {
+            equeue_post_user_allocated(_equeue, &EdgeCapture::dispatch, &_e);
+        }
+    }
+
+    /** Configure the priority class of the handler event
+     *
+     *  @param priority One of the EQUEUE_PRIORITY values
+     */
+    void priority(int priority)
+    {
+        equeue_event_priority(&_e + 1, priority);
+    }
+
+    /** Number of edges dropped because the ring was full
+     *
+     *  @return         Dropped edges since construction
+     */
+    uint32_t overruns() const
+    {
+        return core_util_atomic_load_u32(&_overruns);
+    }
+
+private:
+    // Must stay the first member, dispatch finds the object from it
+    struct equeue_event _e;
+    struct equeue *_equeue;
+    handler_t _handler;
+    EdgeRecord _ring[N];
+    uint32_t _head;
+    uint32_t _tail;
+    uint32_t _overruns;
+    bool _pending;
+#if DEVICE_INTERRUPTIN
+    mbed::InterruptIn *_pin;
+#endif
+
+    void on_rise()
+    {
+        capture(ticker_read(get_us_ticker_data()), true);
+    }
+
+    void on_fall()
+    {
+        capture(ticker_read(get_us_ticker_data()), false);
+    }
+
+    static void dispatch(void *p)
+    {
+        EdgeCapture *self = reinterpret_cast<EdgeCapture *>(static_cast<struct equeue_event *>(p) - 1);
+
+        // Clear first: an edge captured from here on posts the event again,
+        // which equeue allows while this run is still in progress
+        core_util_atomic_store_bool(&self->_pending, false);
+
+        uint32_t tail = self->_tail;
+        uint32_t head = core_util_atomic_load_u32(&self->_head);
+        while (tail != head) {
+            uint32_t start = tail & (N - 1);
+            uint32_t count = head - tail;
+            if (count > N - start) {
+                count = N - start;
+            }
+            self->_handler(&self->_ring[start], count);
+
+            tail += count;
+            core_util_atomic_store_u32(&self->_tail, tail);
+        }
+    }
+
+    static constexpr struct equeue_event default_event()
+    {
+        return equeue_event{ 0, 0, 0, EQUEUE_PRIORITY_NORMAL, NULL, NULL, NULL, 0, -1, NULL, NULL };
+    }
+};
+
+/** @}*/
+
+/** @}*/
+
+}
+
+#endif
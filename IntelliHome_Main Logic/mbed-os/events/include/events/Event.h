@@ -49,7 +49,7 @@ class Event;
 template <typename... ArgTs>
 class Event<void(ArgTs...)> {
 public:
-    using duration = std::chrono::duration<int, std::milli>;
+    using duration = EventQueue::duration;
 
     /** Create an event
      *
@@ -71,6 +71,10 @@ public:
             _event->id = 0;
             _event->delay = duration(0);
             _event->period = non_periodic;
+            _event->priority = EQUEUE_PRIORITY_NORMAL;
+#if EQUEUE_SCHEDULING_STATS
+            _event->deadline = duration(0);
+#endif
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -137,7 +141,7 @@ public:
     MBED_DEPRECATED_SINCE("mbed-os-6.0.0", "Pass a chrono duration, not an integer millisecond count. For example use `5s` rather than `5000`.")
     void delay(int d)
     {
-        delay(duration(d));
+        delay(std::chrono::milliseconds(d));
     }
 
     /** Configure the period of an event
@@ -171,8 +175,40 @@ public:
     MBED_DEPRECATED_SINCE("mbed-os-6.0.0", "Pass a chrono duration, not an integer millisecond count. For example use `5s` rather than `5000`.")
     void period(int p)
     {
-        period(duration(p));
+        period(std::chrono::milliseconds(p));
+    }
+
+    /** Configure the priority class of an event
+     *
+     *  Among the events that are due when the dispatch loop wakes up, those
+     *  of a higher priority class run first.
+     *
+     *  @param p   One of EQUEUE_PRIORITY_LOW, EQUEUE_PRIORITY_NORMAL (the
+     *             default), EQUEUE_PRIORITY_HIGH and EQUEUE_PRIORITY_CRITICAL
+     */
+    void priority(int p)
+    {
+        if (_event) {
+            _event->priority = p;
+        }
+    }
+
+#if EQUEUE_SCHEDULING_STATS
+    /** Configure the deadline of an event
+     *
+     *  An event that starts more than its deadline after its target time
+     *  counts as missed and is reported to EventQueue::deadline_miss_handler.
+     *
+     *  @param d   Deadline expressed as a Chrono duration, 0ms for none
+     *             (the default). E.g. deadline(5ms)
+     */
+    void deadline(duration d)
+    {
+        if (_event) {
+            _event->deadline = d;
+        }
     }
+#endif
 
     /** Posts an event onto the underlying event queue
      *
@@ -252,6 +288,10 @@ private:
 
         duration delay;
         duration period;
+        int priority;
+#if EQUEUE_SCHEDULING_STATS
+        duration deadline;
+#endif
 
         int (*post)(struct event *, ArgTs... args);
         void (*dtor)(struct event *);
@@ -272,6 +312,10 @@ private:
         new (p) C(*(F *)(e + 1), args...);
         equeue_event_delay(p, e->delay.count());
         equeue_event_period(p, e->period.count());
+        equeue_event_priority(p, e->priority);
+#if EQUEUE_SCHEDULING_STATS
+        equeue_event_deadline(p, e->deadline.count());
+#endif
         equeue_event_dtor(p, &EventQueue::function_dtor<C>);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
@@ -61,7 +61,14 @@ class UserAllocatedEvent;
  */
 class EventQueue : private mbed::NonCopyable<EventQueue> {
 public:
+    /** Resolution of the queue's delays and periods: milliseconds, or
+     *  microseconds with the events.use-us-tick config option.
+     */
+#if EQUEUE_TICK_US
+    using duration = std::chrono::duration<int, std::micro>;
+#else
     using duration = std::chrono::duration<int, std::milli>;
+#endif
 
     /** Create an EventQueue
      *
@@ -147,7 +154,8 @@ public:
      *  number of milliseconds that have passed since an arbitrary point in
      *  time. Intentionally overflows to 0 after 2^32-1.
      *
-     *  @return         The underlying tick of the event queue in milliseconds
+     *  @return         The underlying tick of the event queue in milliseconds,
+     *                  microseconds with the events.use-us-tick config option
      */
     unsigned tick();
 
@@ -211,7 +219,8 @@ public:
      *
      *  @param id       Unique id of the event
      *
-     *  @return         Remaining time in milliseconds or
+     *  @return         Remaining time in milliseconds (microseconds
+     *                  with events.use-us-tick) or
      *                   0 if event is already due to be dispatched or
      *                     is currently executing.
      *                  Undefined if id is invalid.
@@ -231,7 +240,8 @@ public:
      *
      *  @param event    Address of the event
      *
-     *  @return         Remaining time in milliseconds or
+     *  @return         Remaining time in milliseconds (microseconds
+     *                  with events.use-us-tick) or
      *                  0 if event is already due to be dispatched or
      *                  is currently executing.
      *                  Undefined if id is invalid.
@@ -284,6 +294,49 @@ public:
      */
     int chain(EventQueue *target);
 
+    /** Coalesce periodic events
+     *
+     *  When enabled, periodic events are due on multiples of their own
+     *  period. Events whose periods divide one another, such as 500ms and
+     *  2s, then run in the same dispatch and the queue wakes up less often.
+     *  The first dispatch of each periodic event may come up to one period
+     *  early. Periodic events already queued move onto their grid after
+     *  their next run. The default is the events.coalesce-periodic config
+     *  option.
+     *
+     *  @param enable   True to align periodic events, false to time them
+     *                  from when they were posted
+     */
+    void coalesce_periodic(bool enable);
+
+#if EQUEUE_SCHEDULING_STATS
+    /** Report events that miss their deadline
+     *
+     *  The handler is called from the dispatch loop right before an event
+     *  that starts more than its deadline after its target time runs. It
+     *  gets the id of the event (0 for user allocated events) and how late
+     *  the event is. Only available with events.scheduling-stats.
+     *
+     *  @param handler  Function to call, or a null callback to stop reporting
+     *  @see Event::deadline
+     */
+    void deadline_miss_handler(mbed::Callback<void(int, duration)> handler);
+
+    /** Dispatch lateness of one priority class
+     *
+     *  Only available with events.scheduling-stats.
+     *
+     *  @param priority One of the EQUEUE_PRIORITY values
+     *  @return         Histogram of how late events of that class started,
+     *                  in ticks, or NULL for an unknown class
+     */
+    const struct equeue_lateness *lateness(int priority);
+
+    /** Clear the lateness histograms of all priority classes
+     */
+    void reset_lateness();
+#endif
+
 
 
 #if defined(DOXYGEN_ONLY)
@@ -925,7 +978,7 @@ public:
     MBED_DEPRECATED_SINCE("mbed-os-6.0.0", "Pass a chrono duration, not an integer millisecond count. For example use `5s` rather than `5000`.")
     int call_in(int ms, F f)
     {
-        return call_in(duration(ms), std::move(f));
+        return call_in(std::chrono::milliseconds(ms), std::move(f));
     }
 
     /** Calls an event on the queue after a specified delay
@@ -938,7 +991,7 @@ public:
     MBED_DEPRECATED_SINCE("mbed-os-6.0.0", "Pass a chrono duration, not an integer millisecond count. For example use `5s` rather than `5000`.")
     int call_in(int ms, F f, ArgTs... args)
     {
-        return call_in(duration(ms), std::move(f), args...);
+        return call_in(std::chrono::milliseconds(ms), std::move(f), args...);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -948,7 +1001,7 @@ public:
     MBED_DEPRECATED_SINCE("mbed-os-6.0.0", "Pass a chrono duration, not an integer millisecond count. For example use `5s` rather than `5000`.")
     int call_in(int ms, T *obj, R(T::*method)(ArgTs...), ArgTs... args)
     {
-        return call_in(duration(ms), obj, method, args...);
+        return call_in(std::chrono::milliseconds(ms), obj, method, args...);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -958,7 +1011,7 @@ public:
     MBED_DEPRECATED_SINCE("mbed-os-6.0.0", "Pass a chrono duration, not an integer millisecond count. For example use `5s` rather than `5000`.")
     int call_in(int ms, const T *obj, R(T::*method)(ArgTs...) const, ArgTs... args)
     {
-        return call_in(duration(ms), obj, method, args...);
+        return call_in(std::chrono::milliseconds(ms), obj, method, args...);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -968,7 +1021,7 @@ public:
     MBED_DEPRECATED_SINCE("mbed-os-6.0.0", "Pass a chrono duration, not an integer millisecond count. For example use `5s` rather than `5000`.")
     int call_in(int ms, volatile T *obj, R(T::*method)(ArgTs...) volatile, ArgTs... args)
     {
-        return call_in(duration(ms), obj, method, args...);
+        return call_in(std::chrono::milliseconds(ms), obj, method, args...);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -978,7 +1031,7 @@ public:
     MBED_DEPRECATED_SINCE("mbed-os-6.0.0", "Pass a chrono duration, not an integer millisecond count. For example use `5s` rather than `5000`.")
     int call_in(int ms, const volatile T *obj, R(T::*method)(ArgTs...) const volatile, ArgTs... args)
     {
-        return call_in(duration(ms), obj, method, args...);
+        return call_in(std::chrono::milliseconds(ms), obj, method, args...);
     }
 
     /** Calls an event on the queue periodically
@@ -1082,7 +1135,7 @@ public:
     MBED_DEPRECATED_SINCE("mbed-os-6.0.0", "Pass a chrono duration, not an integer millisecond count. For example use `5s` rather than `5000`.")
     int call_every(int ms, F f)
     {
-        return call_every(duration(ms), std::move(f));
+        return call_every(std::chrono::milliseconds(ms), std::move(f));
     }
 
     /** Calls an event on the queue periodically
@@ -1095,7 +1148,7 @@ public:
     MBED_DEPRECATED_SINCE("mbed-os-6.0.0", "Pass a chrono duration, not an integer millisecond count. For example use `5s` rather than `5000`.")
     int call_every(int ms, F f, ArgTs... args)
     {
-        return call_every(duration(ms), std::move(f), args...);
+        return call_every(std::chrono::milliseconds(ms), std::move(f), args...);
     }
 
     /** Calls an event on the queue periodically
@@ -1105,7 +1158,7 @@ public:
     MBED_DEPRECATED_SINCE("mbed-os-6.0.0", "Pass a chrono duration, not an integer millisecond count. For example use `5s` rather than `5000`.")
     int call_every(int ms, T *obj, R(T::*method)(ArgTs...), ArgTs... args)
     {
-        return call_every(duration(ms), obj, method, args...);
+        return call_every(std::chrono::milliseconds(ms), obj, method, args...);
     }
 
     /** Calls an event on the queue periodically
@@ -1115,7 +1168,7 @@ public:
     MBED_DEPRECATED_SINCE("mbed-os-6.0.0", "Pass a chrono duration, not an integer millisecond count. For example use `5s` rather than `5000`.")
     int call_every(int ms, const T *obj, R(T::*method)(ArgTs...) const, ArgTs... args)
     {
-        return call_every(duration(ms), obj, method, args...);
+        return call_every(std::chrono::milliseconds(ms), obj, method, args...);
     }
 
     /** Calls an event on the queue periodically
@@ -1125,7 +1178,7 @@ public:
     MBED_DEPRECATED_SINCE("mbed-os-6.0.0", "Pass a chrono duration, not an integer millisecond count. For example use `5s` rather than `5000`.")
     int call_every(int ms, volatile T *obj, R(T::*method)(ArgTs...) volatile, ArgTs... args)
     {
-        return call_every(duration(ms), obj, method, args...);
+        return call_every(std::chrono::milliseconds(ms), obj, method, args...);
     }
 
     /** Calls an event on the queue periodically
@@ -1135,7 +1188,7 @@ public:
     MBED_DEPRECATED_SINCE("mbed-os-6.0.0", "Pass a chrono duration, not an integer millisecond count. For example use `5s` rather than `5000`.")
     int call_every(int ms, const volatile T *obj, R(T::*method)(ArgTs...) const volatile, ArgTs... args)
     {
-        return call_every(duration(ms), obj, method, args...);
+        return call_every(std::chrono::milliseconds(ms), obj, method, args...);
     }
 
     /** Creates an event bound to the event queue
@@ -1403,8 +1456,16 @@ protected:
     friend class Event;
     template <typename F, typename A>
     friend class UserAllocatedEvent;
+    template <unsigned N>
+    friend class EdgeCapture;
+    friend class Coroutine;
     struct equeue _equeue;
     mbed::Callback<void(int)> _update;
+#if EQUEUE_SCHEDULING_STATS
+    mbed::Callback<void(int, duration)> _deadline_miss;
+
+    static void deadline_miss_thunk(void *data, int id, int lateness);
+#endif
 
     // Function attributes
     template <typename F>
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2026 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef STATIC_EVENT_QUEUE_H
+#define STATIC_EVENT_QUEUE_H
+
+#include "events/EventQueue.h"
+
+namespace events {
+/**
+ * \addtogroup events-public-api
+ * @{
+ */
+
+/**
+ * \defgroup events_StaticEventQueue StaticEventQueue class
+ * @{
+ */
+
+/** StaticEventQueue
+ *
+ *  Event queue with a compile time number of fixed-size event slots.
+ *
+ *  The slots are stored in the object itself, so a StaticEventQueue never
+ *  touches the heap. Every event posted with call, call_in or call_every
+ *  occupies exactly one slot regardless of the size of its callable, which
+ *  keeps the equeue free list to a single size class: allocating and
+ *  releasing a slot is O(1) and the buffer can not fragment. Posting a
+ *  callable larger than MaxCallableSize fails to compile instead of
+ *  returning 0 at runtime.
+ *
+ *  high_water_mark() reports the most slots that were ever in use, which
+ *  gives the exact N to use once the application has been exercised.
+ *
+ *  @tparam N                Number of event slots
+ *  @tparam MaxCallableSize  Largest callable, in bytes, that fits in a slot
+ *                           including its bound arguments (defaults to the
+ *                           size of a Callback)
+ *
+ * Usage:
+ * @code
+ *  #include "mbed.h"
+ *
+ *  void handler(int data) { ... }
+ *
+ *  // 8 events with room for a function pointer and two ints each
+ *  static StaticEventQueue<8, 3 * sizeof(void *)> queue;
+ *
+ *  int main()
+ *  {
+ *    queue.call(handler, 1);
+ *    queue.call_every(100ms, handler, 2);
+ *
+ *    queue.dispatch_forever();
+ *  }
+ * @endcode
+ *
+ *  @note Events posted through the EventQueue base class or an Event object
+ *        are sized by their own callable and defeat the single size class,
+ *        prefer the calls of this class.
+ */
+template <unsigned N, size_t MaxCallableSize = sizeof(mbed::Callback<void()>)>
+class StaticEventQueue : public EventQueue {
+    static_assert(N > 0, "StaticEventQueue needs at least one slot");
+
+public:
+    /** Size of one slot in bytes, the equeue event header included
+     */
+    static constexpr size_t slot_size =
+        (sizeof(struct equeue_event) + MaxCallableSize + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+
+    /** Create a StaticEventQueue
+     */
+    StaticEventQueue()
+        : EventQueue(sizeof(_slots), _slots)
+    {
+    }
+
+    /** Number of event slots
+     *
+     *  @return         N
+     */
+    static constexpr unsigned capacity()
+    {
+        return N;
+    }
+
+    /** Most slots that were in use at the same time since construction
+     *
+     *  Slots are carved from the buffer in order and only reused afterwards,
+     *  so the part of the buffer that was ever handed out is the peak.
+     *
+     *  @return         Number of slots, at most N
+     */
+    unsigned high_water_mark() const
+    {
+        return (unsigned)(((unsigned char *)_equeue.slab.data - (unsigned char *)_equeue.buffer) / slot_size);
+    }
+
+    /** Calls an event on the queue
+     *  @see                    EventQueue::call
+     *  @param f                Function to execute in the context of the dispatch loop
+     *  @return                 A unique ID that represents the posted event and can
+     *                          be passed to cancel, or an ID of 0 if all slots are in use.
+     */
+    template <typename F>
+    int call(F f)
+    {
+        return post_slot(std::move(f), -1, -1);
+    }
+
+    /** Calls an event on the queue
+     *  @see                    EventQueue::call
+     *  @param f                Function to execute in the context of the dispatch loop
+     *  @param args             Arguments to pass to the callback
+     */
+    template <typename F, typename... ArgTs>
+    int call(F f, ArgTs... args)
+    {
+        return call(context<F, ArgTs...>(std::move(f), args...));
+    }
+
+    /** Calls an event on the queue
+     *  @see EventQueue::call
+     */
+    template <typename T, typename R, typename... ArgTs>
+    int call(T *obj, R(T::*method)(ArgTs...), ArgTs... args)
+    {
+        return call(mbed::callback(obj, method), args...);
+    }
+
+    /** Calls an event on the queue
+     *  @see EventQueue::call
+     */
+    template <typename T, typename R, typename... ArgTs>
+    int call(const T *obj, R(T::*method)(ArgTs...) const, ArgTs... args)
+    {
+        return call(mbed::callback(obj, method), args...);
+    }
+
+    /** Calls an event on the queue after a specified delay
+     *  @see                    EventQueue::call_in
+     *  @param ms               Time to delay
+     *  @param f                Function to execute in the context of the dispatch loop
+     *  @return                 A unique ID that represents the posted event and can
+     *                          be passed to cancel, or an ID of 0 if all slots are in use.
+     */
+    template <typename F>
+    int call_in(duration ms, F f)
+    {
+        return post_slot(std::move(f), ms.count(), -1);
+    }
+
+    /** Calls an event on the queue after a specified delay
+     *  @see EventQueue::call_in
+     */
+    template <typename F, typename... ArgTs>
+    int call_in(duration ms, F f, ArgTs... args)
+    {
+        return call_in(ms, context<F, ArgTs...>(std::move(f), args...));
+    }
+
+    /** Calls an event on the queue after a specified delay
+     *  @see EventQueue::call_in
+     */
+    template <typename T, typename R, typename... ArgTs>
+    int call_in(duration ms, T *obj, R(T::*method)(ArgTs...), ArgTs... args)
+    {
+        return call_in(ms, mbed::callback(obj, method), args...);
+    }
+
+    /** Calls an event on the queue after a specified delay
+     *  @see EventQueue::call_in
+     */
+    template <typename T, typename R, typename... ArgTs>
+    int call_in(duration ms, const T *obj, R(T::*method)(ArgTs...) const, ArgTs... args)
+    {
+        return call_in(ms, mbed::callback(obj, method), args...);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see                    EventQueue::call_every
+     *  @param ms               Period of the event
+     *  @param f                Function to execute in the context of the dispatch loop
+     *  @return                 A unique ID that represents the posted event and can
+     *                          be passed to cancel, or an ID of 0 if all slots are in use.
+     */
+    template <typename F>
+    int call_every(duration ms, F f)
+    {
+        return post_slot(std::move(f), ms.count(), ms.count());
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename F, typename... ArgTs>
+    int call_every(duration ms, F f, ArgTs... args)
+    {
+        return call_every(ms, context<F, ArgTs...>(std::move(f), args...));
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename... ArgTs>
+    int call_every(duration ms, T *obj, R(T::*method)(ArgTs...), ArgTs... args)
+    {
+        return call_every(ms, mbed::callback(obj, method), args...);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename... ArgTs>
+    int call_every(duration ms, const T *obj, R(T::*method)(ArgTs...) const, ArgTs... args)
+    {
+        return call_every(ms, mbed::callback(obj, method), args...);
+    }
+
+private:
+    template <typename F>
+    int post_slot(F f, int delay, int period)
+    {
+        static_assert(sizeof(F) <= MaxCallableSize,
+                      "Callable does not fit in a StaticEventQueue slot, increase MaxCallableSize");
+
+        // Always ask for a full slot so every chunk in the free list has the same size
+        void *p = equeue_alloc(&_equeue, MaxCallableSize);
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(std::move(f));
+        if (delay >= 0) {
+            equeue_event_delay(e, delay);
+        }
+        equeue_event_period(e, period);
+        equeue_event_dtor(e, &EventQueue::function_dtor<F>);
+        return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
+    }
+
+    alignas(void *) unsigned char _slots[N * slot_size];
+};
+
+/** @}*/
+
+/** @}*/
+
+}
+
+#endif
@@ -210,7 +210,8 @@ public:
 
     /** Configure the delay of an event
      *
-     *  @param delay    Millisecond delay before dispatching the event
+     *  @param delay    Millisecond delay before dispatching the event,
+     *                  microseconds with events.use-us-tick
      */
     void delay(int delay)
     {
@@ -218,9 +219,20 @@ public:
         _delay = delay;
     }
 
+    /** Configure the delay of an event
+     *
+     *  @param delay    Delay before dispatching the event, expressed as a
+     *                  Chrono duration. E.g. delay(50ms)
+     */
+    void delay(EventQueue::duration delay)
+    {
+        this->delay(delay.count());
+    }
+
     /** Configure the period of an event
      *
-     *  @param period   Millisecond period for repeatedly dispatching an event
+     *  @param period   Millisecond period for repeatedly dispatching an event,
+     *                  microseconds with events.use-us-tick
      */
     void period(int period)
     {
@@ -228,6 +240,40 @@ public:
         _period = period;
     }
 
+    /** Configure the period of an event
+     *
+     *  @param period   Period for repeatedly dispatching an event, expressed
+     *                  as a Chrono duration. E.g. period(200ms)
+     */
+    void period(EventQueue::duration period)
+    {
+        this->period(period.count());
+    }
+
+    /** Configure the priority class of an event
+     *
+     *  @param priority One of the EQUEUE_PRIORITY values, decides the order
+     *                  among events that are due at the same time
+     */
+    void priority(int priority)
+    {
+        MBED_ASSERT(!_post_ref);
+        equeue_event_priority(&_e + 1, priority);
+    }
+
+#if EQUEUE_SCHEDULING_STATS
+    /** Configure the deadline of an event
+     *
+     *  @param deadline Longest the event may start after its target time
+     *                  before it counts as a deadline miss, 0 for none
+     */
+    void deadline(EventQueue::duration deadline)
+    {
+        MBED_ASSERT(!_post_ref);
+        equeue_event_deadline(&_e + 1, deadline.count());
+    }
+#endif
+
     /** Cancels posted event
      *
      *  Attempts to cancel posted event. It is not safe to call
@@ -291,7 +337,7 @@ private:
 
     constexpr static equeue_event get_default_equeue_event()
     {
-        return equeue_event{ 0, 0, 0, NULL, NULL, NULL, 0, -1, &UserAllocatedEvent::event_dtor, NULL };
+        return equeue_event{ 0, 0, 0, EQUEUE_PRIORITY_NORMAL, NULL, NULL, NULL, 0, -1, &UserAllocatedEvent::event_dtor, NULL };
     }
 
 public:
@@ -35,6 +35,54 @@ extern "C" {
  * @{
  */
 
+// Pending events are kept in a sorted list by default. With
+// EQUEUE_PAIRING_HEAP set (events.pairing-heap config option) they are kept
+// in a pairing heap instead, trading 8 bytes per event for O(log n) post and
+// cancel.
+#ifndef EQUEUE_PAIRING_HEAP
+#ifdef MBED_CONF_EVENTS_PAIRING_HEAP
+#define EQUEUE_PAIRING_HEAP MBED_CONF_EVENTS_PAIRING_HEAP
+#else
+#define EQUEUE_PAIRING_HEAP 0
+#endif
+#endif
+
+// Dispatch lateness histograms and per-event deadlines, enabled by
+// EQUEUE_SCHEDULING_STATS (events.scheduling-stats config option). Costs 4
+// bytes per event and 60 bytes per priority class in every queue.
+#ifndef EQUEUE_SCHEDULING_STATS
+#ifdef MBED_CONF_EVENTS_SCHEDULING_STATS
+#define EQUEUE_SCHEDULING_STATS MBED_CONF_EVENTS_SCHEDULING_STATS
+#else
+#define EQUEUE_SCHEDULING_STATS 0
+#endif
+#endif
+
+// Default of equeue_coalesce for new queues, taken from the
+// events.coalesce-periodic config option
+#ifndef EQUEUE_COALESCE_PERIODIC
+#ifdef MBED_CONF_EVENTS_COALESCE_PERIODIC
+#define EQUEUE_COALESCE_PERIODIC MBED_CONF_EVENTS_COALESCE_PERIODIC
+#else
+#define EQUEUE_COALESCE_PERIODIC 0
+#endif
+#endif
+
+// Event priority classes
+//
+// Among the events that are due when the dispatch loop wakes up, higher
+// priority classes run first. Events of the same class keep their target
+// time and posting order. Priorities never preempt a running event and
+// never make an event run before its target time.
+#define EQUEUE_PRIORITY_LOW      -1
+#define EQUEUE_PRIORITY_NORMAL    0
+#define EQUEUE_PRIORITY_HIGH      1
+#define EQUEUE_PRIORITY_CRITICAL  2
+#define EQUEUE_PRIORITIES         4
+
+// Number of log2 buckets of a lateness histogram
+#define EQUEUE_LATENESS_BUCKETS 12
+
 // The minimum size of an event
 // This size is guaranteed to fit events created by event_call
 #define EQUEUE_EVENT_SIZE (sizeof(struct equeue_event) + 2*sizeof(void*))
@@ -44,6 +92,7 @@ struct equeue_event {
     unsigned size;
     uint16_t generation;
     uint8_t id;
+    int8_t priority;
 
     struct equeue_event *next;
     struct equeue_event *sibling;
@@ -54,16 +103,38 @@ struct equeue_event {
     void (*dtor)(void *);
 
     void (*cb)(void *);
+#if EQUEUE_PAIRING_HEAP
+    struct equeue_event *child;
+    unsigned seq;
+#endif
+#if EQUEUE_SCHEDULING_STATS
+    int deadline;
+#endif
     // data follows
 };
 
+// Dispatch lateness of one priority class, in ticks past the target time
+// at which an event started. Bucket 0 counts events that started on time,
+// bucket i those that were 2^(i-1) to 2^i - 1 ticks late, the last bucket
+// also takes everything later.
+struct equeue_lateness {
+    unsigned count;
+    unsigned missed;
+    unsigned max;
+    unsigned buckets[EQUEUE_LATENESS_BUCKETS];
+};
+
 // Event queue structure
 typedef struct equeue {
     struct equeue_event *queue;
     unsigned tick;
+#if EQUEUE_PAIRING_HEAP
+    unsigned seq;
+#endif
 
     uint16_t generation;
     bool break_requested;
+    bool coalesce;
 
     unsigned char *buffer;
     unsigned npw2;
@@ -81,6 +152,12 @@ typedef struct equeue {
         void *timer;
     } background;
 
+#if EQUEUE_SCHEDULING_STATS
+    struct equeue_lateness lateness[EQUEUE_PRIORITIES];
+    void (*deadline_miss)(void *data, int id, int lateness);
+    void *deadline_miss_data;
+#endif
+
     equeue_sema_t eventsema;
     equeue_mutex_t queuelock;
     equeue_mutex_t memlock;
@@ -163,9 +240,19 @@ void equeue_dealloc(equeue_t *queue, void *event);
 // equeue_event_delay  - Millisecond delay before dispatching an event
 // equeue_event_period - Millisecond period for repeating dispatching an event
 // equeue_event_dtor   - Destructor to run when the event is deallocated
+// equeue_event_priority - Priority class, one of the EQUEUE_PRIORITY values,
+//                         EQUEUE_PRIORITY_NORMAL by default
+// equeue_event_deadline - Most ticks the event may start after its target
+//                         time, 0 for no deadline (the default). Ticks are
+//                         milliseconds, or microseconds with EQUEUE_TICK_US.
+//                         Only with EQUEUE_SCHEDULING_STATS
 void equeue_event_delay(void *event, int ms);
 void equeue_event_period(void *event, int ms);
 void equeue_event_dtor(void *event, void (*dtor)(void *));
+void equeue_event_priority(void *event, int priority);
+#if EQUEUE_SCHEDULING_STATS
+void equeue_event_deadline(void *event, int ticks);
+#endif
 
 // Post an event onto the event queue
 //
@@ -239,6 +326,45 @@ int equeue_timeleft(equeue_t *q, int id);
 //
 int equeue_timeleft_user_allocated(equeue_t *q, void *event);
 
+#if EQUEUE_SCHEDULING_STATS
+// Scheduling statistics
+//
+// Every dispatched event records how late it started into the lateness
+// histogram of its priority class. An event with a deadline that starts
+// more than its deadline after its target counts as missed and is reported
+// to the deadline miss callback, from the dispatch loop right before the
+// event runs. The callback gets the event's id (0 for user allocated
+// events) and its lateness in ticks, like the lateness histograms:
+// milliseconds, or microseconds with EQUEUE_TICK_US.
+//
+// The statistics are only updated by the dispatch loop, reading them from
+// another context may see a partial update.
+const struct equeue_lateness *equeue_lateness_stats(equeue_t *queue, int priority);
+void equeue_lateness_reset(equeue_t *queue);
+void equeue_deadline_miss(equeue_t *queue,
+                          void (*cb)(void *data, int id, int lateness), void *data);
+#endif
+
+// Coalesce periodic events
+//
+// When enabled, every periodic event is due on multiples of its own period
+// counted from tick 0, instead of on multiples counted from when it was
+// posted. Events whose periods divide one another then fall on the same
+// ticks, share a slot in the queue and run in the same dispatch, so the
+// dispatch loop wakes up less often. Enabling it moves the first dispatch
+// of a periodic event to the grid point at or before its requested time, or
+// to the next one if that is already in the past. A late periodic event
+// skips the periods it missed and returns to its grid instead of running
+// again right away and shifting its phase.
+//
+// The setting is read whenever a periodic event is queued, so it applies to
+// events posted after the call and also to periodic events already queued,
+// which move onto their grid the next time they are queued again after
+// running. Disabling it leaves events where they are, their next periods
+// are then counted from there. Disabled by default, see
+// EQUEUE_COALESCE_PERIODIC.
+void equeue_coalesce(equeue_t *queue, bool enable);
+
 // Background an event queue onto a single-shot timer
 //
 // The provided update function will be called to indicate when the queue
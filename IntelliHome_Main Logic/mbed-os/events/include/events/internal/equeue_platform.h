@@ -54,12 +54,33 @@ extern "C" {
 #endif
 
 
+// Tick resolution
+//
+// By default a tick is a millisecond. With EQUEUE_TICK_US set (events.use-us-tick
+// config option) a tick is a microsecond, and every delay, period and timeout
+// passed to or returned by the equeue functions counts microseconds. The tick
+// then wraps after about 71 minutes, so delays must stay below 2^31 us.
+#ifndef EQUEUE_TICK_US
+#ifdef MBED_CONF_EVENTS_USE_US_TICK
+#define EQUEUE_TICK_US MBED_CONF_EVENTS_USE_US_TICK
+#else
+#define EQUEUE_TICK_US 0
+#endif
+#endif
+
+#if EQUEUE_TICK_US
+#define EQUEUE_TICKS_PER_MS 1000
+#else
+#define EQUEUE_TICKS_PER_MS 1
+#endif
+
+
 // Platform millisecond counter
 //
-// Return a tick that represents the number of milliseconds that have passed
-// since an arbitrary point in time. The granularity does not need to be at
-// the millisecond level, however the accuracy of the equeue library is
-// limited by the accuracy of this tick.
+// Return a tick that represents the number of milliseconds (microseconds
+// with EQUEUE_TICK_US) that have passed since an arbitrary point in time.
+// The granularity does not need to be at the tick level, however the
+// accuracy of the equeue library is limited by the accuracy of this tick.
 //
 // Must intentionally overflow to 0 after 2^32-1
 void equeue_tick_init(void);
@@ -142,7 +163,8 @@ typedef int equeue_sema_t;
 // immediately if equeue_sema_signal had been called since the last
 // equeue_sema_wait. The equeue_sema_wait returns true if it detected that
 // equeue_sema_signal had been called. If ms is negative, equeue_sema_wait
-// will wait for a signal indefinitely.
+// will wait for a signal indefinitely. Like the tick, ms counts
+// microseconds with EQUEUE_TICK_US.
 int equeue_sema_create(equeue_sema_t *sema);
 void equeue_sema_destroy(equeue_sema_t *sema);
 void equeue_sema_signal(equeue_sema_t *sema);
@@ -21,6 +21,9 @@
 #include "events/EventQueue.h"
 #include "events/Event.h"
 #include "events/UserAllocatedEvent.h"
+#include "events/StaticEventQueue.h"
+#include "events/EdgeCapture.h"
+#include "events/Coroutine.h"
 
 #include "events/mbed_shared_queues.h"
 
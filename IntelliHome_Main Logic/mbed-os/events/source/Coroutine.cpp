@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "events/Coroutine.h"
+#include "platform/mbed_atomic.h"
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
+
+namespace events {
+
+static const struct equeue_event default_event = {
+    0, 0, 0, EQUEUE_PRIORITY_NORMAL, NULL, NULL, NULL, 0, -1, NULL, NULL
+};
+
+Coroutine::Coroutine(EventQueue *queue)
+    : _co_line(-1), _equeue(&queue->_equeue), _pending(false), _armed(false),
+      _timed_out(false), _edge_time(0), _received(0),
+#if DEVICE_INTERRUPTIN
+      _pin(NULL), _rising(false),
+#endif
+#if DEVICE_SERIAL
+      _serial(NULL), _rx(NULL), _rx_size(0),
+#endif
+      _release(NULL), _pool(NULL)
+{
+    _resume.e = default_event;
+    _resume.self = this;
+    _timer.e = default_event;
+    _timer.self = this;
+}
+
+Coroutine::~Coroutine()
+{
+    core_util_atomic_store_bool(&_armed, false);
+    detach();
+    equeue_cancel_user_allocated(_equeue, &_timer.e);
+    if (core_util_atomic_load_bool(&_pending)) {
+        equeue_cancel_user_allocated(_equeue, &_resume.e);
+    }
+}
+
+bool Coroutine::start()
+{
+    if (!done()) {
+        return false;
+    }
+    _co_line = 0;
+    wake();
+    return true;
+}
+
+bool Coroutine::done() const
+{
+    return _co_line == -1;
+}
+
+void Coroutine::signal()
+{
+    complete();
+}
+
+void Coroutine::sleep_for(EventQueue::duration ms)
+{
+    arm(ms);
+}
+
+void Coroutine::wait_signal(EventQueue::duration timeout)
+{
+    arm(timeout);
+}
+
+#if DEVICE_INTERRUPTIN
+void Coroutine::pin_edge(mbed::InterruptIn &pin, bool rising, EventQueue::duration timeout)
+{
+    arm(timeout);
+    _pin = &pin;
+    _rising = rising;
+    if (rising) {
+        pin.rise(mbed::callback(this, &Coroutine::on_edge));
+    } else {
+        pin.fall(mbed::callback(this, &Coroutine::on_edge));
+    }
+}
+
+void Coroutine::on_edge()
+{
+    uint32_t now = ticker_read(get_us_ticker_data());
+    if (core_util_atomic_load_bool(&_armed)) {
+        _edge_time = now;
+        complete();
+    }
+}
+#endif
+
+#if DEVICE_SERIAL
+void Coroutine::uart_bytes(mbed::UnbufferedSerial &serial, void *buffer, size_t size, EventQueue::duration timeout)
+{
+    _received = 0;
+    _rx = static_cast<uint8_t *>(buffer);
+    _rx_size = size;
+    arm(timeout);
+    _serial = &serial;
+    serial.attach(mbed::callback(this, &Coroutine::on_rx), mbed::UnbufferedSerial::RxIrq);
+}
+
+void Coroutine::on_rx()
+{
+    while (_received < _rx_size && _serial->readable()) {
+        _serial->read(&_rx[_received++], 1);
+    }
+    if (_received == _rx_size) {
+        // Leave further bytes to the next reader instead of draining them
+        _serial->attach(nullptr, mbed::UnbufferedSerial::RxIrq);
+        _serial = NULL;
+        complete();
+    }
+}
+#endif
+
+void Coroutine::arm(EventQueue::duration timeout)
+{
+    _timed_out = false;
+    core_util_atomic_store_bool(&_armed, true);
+    if (timeout.count() >= 0) {
+        _timer.e.target = timeout.count();
+        _timer.e.period = -1;
+        equeue_post_user_allocated(_equeue, &Coroutine::timer_thunk, &_timer.e);
+    }
+}
+
+bool Coroutine::complete()
+{
+    // Exactly one of the timeout and the waited for source wins
+    if (!core_util_atomic_exchange_bool(&_armed, false)) {
+        return false;
+    }
+    wake();
+    return true;
+}
+
+void Coroutine::wake()
+{
+    if (!core_util_atomic_exchange_bool(&_pending, true)) {
+        _resume.e.target = 0;
+        _resume.e.period = -1;
+        equeue_post_user_allocated(_equeue, &Coroutine::resume_thunk, &_resume.e);
+    }
+}
+
+void Coroutine::detach()
+{
+#if DEVICE_INTERRUPTIN
+    if (_pin) {
+        if (_rising) {
+            _pin->rise(nullptr);
+        } else {
+            _pin->fall(nullptr);
+        }
+        _pin = NULL;
+    }
+#endif
+#if DEVICE_SERIAL
+    if (_serial) {
+        _serial->attach(nullptr, mbed::UnbufferedSerial::RxIrq);
+        _serial = NULL;
+    }
+#endif
+}
+
+void Coroutine::timer_thunk(void *p)
+{
+    Coroutine *self = *static_cast<Coroutine **>(p);
+    // The body runs later from this same dispatch loop, after the flag is set
+    if (self->complete()) {
+        self->_timed_out = true;
+    }
+}
+
+void Coroutine::resume_thunk(void *p)
+{
+    Coroutine *self = *static_cast<Coroutine **>(p);
+    core_util_atomic_store_bool(&self->_pending, false);
+
+    // The wait is over, whichever way it completed
+    self->detach();
+    equeue_cancel_user_allocated(self->_equeue, &self->_timer.e);
+
+    self->run();
+    if (self->done() && self->_release) {
+        self->_release(self, self->_pool);
+    }
+}
+
+}
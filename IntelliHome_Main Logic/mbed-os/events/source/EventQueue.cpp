@@ -48,7 +48,7 @@ void EventQueue::dispatch_for(duration ms)
 
 void EventQueue::dispatch(int ms)
 {
-    return equeue_dispatch(&_equeue, ms);
+    return equeue_dispatch(&_equeue, ms < 0 ? ms : ms * EQUEUE_TICKS_PER_MS);
 }
 
 void EventQueue::dispatch_forever()
@@ -98,6 +98,11 @@ void EventQueue::background(Callback<void(int)> update)
     }
 }
 
+void EventQueue::coalesce_periodic(bool enable)
+{
+    equeue_coalesce(&_equeue, enable);
+}
+
 int EventQueue::chain(EventQueue *target)
 {
     if (target) {
@@ -106,4 +111,33 @@ int EventQueue::chain(EventQueue *target)
         return equeue_chain(&_equeue, 0);
     }
 }
+
+#if EQUEUE_SCHEDULING_STATS
+void EventQueue::deadline_miss_handler(Callback<void(int, duration)> handler)
+{
+    // Same ordering as background(), never leave the old callback half replaced
+    equeue_deadline_miss(&_equeue, 0, 0);
+
+    _deadline_miss = handler;
+
+    if (_deadline_miss) {
+        equeue_deadline_miss(&_equeue, &EventQueue::deadline_miss_thunk, &_deadline_miss);
+    }
+}
+
+void EventQueue::deadline_miss_thunk(void *data, int id, int lateness)
+{
+    (*static_cast<Callback<void(int, duration)> *>(data))(id, duration(lateness));
+}
+
+const struct equeue_lateness *EventQueue::lateness(int priority)
+{
+    return equeue_lateness_stats(&_equeue, priority);
+}
+
+void EventQueue::reset_lateness()
+{
+    equeue_lateness_reset(&_equeue);
+}
+#endif
 }
@@ -28,6 +28,7 @@
 // for user allocated events use event id to track event state
 enum {
     EQUEUE_USER_ALLOCATED_EVENT_STATE_INPROGRESS = 1,
+    EQUEUE_USER_ALLOCATED_EVENT_STATE_DISPATCHING = 2,  // callback running, not queued
     EQUEUE_USER_ALLOCATED_EVENT_STATE_DONE = 0          // event canceled or dispatching done
 };
 
@@ -55,6 +56,104 @@ static inline void equeue_incid(equeue_t *q, struct equeue_event *e)
     }
 }
 
+#if EQUEUE_PAIRING_HEAP
+// Pairing heap of pending events, q->queue is the root. Events are ordered by
+// target, events with the same target by posting order. Each event keeps its
+// children in a list through child/next, ref points at the pointer that
+// references the event so it can be unlinked in place.
+static inline bool equeue_heap_before(struct equeue_event *a, struct equeue_event *b)
+{
+    int diff = equeue_tickdiff(a->target, b->target);
+    return diff < 0 || (diff == 0 && (int)(a->seq - b->seq) < 0);
+}
+
+// link two detached heaps, the later root becomes the first child of the other
+static struct equeue_event *equeue_heap_meld(struct equeue_event *a, struct equeue_event *b)
+{
+    if (!a) {
+        return b;
+    }
+    if (!b) {
+        return a;
+    }
+
+    if (equeue_heap_before(b, a)) {
+        struct equeue_event *t = a;
+        a = b;
+        b = t;
+    }
+
+    b->next = a->child;
+    if (b->next) {
+        b->next->ref = &b->next;
+    }
+    a->child = b;
+    b->ref = &a->child;
+    return a;
+}
+
+// combine a list of sibling heaps into one, melding pairs left to right
+// and then the pairs right to left
+static struct equeue_event *equeue_heap_merge_pairs(struct equeue_event *list)
+{
+    struct equeue_event *pairs = 0;
+    while (list) {
+        struct equeue_event *a = list;
+        struct equeue_event *b = a->next;
+        list = b ? b->next : 0;
+
+        a->next = 0;
+        if (b) {
+            b->next = 0;
+        }
+        struct equeue_event *m = equeue_heap_meld(a, b);
+        m->next = pairs;
+        pairs = m;
+    }
+
+    struct equeue_event *root = 0;
+    while (pairs) {
+        struct equeue_event *m = pairs;
+        pairs = m->next;
+        m->next = 0;
+        root = equeue_heap_meld(root, m);
+    }
+    return root;
+}
+
+static void equeue_heap_insert(equeue_t *q, struct equeue_event *e)
+{
+    e->next = 0;
+    e->sibling = 0;
+    e->child = 0;
+    e->seq = q->seq++;
+
+    q->queue = equeue_heap_meld(q->queue, e);
+    q->queue->ref = &q->queue;
+}
+
+static void equeue_heap_remove(equeue_t *q, struct equeue_event *e)
+{
+    struct equeue_event *children = equeue_heap_merge_pairs(e->child);
+    e->child = 0;
+
+    if (q->queue == e) {
+        q->queue = children;
+    } else {
+        *e->ref = e->next;
+        if (e->next) {
+            e->next->ref = e->ref;
+        }
+        e->next = 0;
+        q->queue = equeue_heap_meld(q->queue, children);
+    }
+
+    if (q->queue) {
+        q->queue->ref = &q->queue;
+    }
+}
+#endif
+
 
 // equeue lifetime management
 int equeue_create(equeue_t *q, size_t size)
@@ -96,15 +195,25 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer)
     q->slab.data = q->buffer;
 
     q->queue = 0;
+#if EQUEUE_PAIRING_HEAP
+    q->seq = 0;
+#endif
     equeue_tick_init();
     q->tick = equeue_tick();
     q->generation = 0;
     q->break_requested = false;
+    q->coalesce = EQUEUE_COALESCE_PERIODIC;
 
     q->background.active = false;
     q->background.update = 0;
     q->background.timer = 0;
 
+#if EQUEUE_SCHEDULING_STATS
+    memset(q->lateness, 0, sizeof(q->lateness));
+    q->deadline_miss = 0;
+    q->deadline_miss_data = 0;
+#endif
+
     // initialize platform resources
     int err;
     err = equeue_sema_create(&q->eventsema);
@@ -128,6 +237,15 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer)
 void equeue_destroy(equeue_t *q)
 {
     // call destructors on pending events
+#if EQUEUE_PAIRING_HEAP
+    while (q->queue) {
+        struct equeue_event *e = q->queue;
+        equeue_heap_remove(q, e);
+        if (e->dtor) {
+            e->dtor(e + 1);
+        }
+    }
+#else
     for (struct equeue_event *es = q->queue; es; es = es->next) {
         for (struct equeue_event *e = es->sibling; e; e = e->sibling) {
             if (e->dtor) {
@@ -138,6 +256,7 @@ void equeue_destroy(equeue_t *q)
             es->dtor(es + 1);
         }
     }
+#endif
     // notify background timer
     if (q->background.update) {
         q->background.update(q->background.timer, -1);
@@ -224,6 +343,10 @@ void *equeue_alloc(equeue_t *q, size_t size)
     e->target = 0;
     e->period = -1;
     e->dtor = 0;
+    e->priority = EQUEUE_PRIORITY_NORMAL;
+#if EQUEUE_SCHEDULING_STATS
+    e->deadline = 0;
+#endif
 
     return e + 1;
 }
@@ -250,6 +373,9 @@ void equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
 
     equeue_mutex_lock(&q->queuelock);
 
+#if EQUEUE_PAIRING_HEAP
+    equeue_heap_insert(q, e);
+#else
     // find the event slot
     struct equeue_event **p = &q->queue;
     while (*p && equeue_tickdiff((*p)->target, e->target) < 0) {
@@ -275,6 +401,7 @@ void equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
 
     *p = e;
     e->ref = p;
+#endif
 
     // notify background timer
     if ((q->background.update && q->background.active) &&
@@ -306,6 +433,9 @@ static struct equeue_event *equeue_unqueue_by_address(equeue_t *q, struct equeue
     }
 
     // disentangle from queue
+#if EQUEUE_PAIRING_HEAP
+    equeue_heap_remove(q, e);
+#else
     if (e->sibling) {
         e->sibling->next = e->next;
         if (e->sibling->next) {
@@ -320,6 +450,7 @@ static struct equeue_event *equeue_unqueue_by_address(equeue_t *q, struct equeue
             e->next->ref = e->ref;
         }
     }
+#endif
     equeue_mutex_unlock(&q->queuelock);
     return e;
 }
@@ -347,6 +478,38 @@ static struct equeue_event *equeue_unqueue_by_id(equeue_t *q, int id)
     return e;
 }
 
+// stable partition of expired events by priority class, higher classes first
+static struct equeue_event *equeue_prioritise(struct equeue_event *es)
+{
+    struct equeue_event *heads[EQUEUE_PRIORITIES];
+    struct equeue_event **tails[EQUEUE_PRIORITIES];
+    for (int i = 0; i < EQUEUE_PRIORITIES; i++) {
+        heads[i] = 0;
+        tails[i] = &heads[i];
+    }
+
+    while (es) {
+        struct equeue_event *e = es;
+        es = e->next;
+
+        int i = e->priority - EQUEUE_PRIORITY_LOW;
+        *tails[i] = e;
+        tails[i] = &e->next;
+    }
+
+    struct equeue_event *head = 0;
+    struct equeue_event **tail = &head;
+    for (int i = EQUEUE_PRIORITIES - 1; i >= 0; i--) {
+        if (heads[i]) {
+            *tail = heads[i];
+            tail = tails[i];
+        }
+    }
+    *tail = 0;
+
+    return head;
+}
+
 static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
 {
     equeue_mutex_lock(&q->queuelock);
@@ -357,6 +520,17 @@ static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
         q->tick = target;
     }
 
+#if EQUEUE_PAIRING_HEAP
+    // pop expired events in order, no slots to flatten afterwards
+    struct equeue_event *head = 0;
+    struct equeue_event **tail = &head;
+    while (q->queue && equeue_tickdiff(q->queue->target, target) <= 0) {
+        struct equeue_event *e = q->queue;
+        equeue_heap_remove(q, e);
+        *tail = e;
+        tail = &e->next;
+    }
+#else
     struct equeue_event *head = q->queue;
     struct equeue_event **p = &head;
     while (*p && equeue_tickdiff((*p)->target, target) <= 0) {
@@ -369,6 +543,7 @@ static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
     }
 
     *p = 0;
+#endif
 
     /* we only increment the generation if events have been taken off the queue
      * as this is the only time cancellation may conflict with dequeueing */
@@ -378,6 +553,7 @@ static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
 
     equeue_mutex_unlock(&q->queuelock);
 
+#if !EQUEUE_PAIRING_HEAP
     // reverse and flatten each slot to match insertion order
     struct equeue_event **tail = &head;
     struct equeue_event *ess = head;
@@ -394,8 +570,25 @@ static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
         *tail = prev;
         tail = &es->next;
     }
+#endif
 
-    return head;
+    return equeue_prioritise(head);
+}
+
+// move a periodic event onto the grid of multiples of its period, at or
+// before its target, or to the first grid point that is not in the past
+static void equeue_align(equeue_t *q, struct equeue_event *e, unsigned tick)
+{
+    if (!q->coalesce || e->period <= 0) {
+        return;
+    }
+
+    unsigned period = e->period;
+    e->target -= e->target % period;
+    int behind = equeue_tickdiff(tick, e->target);
+    if (behind > 0) {
+        e->target += ((behind + period - 1) / period) * period;
+    }
 }
 
 int equeue_post(equeue_t *q, void (*cb)(void *), void *p)
@@ -404,6 +597,7 @@ int equeue_post(equeue_t *q, void (*cb)(void *), void *p)
     unsigned tick = equeue_tick();
     e->cb = cb;
     e->target = tick + e->target;
+    equeue_align(q, e, tick);
 
     equeue_enqueue(q, e, tick);
     int id = equeue_event_id(q, e);
@@ -418,6 +612,7 @@ void equeue_post_user_allocated(equeue_t *q, void (*cb)(void *), void *p)
     e->cb = cb;
     e->target = tick + e->target;
     e->id = EQUEUE_USER_ALLOCATED_EVENT_STATE_INPROGRESS;
+    equeue_align(q, e, tick);
 
     equeue_enqueue(q, e, tick);
     equeue_sema_signal(&q->eventsema);
@@ -488,6 +683,11 @@ int equeue_timeleft_user_allocated(equeue_t *q, void *e)
     return ret;
 }
 
+void equeue_coalesce(equeue_t *q, bool enable)
+{
+    q->coalesce = enable;
+}
+
 void equeue_break(equeue_t *q)
 {
     equeue_mutex_lock(&q->queuelock);
@@ -496,6 +696,57 @@ void equeue_break(equeue_t *q)
     equeue_sema_signal(&q->eventsema);
 }
 
+#if EQUEUE_SCHEDULING_STATS
+static void equeue_record_lateness(equeue_t *q, struct equeue_event *e, unsigned tick)
+{
+    int lateness = equeue_tickdiff(tick, e->target);
+    if (lateness < 0) {
+        lateness = 0;
+    }
+
+    struct equeue_lateness *l = &q->lateness[e->priority - EQUEUE_PRIORITY_LOW];
+    int bucket = 0;
+    for (unsigned v = lateness; v && bucket < EQUEUE_LATENESS_BUCKETS - 1; v >>= 1) {
+        bucket++;
+    }
+    l->buckets[bucket]++;
+    l->count++;
+    if ((unsigned)lateness > l->max) {
+        l->max = lateness;
+    }
+
+    if (e->deadline > 0 && lateness > e->deadline) {
+        l->missed++;
+        if (q->deadline_miss) {
+            int id = EQUEUE_IS_USER_ALLOCATED_EVENT(e) ? 0 : equeue_event_id(q, e);
+            q->deadline_miss(q->deadline_miss_data, id, lateness);
+        }
+    }
+}
+
+const struct equeue_lateness *equeue_lateness_stats(equeue_t *q, int priority)
+{
+    if (priority < EQUEUE_PRIORITY_LOW || priority > EQUEUE_PRIORITY_CRITICAL) {
+        return 0;
+    }
+    return &q->lateness[priority - EQUEUE_PRIORITY_LOW];
+}
+
+void equeue_lateness_reset(equeue_t *q)
+{
+    memset(q->lateness, 0, sizeof(q->lateness));
+}
+
+void equeue_deadline_miss(equeue_t *q,
+                          void (*cb)(void *data, int id, int lateness), void *data)
+{
+    equeue_mutex_lock(&q->queuelock);
+    q->deadline_miss = cb;
+    q->deadline_miss_data = data;
+    equeue_mutex_unlock(&q->queuelock);
+}
+#endif
+
 void equeue_dispatch(equeue_t *q, int ms)
 {
     unsigned tick = equeue_tick();
@@ -513,14 +764,28 @@ void equeue_dispatch(equeue_t *q, int ms)
 
             // actually dispatch the callbacks
             void (*cb)(void *) = e->cb;
+            if (EQUEUE_IS_USER_ALLOCATED_EVENT(e)) {
+                e->id = EQUEUE_USER_ALLOCATED_EVENT_STATE_DISPATCHING;
+            }
             if (cb) {
+#if EQUEUE_SCHEDULING_STATS
+                equeue_record_lateness(q, e, equeue_tick());
+#endif
                 cb(e + 1);
             }
 
             // reenqueue periodic events or deallocate
             if (e->period >= 0) {
+                unsigned now = equeue_tick();
                 e->target += e->period;
-                equeue_enqueue(q, e, equeue_tick());
+                equeue_align(q, e, now);
+                equeue_enqueue(q, e, now);
+            } else if (EQUEUE_IS_USER_ALLOCATED_EVENT(e) &&
+                       e->id != EQUEUE_USER_ALLOCATED_EVENT_STATE_DISPATCHING) {
+                // posted again from its own callback, it is queued and stays live
+                if (e->dtor) {
+                    e->dtor(e + 1);
+                }
             } else {
                 if (!EQUEUE_IS_USER_ALLOCATED_EVENT(e)) {
                     equeue_incid(q, e);
@@ -600,6 +865,25 @@ void equeue_event_dtor(void *p, void (*dtor)(void *))
     e->dtor = dtor;
 }
 
+void equeue_event_priority(void *p, int priority)
+{
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    if (priority < EQUEUE_PRIORITY_LOW) {
+        priority = EQUEUE_PRIORITY_LOW;
+    } else if (priority > EQUEUE_PRIORITY_CRITICAL) {
+        priority = EQUEUE_PRIORITY_CRITICAL;
+    }
+    e->priority = priority;
+}
+
+#if EQUEUE_SCHEDULING_STATS
+void equeue_event_deadline(void *p, int ticks)
+{
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    e->deadline = ticks > 0 ? ticks : 0;
+}
+#endif
+
 
 // simple callbacks
 struct ecallback {
@@ -35,8 +35,48 @@
 
 using namespace mbed;
 
+#if MBED_CONF_EVENTS_USE_LOWPOWER_TIMER_TICKER
+
+#define ALIAS_TIMER      LowPowerTimer
+#define ALIAS_TICKER     LowPowerTicker
+#define ALIAS_TIMEOUT    LowPowerTimeout
+#else
+#define ALIAS_TIMER      Timer
+#define ALIAS_TICKER     Ticker
+#define ALIAS_TIMEOUT    Timeout
+#endif
+
 // Ticker operations
-#if MBED_CONF_RTOS_API_PRESENT
+#if EQUEUE_TICK_US
+
+// Microsecond ticks are read from a free running timer, its 64-bit count
+// truncated to 32 bits wraps the way equeue expects. A running Timer keeps
+// deep sleep locked, which the microsecond ticker needs anyway.
+static unsigned equeue_timer[
+     (sizeof(ALIAS_TIMER) + sizeof(unsigned) - 1) / sizeof(unsigned)];
+static bool equeue_timer_started = false;
+
+void equeue_tick_init()
+{
+    static_assert(sizeof(equeue_timer) >= sizeof(ALIAS_TIMER),
+                  "The equeue_timer buffer must fit the class Timer");
+
+    // Shared by every queue, restarting it would move their deadlines
+    core_util_critical_section_enter();
+    if (!equeue_timer_started) {
+        ALIAS_TIMER *timer = new (equeue_timer) ALIAS_TIMER;
+        timer->start();
+        equeue_timer_started = true;
+    }
+    core_util_critical_section_exit();
+}
+
+unsigned equeue_tick()
+{
+    return (unsigned) reinterpret_cast<ALIAS_TIMER *>(equeue_timer)->elapsed_time().count();
+}
+
+#elif MBED_CONF_RTOS_API_PRESENT
 
 #include "rtos/Kernel.h"
 #include "platform/internal/mbed_os_timer.h"
@@ -81,17 +121,6 @@ unsigned equeue_tick()
 
 #else
 
-#if MBED_CONF_EVENTS_USE_LOWPOWER_TIMER_TICKER
-
-#define ALIAS_TIMER      LowPowerTimer
-#define ALIAS_TICKER     LowPowerTicker
-#define ALIAS_TIMEOUT    LowPowerTimeout
-#else
-#define ALIAS_TIMER      Timer
-#define ALIAS_TICKER     Ticker
-#define ALIAS_TIMEOUT    Timeout
-#endif
-
 static volatile unsigned equeue_minutes = 0;
 static unsigned equeue_timer[
      (sizeof(ALIAS_TIMER) + sizeof(unsigned) - 1) / sizeof(unsigned)];
@@ -158,6 +187,9 @@ void equeue_mutex_unlock(equeue_mutex_t *m)
 
 static_assert(sizeof(equeue_sema_t) == sizeof(rtos::EventFlags), "equeue_sema_t / rtos::EventFlags mismatch");
 
+#define EQUEUE_SEMA_SIGNAL  1
+#define EQUEUE_SEMA_TIMEOUT 2
+
 int equeue_sema_create(equeue_sema_t *s)
 {
     new (s) rtos::EventFlags("equeue");
@@ -173,9 +205,33 @@ void equeue_sema_destroy(equeue_sema_t *s)
 void equeue_sema_signal(equeue_sema_t *s)
 {
     rtos::EventFlags *ef = reinterpret_cast<rtos::EventFlags *>(s);
-    ef->set(1);
+    ef->set(EQUEUE_SEMA_SIGNAL);
+}
+
+#if EQUEUE_TICK_US
+static void equeue_sema_timeout(rtos::EventFlags *ef)
+{
+    ef->set(EQUEUE_SEMA_TIMEOUT);
 }
 
+bool equeue_sema_wait(equeue_sema_t *s, int ms)
+{
+    rtos::EventFlags *ef = reinterpret_cast<rtos::EventFlags *>(s);
+
+    // The kernel waits in milliseconds, a timeout ends microsecond waits
+    ALIAS_TIMEOUT timeout;
+    if (ms > 0) {
+        timeout.attach(callback(equeue_sema_timeout, ef), std::chrono::microseconds(ms));
+    }
+
+    uint32_t flags = ef->wait_any(EQUEUE_SEMA_SIGNAL | EQUEUE_SEMA_TIMEOUT,
+                                  ms == 0 ? 0 : osWaitForever);
+    timeout.detach();
+    ef->clear(EQUEUE_SEMA_TIMEOUT);
+
+    return !(flags & osFlagsError) && (flags & EQUEUE_SEMA_SIGNAL);
+}
+#else
 bool equeue_sema_wait(equeue_sema_t *s, int ms)
 {
     if (ms < 0) {
@@ -183,8 +239,9 @@ bool equeue_sema_wait(equeue_sema_t *s, int ms)
     }
 
     rtos::EventFlags *ef = reinterpret_cast<rtos::EventFlags *>(s);
-    return ef->wait_any(1, ms) == 1;
+    return ef->wait_any(EQUEUE_SEMA_SIGNAL, ms) == EQUEUE_SEMA_SIGNAL;
 }
+#endif
 
 #else
 
@@ -213,7 +270,7 @@ bool equeue_sema_wait(equeue_sema_t *s, int ms)
 {
     ALIAS_TIMEOUT timeout;
     if (ms > 0) {
-        timeout.attach_us(callback(equeue_sema_timeout, s), (us_timestamp_t)ms * 1000);
+        timeout.attach_us(callback(equeue_sema_timeout, s), (us_timestamp_t)ms * 1000 / EQUEUE_TICKS_PER_MS);
     }
 
     core_util_critical_section_enter();
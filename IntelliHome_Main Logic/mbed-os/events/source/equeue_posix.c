@@ -34,7 +34,11 @@ unsigned equeue_tick(void)
 {
     struct timeval tv;
     gettimeofday(&tv, 0);
+#if EQUEUE_TICK_US
+    return (unsigned)(tv.tv_sec * 1000000 + tv.tv_usec);
+#else
     return (unsigned)(tv.tv_sec * 1000 + tv.tv_usec / 1000);
+#endif
 }
 
 
@@ -104,9 +108,12 @@ bool equeue_sema_wait(equeue_sema_t *s, int ms)
             struct timeval tv;
             gettimeofday(&tv, 0);
 
+            // ms is in ticks, keep tv_nsec below one second
+            long long nsec = (long long)tv.tv_usec * 1000 +
+                             (long long)ms * (1000000 / EQUEUE_TICKS_PER_MS);
             struct timespec ts = {
-                .tv_sec = ms / 1000 + tv.tv_sec,
-                .tv_nsec = ms * 1000000 + tv.tv_usec * 1000,
+                .tv_sec = tv.tv_sec + nsec / 1000000000,
+                .tv_nsec = nsec % 1000000000,
             };
 
             pthread_cond_timedwait(&s->cond, &s->mutex, &ts);
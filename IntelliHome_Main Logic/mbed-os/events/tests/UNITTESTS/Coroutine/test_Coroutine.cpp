@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include "events/Coroutine.h"
+#include <vector>
+
+using namespace events;
+using namespace std::chrono_literals;
+
+extern "C" unsigned int equeue_global_time;
+
+struct Step {
+    int step;
+    unsigned time;
+    bool timed_out;
+};
+
+// Two sleeps, then a signal wait with a timeout
+class Sequence : public Coroutine {
+public:
+    Sequence(EventQueue *queue, std::vector<Step> *log) : Coroutine(queue), _log(log) {}
+
+    using Coroutine::timed_out;
+
+private:
+    std::vector<Step> *_log;
+
+    void record(int step)
+    {
+        _log->push_back(Step{step, equeue_global_time, timed_out()});
+    }
+
+    void run() override
+    {
+        CO_BEGIN();
+        record(1);
+        CO_AWAIT(sleep_for(10ms));
+        record(2);
+        CO_AWAIT(sleep_for(20ms));
+        record(3);
+        CO_AWAIT(wait_signal(50ms));
+        record(4);
+        CO_END();
+    }
+};
+
+// Sleeps once and counts how many instances finished
+class Sleeper : public Coroutine {
+public:
+    Sleeper(EventQueue *queue, int *finished) : Coroutine(queue), _finished(finished) {}
+
+    ~Sleeper()
+    {
+        destroyed++;
+    }
+
+    static int destroyed;
+
+private:
+    int *_finished;
+
+    void run() override
+    {
+        CO_BEGIN();
+        CO_AWAIT(sleep_for(10ms));
+        (*_finished)++;
+        CO_END();
+    }
+};
+
+int Sleeper::destroyed = 0;
+
+class TestCoroutine : public testing::Test {
+protected:
+    // Static queue: only user allocated events, nothing can be allocated
+    EventQueue queue{0};
+    std::vector<Step> log;
+    Sequence sequence{&queue, &log};
+
+    void SetUp() override
+    {
+        Sleeper::destroyed = 0;
+    }
+};
+
+TEST_F(TestCoroutine, sleeps_in_order)
+{
+    EXPECT_TRUE(sequence.done());
+    unsigned start = equeue_global_time;
+    EXPECT_TRUE(sequence.start());
+    EXPECT_TRUE(log.empty());
+
+    queue.dispatch_for(35ms);
+    ASSERT_EQ(3u, log.size());
+    EXPECT_EQ(start, log[0].time);
+    EXPECT_EQ(start + 10, log[1].time);
+    EXPECT_EQ(start + 30, log[2].time);
+    EXPECT_TRUE(log[1].timed_out);
+    EXPECT_FALSE(sequence.done());
+}
+
+TEST_F(TestCoroutine, signal_before_timeout)
+{
+    sequence.start();
+    queue.dispatch_for(35ms);
+    ASSERT_EQ(3u, log.size());
+
+    unsigned signalled = equeue_global_time;
+    sequence.signal();
+    sequence.signal();
+    queue.dispatch_once();
+    ASSERT_EQ(4u, log.size());
+    EXPECT_EQ(signalled, log[3].time);
+    EXPECT_FALSE(log[3].timed_out);
+    EXPECT_TRUE(sequence.done());
+
+    // The timeout was canceled with the wait
+    queue.dispatch_for(100ms);
+    EXPECT_EQ(4u, log.size());
+}
+
+TEST_F(TestCoroutine, timeout)
+{
+    unsigned start = equeue_global_time;
+    sequence.start();
+    queue.dispatch_for(100ms);
+    ASSERT_EQ(4u, log.size());
+    EXPECT_EQ(start + 80, log[3].time);
+    EXPECT_TRUE(log[3].timed_out);
+    EXPECT_TRUE(sequence.done());
+
+    // Late signals are ignored
+    sequence.signal();
+    queue.dispatch_for(10ms);
+    EXPECT_EQ(4u, log.size());
+}
+
+TEST_F(TestCoroutine, restart)
+{
+    sequence.start();
+    queue.dispatch_for(5ms);
+    EXPECT_FALSE(sequence.start());
+
+    queue.dispatch_for(100ms);
+    ASSERT_TRUE(sequence.done());
+    EXPECT_TRUE(sequence.start());
+    queue.dispatch_for(100ms);
+    EXPECT_EQ(8u, log.size());
+    EXPECT_EQ(1, log[4].step);
+}
+
+TEST_F(TestCoroutine, pool_frames)
+{
+    int finished = 0;
+    CoroutinePool<Sleeper, 2> pool;
+    EXPECT_EQ(2u, pool.capacity());
+
+    EXPECT_NE(nullptr, pool.start(&queue, &finished));
+    EXPECT_NE(nullptr, pool.start(&queue, &finished));
+    EXPECT_EQ(nullptr, pool.start(&queue, &finished));
+    EXPECT_EQ(2u, pool.in_use());
+
+    queue.dispatch_for(20ms);
+    EXPECT_EQ(2, finished);
+    EXPECT_EQ(2, Sleeper::destroyed);
+    EXPECT_EQ(0u, pool.in_use());
+
+    EXPECT_NE(nullptr, pool.start(&queue, &finished));
+    queue.dispatch_for(20ms);
+    EXPECT_EQ(3, finished);
+}
+
+TEST_F(TestCoroutine, destroy_while_waiting)
+{
+    int finished = 0;
+    {
+        CoroutinePool<Sleeper, 1> pool;
+        pool.start(&queue, &finished);
+        queue.dispatch_for(5ms);
+        EXPECT_EQ(1u, pool.in_use());
+    }
+    EXPECT_EQ(1, Sleeper::destroyed);
+
+    // Nothing of the destroyed frame is left in the queue
+    queue.dispatch_for(20ms);
+    EXPECT_EQ(0, finished);
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include "events/EdgeCapture.h"
+#include <new>
+#include <vector>
+
+using namespace events;
+
+#define TEST_RING_SIZE 8
+
+class TestEdgeCapture : public testing::Test {
+protected:
+    // Static queue: only user allocated events, nothing can be allocated
+    EventQueue queue{0};
+    EdgeCapture<TEST_RING_SIZE> capture{&queue, mbed::callback(this, &TestEdgeCapture::on_edges)};
+
+    std::vector<EdgeRecord> edges;
+    int batches = 0;
+    int reentrant = 0;
+
+    void on_edges(const EdgeRecord *records, size_t count)
+    {
+        batches++;
+        edges.insert(edges.end(), records, records + count);
+        while (reentrant > 0) {
+            reentrant--;
+            capture.capture(1000 + reentrant, true);
+        }
+    }
+};
+
+TEST_F(TestEdgeCapture, burst_is_one_event)
+{
+    for (uint32_t i = 0; i < 5; i++) {
+        capture.capture(100 * i, (i & 1) == 0);
+    }
+    EXPECT_EQ(0, batches);
+
+    queue.dispatch_once();
+    EXPECT_EQ(1, batches);
+    ASSERT_EQ(5u, edges.size());
+    for (uint32_t i = 0; i < 5; i++) {
+        EXPECT_EQ(100 * i, edges[i].time_us);
+        EXPECT_EQ((i & 1) == 0, edges[i].rising);
+    }
+    EXPECT_EQ(0u, capture.overruns());
+
+    queue.dispatch_once();
+    EXPECT_EQ(1, batches);
+}
+
+TEST_F(TestEdgeCapture, overrun_drops_newest)
+{
+    for (uint32_t i = 0; i < TEST_RING_SIZE + 3; i++) {
+        capture.capture(i, true);
+    }
+    EXPECT_EQ(3u, capture.overruns());
+
+    queue.dispatch_once();
+    ASSERT_EQ(size_t(TEST_RING_SIZE), edges.size());
+    EXPECT_EQ(uint32_t(TEST_RING_SIZE - 1), edges.back().time_us);
+
+    // the ring is free again
+    capture.capture(42, false);
+    queue.dispatch_once();
+    EXPECT_EQ(42u, edges.back().time_us);
+    EXPECT_EQ(3u, capture.overruns());
+}
+
+TEST_F(TestEdgeCapture, wrap_is_split)
+{
+    for (uint32_t i = 0; i < 6; i++) {
+        capture.capture(i, true);
+    }
+    queue.dispatch_once();
+    EXPECT_EQ(1, batches);
+
+    for (uint32_t i = 6; i < 10; i++) {
+        capture.capture(i, false);
+    }
+    queue.dispatch_once();
+    EXPECT_EQ(3, batches);
+    ASSERT_EQ(10u, edges.size());
+    for (uint32_t i = 0; i < 10; i++) {
+        EXPECT_EQ(i, edges[i].time_us);
+    }
+}
+
+TEST_F(TestEdgeCapture, edge_while_handling)
+{
+    // edges captured while the handler runs post the event again
+    reentrant = 2;
+    capture.capture(1, true);
+    queue.dispatch_once();
+    EXPECT_EQ(1, batches);
+    EXPECT_EQ(1u, edges.size());
+
+    queue.dispatch_once();
+    EXPECT_EQ(2, batches);
+    ASSERT_EQ(3u, edges.size());
+    EXPECT_EQ(1001u, edges[1].time_us);
+    EXPECT_EQ(1000u, edges[2].time_us);
+}
+
+struct RepostingHandler {
+    EdgeCapture<4> *capture;
+    int batches;
+
+    void on_edges(const EdgeRecord *records, size_t count)
+    {
+        if (batches++ == 0) {
+            capture->capture(records[0].time_us + 1, false);
+        }
+    }
+};
+
+TEST_F(TestEdgeCapture, destroy_after_edge_while_handling)
+{
+    // The storage outlives the capture, so a queued event left behind
+    // by the destructor would still run its handler
+    alignas(EdgeCapture<4>) unsigned char storage[sizeof(EdgeCapture<4>)];
+    RepostingHandler handler = { nullptr, 0 };
+    handler.capture = new (storage) EdgeCapture<4>(&queue, mbed::callback(&handler, &RepostingHandler::on_edges));
+
+    handler.capture->capture(1, true);
+    queue.dispatch_once();
+    EXPECT_EQ(1, handler.batches);
+
+    // the edge captured while handling is queued, the destructor cancels it
+    handler.capture->~EdgeCapture();
+    queue.dispatch_once();
+    EXPECT_EQ(1, handler.batches);
+}
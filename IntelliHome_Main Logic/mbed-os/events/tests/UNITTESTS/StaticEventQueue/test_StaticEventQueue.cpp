@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include "events/StaticEventQueue.h"
+
+using namespace events;
+using namespace std::chrono_literals;
+
+#define TEST_SLOTS 4
+// Room for a bound method and one int argument
+#define TEST_CALLABLE_SIZE (sizeof(mbed::Callback<void()>) + sizeof(void *))
+
+static int counter;
+
+static void count_func(void)
+{
+    counter++;
+}
+
+static void add_func(int a, int b)
+{
+    counter += a + b;
+}
+
+class Counter {
+public:
+    int calls = 0;
+
+    void hit(int n)
+    {
+        calls += n;
+    }
+
+    int peek() const
+    {
+        counter++;
+        return calls;
+    }
+};
+
+class TestStaticEventQueue : public testing::Test {
+protected:
+    StaticEventQueue<TEST_SLOTS, TEST_CALLABLE_SIZE> queue;
+
+    virtual void SetUp()
+    {
+        counter = 0;
+    }
+};
+
+TEST_F(TestStaticEventQueue, storage_is_inline)
+{
+    EXPECT_EQ(TEST_SLOTS, queue.capacity());
+    EXPECT_GE(sizeof(queue), TEST_SLOTS * queue.slot_size);
+    EXPECT_EQ(0u, queue.slot_size % sizeof(void *));
+    EXPECT_EQ(0u, queue.high_water_mark());
+}
+
+TEST_F(TestStaticEventQueue, fills_exactly_capacity)
+{
+    for (int i = 0; i < TEST_SLOTS; i++) {
+        EXPECT_NE(0, queue.call(count_func));
+    }
+    EXPECT_EQ(0, queue.call(count_func));
+    EXPECT_EQ(unsigned(TEST_SLOTS), queue.high_water_mark());
+
+    queue.dispatch_once();
+    EXPECT_EQ(TEST_SLOTS, counter);
+}
+
+TEST_F(TestStaticEventQueue, slots_are_reused)
+{
+    // Callables of different sizes all take one slot
+    Counter c;
+    for (int round = 0; round < 10; round++) {
+        EXPECT_NE(0, queue.call(count_func));
+        EXPECT_NE(0, queue.call(add_func, 1, 2));
+        EXPECT_NE(0, queue.call(&c, &Counter::hit, 5));
+        int id = queue.call(count_func);
+        EXPECT_NE(0, id);
+        queue.cancel(id);
+        queue.dispatch_once();
+    }
+    EXPECT_EQ(10 * 4, counter);
+    EXPECT_EQ(10 * 5, c.calls);
+    EXPECT_EQ(unsigned(TEST_SLOTS), queue.high_water_mark());
+}
+
+TEST_F(TestStaticEventQueue, high_water_mark_keeps_peak)
+{
+    queue.call(count_func);
+    queue.call(count_func);
+    queue.dispatch_once();
+    EXPECT_EQ(2u, queue.high_water_mark());
+
+    queue.call(count_func);
+    queue.dispatch_once();
+    EXPECT_EQ(2u, queue.high_water_mark());
+    EXPECT_EQ(3, counter);
+}
+
+TEST_F(TestStaticEventQueue, const_method)
+{
+    const Counter c;
+    EXPECT_NE(0, queue.call(&c, &Counter::peek));
+    queue.dispatch_once();
+    EXPECT_EQ(1, counter);
+}
+
+TEST_F(TestStaticEventQueue, call_in)
+{
+    EXPECT_NE(0, queue.call_in(20ms, count_func));
+    EXPECT_NE(0, queue.call_in(40ms, add_func, 1, 1));
+
+    queue.dispatch_for(10ms);
+    EXPECT_EQ(0, counter);
+    queue.dispatch_for(20ms);
+    EXPECT_EQ(1, counter);
+    queue.dispatch_for(20ms);
+    EXPECT_EQ(3, counter);
+}
+
+TEST_F(TestStaticEventQueue, call_every)
+{
+    Counter c;
+    int id = queue.call_every(10ms, &c, &Counter::hit, 1);
+    EXPECT_NE(0, id);
+
+    queue.dispatch_for(55ms);
+    EXPECT_EQ(5, c.calls);
+
+    // The periodic event keeps its slot until cancelled
+    EXPECT_EQ(1u, queue.high_water_mark());
+    queue.cancel(id);
+    for (int i = 0; i < TEST_SLOTS; i++) {
+        EXPECT_NE(0, queue.call(count_func));
+    }
+}
@@ -61,6 +61,10 @@ void EventQueue::background(Callback<void(int)> update)
 {
 }
 
+void EventQueue::coalesce_periodic(bool enable)
+{
+}
+
 int EventQueue::chain(EventQueue *target)
 {
     return 0;
@@ -103,6 +103,11 @@ void equeue_background(equeue_t *queue,
 
 }
 
+void equeue_coalesce(equeue_t *queue, bool enable)
+{
+
+}
+
 int equeue_chain(equeue_t *queue, equeue_t *target)
 {
     return 0;
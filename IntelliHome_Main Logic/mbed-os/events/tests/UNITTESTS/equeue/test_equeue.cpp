@@ -19,6 +19,9 @@
 #include "platform/Callback.h"
 #include <unistd.h>
 #include <pthread.h>
+#include <chrono>
+#include <limits.h>
+#include <stdio.h>
 
 #define EVENTS_EVENT_SIZE (EQUEUE_EVENT_SIZE - 2*sizeof(void*) + sizeof(mbed::Callback<void()>))
 #define TEST_EQUEUE_SIZE 2048
@@ -222,6 +225,26 @@ struct count_and_queue {
     equeue_t *q;
 };
 
+struct order {
+    int delay;
+    int posted;
+    int *ran;
+    int *count;
+};
+
+static void order_func(void *p)
+{
+    struct order *o = (struct order *)p;
+    o->ran[(*o->count)++] = o->posted;
+}
+
+// deterministic pseudo random numbers, the same sequence for every backend
+static unsigned bench_random(unsigned *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 8;
+}
+
 static void simple_breaker(void *p)
 {
     struct count_and_queue *caq = reinterpret_cast<struct count_and_queue *>(p);
@@ -1071,11 +1094,11 @@ TEST_F(TestEqueue, test_equeue_user_allocated_event_post)
     ASSERT_EQ(0, err);
 
     uint8_t touched = 0;
-    user_allocated_event e1 = { { 0, 0, 0, NULL, NULL, NULL, 0, -1, NULL, NULL }, 0 };
-    user_allocated_event e2 = { { 0, 0, 0, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
-    user_allocated_event e3 = { { 0, 0, 0, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
-    user_allocated_event e4 = { { 0, 0, 0, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
-    user_allocated_event e5 = { { 0, 0, 0, NULL, NULL, NULL, 0, -1, NULL, NULL }, 0 };
+    user_allocated_event e1 = { { 0, 0, 0, EQUEUE_PRIORITY_NORMAL, NULL, NULL, NULL, 0, -1, NULL, NULL }, 0 };
+    user_allocated_event e2 = { { 0, 0, 0, EQUEUE_PRIORITY_NORMAL, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
+    user_allocated_event e3 = { { 0, 0, 0, EQUEUE_PRIORITY_NORMAL, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
+    user_allocated_event e4 = { { 0, 0, 0, EQUEUE_PRIORITY_NORMAL, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
+    user_allocated_event e5 = { { 0, 0, 0, EQUEUE_PRIORITY_NORMAL, NULL, NULL, NULL, 0, -1, NULL, NULL }, 0 };
 
     EXPECT_NE(0, equeue_call_every(&q, 10, simple_func, &touched));
     EXPECT_EQ(0, equeue_call_every(&q, 10, simple_func, &touched));
@@ -1112,3 +1135,473 @@ TEST_F(TestEqueue, test_equeue_user_allocated_event_post)
 
     equeue_destroy(&q);
 }
+
+struct repost_event {
+    struct equeue_event e;
+    equeue_t *q;
+    int runs;
+    int reposts;
+};
+
+static void repost_func(void *p)
+{
+    struct repost_event *r = reinterpret_cast<repost_event *>(reinterpret_cast<equeue_event *>(p) - 1);
+    r->runs++;
+    if (r->reposts > 0) {
+        r->reposts--;
+        r->e.target = 10;
+        equeue_post_user_allocated(r->q, repost_func, &r->e);
+    }
+}
+
+/** Test that a user allocated event posted again from its own callback stays live.
+ *
+ *  Given a user allocated event whose callback posts it again with a delay.
+ *  When the first run returns.
+ *  Then the queued event can still be canceled, and once canceled it is not dispatched.
+ *  When the callback stops posting itself.
+ *  Then the event runs once per post and ends up done.
+ */
+TEST_F(TestEqueue, test_equeue_user_allocated_repost)
+{
+    equeue_t q;
+    int err = equeue_create(&q, EQUEUE_EVENT_SIZE);
+    ASSERT_EQ(0, err);
+
+    repost_event r = { { 0, 0, 0, EQUEUE_PRIORITY_NORMAL, NULL, NULL, NULL, 0, -1, NULL, NULL }, &q, 0, 1 };
+    equeue_post_user_allocated(&q, repost_func, &r.e);
+    equeue_dispatch(&q, 0);
+    EXPECT_EQ(1, r.runs);
+
+    EXPECT_TRUE(equeue_cancel_user_allocated(&q, &r.e));
+    equeue_dispatch(&q, 20);
+    EXPECT_EQ(1, r.runs);
+
+    r.e.target = 0;
+    r.reposts = 2;
+    equeue_post_user_allocated(&q, repost_func, &r.e);
+    equeue_dispatch(&q, 30);
+    EXPECT_EQ(4, r.runs);
+    EXPECT_FALSE(equeue_cancel_user_allocated(&q, &r.e));
+
+    equeue_destroy(&q);
+}
+
+/** Test that delays and the background timer are correct across a tick overflow.
+ *
+ *  Given queue is initialized just before the tick wraps around to 0.
+ *  When an event is posted with a delay that ends after the wrap.
+ *  Then the time left, the background timer update and the dispatch time are correct.
+ */
+TEST_F(TestEqueue, test_equeue_tick_wrap)
+{
+    equeue_global_time = UINT_MAX - 5;
+
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+
+    int ms = 0;
+    equeue_background(&q, background_func, &ms);
+
+    uint8_t touched = 0;
+    int id = equeue_call_in(&q, 10, simple_func, &touched);
+    ASSERT_NE(0, id);
+    EXPECT_EQ(10, ms);
+    EXPECT_EQ(10, equeue_timeleft(&q, id));
+
+    equeue_dispatch(&q, 5);
+    EXPECT_EQ(0, touched);
+    EXPECT_EQ(5, equeue_timeleft(&q, id));
+    EXPECT_EQ(5, ms);
+
+    equeue_dispatch(&q, 10);
+    EXPECT_EQ(1, touched);
+    EXPECT_GT(UINT_MAX - 5, equeue_global_time);
+
+    equeue_background(&q, 0, 0);
+    equeue_destroy(&q);
+}
+
+/** Test that equeue dispatches events in order of their target, and events
+ *  with the same target in the order they were posted.
+ *
+ *  Given queue is initialized.
+ *  When many events with random, often equal, delays are posted and some are cancelled.
+ *  Then the remaining events are executed ordered by delay, ties in posting order.
+ */
+TEST_F(TestEqueue, test_equeue_dispatch_order)
+{
+    const int events = 200;
+    equeue_t q;
+    int err = equeue_create(&q, events * (EQUEUE_EVENT_SIZE + sizeof(struct order)));
+    ASSERT_EQ(0, err);
+
+    int delays[events];
+    int ids[events];
+    int ran[events];
+    int count = 0;
+    unsigned state = 1;
+    for (int i = 0; i < events; i++) {
+        struct order *o = (struct order *)equeue_alloc(&q, sizeof(struct order));
+        ASSERT_TRUE(o != NULL);
+        o->delay = bench_random(&state) % 20;
+        o->posted = i;
+        o->ran = ran;
+        o->count = &count;
+        delays[i] = o->delay;
+        equeue_event_delay(o, o->delay);
+        ids[i] = equeue_post(&q, order_func, o);
+        ASSERT_NE(0, ids[i]);
+    }
+
+    int cancelled = 0;
+    for (int i = 0; i < events; i += 7) {
+        EXPECT_TRUE(equeue_cancel(&q, ids[i]));
+        cancelled++;
+    }
+
+    equeue_dispatch(&q, 30);
+    ASSERT_EQ(events - cancelled, count);
+
+    for (int i = 0; i < count; i++) {
+        EXPECT_NE(0, ran[i] % 7);
+        if (i > 0) {
+            int previous = ran[i - 1];
+            EXPECT_TRUE(delays[previous] < delays[ran[i]] ||
+                        (delays[previous] == delays[ran[i]] && previous < ran[i]));
+        }
+    }
+
+    equeue_destroy(&q);
+}
+
+static struct order *post_prioritised(equeue_t *q, int delay, int priority, int posted,
+                                      int *ran, int *count)
+{
+    struct order *o = (struct order *)equeue_alloc(q, sizeof(struct order));
+    if (o) {
+        o->delay = delay;
+        o->posted = posted;
+        o->ran = ran;
+        o->count = count;
+        equeue_event_delay(o, delay);
+        equeue_event_priority(o, priority);
+        equeue_post(q, order_func, o);
+    }
+    return o;
+}
+
+/** Test that events due at the same time run in priority order.
+ *
+ *  Given queue is initialized.
+ *  When events of every priority class become due in the same dispatch,
+ *  some of them with an earlier target than higher priority ones.
+ *  Then higher classes run first, and each class keeps target and posting order.
+ */
+TEST_F(TestEqueue, test_equeue_priority_order)
+{
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+
+    int ran[8];
+    int count = 0;
+    ASSERT_TRUE(post_prioritised(&q, 0, EQUEUE_PRIORITY_LOW, 0, ran, &count));
+    ASSERT_TRUE(post_prioritised(&q, 0, EQUEUE_PRIORITY_NORMAL, 1, ran, &count));
+    ASSERT_TRUE(post_prioritised(&q, 2, EQUEUE_PRIORITY_CRITICAL, 2, ran, &count));
+    ASSERT_TRUE(post_prioritised(&q, 1, EQUEUE_PRIORITY_HIGH, 3, ran, &count));
+    ASSERT_TRUE(post_prioritised(&q, 0, EQUEUE_PRIORITY_NORMAL, 4, ran, &count));
+    ASSERT_TRUE(post_prioritised(&q, 0, EQUEUE_PRIORITY_HIGH, 5, ran, &count));
+    // out of range classes are clamped
+    ASSERT_TRUE(post_prioritised(&q, 0, 100, 6, ran, &count));
+    ASSERT_TRUE(post_prioritised(&q, 0, -100, 7, ran, &count));
+
+    // everything is due once the dispatcher catches up
+    equeue_global_time += 5;
+    equeue_dispatch(&q, 0);
+
+    const int expected[] = { 6, 2, 5, 3, 1, 4, 0, 7 };
+    ASSERT_EQ(8, count);
+    for (int i = 0; i < count; i++) {
+        EXPECT_EQ(expected[i], ran[i]);
+    }
+
+    equeue_destroy(&q);
+}
+
+#if EQUEUE_SCHEDULING_STATS
+struct miss {
+    int id;
+    int lateness;
+    int calls;
+};
+
+static void miss_func(void *data, int id, int lateness)
+{
+    struct miss *m = (struct miss *)data;
+    m->id = id;
+    m->lateness = lateness;
+    m->calls++;
+}
+
+/** Test lateness histograms and deadline misses.
+ *
+ *  Given queue with a deadline miss callback.
+ *  When a slow event delays a second event of its class past its deadline,
+ *  while a high priority event with the same deadline runs first.
+ *  Then only the delayed event is reported, and the histograms of both
+ *  classes hold the lateness of their events.
+ */
+TEST_F(TestEqueue, test_equeue_deadline_miss)
+{
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+
+    struct miss m = { 0, 0, 0 };
+    equeue_deadline_miss(&q, miss_func, &m);
+
+    uint8_t touched = 0;
+    uint8_t *slow = (uint8_t *)equeue_alloc(&q, sizeof(uint8_t));
+    ASSERT_TRUE(slow != NULL);
+    *slow = 0;
+    ASSERT_NE(0, equeue_post(&q, sloth_func, slow));
+
+    int ids[2];
+    for (int i = 0; i < 2; i++) {
+        uint8_t **e = (uint8_t **)equeue_alloc(&q, sizeof(uint8_t *));
+        ASSERT_TRUE(e != NULL);
+        *e = &touched;
+        equeue_event_deadline(e, 5);
+        equeue_event_priority(e, i == 0 ? EQUEUE_PRIORITY_NORMAL : EQUEUE_PRIORITY_HIGH);
+        ids[i] = equeue_post(&q, [](void *p) {
+            (**(uint8_t **)p)++;
+        }, e);
+        ASSERT_NE(0, ids[i]);
+    }
+
+    equeue_dispatch(&q, 0);
+    EXPECT_EQ(1, *slow);
+    EXPECT_EQ(2, touched);
+
+    EXPECT_EQ(1, m.calls);
+    EXPECT_EQ(ids[0], m.id);
+    EXPECT_EQ(10, m.lateness);
+
+    const struct equeue_lateness *normal = equeue_lateness_stats(&q, EQUEUE_PRIORITY_NORMAL);
+    ASSERT_TRUE(normal != NULL);
+    EXPECT_EQ(2u, normal->count);
+    EXPECT_EQ(1u, normal->missed);
+    EXPECT_EQ(10u, normal->max);
+    EXPECT_EQ(1u, normal->buckets[0]);
+    EXPECT_EQ(1u, normal->buckets[4]);
+
+    const struct equeue_lateness *high = equeue_lateness_stats(&q, EQUEUE_PRIORITY_HIGH);
+    EXPECT_EQ(1u, high->count);
+    EXPECT_EQ(0u, high->missed);
+    EXPECT_EQ(1u, high->buckets[0]);
+
+    EXPECT_TRUE(equeue_lateness_stats(&q, EQUEUE_PRIORITY_CRITICAL + 1) == NULL);
+
+    equeue_lateness_reset(&q);
+    EXPECT_EQ(0u, normal->count);
+    EXPECT_EQ(0u, normal->max);
+
+    equeue_destroy(&q);
+}
+#endif
+
+/** Benchmark posting and cancelling with many pending events.
+ *
+ *  Given queue holds 10 to 10000 pending events with random delays.
+ *  When one more event is posted and cancelled again, many times over.
+ *  Then the average cost of a post and of a cancel is printed. Nothing is
+ *  asserted about the timing, the numbers are for comparing the list and
+ *  pairing heap backends.
+ */
+TEST_F(TestEqueue, test_equeue_benchmark_pending)
+{
+    const int pending[] = { 10, 100, 1000, 10000 };
+    const int rounds = 1000;
+
+    for (size_t n = 0; n < sizeof(pending) / sizeof(pending[0]); n++) {
+        equeue_t q;
+        int err = equeue_create(&q, (pending[n] + 1) * EQUEUE_EVENT_SIZE);
+        ASSERT_EQ(0, err);
+
+        unsigned state = 1;
+        for (int i = 0; i < pending[n]; i++) {
+            ASSERT_NE(0, equeue_call_in(&q, 1 + bench_random(&state) % 1000000, pass_func, 0));
+        }
+
+        std::chrono::nanoseconds post(0);
+        std::chrono::nanoseconds cancel(0);
+        for (int i = 0; i < rounds; i++) {
+            int delay = 1 + bench_random(&state) % 1000000;
+
+            auto start = std::chrono::steady_clock::now();
+            int id = equeue_call_in(&q, delay, pass_func, 0);
+            auto posted = std::chrono::steady_clock::now();
+            bool ok = equeue_cancel(&q, id);
+            auto cancelled = std::chrono::steady_clock::now();
+
+            ASSERT_NE(0, id);
+            ASSERT_TRUE(ok);
+            post += posted - start;
+            cancel += cancelled - posted;
+        }
+
+        printf("%s, %5d pending: post %6lld ns, cancel %6lld ns\n",
+               EQUEUE_PAIRING_HEAP ? "pairing heap" : "sorted list", pending[n],
+               (long long)(post.count() / rounds), (long long)(cancel.count() / rounds));
+
+        equeue_destroy(&q);
+    }
+}
+
+struct wakeups {
+    unsigned last;
+    unsigned count;
+    unsigned runs;
+};
+
+static void wakeup_func(void *p)
+{
+    struct wakeups *w = (struct wakeups *)p;
+    unsigned tick = equeue_tick();
+    if (w->runs == 0 || tick != w->last) {
+        w->count++;
+        w->last = tick;
+    }
+    w->runs++;
+}
+
+struct phase {
+    int period;
+    unsigned settled;
+    int misaligned;
+    int runs;
+};
+
+static void phase_func(void *p)
+{
+    struct phase *ph = (struct phase *)p;
+    unsigned tick = equeue_tick();
+    if (tick >= ph->settled && tick % ph->period != 0) {
+        ph->misaligned++;
+    }
+    ph->runs++;
+}
+
+static void overrun_func(void *p)
+{
+    // overruns both periods, everything due meanwhile runs late once
+    equeue_global_time += 53;
+}
+
+/** Test that coalesced periodic events stay on multiples of their period.
+ *
+ *  Given queue with coalescing enabled.
+ *  When periodic events are posted at ticks that are not multiples of their
+ *  period, and another event blocks the queue for longer than both periods.
+ *  Then every dispatch happens on a multiple of the event's period, apart
+ *  from the late runs right after the blocking event.
+ */
+TEST_F(TestEqueue, test_equeue_coalesce_alignment)
+{
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+    equeue_coalesce(&q, true);
+
+    equeue_global_time = 1003;
+    struct phase fast = { 10, 1003, 0, 0 };
+    struct phase slow = { 40, 1003, 0, 0 };
+    ASSERT_NE(0, equeue_call_every(&q, fast.period, phase_func, &fast));
+    equeue_global_time += 7;
+    ASSERT_NE(0, equeue_call_every(&q, slow.period, phase_func, &slow));
+    ASSERT_NE(0, equeue_call_in(&q, 95, overrun_func, 0));
+
+    equeue_dispatch(&q, 400);
+    EXPECT_GT(fast.runs, 30);
+    EXPECT_GT(slow.runs, 5);
+    EXPECT_EQ(1, fast.misaligned);
+    EXPECT_EQ(1, slow.misaligned);
+
+    equeue_destroy(&q);
+}
+
+/** Test that enabling coalescing also aligns periodic events already queued.
+ *
+ *  Given queue without coalescing holds a periodic event off its grid.
+ *  When coalescing is enabled between two dispatches.
+ *  Then the event runs once more at its old phase and is on multiples of
+ *  its period from its next period on.
+ */
+TEST_F(TestEqueue, test_equeue_coalesce_queued_events)
+{
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+    equeue_coalesce(&q, false);
+
+    equeue_global_time = 1003;
+    struct phase p = { 10, 1003, 0, 0 };
+    ASSERT_NE(0, equeue_call_every(&q, p.period, phase_func, &p));
+    equeue_dispatch(&q, 55);
+    EXPECT_EQ(5, p.runs);
+    EXPECT_EQ(5, p.misaligned);
+
+    equeue_coalesce(&q, true);
+    p.settled = equeue_global_time + p.period;
+    p.runs = 0;
+    p.misaligned = 0;
+    equeue_dispatch(&q, 100);
+    EXPECT_GT(p.runs, 8);
+    EXPECT_EQ(0, p.misaligned);
+
+    equeue_destroy(&q);
+}
+
+/** Benchmark how often periodic events wake the dispatch loop.
+ *
+ *  Given queue holds the periodic events of the home controller (30 ms
+ *  ranging, 500 ms display, 2 s climate and telemetry), posted a few
+ *  milliseconds apart as they would be at boot.
+ *  When the queue is dispatched for a minute without and with coalescing.
+ *  Then both runs dispatch the same events, the coalesced one in fewer
+ *  distinct ticks. The wakeups per second of both are printed.
+ */
+TEST_F(TestEqueue, test_equeue_benchmark_coalescing)
+{
+    const int periods[] = { 30, 500, 2000, 2000 };
+    const int offsets[] = { 0, 7, 13, 101 };
+    const int seconds = 60;
+    unsigned wakeups[2];
+    unsigned runs[2];
+
+    for (int coalesce = 0; coalesce < 2; coalesce++) {
+        equeue_t q;
+        int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+        ASSERT_EQ(0, err);
+        equeue_coalesce(&q, coalesce);
+
+        struct wakeups w = { 0, 0, 0 };
+        for (int i = 0; i < 4; i++) {
+            equeue_global_time += offsets[i];
+            ASSERT_NE(0, equeue_call_every(&q, periods[i], wakeup_func, &w));
+        }
+
+        equeue_dispatch(&q, seconds * 1000);
+        wakeups[coalesce] = w.count;
+        runs[coalesce] = w.runs;
+
+        equeue_destroy(&q);
+    }
+
+    printf("periodic wakeups per second: %.1f separate, %.1f coalesced (%u and %u events)\n",
+           (double)wakeups[0] / seconds, (double)wakeups[1] / seconds, runs[0], runs[1]);
+    EXPECT_LT(wakeups[1], wakeups[0]);
+    EXPECT_NEAR(runs[0], runs[1], 4);
+}
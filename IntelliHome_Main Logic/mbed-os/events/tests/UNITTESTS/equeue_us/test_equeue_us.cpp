@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include "events/equeue.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <sys/time.h>
+
+#define TEST_EQUEUE_SIZE 2048
+#define JITTER_PERIOD_US 1000
+#define JITTER_PERIODS 500
+
+class TestEqueueUs : public testing::Test {
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+static unsigned wall_us()
+{
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return (unsigned)(tv.tv_sec * 1000000 + tv.tv_usec);
+}
+
+static void stamp_func(void *p)
+{
+    *(reinterpret_cast<unsigned *>(p)) = equeue_tick();
+}
+
+static void background_func(void *p, int us)
+{
+    *(reinterpret_cast<int *>(p)) = us;
+}
+
+struct jitter {
+    equeue_t *q;
+    unsigned last;
+    int count;
+    int error[JITTER_PERIODS];
+};
+
+// deviation of each period from the nominal one
+static void jitter_func(void *p)
+{
+    struct jitter *j = reinterpret_cast<struct jitter *>(p);
+    unsigned now = equeue_tick();
+    j->error[j->count] = (int)(now - j->last) - JITTER_PERIOD_US;
+    j->last = now;
+    j->count++;
+    if (j->count == JITTER_PERIODS) {
+        equeue_break(j->q);
+    }
+}
+
+/** Test that the tick counts microseconds.
+ *
+ *  Given the microsecond tick mode.
+ *  When 20 ms pass.
+ *  Then the tick advanced by about 20000.
+ */
+TEST_F(TestEqueueUs, test_equeue_us_tick)
+{
+    equeue_tick_init();
+    unsigned start = equeue_tick();
+    unsigned wall = wall_us();
+    usleep(20000);
+    unsigned ticks = equeue_tick() - start;
+    unsigned elapsed = wall_us() - wall;
+
+    EXPECT_GE(ticks, 20000u);
+    EXPECT_NEAR((double)elapsed, (double)ticks, 1000.0);
+}
+
+/** Test that delays below a millisecond are honoured.
+ *
+ *  Given the microsecond tick mode.
+ *  When an event is posted with a 300 us delay.
+ *  Then it runs no earlier than 300 us and well before the next millisecond tick
+ *  would have been, had the queue used the default resolution of a delay in ms.
+ */
+TEST_F(TestEqueueUs, test_equeue_us_sub_millisecond_delay)
+{
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+
+    unsigned fired = 0;
+    unsigned posted = equeue_tick();
+    ASSERT_NE(0, equeue_call_in(&q, 300, stamp_func, &fired));
+    equeue_dispatch(&q, 20000);
+
+    ASSERT_NE(0u, fired);
+    int late = (int)(fired - posted);
+    EXPECT_GE(late, 300);
+    EXPECT_LT(late, 20000);
+
+    equeue_destroy(&q);
+}
+
+/** Test that the background timer is updated in microseconds.
+ *
+ *  Given a backgrounded queue in the microsecond tick mode.
+ *  When an event is posted 2500 us ahead.
+ *  Then the background timer is asked to fire within 2500 us.
+ */
+TEST_F(TestEqueueUs, test_equeue_us_background)
+{
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+
+    int us = -1;
+    equeue_background(&q, background_func, &us);
+    unsigned fired = 0;
+    ASSERT_NE(0, equeue_call_in(&q, 2500, stamp_func, &fired));
+    EXPECT_LE(us, 2500);
+    EXPECT_GT(us, 1500);
+
+    equeue_background(&q, 0, 0);
+    equeue_destroy(&q);
+}
+
+/** Measure dispatch jitter of a 1 ms periodic event.
+ *
+ *  Given the microsecond tick mode.
+ *  When a periodic event runs 500 times.
+ *  Then every period ran and the deviation of the periods is printed. The
+ *  host scheduler dominates the figures, nothing is asserted about them.
+ */
+TEST_F(TestEqueueUs, test_equeue_us_jitter)
+{
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+
+    struct jitter *j = new struct jitter;
+    j->q = &q;
+    j->count = 0;
+    j->last = equeue_tick();
+    ASSERT_NE(0, equeue_call_every(&q, JITTER_PERIOD_US, jitter_func, j));
+    equeue_dispatch(&q, -1);
+
+    ASSERT_EQ(JITTER_PERIODS, j->count);
+    long long total = 0;
+    int worst = 0;
+    for (int i = 0; i < j->count; i++) {
+        int error = j->error[i] < 0 ? -j->error[i] : j->error[i];
+        total += error;
+        if (error > worst) {
+            worst = error;
+        }
+    }
+    printf("%d periods of %d us: mean jitter %lld us, worst %d us\n",
+           j->count, JITTER_PERIOD_US, total / j->count, worst);
+
+    delete j;
+    equeue_destroy(&q);
+}
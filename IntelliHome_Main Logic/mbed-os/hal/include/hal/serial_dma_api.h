@@ -0,0 +1,127 @@
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2026 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_SERIAL_DMA_API_H
+#define MBED_SERIAL_DMA_API_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hal/serial_api.h"
+
+#if DEVICE_SERIAL_DMA
+
+/**
+ * @defgroup SerialDMAEvents Serial DMA Events Macros
+ *
+ * @{
+ */
+#define SERIAL_DMA_EVENT_RX      (1 << 0) ///< New bytes in the receive ring: idle line, half or whole ring written
+#define SERIAL_DMA_EVENT_TX_DONE (1 << 1) ///< The transmit transfer is over
+/**@}*/
+
+/** DMA event handler
+ *
+ * Called in interrupt context with the id given to serial_dma_handler()
+ * and one or more SERIAL_DMA_EVENT_* bits.
+ */
+typedef void (*serial_dma_irq_handler)(uintptr_t id, uint32_t event);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_SerialDMA Serial DMA hardware abstraction layer
+ *
+ * Reception into a circular buffer written by DMA, and transmission of a
+ * whole buffer by DMA, so the CPU is interrupted per burst rather than per
+ * byte.
+ *
+ * # Defined behavior
+ * * Once ::serial_dma_rx_start is called, received bytes are written to the
+ *   ring in order, wrapping to its start, until ::serial_dma_rx_stop
+ * * ::serial_dma_rx_head returns the index the next received byte is written at
+ * * SERIAL_DMA_EVENT_RX is raised when the line goes idle after a byte,
+ *   and each time the write index crosses the middle or the end of the ring,
+ *   so a reader is told at least every half ring
+ * * SERIAL_DMA_EVENT_TX_DONE is raised once all the bytes of a
+ *   ::serial_dma_tx_start are handed to the peripheral
+ *
+ * # Undefined behavior
+ * * Calling ::serial_dma_tx_start while ::serial_dma_tx_active returns non-zero
+ * * Freeing or changing the receive ring while reception is running
+ * * Using ::serial_irq_set for RxIrq while reception is running
+ *
+ * @{
+ */
+
+/** Register the DMA event handler
+ *
+ * @param obj     The serial object
+ * @param handler The handler, called in interrupt context
+ * @param id      The value given to the handler
+ */
+void serial_dma_handler(serial_t *obj, serial_dma_irq_handler handler, uintptr_t id);
+
+/** Start circular reception
+ *
+ * @param obj    The serial object
+ * @param buffer The ring the received bytes are written to
+ * @param size   The size of the ring, at most 65535 bytes
+ */
+void serial_dma_rx_start(serial_t *obj, uint8_t *buffer, size_t size);
+
+/** Get the write index of the receive ring
+ *
+ * @param obj The serial object
+ * @return    The index in the ring the next received byte goes to
+ */
+size_t serial_dma_rx_head(serial_t *obj);
+
+/** Stop reception
+ *
+ * @param obj The serial object
+ */
+void serial_dma_rx_stop(serial_t *obj);
+
+/** Start a transmission
+ *
+ * @param obj    The serial object
+ * @param data   The bytes to send, kept unchanged until SERIAL_DMA_EVENT_TX_DONE
+ * @param length The number of bytes, 1 to 65535
+ */
+void serial_dma_tx_start(serial_t *obj, const uint8_t *data, size_t length);
+
+/** Check for a transmission in progress
+ *
+ * @param obj The serial object
+ * @return    Non-zero while a transmission is in progress
+ */
+int serial_dma_tx_active(serial_t *obj);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
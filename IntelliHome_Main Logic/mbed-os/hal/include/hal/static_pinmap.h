@@ -55,7 +55,7 @@ MSTD_CONSTEXPR_FN_14 PinMap get_analogin_pinmap(const PinName pin)
         }
     }
 
-#if PINMAP_ANALOGIN_INTERNAL
+#ifdef PINMAP_ANALOGIN_INTERNAL
     for (const PinMap &pinmap : PINMAP_ANALOGIN_INTERNAL) {
         if (pinmap.pin == pin) {
             return {pin, pinmap.peripheral, pinmap.function};
@@ -469,4 +469,107 @@ MSTD_CONSTEXPR_FN_14 ospi_pinmap_t get_ospi_pinmap(const PinName data0, const Pi
 
 #endif // STATIC_PINMAP_READY
 
+/* Compile time checked static pinmaps
+ *
+ * static_xxx_pinmap<pins...>::value is the result of get_xxx_pinmap(pins...)
+ * as a constexpr object with static storage duration, so it can be passed to
+ * the drivers which keep a pointer to their pinmap (SerialBase, SPI) too.
+ *
+ * When the target provides its pinmaps (STATIC_PINMAP_READY), using a pin which
+ * has no such peripheral is a compile error instead of an assert at run time.
+ * Otherwise the pinmap only carries the pins and the HAL looks them up.
+ *
+ * Example:
+ * @code
+ * PwmOut servo(static_pwm_pinmap<PA_7>::value);
+ * UnbufferedSerial bt(static_uart_pinmap<PB_6, PB_7>::value, 9600);
+ * @endcode
+ */
+template <typename Pinmap>
+constexpr bool static_pinmap_found(const Pinmap &pinmap)
+{
+#if STATIC_PINMAP_READY
+    return pinmap.peripheral != (int) NC;
+#else
+    return true;
+#endif
+}
+
+#if defined(DEVICE_PWMOUT) && (!STATIC_PINMAP_READY || defined(PINMAP_PWM))
+template <PinName Pin>
+struct static_pwm_pinmap {
+    static constexpr PinMap value = get_pwm_pinmap(Pin);
+    static_assert(static_pinmap_found(value), "No PWM peripheral on this pin");
+};
+
+template <PinName Pin>
+constexpr PinMap static_pwm_pinmap<Pin>::value;
+#endif // DEVICE_PWMOUT
+
+#if defined(DEVICE_ANALOGIN) && (!STATIC_PINMAP_READY || defined(PINMAP_ANALOGIN))
+template <PinName Pin>
+struct static_analogin_pinmap {
+    static constexpr PinMap value = get_analogin_pinmap(Pin);
+    static_assert(static_pinmap_found(value), "No ADC channel on this pin");
+};
+
+template <PinName Pin>
+constexpr PinMap static_analogin_pinmap<Pin>::value;
+#endif // DEVICE_ANALOGIN
+
+#if defined(DEVICE_ANALOGOUT) && (!STATIC_PINMAP_READY || defined(PINMAP_ANALOGOUT))
+template <PinName Pin>
+struct static_analogout_pinmap {
+    static constexpr PinMap value = get_analogout_pinmap(Pin);
+    static_assert(static_pinmap_found(value), "No DAC channel on this pin");
+};
+
+template <PinName Pin>
+constexpr PinMap static_analogout_pinmap<Pin>::value;
+#endif // DEVICE_ANALOGOUT
+
+#if defined(DEVICE_I2C) && (!STATIC_PINMAP_READY || (defined(PINMAP_I2C_SDA) && defined(PINMAP_I2C_SCL)))
+template <PinName Sda, PinName Scl>
+struct static_i2c_pinmap {
+    static constexpr i2c_pinmap_t value = get_i2c_pinmap(Sda, Scl);
+    static_assert(static_pinmap_found(value), "No I2C peripheral on these pins");
+};
+
+template <PinName Sda, PinName Scl>
+constexpr i2c_pinmap_t static_i2c_pinmap<Sda, Scl>::value;
+#endif // DEVICE_I2C
+
+#if defined(DEVICE_SERIAL) && (!STATIC_PINMAP_READY || (defined(PINMAP_UART_TX) && defined(PINMAP_UART_RX)))
+template <PinName Tx, PinName Rx>
+struct static_uart_pinmap {
+    static constexpr serial_pinmap_t value = get_uart_pinmap(Tx, Rx);
+    static_assert(static_pinmap_found(value), "No UART peripheral on these pins");
+};
+
+template <PinName Tx, PinName Rx>
+constexpr serial_pinmap_t static_uart_pinmap<Tx, Rx>::value;
+#endif // DEVICE_SERIAL
+
+#if defined(DEVICE_SPI) && (!STATIC_PINMAP_READY || (defined(PINMAP_SPI_MOSI) && defined(PINMAP_SPI_MISO) && defined(PINMAP_SPI_SCLK) && defined(PINMAP_SPI_SSEL)))
+template <PinName Mosi, PinName Miso, PinName Sclk, PinName Ssel = NC>
+struct static_spi_pinmap {
+    static constexpr spi_pinmap_t value = get_spi_pinmap(Mosi, Miso, Sclk, Ssel);
+    static_assert(static_pinmap_found(value), "No SPI peripheral on these pins");
+};
+
+template <PinName Mosi, PinName Miso, PinName Sclk, PinName Ssel>
+constexpr spi_pinmap_t static_spi_pinmap<Mosi, Miso, Sclk, Ssel>::value;
+#endif // DEVICE_SPI
+
+#if defined(DEVICE_CAN) && (!STATIC_PINMAP_READY || (defined(PINMAP_CAN_RD) && defined(PINMAP_CAN_TD)))
+template <PinName Rd, PinName Td>
+struct static_can_pinmap {
+    static constexpr can_pinmap_t value = get_can_pinmap(Rd, Td);
+    static_assert(static_pinmap_found(value), "No CAN peripheral on these pins");
+};
+
+template <PinName Rd, PinName Td>
+constexpr can_pinmap_t static_can_pinmap<Rd, Td>::value;
+#endif // DEVICE_CAN
+
 #endif // STATIC_PINMAP_H
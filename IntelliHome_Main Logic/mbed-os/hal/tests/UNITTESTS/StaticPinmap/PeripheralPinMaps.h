@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_PERIPHERALPINMAPS_H
+#define MBED_PERIPHERALPINMAPS_H
+
+#include "PinNames.h"
+
+// Pin tables of a pretend target, PTC0 and PTC1 being PWM channels of two
+// timers and CONSOLE_TX/CONSOLE_RX a UART also reachable on PTC0/PTC1.
+
+namespace test_static_pinmap {
+
+constexpr PinMap PinMap_PWM[] = {
+    {PTC1, 2, 0x21},
+    {PTC0, 1, 0x11},
+    {NC, NC, 0}
+};
+
+constexpr PinMap PinMap_ADC[] = {
+    {PTC1, 3, 0x05},
+    {NC, NC, 0}
+};
+
+constexpr PinMap PinMap_UART_TX[] = {
+    {CONSOLE_TX, 4, 0x07},
+    {PTC0, 5, 0x08},
+    {NC, NC, 0}
+};
+
+constexpr PinMap PinMap_UART_RX[] = {
+    {CONSOLE_RX, 4, 0x07},
+    {PTC1, 5, 0x08},
+    {NC, NC, 0}
+};
+
+} // namespace test_static_pinmap
+
+#define PINMAP_PWM test_static_pinmap::PinMap_PWM
+#define PINMAP_ANALOGIN test_static_pinmap::PinMap_ADC
+#define PINMAP_UART_TX test_static_pinmap::PinMap_UART_TX
+#define PINMAP_UART_RX test_static_pinmap::PinMap_UART_RX
+
+#endif // MBED_PERIPHERALPINMAPS_H
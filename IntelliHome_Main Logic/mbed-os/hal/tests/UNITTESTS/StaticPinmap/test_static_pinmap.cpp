@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include "hal/static_pinmap.h"
+#include <chrono>
+#include <stdio.h>
+
+// Resolved by the compiler, a pin without the peripheral would not build
+static_assert(static_pwm_pinmap<PTC0>::value.peripheral == 1, "PWM peripheral");
+static_assert(static_pwm_pinmap<PTC0>::value.function == 0x11, "PWM function");
+static_assert(static_analogin_pinmap<PTC1>::value.peripheral == 3, "ADC peripheral");
+static_assert(static_uart_pinmap<PTC0, PTC1>::value.peripheral == 5, "UART peripheral");
+
+// The conditions the static_asserts of the templates check
+static_assert(!static_pinmap_found(get_analogin_pinmap(PTC0)), "PTC0 has no ADC channel");
+static_assert(!static_pinmap_found(get_uart_pinmap(PTC0, CONSOLE_RX)), "TX and RX of two UARTs");
+
+// The search pinmap_find_peripheral() and pinmap_find_function() do
+static int find_peripheral(PinName pin, const PinMap *map)
+{
+    while (map->pin != NC) {
+        if (map->pin == pin) {
+            return map->peripheral;
+        }
+        map++;
+    }
+    return (int) NC;
+}
+
+static int find_function(PinName pin, const PinMap *map)
+{
+    while (map->pin != NC) {
+        if (map->pin == pin) {
+            return map->function;
+        }
+        map++;
+    }
+    return (int) NC;
+}
+
+class StaticPinmapTest : public testing::Test {
+};
+
+TEST_F(StaticPinmapTest, pwm)
+{
+    const PinMap &pinmap = static_pwm_pinmap<PTC1>::value;
+
+    EXPECT_EQ(PTC1, pinmap.pin);
+    EXPECT_EQ(2, pinmap.peripheral);
+    EXPECT_EQ(0x21, pinmap.function);
+}
+
+TEST_F(StaticPinmapTest, analogin)
+{
+    const PinMap &pinmap = static_analogin_pinmap<PTC1>::value;
+
+    EXPECT_EQ(PTC1, pinmap.pin);
+    EXPECT_EQ(3, pinmap.peripheral);
+    EXPECT_EQ(0x05, pinmap.function);
+}
+
+TEST_F(StaticPinmapTest, uart)
+{
+    const serial_pinmap_t &pinmap = static_uart_pinmap<PTC0, PTC1>::value;
+
+    EXPECT_EQ(5, pinmap.peripheral);
+    EXPECT_EQ(PTC0, pinmap.tx_pin);
+    EXPECT_EQ(0x08, pinmap.tx_function);
+    EXPECT_EQ(PTC1, pinmap.rx_pin);
+    EXPECT_EQ(0x08, pinmap.rx_function);
+    EXPECT_FALSE(pinmap.stdio_config);
+
+    EXPECT_TRUE((static_uart_pinmap<CONSOLE_TX, CONSOLE_RX>::value.stdio_config));
+}
+
+TEST_F(StaticPinmapTest, static_storage)
+{
+    // Drivers such as SerialBase keep a pointer to the pinmap they are given
+    const serial_pinmap_t *first = &static_uart_pinmap<PTC0, PTC1>::value;
+    const serial_pinmap_t *second = &static_uart_pinmap<PTC0, PTC1>::value;
+    EXPECT_EQ(first, second);
+}
+
+TEST_F(StaticPinmapTest, matches_runtime_lookup)
+{
+    const PinMap &pinmap = static_pwm_pinmap<PTC0>::value;
+
+    EXPECT_EQ(find_peripheral(PTC0, PINMAP_PWM), pinmap.peripheral);
+    EXPECT_EQ(find_function(PTC0, PINMAP_PWM), pinmap.function);
+}
+
+// What a driver constructed from a PinName does before it reaches the
+// xxx_init_direct() of the HAL, against a table as long as a board's PWM map.
+TEST_F(StaticPinmapTest, benchmark_lookup)
+{
+    PinMap table[26];
+    for (int i = 0; i < 24; i++) {
+        table[i] = {PTC1, 2, i};
+    }
+    table[24] = {PTC0, 1, 0x11};
+    table[25] = {NC, NC, 0};
+
+    const int rounds = 100000;
+    volatile PinName pin = PTC0;
+    volatile int sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        sink = find_peripheral(pin, table) + find_function(pin, table);
+    }
+    auto dynamic_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        const PinMap &pinmap = static_pwm_pinmap<PTC0>::value;
+        sink = pinmap.peripheral + pinmap.function;
+    }
+    auto static_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    printf("pin lookup: pinmap tables %.1f ns, static pinmap %.1f ns\n",
+           (double) dynamic_ns / rounds, (double) static_ns / rounds);
+    EXPECT_EQ(1 + 0x11, sink);
+}
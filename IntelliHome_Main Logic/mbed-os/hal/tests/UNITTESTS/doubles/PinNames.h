@@ -49,6 +49,7 @@ typedef enum {
 
 typedef enum {
     PortA = 0,
+    PortB = 1,
 } PortName;
 
 #ifdef __cplusplus
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gpio_stub.h"
+#include "hal/gpio_api.h"
+#include "hal/port_api.h"
+
+namespace {
+
+const int num_ports = 4;
+
+struct Port {
+    uint32_t latch;
+    uint32_t outputs;
+    uint32_t driven;
+    PinMode modes[16];
+};
+
+Port ports[num_ports];
+uint64_t clock_us;
+unsigned writes;
+std::vector<gpio_stub::Transition> log;
+
+uint32_t port_levels(const Port &port)
+{
+    return (port.latch & port.outputs) | (port.driven & ~port.outputs);
+}
+
+// Apply a change to a port and record the pins whose level it changed
+template <typename Change>
+void update(PortName name, Change change)
+{
+    Port &port = ports[name];
+    uint32_t before = port_levels(port);
+    change(port);
+    uint32_t after = port_levels(port);
+    if (before != after) {
+        log.push_back({clock_us, name, before ^ after, after});
+    }
+}
+
+PortName pin_port(PinName pin)
+{
+    return (PortName)((pin >> 4) & 0xF);
+}
+
+uint32_t pin_mask(PinName pin)
+{
+    return 1UL << (pin & 0xF);
+}
+
+} // namespace
+
+namespace gpio_stub {
+
+void reset()
+{
+    for (Port &port : ports) {
+        port = Port();
+    }
+    clock_us = 0;
+    writes = 0;
+    log.clear();
+}
+
+void clear_log()
+{
+    writes = 0;
+    log.clear();
+}
+
+void advance_us(uint32_t us)
+{
+    clock_us += us;
+}
+
+uint64_t now_us()
+{
+    return clock_us;
+}
+
+void drive(PortName port, int pin, int value)
+{
+    update(port, [&](Port &p) {
+        p.driven = value ? (p.driven | (1UL << pin)) : (p.driven & ~(1UL << pin));
+    });
+}
+
+uint32_t levels(PortName port)
+{
+    return port_levels(ports[port]);
+}
+
+uint32_t outputs(PortName port)
+{
+    return ports[port].outputs;
+}
+
+PinMode mode(PortName port, int pin)
+{
+    return ports[port].modes[pin];
+}
+
+unsigned port_writes()
+{
+    return writes;
+}
+
+const std::vector<Transition> &transitions()
+{
+    return log;
+}
+
+} // namespace gpio_stub
+
+PinName port_pin(PortName port, int pin_n)
+{
+    return (PinName)((port << 4) | pin_n);
+}
+
+void gpio_port_set_reset(PortName port, uint32_t set, uint32_t reset)
+{
+    writes++;
+    update(port, [&](Port &p) {
+        p.latch = (p.latch & ~reset) | set;
+    });
+}
+
+uint32_t gpio_port_read(PortName port)
+{
+    return port_levels(ports[port]);
+}
+
+void gpio_init(gpio_t *obj, PinName pin)
+{
+    obj->pin = pin;
+}
+
+int gpio_is_connected(const gpio_t *obj)
+{
+    return obj->pin != NC;
+}
+
+void gpio_mode(gpio_t *obj, PinMode mode)
+{
+    ports[pin_port(obj->pin)].modes[obj->pin & 0xF] = mode;
+}
+
+void gpio_dir(gpio_t *obj, PinDirection direction)
+{
+    uint32_t mask = pin_mask(obj->pin);
+    update(pin_port(obj->pin), [&](Port &p) {
+        p.outputs = direction == PIN_OUTPUT ? (p.outputs | mask) : (p.outputs & ~mask);
+    });
+}
+
+void gpio_write(gpio_t *obj, int value)
+{
+    uint32_t mask = pin_mask(obj->pin);
+    update(pin_port(obj->pin), [&](Port &p) {
+        p.latch = value ? (p.latch | mask) : (p.latch & ~mask);
+    });
+}
+
+int gpio_read(gpio_t *obj)
+{
+    return (port_levels(ports[pin_port(obj->pin)]) & pin_mask(obj->pin)) ? 1 : 0;
+}
@@ -18,6 +18,7 @@
 #ifndef MBED_GPIO_OBJECT_H
 #define MBED_GPIO_OBJECT_H
 
+#include <stdint.h>
 #include "mbed_assert.h"
 #include "PeripheralNames.h"
 #include "PinNames.h"
@@ -27,9 +28,14 @@ extern "C" {
 #endif
 
 typedef struct {
-    int unused;
+    PinName pin;
 } gpio_t;
 
+/* Whole port accesses of drivers/Gpio.h, recorded by gpio_api_stub.cpp */
+#define GPIO_PORT_ACCESS 1
+void gpio_port_set_reset(PortName port, uint32_t set, uint32_t reset);
+uint32_t gpio_port_read(PortName port);
+
 #ifdef __cplusplus
 }
 #endif
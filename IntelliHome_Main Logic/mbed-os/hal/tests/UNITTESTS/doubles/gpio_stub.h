@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_GPIO_STUB_H
+#define MBED_GPIO_STUB_H
+
+#include <stdint.h>
+#include <vector>
+#include "PinNames.h"
+
+/* Host backend of the GPIO HAL, gpio_api_stub.cpp
+ *
+ * It keeps the output latch, direction and pull of every pin and records
+ * each change of the pin levels with the time of a simulated clock, like a
+ * logic analyser would, so that bit-banged protocols can be checked and
+ * timed. The code under test moves the clock forward with advance_us(), the
+ * test drives the inputs with drive().
+ */
+namespace gpio_stub {
+
+struct Transition {
+    uint64_t time_us;   // simulated time of the change
+    PortName port;
+    uint32_t changed;   // pins whose level changed
+    uint32_t levels;    // levels of all the pins of the port after the change
+};
+
+/* All the pins inputs without pull, outputs latched low, clock at 0, no transitions */
+void reset();
+
+/* Forget the transitions and writes recorded so far, keeping the pins as they are */
+void clear_log();
+
+void advance_us(uint32_t us);
+
+uint64_t now_us();
+
+/* Level driven on the pin from outside, seen while the pin is an input */
+void drive(PortName port, int pin, int value);
+
+/* Levels of all the pins of the port */
+uint32_t levels(PortName port);
+
+/* Pins configured as outputs */
+uint32_t outputs(PortName port);
+
+PinMode mode(PortName port, int pin);
+
+/* Number of gpio_port_set_reset() calls, one per atomic write */
+unsigned port_writes();
+
+const std::vector<Transition> &transitions();
+
+} // namespace gpio_stub
+
+#endif
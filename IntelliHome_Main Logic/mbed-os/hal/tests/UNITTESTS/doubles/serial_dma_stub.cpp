@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serial_dma_stub.h"
+#include "hal/serial_dma_api.h"
+
+namespace {
+
+serial_dma_irq_handler handler;
+uintptr_t handler_id;
+uint8_t *ring;
+size_t ring_size;
+size_t head;
+bool transmitting;
+std::vector<std::vector<uint8_t>> sent;
+
+void raise(uint32_t event)
+{
+    if (handler) {
+        handler(handler_id, event);
+    }
+}
+
+}
+
+namespace serial_dma_stub {
+
+void reset()
+{
+    handler = nullptr;
+    handler_id = 0;
+    ring = nullptr;
+    ring_size = 0;
+    head = 0;
+    transmitting = false;
+    sent.clear();
+}
+
+void receive(const void *data, size_t length, bool idle)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+
+    if (ring == nullptr) {
+        return;
+    }
+    for (size_t i = 0; i < length; i++) {
+        ring[head] = bytes[i];
+        head = (head + 1) % ring_size;
+        // Half transfer and transfer complete
+        if (head == ring_size / 2 || head == 0) {
+            raise(SERIAL_DMA_EVENT_RX);
+        }
+    }
+    if (idle && length != 0) {
+        raise(SERIAL_DMA_EVENT_RX);
+    }
+}
+
+bool rx_running()
+{
+    return ring != nullptr;
+}
+
+bool tx_active()
+{
+    return transmitting;
+}
+
+void complete_tx()
+{
+    if (transmitting) {
+        transmitting = false;
+        raise(SERIAL_DMA_EVENT_TX_DONE);
+    }
+}
+
+void complete_tx_silently()
+{
+    transmitting = false;
+}
+
+const std::vector<std::vector<uint8_t>> &transfers()
+{
+    return sent;
+}
+
+} // namespace serial_dma_stub
+
+void serial_dma_handler(serial_t *obj, serial_dma_irq_handler irq_handler, uintptr_t id)
+{
+    handler = irq_handler;
+    handler_id = id;
+}
+
+void serial_dma_rx_start(serial_t *obj, uint8_t *buffer, size_t size)
+{
+    ring = buffer;
+    ring_size = size;
+    head = 0;
+}
+
+size_t serial_dma_rx_head(serial_t *obj)
+{
+    return head;
+}
+
+void serial_dma_rx_stop(serial_t *obj)
+{
+    ring = nullptr;
+}
+
+void serial_dma_tx_start(serial_t *obj, const uint8_t *data, size_t length)
+{
+    sent.emplace_back(data, data + length);
+    transmitting = true;
+}
+
+int serial_dma_tx_active(serial_t *obj)
+{
+    return transmitting;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_SERIAL_DMA_STUB_H
+#define MBED_SERIAL_DMA_STUB_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/* Host model of the DMA serial HAL, serial_dma_stub.cpp
+ *
+ * It stands for one USART with a circular receive DMA channel and a
+ * transmit DMA channel. Bytes given to receive() are written to the ring at
+ * the DMA write index, which wraps, and the events are raised like the
+ * hardware does: at the middle and the end of the ring, and when the line
+ * goes idle after the bytes. Transmit transfers are recorded and stay in
+ * progress until complete_tx().
+ */
+namespace serial_dma_stub {
+
+/* No handler, reception stopped, no transfer */
+void reset();
+
+/* Bytes arriving on the line, followed by an idle line if idle is set */
+void receive(const void *data, size_t length, bool idle = true);
+
+/* Whether serial_dma_rx_start() was called and not stopped */
+bool rx_running();
+
+/* Whether a transmit transfer is in progress */
+bool tx_active();
+
+/* Finish the transmit transfer in progress, raising its event */
+void complete_tx();
+
+/* Finish the transfer without raising the event, as seen when the
+ * interrupts are masked */
+void complete_tx_silently();
+
+/* The bytes of each serial_dma_tx_start() */
+const std::vector<std::vector<uint8_t>> &transfers();
+
+} // namespace serial_dma_stub
+
+#endif
@@ -60,6 +60,7 @@
 #include "drivers/PortIn.h"
 #include "drivers/PortInOut.h"
 #include "drivers/PortOut.h"
+#include "drivers/Gpio.h"
 #include "drivers/AnalogIn.h"
 #include "drivers/AnalogOut.h"
 #include "drivers/PwmOut.h"
@@ -71,6 +72,7 @@
 #include "drivers/RawCAN.h"
 #include "drivers/UnbufferedSerial.h"
 #include "drivers/BufferedSerial.h"
+#include "drivers/DmaSerial.h"
 #include "drivers/FlashIAP.h"
 #include "drivers/MbedCRC.h"
 #include "drivers/QSPI.h"
@@ -99,6 +101,7 @@
 #include "platform/ATCmdParser.h"
 #include "platform/FileSystemHandle.h"
 #include "platform/FileHandle.h"
+#include "platform/PollEvent.h"
 #include "platform/DirHandle.h"
 #include "platform/CriticalSectionLock.h"
 #include "platform/DeepSleepLock.h"
@@ -254,6 +254,63 @@ public:
         return mbed::make_Span(dest.data(), popped);
     }
 
+    /** Contiguous free space at the head of the buffer.
+     *
+     * Build elements in place at the start of the region, then add them to
+     * the buffer with commit_write, so they are not copied. The region may be
+     * shorter than the total free space when it wraps around the end of the
+     * storage; when the buffer is empty it starts at the beginning of the
+     * storage, so the whole buffer is contiguous.
+     *
+     * Only one writer may hold a region at a time. Pops, from an interrupt
+     * for example, only make the free space larger.
+     *
+     * @return The writable region, empty if the buffer is full.
+     */
+    mbed::Span<T> write_region()
+    {
+        core_util_critical_section_enter();
+
+        if (non_critical_empty()) {
+            _head = 0;
+            _tail = 0;
+        }
+
+        CounterType contiguous;
+        if (_full) {
+            contiguous = 0;
+        } else if (_head < _tail) {
+            contiguous = _tail - _head;
+        } else {
+            contiguous = BufferSize - _head;
+        }
+
+        core_util_critical_section_exit();
+
+        return mbed::Span<T>(_buffer + _head, contiguous);
+    }
+
+    /** Add elements built at the start of write_region to the buffer.
+     *
+     * @param len Number of elements, at most the size of the last write_region.
+     */
+    void commit_write(CounterType len)
+    {
+        if (len == 0) {
+            return;
+        }
+
+        core_util_critical_section_enter();
+
+        MBED_ASSERT(len <= BufferSize - non_critical_size());
+        _head = incrementCounter(_head, len);
+        if (_head == _tail) {
+            _full = true;
+        }
+
+        core_util_critical_section_exit();
+    }
+
     /** Check if the buffer is empty.
      *
      * @return True if the buffer is empty, false if not.
@@ -24,6 +24,7 @@ typedef int FILEHANDLE;
 #include "platform/mbed_poll.h"
 #include "platform/platform.h"
 #include "platform/NonCopyable.h"
+#include "platform/Span.h"
 
 namespace mbed {
 
@@ -75,6 +76,73 @@ public:
      */
     virtual ssize_t write(const void *buffer, size_t size) = 0;
 
+    /** Write the contents of several buffers to a file, in order
+     *
+     *  Like POSIX writev(), for example to send a header, a payload and a
+     *  checksum without first copying them together.
+     *
+     *  The default implementation calls write() for each buffer and stops at
+     *  the first short write. Devices with a transmit buffer may override it
+     *  to queue all the buffers at once.
+     *
+     *  @param iov      The buffers to write from
+     *  @return         The number of bytes written, negative error on failure
+     *                  when nothing was written
+     */
+    virtual ssize_t writev(Span<const Span<const uint8_t>> iov)
+    {
+        ssize_t written = 0;
+        for (Span<const uint8_t> buffer : iov) {
+            if (buffer.empty()) {
+                continue;
+            }
+            ssize_t n = write(buffer.data(), buffer.size());
+            if (n < 0) {
+                return written != 0 ? written : n;
+            }
+            written += n;
+            if ((size_t)n < buffer.size()) {
+                break;
+            }
+        }
+        return written;
+    }
+
+    /** Read the contents of a file into several buffers, in order
+     *
+     *  Like POSIX readv(), for example to take a header and a payload into
+     *  separate buffers.
+     *
+     *  The default implementation calls read() for each buffer. Only the
+     *  first read may wait: a later buffer is only read while poll() reports
+     *  POLLIN, and reading stops at the first short read.
+     *
+     *  @param iov      The buffers to read in to
+     *  @return         The number of bytes read, 0 at end of file, negative
+     *                  error on failure when nothing was read
+     */
+    virtual ssize_t readv(Span<const Span<uint8_t>> iov)
+    {
+        ssize_t total = 0;
+        for (Span<uint8_t> buffer : iov) {
+            if (buffer.empty()) {
+                continue;
+            }
+            if (total != 0 && !(poll(POLLIN) & POLLIN)) {
+                break;
+            }
+            ssize_t n = read(buffer.data(), buffer.size());
+            if (n < 0) {
+                return total != 0 ? total : n;
+            }
+            total += n;
+            if ((size_t)n < buffer.size()) {
+                break;
+            }
+        }
+        return total;
+    }
+
     /** Move the file position to a given offset from from a given location
      *
      *  @param offset   The offset from whence to move to
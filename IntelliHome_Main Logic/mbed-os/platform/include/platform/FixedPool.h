@@ -0,0 +1,322 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2026 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_FIXEDPOOL_H
+#define MBED_FIXEDPOOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <new>
+#include <utility>
+#include "platform/NonCopyable.h"
+#include "platform/mbed_assert.h"
+
+namespace mbed {
+
+/** \addtogroup platform-public-api */
+/** @{*/
+/**
+ * \defgroup platform_FixedPool FixedPool class
+ * @{
+ */
+
+/** Untyped core of the fixed-block pools.
+ *
+ * Keeps the free blocks in a singly linked list threaded through the blocks
+ * themselves. The head of the list is one word holding the index of the
+ * first free block and a tag that changes on every update, so try_alloc and
+ * free are a single compare and swap on that word: O(1), without a critical
+ * section, and safe from interrupt handlers on any core that mbed_atomic
+ * supports. The tag guards against a handler recycling the head block
+ * between the load and the swap of the context it preempted.
+ *
+ * Occupancy, peak occupancy and the number of requests that found the pool
+ * empty are kept for every pool. With MBED_POOL_STATS_ENABLED the pools are
+ * also reported by mbed_stats_pool_get_each.
+ *
+ * @note Synchronization level: Interrupt safe.
+ */
+class FixedPoolBase : private NonCopyable<FixedPoolBase> {
+public:
+    /** Allocate a block.
+     *
+     * @return The block, or NULL if every block is in use.
+     */
+    void *try_alloc();
+
+    /** Allocate a block filled with zeros.
+     *
+     * @return The block, or NULL if every block is in use.
+     */
+    void *try_calloc()
+    {
+        void *block = try_alloc();
+        if (block) {
+            memset(block, 0, _block_size);
+        }
+        return block;
+    }
+
+    /** Return a block to the pool.
+     *
+     * @param block Block from try_alloc of this pool. NULL is ignored.
+     */
+    void free(void *block);
+
+    /** Check if a pointer is a block of this pool.
+     *
+     * @param ptr Pointer to check.
+     * @return True if ptr is the start of one of the blocks.
+     */
+    bool owns(const void *ptr) const;
+
+    /** Size of each block in bytes. */
+    uint32_t block_size() const
+    {
+        return _block_size;
+    }
+
+    /** Number of blocks. */
+    uint32_t capacity() const
+    {
+        return _block_count;
+    }
+
+    /** Number of blocks currently allocated. */
+    uint32_t in_use() const;
+
+    /** Largest number of blocks allocated at one time. */
+    uint32_t max_in_use() const;
+
+    /** Number of try_alloc calls that found every block in use. */
+    uint32_t fail_count() const;
+
+protected:
+    /** Create a pool over caller provided storage.
+     *
+     * @param storage     block_count blocks of block_size bytes.
+     * @param block_size  Size of each block, at least 2 bytes and even.
+     * @param block_count Number of blocks, at most 65535.
+     */
+    FixedPoolBase(void *storage, uint32_t block_size, uint32_t block_count);
+
+    ~FixedPoolBase();
+
+private:
+    friend struct FixedPoolRegistry;
+
+    uint16_t *link(uint32_t index) const
+    {
+        return reinterpret_cast<uint16_t *>(_storage + index * _block_size);
+    }
+
+    uint8_t *_storage;
+    uint32_t _block_size;
+    uint32_t _block_count;
+    // Tag in the high half, index + 1 of the first free block in the low
+    // half, 0 when the pool is empty
+    uint32_t _free_head;
+    uint32_t _in_use;
+    uint32_t _max_in_use;
+    uint32_t _fail_count;
+    FixedPoolBase *_next_pool;
+};
+
+/** Pool of N untyped blocks of BlockSize bytes.
+ *
+ * Blocks are aligned to 8 bytes when BlockSize is a multiple of 8, which
+ * makes them suitable to stand in for malloc.
+ *
+ * @tparam BlockSize Size of each block in bytes, even and at least 2.
+ * @tparam N         Number of blocks.
+ */
+template<uint32_t BlockSize, uint32_t N>
+class FixedBlockPool : public FixedPoolBase {
+    static_assert(BlockSize >= sizeof(uint16_t) && BlockSize % 2 == 0,
+                  "BlockSize must be even and at least 2 bytes");
+    static_assert(N > 0 && N <= 0xFFFF, "N must be between 1 and 65535");
+
+public:
+    FixedBlockPool() : FixedPoolBase(_blocks, BlockSize, N)
+    {
+    }
+
+private:
+    alignas(8) uint8_t _blocks[N][BlockSize];
+};
+
+/** Pool of N objects of type T.
+ *
+ * The bare-metal counterpart of rtos::MemoryPool: nothing blocks and every
+ * call is interrupt safe, since a pool never waits for a block.
+ *
+ * Usage:
+ * @code
+ *  struct message_t {
+ *      uint32_t id;
+ *      float value;
+ *  };
+ *
+ *  FixedPool<message_t, 4> pool;
+ *
+ *  void on_sample()
+ *  {
+ *      // Called from an interrupt
+ *      message_t *msg = pool.construct();
+ *      if (msg) {
+ *          ...
+ *      }
+ *  }
+ * @endcode
+ *
+ * @tparam T Type of the objects
+ * @tparam N Number of objects
+ */
+template<typename T, uint32_t N>
+class FixedPool : public FixedPoolBase {
+    static_assert(N > 0 && N <= 0xFFFF, "N must be between 1 and 65535");
+
+public:
+    FixedPool() : FixedPoolBase(_blocks, sizeof(block_t), N)
+    {
+    }
+
+    /** Allocate memory for one object, without constructing it.
+     *
+     * @return The memory, or NULL if the pool is exhausted.
+     */
+    T *try_alloc()
+    {
+        return static_cast<T *>(FixedPoolBase::try_alloc());
+    }
+
+    /** Allocate memory for one object filled with zeros.
+     *
+     * @return The memory, or NULL if the pool is exhausted.
+     */
+    T *try_calloc()
+    {
+        return static_cast<T *>(FixedPoolBase::try_calloc());
+    }
+
+    /** Allocate and construct one object.
+     *
+     * @param args Arguments of the T constructor.
+     * @return The object, or NULL if the pool is exhausted.
+     */
+    template <typename... Args>
+    T *construct(Args &&... args)
+    {
+        void *block = FixedPoolBase::try_alloc();
+        return block ? new (block) T(std::forward<Args>(args)...) : NULL;
+    }
+
+    /** Destroy an object from construct and return its memory.
+     *
+     * @param obj Object of this pool. NULL is ignored.
+     */
+    void destroy(T *obj)
+    {
+        if (obj) {
+            obj->~T();
+            FixedPoolBase::free(obj);
+        }
+    }
+
+    /** Return memory from try_alloc or try_calloc.
+     *
+     * @param obj Memory of this pool. NULL is ignored.
+     */
+    void free(T *obj)
+    {
+        FixedPoolBase::free(obj);
+    }
+
+private:
+    // A free block holds the link to the next one
+    union block_t {
+        uint16_t next;
+        alignas(T) uint8_t obj[sizeof(T)];
+    };
+
+    block_t _blocks[N];
+};
+
+/** Allocator over pools of increasing block sizes.
+ *
+ * A request is served by the smallest pool whose blocks fit it, or by a
+ * larger one when that pool is exhausted. The number of pools is fixed, so
+ * allocation and free stay O(1) and interrupt safe. Requests that no pool
+ * can serve return NULL, leaving the fallback, typically the heap, to the
+ * caller.
+ *
+ * Usage:
+ * @code
+ *  FixedBlockPool<16, 8> small;
+ *  FixedBlockPool<64, 4> large;
+ *  FixedPoolBase *const pools[] = { &small, &large };
+ *  FixedPoolAllocator allocator(pools, 2);
+ *
+ *  void *p = allocator.try_alloc(24); // from large
+ * @endcode
+ */
+class FixedPoolAllocator : private NonCopyable<FixedPoolAllocator> {
+public:
+    /** Create an allocator.
+     *
+     * @param pools Pools sorted by increasing block size, must stay valid.
+     * @param count Number of pools.
+     */
+    constexpr FixedPoolAllocator(FixedPoolBase *const *pools, size_t count) : _pools(pools), _count(count)
+    {
+    }
+
+    /** Allocate a block of at least size bytes.
+     *
+     * @param size Requested size.
+     * @return The block, or NULL if size is larger than every block or
+     *         every pool that fits it is exhausted.
+     */
+    void *try_alloc(size_t size);
+
+    /** Return a block to its pool.
+     *
+     * @param ptr Pointer to check and free.
+     * @return True if ptr was a block of one of the pools, false if it
+     *         belongs to someone else and was left alone.
+     */
+    bool free(void *ptr);
+
+    /** Find the pool of a block.
+     *
+     * @param ptr Pointer to check.
+     * @return The pool of ptr, or NULL if no pool owns it.
+     */
+    FixedPoolBase *owner(const void *ptr) const;
+
+private:
+    FixedPoolBase *const *_pools;
+    size_t _count;
+};
+
+/**@}*/
+
+/**@}*/
+
+}
+
+#endif
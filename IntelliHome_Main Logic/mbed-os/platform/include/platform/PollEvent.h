@@ -0,0 +1,110 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2026 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_POLLEVENT_H
+#define MBED_POLLEVENT_H
+
+#include "platform/FileHandle.h"
+
+namespace mbed {
+/** \addtogroup platform-public-api */
+/** @{*/
+/**
+ * \defgroup platform_PollEvent PollEvent class
+ * @{
+ */
+
+/** A pollable flag, for waiting on pin and timer events with poll_wait()
+ *
+ * set() marks the event ready for POLLIN and wakes poll_wait(), so an
+ * InterruptIn, Ticker or Timeout callback can end the wait next to the
+ * serial ports it watches. The event stays ready until clear().
+ *
+ * Reads and writes are not supported.
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * Example:
+ * @code
+ * UnbufferedSerial bt(PB_6, PB_7);
+ * InterruptIn motion(PA_0);
+ * PollEvent moved;
+ *
+ * int main() {
+ *     bt.sigio(poll_wake);
+ *     motion.rise(callback(&moved, &PollEvent::set));
+ *     pollfh fhs[] = {{&bt, POLLIN}, {&moved, POLLIN}};
+ *     while (1) {
+ *         poll_wait(fhs, 2, 1000);
+ *         if (moved.clear()) {
+ *             // motion
+ *         }
+ *         if (fhs[0].revents & POLLIN) {
+ *             // read bt
+ *         }
+ *     }
+ * }
+ * @endcode
+ */
+class PollEvent : public FileHandle {
+public:
+    PollEvent() = default;
+
+    /** Mark the event ready and wake poll_wait() */
+    void set();
+
+    /** Clear the event
+     *
+     *  @return true if the event was set
+     */
+    bool clear();
+
+    /** Check if the event is set
+     *
+     *  @return true if the event was set
+     */
+    bool is_set() const;
+
+    ssize_t read(void *buffer, size_t size) override;
+    ssize_t write(const void *buffer, size_t size) override;
+    off_t seek(off_t offset, int whence = SEEK_SET) override;
+    int close() override;
+
+    /** Check for poll event flags
+     *
+     *  @param events bitmask of poll events we're interested in
+     *  @return POLLIN if the event is set
+     */
+    short poll(short events) const override;
+
+    /** Register a callback called by set()
+     *
+     *  @param func Function to call, nullptr for none
+     */
+    void sigio(Callback<void()> func) override;
+
+private:
+    volatile bool _set = false;
+    Callback<void()> _sigio_cb;
+};
+
+/**@}*/
+
+/**@}*/
+
+} // namespace mbed
+
+#endif
@@ -0,0 +1,321 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2026 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_SPSCCIRCULARBUFFER_H
+#define MBED_SPSCCIRCULARBUFFER_H
+
+#include <stdint.h>
+#include <algorithm>
+#include "platform/CircularBuffer.h"
+#include "platform/NonCopyable.h"
+#include "platform/Span.h"
+#include "platform/mbed_atomic.h"
+
+namespace mbed {
+
+/** \addtogroup platform-public-api */
+/** @{*/
+/**
+ * \defgroup platform_SPSCCircularBuffer SPSCCircularBuffer functions
+ * @{
+ */
+
+/** Lock-free circular buffer for a single producer and a single consumer.
+ *
+ * Drop-in alternative to CircularBuffer when exactly one context pushes and
+ * exactly one context pops, for example a receive interrupt and the main
+ * loop. No critical section is ever entered: the producer owns the head
+ * index and the consumer owns the tail index, and each publishes its index
+ * with a release store that the other side reads with an acquire load.
+ *
+ * Unlike CircularBuffer, a push never overwrites unread data, since only the
+ * consumer may move the tail. A push into a full buffer stores nothing and
+ * reports it, which leaves the drop policy to the producer.
+ *
+ * write_region()/commit_write() and read_region()/commit_read() give direct
+ * access to the contiguous free and filled parts of the storage, so data can
+ * be received or parsed in place without a copy.
+ *
+ * @note Synchronization level: Interrupt safe for one producer and one
+ *       consumer. Methods are marked with the side that may call them.
+ *
+ * @tparam T Type of the elements
+ * @tparam BufferSize Number of elements
+ * @tparam CounterType Unsigned type of the indices, at most 32 bits so that
+ *         it is loaded and stored without a lock
+ */
+template<typename T, uint32_t BufferSize, typename CounterType = uint32_t>
+class SPSCCircularBuffer : private NonCopyable<SPSCCircularBuffer<T, BufferSize, CounterType> > {
+public:
+    SPSCCircularBuffer() : _head(0), _tail(0)
+    {
+        static_assert(
+            internal::is_unsigned<CounterType>::value,
+            "CounterType must be unsigned"
+        );
+
+        static_assert(
+            sizeof(CounterType) <= sizeof(uint32_t),
+            "CounterType must be at most 32 bits wide"
+        );
+
+        static_assert(
+            BufferSize > 0 && ((uint64_t) BufferSize * 2) <= (CounterType) - 1,
+            "Invalid BufferSize for the CounterType"
+        );
+    }
+
+    /** Push an element to the buffer. Producer only.
+     *
+     * @param data Element to be pushed.
+     * @return True if pushed, false if the buffer is full.
+     */
+    bool push(const T &data)
+    {
+        CounterType head = _head;
+        if (distance(head, acquire(&_tail)) == BufferSize) {
+            return false;
+        }
+        _buffer[index(head)] = data;
+        release(&_head, advance(head, 1));
+        return true;
+    }
+
+    /** Push elements to the buffer, as many as fit. Producer only.
+     *
+     * @param src Elements to be pushed.
+     * @param len Number of elements.
+     * @return The number of elements pushed.
+     */
+    CounterType push(const T *src, CounterType len)
+    {
+        CounterType pushed = 0;
+        // The free space can be split by the end of the storage
+        for (int pass = 0; pass < 2 && pushed < len; pass++) {
+            mbed::Span<T> region = write_region();
+            CounterType n = std::min<CounterType>(region.size(), len - pushed);
+            if (n == 0) {
+                break;
+            }
+            std::copy(src + pushed, src + pushed + n, region.data());
+            commit_write(n);
+            pushed += n;
+        }
+        return pushed;
+    }
+
+    /** Push elements to the buffer, as many as fit. Producer only.
+     *
+     * @param src Elements to be pushed.
+     * @return The number of elements pushed.
+     */
+    CounterType push(mbed::Span<const T> src)
+    {
+        return push(src.data(), src.size());
+    }
+
+    /** Pop an element from the buffer. Consumer only.
+     *
+     * @param data Container to store the element.
+     * @return True if an element was popped.
+     */
+    bool pop(T &data)
+    {
+        CounterType tail = _tail;
+        if (tail == acquire(&_head)) {
+            return false;
+        }
+        data = _buffer[index(tail)];
+        release(&_tail, advance(tail, 1));
+        return true;
+    }
+
+    /** Pop multiple elements from the buffer. Consumer only.
+     *
+     * @param dest The array which will receive the elements.
+     * @param len The number of elements to pop.
+     * @return The number of elements popped.
+     */
+    CounterType pop(T *dest, CounterType len)
+    {
+        CounterType popped = 0;
+        for (int pass = 0; pass < 2 && popped < len; pass++) {
+            mbed::Span<const T> region = read_region();
+            CounterType n = std::min<CounterType>(region.size(), len - popped);
+            if (n == 0) {
+                break;
+            }
+            std::copy(region.data(), region.data() + n, dest + popped);
+            commit_read(n);
+            popped += n;
+        }
+        return popped;
+    }
+
+    /** Pop multiple elements from the buffer. Consumer only.
+     *
+     * @param dest The span that receives the elements.
+     * @return The span with the size set to the number of elements popped.
+     */
+    mbed::Span<T> pop(mbed::Span<T> dest)
+    {
+        CounterType popped = pop(dest.data(), dest.size());
+        return mbed::make_Span(dest.data(), popped);
+    }
+
+    /** Peek at the oldest element without popping it. Consumer only.
+     *
+     * @param data Container to store the element.
+     * @return True if the buffer is not empty and data was set.
+     */
+    bool peek(T &data) const
+    {
+        CounterType tail = _tail;
+        if (tail == acquire(&_head)) {
+            return false;
+        }
+        data = _buffer[index(tail)];
+        return true;
+    }
+
+    /** Contiguous free space at the head of the buffer. Producer only.
+     *
+     * Fill the start of the region, then publish it with commit_write. The
+     * region may be shorter than the total free space when the free space
+     * wraps around the end of the storage.
+     *
+     * @return The writable region, empty if the buffer is full.
+     */
+    mbed::Span<T> write_region()
+    {
+        CounterType head = _head;
+        CounterType free = BufferSize - distance(head, acquire(&_tail));
+        CounterType contiguous = BufferSize - index(head);
+        return mbed::Span<T>(&_buffer[index(head)], std::min(free, contiguous));
+    }
+
+    /** Publish elements written to the start of write_region. Producer only.
+     *
+     * @param len Number of elements, at most the size of the last write_region.
+     */
+    void commit_write(CounterType len)
+    {
+        MBED_ASSERT(len <= BufferSize - index(_head));
+        release(&_head, advance(_head, len));
+    }
+
+    /** Contiguous filled space at the tail of the buffer. Consumer only.
+     *
+     * Read the start of the region, then free it with commit_read. The
+     * region may be shorter than size() when the data wraps around the end
+     * of the storage.
+     *
+     * @return The readable region, empty if the buffer is empty.
+     */
+    mbed::Span<const T> read_region() const
+    {
+        CounterType tail = _tail;
+        CounterType filled = distance(acquire(&_head), tail);
+        CounterType contiguous = BufferSize - index(tail);
+        return mbed::Span<const T>(&_buffer[index(tail)], std::min(filled, contiguous));
+    }
+
+    /** Free elements read from the start of read_region. Consumer only.
+     *
+     * @param len Number of elements, at most the size of the last read_region.
+     */
+    void commit_read(CounterType len)
+    {
+        MBED_ASSERT(len <= BufferSize - index(_tail));
+        release(&_tail, advance(_tail, len));
+    }
+
+    /** Check if the buffer is empty.
+     *
+     * @return True if the buffer is empty, false if not.
+     */
+    bool empty() const
+    {
+        return acquire(&_head) == acquire(&_tail);
+    }
+
+    /** Check if the buffer is full.
+     *
+     * @return True if the buffer is full, false if not.
+     */
+    bool full() const
+    {
+        return size() == BufferSize;
+    }
+
+    /** Get the number of elements currently stored in the buffer.
+     *
+     * Exact when called by either side, a snapshot otherwise.
+     */
+    CounterType size() const
+    {
+        CounterType tail = acquire(&_tail);
+        return distance(acquire(&_head), tail);
+    }
+
+    /** Drop every element in the buffer. Consumer only.
+     */
+    void reset()
+    {
+        release(&_tail, acquire(&_head));
+    }
+
+private:
+    // Indices run over twice the buffer size so that a full and an empty
+    // buffer can be told apart without a separate flag
+    static CounterType advance(CounterType val, CounterType increment)
+    {
+        CounterType room = (CounterType)(2 * BufferSize - val);
+        return increment >= room ? (CounterType)(increment - room) : (CounterType)(val + increment);
+    }
+
+    static CounterType index(CounterType val)
+    {
+        return val < BufferSize ? val : val - BufferSize;
+    }
+
+    static CounterType distance(CounterType head, CounterType tail)
+    {
+        return head >= tail ? head - tail : (CounterType)(head + 2 * BufferSize - tail);
+    }
+
+    static CounterType acquire(const CounterType *counter)
+    {
+        return core_util_atomic_load_explicit(counter, mbed_memory_order_acquire);
+    }
+
+    static void release(CounterType *counter, CounterType val)
+    {
+        core_util_atomic_store_explicit(counter, val, mbed_memory_order_release);
+    }
+
+    T _buffer[BufferSize];
+    CounterType _head;
+    CounterType _tail;
+};
+
+/**@}*/
+
+/**@}*/
+
+}
+
+#endif
@@ -0,0 +1,575 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2026 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_STATICFORMAT_H
+#define MBED_STATICFORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits>
+#include <type_traits>
+#include "platform/Span.h"
+
+namespace mbed {
+
+/** \addtogroup platform-public-api */
+/** @{*/
+/**
+ * \defgroup platform_StaticFormat StaticFormat functions
+ * @{
+ */
+
+/** Decimal scaled integer argument of StaticFormat, value / 10^Scale.
+ *
+ * Printed by `%f` with integer arithmetic, for example tenths of a degree
+ * as Scaled<1>(235) with "%.1f" gives "23.5".
+ */
+template<int Scale>
+struct Scaled {
+    static_assert(Scale >= 0 && Scale <= 9, "Scale must be 0 to 9");
+
+    constexpr explicit Scaled(int32_t scaled_value) : value(scaled_value) {}
+
+    int32_t value;
+};
+
+/** Binary fixed-point argument of StaticFormat, value / 2^FracBits.
+ *
+ * Printed by `%f` with integer arithmetic, for example a 16-bit ADC reading
+ * as a fraction is Fixed<16>(raw).
+ */
+template<int FracBits>
+struct Fixed {
+    static_assert(FracBits >= 0 && FracBits <= 31, "FracBits must be 0 to 31");
+
+    constexpr explicit Fixed(int32_t fixed_value) : value(fixed_value) {}
+
+    int32_t value;
+};
+
+#ifndef DOXYGEN_ONLY
+namespace impl {
+
+/* Format string specification, parsed by the compiler */
+struct static_format_spec {
+    char conversion;    // '\0' at the end of the format, '%' for "%%", '?' for a malformed one
+    bool left;          // '-' flag
+    bool zero;          // '0' flag
+    unsigned width;
+    int precision;      // -1 if not given
+    size_t begin;       // index of the '%'
+    size_t end;         // index after the specification
+};
+
+constexpr static_format_spec static_format_parse(const char *format, size_t pos)
+{
+    static_format_spec spec = { '\0', false, false, 0, -1, pos, pos };
+    while (format[pos] != '\0' && format[pos] != '%') {
+        pos++;
+    }
+    spec.begin = pos;
+    spec.end = pos;
+    if (format[pos] == '\0') {
+        return spec;
+    }
+    pos++;
+    for (;; pos++) {
+        if (format[pos] == '-') {
+            spec.left = true;
+        } else if (format[pos] == '0') {
+            spec.zero = true;
+        } else {
+            break;
+        }
+    }
+    while (format[pos] >= '0' && format[pos] <= '9') {
+        spec.width = spec.width * 10 + (format[pos++] - '0');
+    }
+    if (format[pos] == '.') {
+        spec.precision = 0;
+        pos++;
+        while (format[pos] >= '0' && format[pos] <= '9') {
+            spec.precision = spec.precision * 10 + (format[pos++] - '0');
+        }
+    }
+    /* length modifiers are not needed, the argument types are known */
+    switch (format[pos]) {
+        case '\0':
+            spec.conversion = '?';
+            return spec;
+        case 'i':
+            spec.conversion = 'd';
+            break;
+        case 'F':
+            spec.conversion = 'f';
+            break;
+        default:
+            spec.conversion = format[pos];
+            break;
+    }
+    spec.end = pos + 1;
+    return spec;
+}
+
+constexpr size_t static_format_max(size_t a, size_t b)
+{
+    return a > b ? a : b;
+}
+
+constexpr size_t static_format_digits(uint64_t value)
+{
+    size_t digits = 1;
+    while (value >= 10) {
+        value /= 10;
+        digits++;
+    }
+    return digits;
+}
+
+constexpr uint32_t static_format_pow10(int exponent)
+{
+    uint32_t value = 1;
+    while (exponent-- > 0) {
+        value *= 10;
+    }
+    return value;
+}
+
+/* Writes the reversed characters of a number with its sign and padding */
+template<bool left, bool zero, unsigned width>
+inline char *static_format_emit(char *p, bool negative, const char *reversed, unsigned count)
+{
+    unsigned len = count + negative;
+    unsigned pad = width > len ? width - len : 0;
+    if (!left && !zero) {
+        memset(p, ' ', pad);
+        p += pad;
+    }
+    if (negative) {
+        *p++ = '-';
+    }
+    if (!left && zero) {
+        memset(p, '0', pad);
+        p += pad;
+    }
+    while (count) {
+        *p++ = reversed[--count];
+    }
+    if (left) {
+        memset(p, ' ', pad);
+        p += pad;
+    }
+    return p;
+}
+
+template<typename U>
+inline unsigned static_format_reverse_decimal(char *reversed, U value)
+{
+    unsigned count = 0;
+    do {
+        reversed[count++] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+    return count;
+}
+
+template<typename T>
+using static_format_unsigned = std::conditional_t<sizeof(T) <= 4, uint32_t, uint64_t>;
+
+template<typename T>
+constexpr std::enable_if_t<std::is_signed<T>::value, bool> static_format_negative(T value)
+{
+    return value < 0;
+}
+
+template<typename T>
+constexpr std::enable_if_t<!std::is_signed<T>::value, bool> static_format_negative(T)
+{
+    return false;
+}
+
+/* One conversion with its flags, the argument type is checked here */
+template<char conversion, bool left, bool zero, unsigned width, int precision>
+struct static_format_arg {
+    static_assert(conversion != '?', "Malformed conversion at the end of the format");
+    static_assert(conversion == 'd' || conversion == 'u' || conversion == 'x' || conversion == 'X' ||
+                  conversion == 'c' || conversion == 's' || conversion == 'f',
+                  "Unsupported conversion, use d, i, u, x, X, c, s, f or F");
+
+    template<typename T>
+    static constexpr size_t max_size(T *)
+    {
+        return static_format_max(width, natural_size((T *) nullptr));
+    }
+
+    /* Integers */
+    template<typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+    static constexpr size_t natural_size(T *)
+    {
+        return conversion == 'c' ? 1 :
+               conversion == 'x' || conversion == 'X' ? sizeof(T) * 2 :
+               std::numeric_limits<T>::digits10 + 1 + std::is_signed<T>::value;
+    }
+
+    template<typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+    static char *write(char *p, T value)
+    {
+        static_assert(conversion != 's' && conversion != 'f', "Integer argument for %s or %f");
+        static_assert(conversion == 'd' || conversion == 'c' || std::is_unsigned<T>::value,
+                      "Signed argument for %u, %x or %X, use %d or cast it");
+        static_assert(conversion != 'c' || std::is_same<T, char>::value, "%c needs a char argument");
+        static_assert(precision < 0, "Precision is not supported for integers");
+
+        char reversed[sizeof(T) * 3];
+        unsigned count = 0;
+        bool negative = false;
+        if (conversion == 'c') {
+            reversed[count++] = (char) value;
+        } else if (conversion == 'x' || conversion == 'X') {
+            const char *hex = conversion == 'x' ? "0123456789abcdef" : "0123456789ABCDEF";
+            static_format_unsigned<T> magnitude = value;
+            do {
+                reversed[count++] = hex[magnitude & 0xF];
+                magnitude >>= 4;
+            } while (magnitude);
+        } else {
+            static_format_unsigned<T> magnitude = (static_format_unsigned<T>) value;
+            negative = static_format_negative(value);
+            if (negative) {
+                magnitude = 0 - magnitude;
+            }
+            count = static_format_reverse_decimal(reversed, magnitude);
+        }
+        return static_format_emit<left, zero, width>(p, negative, reversed, count);
+    }
+
+    /* Strings, the precision bounds the size */
+    static constexpr size_t natural_size(const char **)
+    {
+        return precision < 0 ? 0 : precision;
+    }
+
+    static constexpr size_t natural_size(char **)
+    {
+        return natural_size((const char **) nullptr);
+    }
+
+    static char *write(char *p, const char *value)
+    {
+        static_assert(conversion == 's', "String argument for a conversion other than %s");
+        static_assert(precision >= 0, "%s needs a precision, such as %.16s, to bound the output size");
+
+        unsigned len = strnlen(value, precision);
+        unsigned pad = width > len ? width - len : 0;
+        if (!left) {
+            memset(p, ' ', pad);
+            p += pad;
+        }
+        memcpy(p, value, len);
+        p += len;
+        if (left) {
+            memset(p, ' ', pad);
+            p += pad;
+        }
+        return p;
+    }
+
+    /* Fixed-point values, default of 6 decimals as for printf */
+    static constexpr int decimals = precision < 0 ? 6 : precision;
+
+    template<int Scale>
+    static constexpr size_t natural_size(Scaled<Scale> *)
+    {
+        return 1 + static_format_digits(2147483648u / static_format_pow10(Scale)) + (decimals ? 1 + decimals : 0);
+    }
+
+    template<int FracBits>
+    static constexpr size_t natural_size(Fixed<FracBits> *)
+    {
+        return 1 + static_format_digits(((uint64_t) 1) << (31 - FracBits)) + (decimals ? 1 + decimals : 0);
+    }
+
+    /* Rounds to nearest, ties to even, like printf */
+    static char *write_fixed(char *p, bool negative, uint32_t integer, uint32_t decimal, int rest)
+    {
+        bool odd = decimals ? (decimal & 1) : (integer & 1);
+        if (rest > 0 || (rest == 0 && odd)) {
+            if (++decimal >= static_format_pow10(decimals)) {
+                decimal = 0;
+                integer++;
+            }
+        }
+        char reversed[12 + decimals];
+        unsigned count = 0;
+        for (int i = 0; i < decimals; i++) {
+            reversed[count++] = '0' + decimal % 10;
+            decimal /= 10;
+        }
+        if (decimals) {
+            reversed[count++] = '.';
+        }
+        count += static_format_reverse_decimal(reversed + count, integer);
+        return static_format_emit<left, zero, width>(p, negative, reversed, count);
+    }
+
+    template<int Scale>
+    static char *write(char *p, Scaled<Scale> value)
+    {
+        static_assert(conversion == 'f', "Scaled argument for a conversion other than %f");
+        static_assert(decimals <= 9, "At most 9 decimals");
+
+        uint32_t magnitude = value.value < 0 ? 0u - (uint32_t) value.value : (uint32_t) value.value;
+        uint32_t integer = magnitude / static_format_pow10(Scale);
+        uint32_t fraction = magnitude % static_format_pow10(Scale);
+        if (decimals >= Scale) {
+            return write_fixed(p, value.value < 0, integer, fraction * static_format_pow10(decimals - Scale), -1);
+        }
+        constexpr uint32_t drop = static_format_pow10(Scale - decimals);
+        uint32_t rest = (fraction % drop) * 2;
+        return write_fixed(p, value.value < 0, integer, fraction / drop, rest > drop ? 1 : rest == drop ? 0 : -1);
+    }
+
+    template<int FracBits>
+    static char *write(char *p, Fixed<FracBits> value)
+    {
+        static_assert(conversion == 'f', "Fixed argument for a conversion other than %f");
+        static_assert(decimals <= 9, "At most 9 decimals");
+
+        uint32_t magnitude = value.value < 0 ? 0u - (uint32_t) value.value : (uint32_t) value.value;
+        uint32_t integer = FracBits ? magnitude >> FracBits : magnitude;
+        if (FracBits == 0) {
+            return write_fixed(p, value.value < 0, integer, 0, -1);
+        }
+        constexpr uint64_t half = ((uint64_t) 1) << (FracBits ? FracBits - 1 : 0);
+        uint64_t scaled = (uint64_t)(magnitude & (uint32_t)((half << 1) - 1)) * static_format_pow10(decimals);
+        uint64_t rest = scaled & ((half << 1) - 1);
+        return write_fixed(p, value.value < 0, integer, (uint32_t)(scaled >> FracBits),
+                           rest > half ? 1 : rest == half ? 0 : -1);
+    }
+};
+
+/* The writer of the format from index Pos, one step per conversion */
+template<typename Format, size_t Pos, char conversion = static_format_parse(Format::value(), Pos).conversion>
+struct static_format_step {
+    static constexpr static_format_spec spec = static_format_parse(Format::value(), Pos);
+    using arg = static_format_arg<spec.conversion, spec.left, spec.zero, spec.width, spec.precision>;
+    using next = static_format_step<Format, spec.end>;
+
+    template<typename T, typename... Rest>
+    static constexpr size_t max_size()
+    {
+        return spec.begin - Pos + arg::max_size((T *) nullptr) + next::template max_size<Rest...>();
+    }
+
+    template<typename T, typename... Rest>
+    static char *write(char *p, T value, Rest... rest)
+    {
+        memcpy(p, Format::value() + Pos, spec.begin - Pos);
+        p = arg::write(p + (spec.begin - Pos), value);
+        return next::write(p, rest...);
+    }
+
+    template<typename... None>
+    static char *write(char *p)
+    {
+        static_assert(sizeof...(None) != 0, "Not enough arguments for the format");
+        return p;
+    }
+};
+
+template<typename Format, size_t Pos>
+struct static_format_step<Format, Pos, '%'> {
+    static constexpr static_format_spec spec = static_format_parse(Format::value(), Pos);
+    using next = static_format_step<Format, spec.end>;
+
+    template<typename... Args>
+    static constexpr size_t max_size()
+    {
+        return spec.begin - Pos + 1 + next::template max_size<Args...>();
+    }
+
+    template<typename... Args>
+    static char *write(char *p, Args... args)
+    {
+        memcpy(p, Format::value() + Pos, spec.begin - Pos);
+        p += spec.begin - Pos;
+        *p++ = '%';
+        return next::write(p, args...);
+    }
+};
+
+template<typename Format, size_t Pos>
+struct static_format_step<Format, Pos, '\0'> {
+    static constexpr static_format_spec spec = static_format_parse(Format::value(), Pos);
+
+    template<typename... Args>
+    static constexpr size_t max_size()
+    {
+        static_assert(sizeof...(Args) == 0, "Too many arguments for the format");
+        return spec.begin - Pos;
+    }
+
+    template<typename... Args>
+    static char *write(char *p, Args...)
+    {
+        static_assert(sizeof...(Args) == 0, "Too many arguments for the format");
+        memcpy(p, Format::value() + Pos, spec.begin - Pos);
+        return p + (spec.begin - Pos);
+    }
+};
+
+template<typename Format, size_t Pos, char conversion>
+constexpr static_format_spec static_format_step<Format, Pos, conversion>::spec;
+
+template<typename Format, size_t Pos>
+constexpr static_format_spec static_format_step<Format, Pos, '%'>::spec;
+
+template<typename Format, size_t Pos>
+constexpr static_format_spec static_format_step<Format, Pos, '\0'>::spec;
+
+} // namespace impl
+#endif // DOXYGEN_ONLY
+
+/** Formatter for a format string known at compile time.
+ *
+ * The compiler parses the format and builds a writer for the call site:
+ * literal text is copied in chunks, and each conversion is a function
+ * specialized for its flags and argument type. There are no varargs and
+ * no parsing at run time. Argument types are checked against the format,
+ * and the largest output for the argument types is a compile time
+ * constant, max_size(), so a char array buffer that could be overrun does
+ * not compile.
+ *
+ * Create one with MBED_STATIC_FORMAT. Supported conversions:
+ * - `%d`, `%i`, `%u`, `%x`, `%X`: any integer type, `%u` and `%x` unsigned only.
+ * - `%c`: char.
+ * - `%s`: string, with a precision bounding its length, such as `%.16s`.
+ * - `%f`, `%F`: Scaled and Fixed values, printed with integer arithmetic
+ *   and rounded like printf. There is no floating point support.
+ * - `%%`.
+ *
+ * Flags `-` and `0`, and the width, are supported. The output is not NUL
+ * terminated.
+ *
+ * Example:
+ * @code
+ * char line[32];
+ * size_t len = MBED_STATIC_FORMAT("T=%.1f H=%d%%\r\n")(line, Scaled<1>(temp_tenths), humidity);
+ * uart.write(line, len);
+ * @endcode
+ *
+ * @tparam Format Type with a static constexpr value() returning the format
+ */
+template<typename Format>
+class StaticFormat {
+public:
+    /** Largest number of characters written for the argument types.
+     *
+     * @tparam Args Types of the arguments
+     */
+    template<typename... Args>
+    static constexpr size_t max_size()
+    {
+        return impl::static_format_step<Format, 0>::template max_size<std::decay_t<Args>...>();
+    }
+
+    /** Format into a buffer of a size known at compile time, which must hold max_size().
+     *
+     * @param buffer Output buffer
+     * @param args Arguments of the format
+     * @return Number of characters written
+     */
+    template<ptrdiff_t Extent, typename... Args>
+    size_t operator()(Span<char, Extent> buffer, Args... args) const
+    {
+        return format(buffer, std::integral_constant<bool, Extent == SPAN_DYNAMIC_EXTENT>(), args...);
+    }
+
+    /** Format into a char array, which must hold max_size().
+     *
+     * @param buffer Output buffer
+     * @param args Arguments of the format
+     * @return Number of characters written
+     */
+    template<size_t N, typename... Args>
+    size_t operator()(char (&buffer)[N], Args... args) const
+    {
+        return (*this)(Span<char, N>(buffer), args...);
+    }
+
+    /** Format into a buffer of a size known at run time.
+     *
+     * When the buffer is smaller than max_size(), the output is written to a
+     * temporary buffer on the stack first and cut to the size of the buffer.
+     *
+     * @param buffer Output buffer
+     * @param args Arguments of the format
+     * @return Number of characters written
+     */
+    template<typename... Args>
+    size_t operator()(Span<char> buffer, Args... args) const
+    {
+        return format(buffer, std::true_type(), args...);
+    }
+
+private:
+    template<ptrdiff_t Extent, typename... Args>
+    static size_t format(Span<char, Extent> buffer, std::false_type, Args... args)
+    {
+        static_assert(Extent >= (ptrdiff_t) max_size<Args...>(), "Buffer smaller than the largest output of the format");
+        return impl::static_format_step<Format, 0>::write(buffer.data(), args...) - buffer.data();
+    }
+
+    template<ptrdiff_t Extent, typename... Args>
+    static size_t format(Span<char, Extent> buffer, std::true_type, Args... args)
+    {
+        constexpr size_t size = max_size<Args...>();
+        if ((size_t) buffer.size() >= size) {
+            return impl::static_format_step<Format, 0>::write(buffer.data(), args...) - buffer.data();
+        }
+        char scratch[size + 1];
+        size_t len = impl::static_format_step<Format, 0>::write(scratch, args...) - scratch;
+        if (len > (size_t) buffer.size()) {
+            len = buffer.size();
+        }
+        memcpy(buffer.data(), scratch, len);
+        return len;
+    }
+};
+
+/** Create a StaticFormat for a string literal.
+ *
+ * @param format String literal, parsed at compile time
+ */
+#define MBED_STATIC_FORMAT(format)                                      \
+    ([] {                                                               \
+        struct mbed_static_format_string {                              \
+            static constexpr const char *value()                        \
+            {                                                           \
+                return format;                                          \
+            }                                                           \
+        };                                                              \
+        return ::mbed::StaticFormat<mbed_static_format_string>();       \
+    }())
+
+/**@}*/
+
+/**@}*/
+
+} // namespace mbed
+
+#endif // MBED_STATICFORMAT_H
@@ -0,0 +1,91 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2026 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_FORMAT_FIXED_H
+#define MBED_FORMAT_FIXED_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_format_fixed Fixed-point formatting functions
+ *
+ * Decimal formatting of fixed-point and scaled-integer values with integer
+ * arithmetic only, as an alternative to `%f` that needs neither the
+ * floating point printf nor `double` math.
+ *
+ * The functions behave like snprintf: the output is always NUL terminated
+ * when length is not 0, and the return value is the number of characters
+ * the full output needs, so calls can be chained into one buffer.
+ * The values are rounded like printf does, to nearest with ties to even,
+ * so the text is the same as `%.<decimals>f` of the exact value.
+ *
+ * Example:
+ * @code
+ * char line[32];
+ * int len = mbed_format_scaled(line, sizeof(line), temperature_tenths, 1, 1);
+ * len += snprintf(line + len, sizeof(line) - len, ",");
+ * len += mbed_format_fixed(line + len, sizeof(line) - len, adc_q16, 16, 2);
+ * @endcode
+ * @{
+ */
+
+/** Largest number of decimals the functions print */
+#define MBED_FORMAT_FIXED_MAX_DECIMALS 9
+
+/** Format a binary fixed-point value, value / 2^frac_bits.
+ *
+ * @param buffer    buffer to write to, may be NULL if length is 0
+ * @param length    size of the buffer
+ * @param value     signed fixed-point value, for example Q16.16 with frac_bits 16
+ * @param frac_bits number of fractional bits, 0 to 31
+ * @param decimals  number of decimals to print, 0 to MBED_FORMAT_FIXED_MAX_DECIMALS
+ * @return number of characters of the output, excluding the NUL, or
+ *         a negative value if frac_bits or decimals is out of range
+ */
+int mbed_format_fixed(char *buffer, size_t length, int32_t value, int frac_bits, int decimals);
+
+/** Format a decimal scaled integer, value / 10^scale.
+ *
+ * Dropped digits are rounded, missing ones are filled with zeros, so
+ * 1234 at scale 2 prints as "12.3" with 1 decimal and "12.340" with 3.
+ *
+ * @param buffer    buffer to write to, may be NULL if length is 0
+ * @param length    size of the buffer
+ * @param value     signed scaled value, for example tenths of a degree with scale 1
+ * @param scale     number of decimal digits of value after the point, 0 to MBED_FORMAT_FIXED_MAX_DECIMALS
+ * @param decimals  number of decimals to print, 0 to MBED_FORMAT_FIXED_MAX_DECIMALS
+ * @return number of characters of the output, excluding the NUL, or
+ *         a negative value if scale or decimals is out of range
+ */
+int mbed_format_scaled(char *buffer, size_t length, int32_t value, int scale, int decimals);
+
+/**@}*/
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_FORMAT_FIXED_H
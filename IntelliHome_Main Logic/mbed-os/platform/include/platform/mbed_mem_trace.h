@@ -162,6 +162,74 @@ void mbed_mem_trace_free(void *ptr, void *caller);
  */
 void mbed_mem_trace_default_callback(uint8_t op, void *res, void *caller, ...);
 
+/* Sync byte of the records of the binary tracer */
+#define MBED_MEM_TRACE_BINARY_SYNC          0x1C
+
+/* Size of a record of the binary tracer */
+#define MBED_MEM_TRACE_BINARY_RECORD_SIZE   24
+
+/**
+ * Binary memory trace callback. DO NOT CALL DIRECTLY. It is meant to be given to
+ * 'mbed_mem_trace_set_callback'.
+ *
+ * Formatting a text line for each memory operation takes much longer than the
+ * operation itself. The binary callback instead copies a fixed size record into
+ * a RAM ring of 'platform.memory-tracing-buffer-size' bytes, which
+ * 'mbed_mem_trace_binary_drain' writes out later, for example from the main loop.
+ * When the ring is full the record is dropped and counted.
+ *
+ * Each record is MBED_MEM_TRACE_BINARY_RECORD_SIZE bytes, little endian:
+ *
+ * - offset 0: MBED_MEM_TRACE_BINARY_SYNC.
+ * - offset 1: the operation (MBED_MEM_TRACE_MALLOC, ...).
+ * - offset 2: 16 bit sequence number. It counts dropped records too, so the reader
+ *   can tell how many are missing.
+ * - offset 4: time given by the function set with 'mbed_mem_trace_binary_time_function_set'.
+ * - offset 8: the result of the operation, 0 for 'free'.
+ * - offset 12: the 'ptr' argument of 'realloc' and 'free', 0 for 'malloc' and 'calloc'.
+ * - offset 16: the size asked for, 'nmemb' * 'size' for 'calloc', 0 for 'free'.
+ * - offset 20: the caller of the operation.
+ *
+ * Addresses are stored as 32 bit values. tools/debug_tools/mem_trace_analyzer
+ * rebuilds the live heap over time, the peak use of each call site and the
+ * fragmentation of the heap from the records.
+ *
+ * @note Only available when 'platform.memory-tracing-enabled' is set.
+ */
+void mbed_mem_trace_binary_callback(uint8_t op, void *res, void *caller, ...);
+
+/**
+ * Write out records of the binary tracer with the output function.
+ *
+ * Only whole records are written, so text and the records of other tracers
+ * sent to the same port between two drains never land inside a record.
+ *
+ * @param max bytes to write, rounded up to whole records, 0 to empty the ring.
+ * @return number of bytes written.
+ */
+size_t mbed_mem_trace_binary_drain(size_t max);
+
+/**
+ * Set the function that receives the bytes drained from the binary tracer.
+ * By default, the bytes are written to stdout.
+ *
+ * @param write_f the output function, NULL for the default one.
+ */
+void mbed_mem_trace_binary_output_function_set(void (*write_f)(const uint8_t *data, size_t len));
+
+/**
+ * Set the time source of the binary tracer records, for example 'us_ticker_read'.
+ * Without a time source every record has a time of 0.
+ *
+ * @param time_f the time function.
+ */
+void mbed_mem_trace_binary_time_function_set(uint32_t (*time_f)(void));
+
+/**
+ * Number of binary tracer records dropped because the ring was full.
+ */
+uint32_t mbed_mem_trace_binary_dropped(void);
+
 /** @}*/
 
 #ifdef __cplusplus
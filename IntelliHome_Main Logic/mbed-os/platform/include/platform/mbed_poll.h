@@ -23,6 +23,8 @@
 #define POLLHUP        0x2000 ///< The device has been disconnected
 #define POLLNVAL       0x4000 ///< The specified file handle value is invalid
 
+#define MBED_POLL_WAKE_FLAG 0x40000000 ///< Thread flag used by poll_wait() to sleep until poll_wake()
+
 namespace mbed {
 
 class FileHandle;
@@ -53,6 +55,35 @@ struct pollfh {
  */
 int poll(pollfh fhs[], unsigned nfhs, int timeout);
 
+/** Wait for events on a set of file handles, sleeping between them.
+ *
+ * poll() rescans its file handles every millisecond. poll_wait() scans them,
+ * then sleeps until poll_wake() is called or the timeout expires, so the
+ * device idles between inputs and rescans as soon as one of them changes.
+ *
+ * Every file handle in the set must call poll_wake() when its state changes,
+ * usually from its sigio() callback: fh->sigio(poll_wake). A handle that
+ * never does is only seen at the timeout. Pin and timer events join the set
+ * through a PollEvent set from their interrupt callback.
+ *
+ * Only one thread at a time may wait in poll_wait(). It uses one of the
+ * thread flags of the caller, MBED_POLL_WAKE_FLAG.
+ *
+ * @param fhs     an array of PollFh struct carrying a FileHandle and bitmasks of events
+ * @param nfhs    number of file handles
+ * @param timeout timeout in milliseconds or -1 to wait forever
+ *
+ * @return number of file handles selected (for which revents is non-zero). 0 if timed out with nothing selected.
+ */
+int poll_wait(pollfh fhs[], unsigned nfhs, int timeout);
+
+/** Wake poll_wait() to rescan its file handles.
+ *
+ * Interrupt safe. With no poll_wait() in progress it does nothing, as
+ * poll_wait() always scans its file handles before it sleeps.
+ */
+void poll_wake();
+
 /**@}*/
 
 /**@}*/
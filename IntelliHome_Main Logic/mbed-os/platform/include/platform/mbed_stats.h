@@ -49,6 +49,9 @@ extern "C" {
 #ifndef MBED_THREAD_STATS_ENABLED
 #define MBED_THREAD_STATS_ENABLED   1
 #endif
+#ifndef MBED_POOL_STATS_ENABLED
+#define MBED_POOL_STATS_ENABLED     1
+#endif
 
 #endif // MBED_ALL_STATS_ENABLED
 
@@ -75,6 +78,28 @@ typedef struct {
  */
 void mbed_stats_heap_get(mbed_stats_heap_t *stats);
 
+/**
+ * struct mbed_stats_pool_t definition
+ */
+typedef struct {
+    uint32_t block_size;        /**< Size of each block of the pool in bytes */
+    uint32_t block_cnt;         /**< Number of blocks in the pool */
+    uint32_t current_cnt;       /**< Number of blocks currently allocated */
+    uint32_t max_cnt;           /**< Maximum number of blocks allocated at one time */
+    uint32_t alloc_fail_cnt;    /**< Number of allocations that found every block in use */
+} mbed_stats_pool_t;
+
+/**
+ *  Fill the passed array of structures with the statistics of each fixed-block pool (see FixedPool.h).
+ *
+ *  @param stats    A pointer to an array of mbed_stats_pool_t structures to fill
+ *  @param count    The number of mbed_stats_pool_t structures in the provided array
+ *  @return         The number of mbed_stats_pool_t structures that have been filled.
+ *                  If the number of pools on the system is less than or equal to count, it will equal the number of pools on the system.
+ *                  If the number of pools on the system is greater than count, it will equal count.
+ */
+size_t mbed_stats_pool_get_each(mbed_stats_pool_t *stats, size_t count);
+
 /**
  * struct mbed_stats_stack_t definition
  */
@@ -85,9 +110,15 @@ typedef struct {
     uint32_t stack_cnt;         /**< The number of stacks represented in the accumulated statistics or 1 if representing a single stack */
 } mbed_stats_stack_t;
 
+/** Value the unused stack is filled with when stack statistics are enabled
+ *  without the rtos. The high water mark is the first word that differs.
+ */
+#define MBED_STACK_STATS_PAINT_VALUE 0xE25A2EA5UL
+
 /**
  *  Fill the passed in structure with stack statistics accumulated for all threads. The thread_id will be 0
  *  and stack_cnt will represent number of threads.
+ *  Without the rtos the single main/ISR stack is reported.
  *
  *  @param stats    A pointer to the mbed_stats_stack_t structure to fill
  */
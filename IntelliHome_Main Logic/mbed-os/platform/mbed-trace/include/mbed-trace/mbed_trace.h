@@ -69,6 +69,10 @@ extern "C" {
 #define MBED_CONF_MBED_TRACE_ENABLE 0
 #endif
 
+#ifndef MBED_CONF_MBED_TRACE_DEFERRED
+#define MBED_CONF_MBED_TRACE_DEFERRED 0
+#endif
+
 #if !defined(MBED_CONF_MBED_TRACE_FEA_IPV6) && MBED_CONF_NANOSTACK_LIBSERVICE_PRESENT
 #define MBED_CONF_MBED_TRACE_FEA_IPV6 1
 #endif
@@ -118,30 +122,37 @@ extern "C" {
 #define MBED_TRACE_MAX_LEVEL TRACE_LEVEL_INFO
 #endif
 
+// In deferred mode C++ call sites only store binary records, see mbed_trace_deferred.h
+#if MBED_CONF_MBED_TRACE_DEFERRED && MBED_CONF_MBED_TRACE_ENABLE && defined(__cplusplus)
+#define MBED_TRACE_CALL(dlevel, grp, ...)   MBED_TRACE_DEFERRED(dlevel, grp, __VA_ARGS__)
+#else
+#define MBED_TRACE_CALL(dlevel, grp, ...)   mbed_tracef(dlevel, grp, __VA_ARGS__)
+#endif
+
 //usage macros:
 #if MBED_TRACE_MAX_LEVEL >= TRACE_LEVEL_DEBUG
-#define tr_debug(...)           mbed_tracef(TRACE_LEVEL_DEBUG,   TRACE_GROUP, __VA_ARGS__)   //!< Print debug message
+#define tr_debug(...)           MBED_TRACE_CALL(TRACE_LEVEL_DEBUG, TRACE_GROUP, __VA_ARGS__)   //!< Print debug message
 #else
 #define tr_debug(...)
 #endif
 
 #if MBED_TRACE_MAX_LEVEL >= TRACE_LEVEL_INFO
-#define tr_info(...)            mbed_tracef(TRACE_LEVEL_INFO,    TRACE_GROUP, __VA_ARGS__)   //!< Print info message
+#define tr_info(...)            MBED_TRACE_CALL(TRACE_LEVEL_INFO, TRACE_GROUP, __VA_ARGS__)   //!< Print info message
 #else
 #define tr_info(...)
 #endif
 
 #if MBED_TRACE_MAX_LEVEL >= TRACE_LEVEL_WARN
-#define tr_warning(...)         mbed_tracef(TRACE_LEVEL_WARN,    TRACE_GROUP, __VA_ARGS__)   //!< Print warning message
-#define tr_warn(...)            mbed_tracef(TRACE_LEVEL_WARN,    TRACE_GROUP, __VA_ARGS__)   //!< Alternative warning message
+#define tr_warning(...)         MBED_TRACE_CALL(TRACE_LEVEL_WARN, TRACE_GROUP, __VA_ARGS__)   //!< Print warning message
+#define tr_warn(...)            MBED_TRACE_CALL(TRACE_LEVEL_WARN, TRACE_GROUP, __VA_ARGS__)   //!< Alternative warning message
 #else
 #define tr_warning(...)
 #define tr_warn(...)
 #endif
 
 #if MBED_TRACE_MAX_LEVEL >= TRACE_LEVEL_ERROR
-#define tr_error(...)           mbed_tracef(TRACE_LEVEL_ERROR,   TRACE_GROUP, __VA_ARGS__)   //!< Print Error Message
-#define tr_err(...)             mbed_tracef(TRACE_LEVEL_ERROR,   TRACE_GROUP, __VA_ARGS__)   //!< Alternative error message
+#define tr_error(...)           MBED_TRACE_CALL(TRACE_LEVEL_ERROR, TRACE_GROUP, __VA_ARGS__)   //!< Print Error Message
+#define tr_err(...)             MBED_TRACE_CALL(TRACE_LEVEL_ERROR, TRACE_GROUP, __VA_ARGS__)   //!< Alternative error message
 #else
 #define tr_error(...)
 #define tr_err(...)
@@ -366,6 +377,10 @@ char *mbed_trace_array(const uint8_t *buf, uint16_t len);
 }
 #endif
 
+#if MBED_CONF_MBED_TRACE_DEFERRED
+#include "mbed-trace/mbed_trace_deferred.h"
+#endif
+
 #endif /* MBED_TRACE_H_ */
 
 /* These macros are outside the inclusion guard so they will be re-evaluated for every inclusion of the header.
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2026 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file mbed_trace_deferred.h
+ * Deferred binary trace records.
+ *
+ * With mbed-trace.deferred enabled, the tr_debug/tr_info/tr_warn/tr_error
+ * macros of C++ sources do not format anything on the device. The level,
+ * group and format string of each call site are placed in the .mbed_trace_fmt
+ * section, which the GCC_ARM linker script keeps in the ELF file but does not
+ * load into flash. ARM and IAR builds are refused: armlink and ilink have no
+ * such non-loaded placement here and would put every format string in flash,
+ * in a section the decoder does not find. A call only stores a small binary
+ * record in a RAM ring:
+ *
+ *   0x1E, payload length, payload
+ *   payload: varint time delta, varint string id, arguments
+ *
+ * The string id is the address of the call site's string in .mbed_trace_fmt.
+ * Integer and pointer arguments are varints of their bit pattern, floating
+ * point arguments four byte little endian floats and strings a varint length
+ * followed by the characters. When records have been dropped because the ring
+ * was full, a 0x1D byte followed by a varint count precedes the next record.
+ *
+ * mbed_trace_deferred_drain() writes the ring out, typically from the main
+ * loop, and tools/trace_decoder rebuilds the text lines on the host from the
+ * byte stream and the ELF file. Bytes outside records pass through the
+ * decoder unchanged, so plain printf output can share the same port.
+ *
+ * C sources keep the formatting mbed_tracef path. Include and exclude group
+ * filters do not apply to deferred records, the trace level does.
+ */
+#ifndef MBED_TRACE_DEFERRED_H_
+#define MBED_TRACE_DEFERRED_H_
+
+#if MBED_CONF_MBED_TRACE_DEFERRED && (defined(__ARMCC_VERSION) || defined(__ICCARM__))
+#error "mbed-trace.deferred is only supported with GCC_ARM, whose linker script keeps .mbed_trace_fmt out of flash"
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Record sync byte */
+#define MBED_TRACE_DEFERRED_SYNC    0x1E
+/** Dropped records marker, followed by a varint count */
+#define MBED_TRACE_DEFERRED_DROPPED 0x1D
+
+/** Largest record payload without the time delta, longer strings are cut */
+#ifndef MBED_TRACE_DEFERRED_RECORD_SIZE
+#define MBED_TRACE_DEFERRED_RECORD_SIZE 48
+#endif
+
+/** Record being built by a trace call */
+typedef struct {
+    uint8_t len;
+    bool full;
+    uint8_t data[MBED_TRACE_DEFERRED_RECORD_SIZE];
+} mbed_trace_record_t;
+
+/**
+ * Start a record
+ * @param rec    record to fill
+ * @param dlevel trace level of the call
+ * @param fmt    call site string in .mbed_trace_fmt
+ * @return false when the level is not active and nothing is to be recorded
+ */
+bool mbed_trace_deferred_begin(mbed_trace_record_t *rec, uint8_t dlevel, const char *fmt);
+/**
+ * Time stamp a record and copy it to the ring, or count it as dropped
+ * Safe to call from interrupt context.
+ */
+void mbed_trace_deferred_end(mbed_trace_record_t *rec);
+/**
+ * Write out records from the ring with the output function
+ * Only whole records are written, so text and the records of other tracers
+ * sent to the same port between two drains never land inside a record.
+ * @param max   bytes after which to stop, at the end of the record being
+ *              written, 0 to empty the ring
+ * @return number of bytes written
+ */
+size_t mbed_trace_deferred_drain(size_t max);
+/**
+ * Set the function that receives the drained bytes
+ * By default, the bytes are written to stdout.
+ */
+void mbed_trace_deferred_output_function_set(void (*write_f)(const uint8_t *data, size_t len));
+/**
+ * Set the time source of the records
+ * Records carry the difference to the previous record, so the function
+ * may wrap. Without a time source every delta is 0.
+ * e.g.
+ *   mbed_trace_deferred_time_function_set(us_ticker_read);
+ */
+void mbed_trace_deferred_time_function_set(uint32_t (*time_f)(void));
+/**
+ * Number of records dropped because the ring was full
+ */
+uint32_t mbed_trace_deferred_dropped(void);
+
+static inline uint8_t mbed_trace_deferred_varint(uint8_t *out, uint64_t value)
+{
+    uint8_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t) value;
+    return n;
+}
+
+static inline bool mbed_trace_deferred_room(mbed_trace_record_t *rec, size_t len)
+{
+    if (rec->full || rec->len + len > MBED_TRACE_DEFERRED_RECORD_SIZE) {
+        // Later arguments would be decoded in the wrong place
+        rec->full = true;
+        return false;
+    }
+    return true;
+}
+
+static inline void mbed_trace_deferred_put_u32(mbed_trace_record_t *rec, uint32_t value)
+{
+    uint8_t buf[5];
+    uint8_t n = 0;
+    while (value >= 0x80) {
+        buf[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    buf[n++] = (uint8_t) value;
+    if (mbed_trace_deferred_room(rec, n)) {
+        memcpy(&rec->data[rec->len], buf, n);
+        rec->len += n;
+    }
+}
+
+static inline void mbed_trace_deferred_put_u64(mbed_trace_record_t *rec, uint64_t value)
+{
+    uint8_t buf[10];
+    uint8_t n = mbed_trace_deferred_varint(buf, value);
+    if (mbed_trace_deferred_room(rec, n)) {
+        memcpy(&rec->data[rec->len], buf, n);
+        rec->len += n;
+    }
+}
+
+static inline void mbed_trace_deferred_put_float(mbed_trace_record_t *rec, float value)
+{
+    if (mbed_trace_deferred_room(rec, sizeof(value))) {
+        // Little endian targets only, like the host decoder
+        memcpy(&rec->data[rec->len], &value, sizeof(value));
+        rec->len += sizeof(value);
+    }
+}
+
+static inline void mbed_trace_deferred_put_string(mbed_trace_record_t *rec, const char *str)
+{
+    size_t len = str ? strlen(str) : 0;
+    size_t space = rec->full ? 0 : MBED_TRACE_DEFERRED_RECORD_SIZE - rec->len;
+    if (space < 1) {
+        rec->full = true;
+        return;
+    }
+    // Cut the string to what is left, with a one byte length below 128
+    if (len > space - 1) {
+        len = space - 1;
+    }
+    if (len > 127) {
+        len = 127;
+    }
+    rec->data[rec->len++] = (uint8_t) len;
+    if (len) {
+        memcpy(&rec->data[rec->len], str, len);
+        rec->len += len;
+    }
+}
+
+#ifdef __cplusplus
+}
+
+#include <type_traits>
+
+#if defined(__GNUC__) || defined(__CC_ARM)
+#define MBED_TRACE_DEFERRED_SECTION __attribute__((section(".mbed_trace_fmt"), used))
+#else
+#define MBED_TRACE_DEFERRED_SECTION
+#endif
+
+#define MBED_TRACE_DEFERRED_STR_(x) #x
+#define MBED_TRACE_DEFERRED_STR(x)  MBED_TRACE_DEFERRED_STR_(x)
+
+/**
+ * Record a trace call, used by the tr_ macros in deferred mode
+ * @param dlevel trace level, a TRACE_LEVEL_ constant
+ * @param grp    trace group, a string literal
+ * @param fmt    printf format, a string literal
+ */
+#define MBED_TRACE_DEFERRED(dlevel, grp, fmt, ...)                                                  \
+    do {                                                                                            \
+        static const char mbed_trace_site_[] MBED_TRACE_DEFERRED_SECTION =                          \
+            MBED_TRACE_DEFERRED_STR(dlevel) "\0" grp "\0" fmt;                                      \
+        if (0) {                                                                                    \
+            mbed_trace_deferred_format_check(fmt, ##__VA_ARGS__);                                   \
+        }                                                                                           \
+        mbed_trace_deferred(dlevel, mbed_trace_site_, ##__VA_ARGS__);                               \
+    } while (0)
+
+// Never called, keeps the printf format warnings of the formatting path
+#if defined(__GNUC__) || defined(__CC_ARM)
+static inline void mbed_trace_deferred_format_check(const char *fmt, ...) __attribute__((__format__(__printf__, 1, 2)));
+#endif
+static inline void mbed_trace_deferred_format_check(const char *fmt, ...)
+{
+    (void) fmt;
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+mbed_trace_deferred_put(mbed_trace_record_t *rec, T value)
+{
+    if (sizeof(T) > sizeof(uint32_t)) {
+        mbed_trace_deferred_put_u64(rec, (uint64_t) value);
+    } else {
+        mbed_trace_deferred_put_u32(rec, (uint32_t) value);
+    }
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_floating_point<T>::value>::type
+mbed_trace_deferred_put(mbed_trace_record_t *rec, T value)
+{
+    mbed_trace_deferred_put_float(rec, (float) value);
+}
+
+template <typename T>
+inline void mbed_trace_deferred_put(mbed_trace_record_t *rec, T *ptr)
+{
+    mbed_trace_deferred_put_u64(rec, (uintptr_t) ptr);
+}
+
+// Character pointers are copied as strings, also when printed with %p
+inline void mbed_trace_deferred_put(mbed_trace_record_t *rec, const char *str)
+{
+    mbed_trace_deferred_put_string(rec, str);
+}
+
+inline void mbed_trace_deferred_put(mbed_trace_record_t *rec, char *str)
+{
+    mbed_trace_deferred_put_string(rec, str);
+}
+
+template <typename... Args>
+inline void mbed_trace_deferred(uint8_t dlevel, const char *site, Args... args)
+{
+    mbed_trace_record_t rec;
+    if (mbed_trace_deferred_begin(&rec, dlevel, site)) {
+        int expand[] = { 0, (mbed_trace_deferred_put(&rec, args), 0)... };
+        (void) expand;
+        mbed_trace_deferred_end(&rec);
+    }
+}
+
+#endif /* __cplusplus */
+
+#endif /* MBED_TRACE_DEFERRED_H_ */
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+
+#ifdef MBED_CONF_MBED_TRACE_ENABLE
+#undef MBED_CONF_MBED_TRACE_ENABLE
+#endif
+#define MBED_CONF_MBED_TRACE_ENABLE 1
+
+#include "mbed-trace/mbed_trace.h"
+#include "mbed-trace/mbed_trace_deferred.h"
+
+#if MBED_CONF_MBED_TRACE_DEFERRED
+
+#include "platform/SPSCCircularBuffer.h"
+#include "platform/mbed_critical.h"
+
+#ifndef MBED_CONF_MBED_TRACE_DEFERRED_BUFFER_SIZE
+#define MBED_CONF_MBED_TRACE_DEFERRED_BUFFER_SIZE 256
+#endif
+
+static_assert(MBED_CONF_MBED_TRACE_DEFERRED_BUFFER_SIZE >= 2 + 5 + MBED_TRACE_DEFERRED_RECORD_SIZE,
+              "mbed-trace.deferred-buffer-size must hold at least one record");
+
+static void mbed_trace_deferred_default_write(const uint8_t *data, size_t len)
+{
+    fwrite(data, 1, len, stdout);
+    fflush(stdout);
+}
+
+// Several contexts may end records, so the producer side of the ring is
+// serialized with a critical section. Only mbed_trace_deferred_drain reads.
+static struct {
+    mbed::SPSCCircularBuffer<uint8_t, MBED_CONF_MBED_TRACE_DEFERRED_BUFFER_SIZE> ring;
+    void (*write_f)(const uint8_t *data, size_t len);
+    uint32_t (*time_f)(void);
+    uint32_t last_time;
+    uint32_t dropped;
+    uint32_t dropped_pending;
+} m_deferred = {
+    {},
+    mbed_trace_deferred_default_write,
+    NULL,
+    0,
+    0,
+    0
+};
+
+static bool mbed_trace_deferred_push(const uint8_t *data, uint32_t len)
+{
+    return m_deferred.ring.push(data, len) == len;
+}
+
+bool mbed_trace_deferred_begin(mbed_trace_record_t *rec, uint8_t dlevel, const char *fmt)
+{
+    if ((mbed_trace_config_get() & TRACE_MASK_LEVEL & dlevel) == 0) {
+        return false;
+    }
+    rec->len = 0;
+    rec->full = false;
+    mbed_trace_deferred_put_u64(rec, (uintptr_t) fmt);
+    return true;
+}
+
+void mbed_trace_deferred_end(mbed_trace_record_t *rec)
+{
+    uint8_t head[2 + 5];
+    uint8_t marker[1 + 5];
+
+    core_util_critical_section_enter();
+    uint32_t now = m_deferred.time_f ? m_deferred.time_f() : 0;
+    uint8_t time_len = mbed_trace_deferred_varint(&head[2], now - m_deferred.last_time);
+    head[0] = MBED_TRACE_DEFERRED_SYNC;
+    head[1] = time_len + rec->len;
+
+    uint32_t space = MBED_CONF_MBED_TRACE_DEFERRED_BUFFER_SIZE - m_deferred.ring.size();
+    uint8_t marker_len = 0;
+    if (m_deferred.dropped_pending) {
+        marker[0] = MBED_TRACE_DEFERRED_DROPPED;
+        marker_len = 1 + mbed_trace_deferred_varint(&marker[1], m_deferred.dropped_pending);
+    }
+
+    if (marker_len + 2u + time_len + rec->len <= space) {
+        if (marker_len) {
+            mbed_trace_deferred_push(marker, marker_len);
+            m_deferred.dropped_pending = 0;
+        }
+        mbed_trace_deferred_push(head, 2 + time_len);
+        mbed_trace_deferred_push(rec->data, rec->len);
+        m_deferred.last_time = now;
+    } else {
+        m_deferred.dropped++;
+        m_deferred.dropped_pending++;
+    }
+    core_util_critical_section_exit();
+}
+
+size_t mbed_trace_deferred_drain(size_t max)
+{
+    // Records are pushed whole, so the ring always starts at a record. The
+    // drain only stops between records, where the heap tracer and plain text
+    // sharing the output may go.
+    enum { NEXT, LENGTH, PAYLOAD, DROPPED } state = NEXT;
+    uint8_t left = 0;
+    size_t written = 0;
+    bool stop = false;
+    while (!stop) {
+        mbed::Span<const uint8_t> data = m_deferred.ring.read_region();
+        if (data.empty()) {
+            break;
+        }
+        size_t len = 0;
+        while (len < data.size()) {
+            if (state == NEXT && max && written + len >= max) {
+                stop = true;
+                break;
+            }
+            uint8_t byte = data[len++];
+            switch (state) {
+                case NEXT:
+                    if (byte == MBED_TRACE_DEFERRED_SYNC) {
+                        state = LENGTH;
+                    } else if (byte == MBED_TRACE_DEFERRED_DROPPED) {
+                        state = DROPPED;
+                    }
+                    break;
+                case LENGTH:
+                    left = byte;
+                    state = left ? PAYLOAD : NEXT;
+                    break;
+                case PAYLOAD:
+                    if (--left == 0) {
+                        state = NEXT;
+                    }
+                    break;
+                case DROPPED:
+                    if ((byte & 0x80) == 0) {
+                        state = NEXT;
+                    }
+                    break;
+            }
+        }
+        if (len) {
+            m_deferred.write_f(data.data(), len);
+            m_deferred.ring.commit_read(len);
+            written += len;
+        }
+    }
+    return written;
+}
+
+void mbed_trace_deferred_output_function_set(void (*write_f)(const uint8_t *data, size_t len))
+{
+    m_deferred.write_f = write_f ? write_f : mbed_trace_deferred_default_write;
+}
+
+void mbed_trace_deferred_time_function_set(uint32_t (*time_f)(void))
+{
+    m_deferred.time_f = time_f;
+}
+
+uint32_t mbed_trace_deferred_dropped(void)
+{
+    return core_util_atomic_load_u32(&m_deferred.dropped);
+}
+
+#endif /* MBED_CONF_MBED_TRACE_DEFERRED */
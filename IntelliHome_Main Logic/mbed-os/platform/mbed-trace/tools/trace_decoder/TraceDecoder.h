@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2026 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file TraceDecoder.h
+ * Host side decoder of deferred mbed-trace records.
+ *
+ * Turns the byte stream written by mbed_trace_deferred_drain() back into
+ * the lines mbed_tracef would have printed. See mbed_trace_deferred.h for
+ * the record format.
+ */
+#ifndef MBED_TRACE_DECODER_H_
+#define MBED_TRACE_DECODER_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <functional>
+#include <string>
+
+#include "mbed-trace/mbed_trace.h"
+#include "mbed-trace/mbed_trace_deferred.h"
+
+class TraceDecoder {
+public:
+    /** Find the call site string, "<level>\0<group>\0<format>", of a string id */
+    typedef std::function<const char *(uint64_t id)> Lookup;
+    /** Receive one decoded line, without the line ending */
+    typedef std::function<void(const std::string &line)> Output;
+
+    TraceDecoder(Lookup lookup, Output output) :
+        _lookup(lookup), _output(output), _state(TEXT), _time(0)
+    {
+    }
+
+    /** Decode the next bytes of the stream */
+    void feed(const uint8_t *data, size_t len)
+    {
+        for (size_t i = 0; i < len; i++) {
+            feed(data[i]);
+        }
+    }
+
+    /** Output a pending text line that has no line ending yet */
+    void flush()
+    {
+        if (!_text.empty()) {
+            _output(_text);
+            _text.clear();
+        }
+    }
+
+    /** Sum of the time deltas of the records decoded so far */
+    uint64_t time() const
+    {
+        return _time;
+    }
+
+private:
+    enum State { TEXT, LENGTH, PAYLOAD, DROPPED, HEAP };
+
+    // Heap records of mbed_mem_trace_binary_callback may share the port,
+    // see platform/mbed_mem_trace.h
+    static const uint8_t MEM_TRACE_SYNC = 0x1C;
+    static const size_t MEM_TRACE_RECORD_SIZE = 24;
+
+    void feed(uint8_t byte)
+    {
+        switch (_state) {
+            case TEXT:
+                if (byte == MBED_TRACE_DEFERRED_SYNC || byte == MBED_TRACE_DEFERRED_DROPPED) {
+                    flush();
+                    _payload.clear();
+                    _state = byte == MBED_TRACE_DEFERRED_SYNC ? LENGTH : DROPPED;
+                } else if (byte == MEM_TRACE_SYNC) {
+                    _length = MEM_TRACE_RECORD_SIZE - 1;
+                    _state = HEAP;
+                } else if (byte == '\n') {
+                    _output(_text);
+                    _text.clear();
+                } else if (byte != '\r') {
+                    _text += (char) byte;
+                }
+                break;
+            case LENGTH:
+                _length = byte;
+                _state = _length ? PAYLOAD : TEXT;
+                break;
+            case PAYLOAD:
+                _payload += (char) byte;
+                if (_payload.size() == _length) {
+                    record();
+                    _state = TEXT;
+                }
+                break;
+            case HEAP:
+                if (--_length == 0) {
+                    _state = TEXT;
+                }
+                break;
+            case DROPPED:
+                _payload += (char) byte;
+                if ((byte & 0x80) == 0) {
+                    size_t pos = 0;
+                    unsigned long long count = varint(pos);
+                    _output("[dropped " + std::to_string(count) + " trace records]");
+                    _state = TEXT;
+                }
+                break;
+        }
+    }
+
+    uint64_t varint(size_t &pos) const
+    {
+        uint64_t value = 0;
+        for (unsigned shift = 0; pos < _payload.size() && shift < 64; shift += 7) {
+            uint8_t byte = _payload[pos++];
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                break;
+            }
+        }
+        return value;
+    }
+
+    static const char *level_name(unsigned long level)
+    {
+        switch (level) {
+            case TRACE_LEVEL_DEBUG:
+                return "DBG ";
+            case TRACE_LEVEL_INFO:
+                return "INFO";
+            case TRACE_LEVEL_WARN:
+                return "WARN";
+            case TRACE_LEVEL_ERROR:
+                return "ERR ";
+            case TRACE_LEVEL_CMD:
+                return "CMD ";
+            default:
+                return "??? ";
+        }
+    }
+
+    void record()
+    {
+        size_t pos = 0;
+        _time += varint(pos);
+        uint64_t id = varint(pos);
+
+        const char *site = _lookup(id);
+        if (site == NULL) {
+            char line[64];
+            snprintf(line, sizeof(line), "[??? ][    ]: unknown trace id 0x%llx", (unsigned long long) id);
+            _output(line);
+            return;
+        }
+        const char *grp = site + strlen(site) + 1;
+        const char *fmt = grp + strlen(grp) + 1;
+
+        char prefix[32];
+        snprintf(prefix, sizeof(prefix), "[%s][%-4s]: ", level_name(strtoul(site, NULL, 0)), grp);
+        _output(prefix + format(fmt, pos));
+    }
+
+    bool has(size_t pos, size_t len) const
+    {
+        return pos + len <= _payload.size();
+    }
+
+    // Rebuild the text of a printf format from the recorded arguments. A
+    // record cut short on the device prints "?" for the missing arguments.
+    std::string format(const char *fmt, size_t &pos) const
+    {
+        std::string out;
+        char buf[128];
+        while (*fmt) {
+            if (*fmt != '%') {
+                out += *fmt++;
+                continue;
+            }
+            const char *start = fmt++;
+            if (*fmt == '%') {
+                out += '%';
+                fmt++;
+                continue;
+            }
+
+            std::string spec("%");
+            while (*fmt && strchr("-+ #0", *fmt)) {
+                spec += *fmt++;
+            }
+            bool ok = true;
+            for (int field = 0; field < 2; field++) {
+                if (field == 1) {
+                    if (*fmt != '.') {
+                        break;
+                    }
+                    spec += *fmt++;
+                }
+                if (*fmt == '*') {
+                    fmt++;
+                    ok = ok && has(pos, 1);
+                    spec += std::to_string((int32_t)(uint32_t) varint(pos));
+                } else {
+                    while (*fmt >= '0' && *fmt <= '9') {
+                        spec += *fmt++;
+                    }
+                }
+            }
+
+            int longs = 0;
+            int shorts = 0;
+            while (*fmt && strchr("hljztL", *fmt)) {
+                longs += *fmt == 'l' || *fmt == 'j' ? (*fmt == 'j' ? 2 : 1) : 0;
+                shorts += *fmt == 'h';
+                fmt++;
+            }
+            char conv = *fmt;
+            if (conv == '\0') {
+                out.append(start);
+                break;
+            }
+            fmt++;
+
+            buf[0] = '\0';
+            if (strchr("di", conv)) {
+                ok = ok && has(pos, 1);
+                uint64_t raw = varint(pos);
+                long long value = longs >= 2 || raw > UINT32_MAX ? (long long) raw : (long long)(int32_t)(uint32_t) raw;
+                value = shorts == 2 ? (signed char) value : shorts == 1 ? (short) value : value;
+                snprintf(buf, sizeof(buf), (spec + "ll" + conv).c_str(), value);
+            } else if (strchr("uxXo", conv)) {
+                ok = ok && has(pos, 1);
+                unsigned long long value = varint(pos);
+                value = shorts == 2 ? (unsigned char) value : shorts == 1 ? (unsigned short) value : value;
+                snprintf(buf, sizeof(buf), (spec + "ll" + conv).c_str(), value);
+            } else if (conv == 'c') {
+                ok = ok && has(pos, 1);
+                snprintf(buf, sizeof(buf), (spec + conv).c_str(), (int) varint(pos));
+            } else if (conv == 'p') {
+                ok = ok && has(pos, 1);
+                snprintf(buf, sizeof(buf), "0x%llx", (unsigned long long) varint(pos));
+            } else if (conv == 's') {
+                ok = ok && has(pos, 1);
+                size_t len = (size_t) varint(pos);
+                std::string str;
+                if (ok && has(pos, len)) {
+                    str = _payload.substr(pos, len);
+                    pos += len;
+                }
+                snprintf(buf, sizeof(buf), (spec + 's').c_str(), str.c_str());
+            } else if (strchr("fFeEgGaA", conv)) {
+                float value = 0;
+                ok = ok && has(pos, sizeof(value));
+                if (ok) {
+                    memcpy(&value, &_payload[pos], sizeof(value));
+                    pos += sizeof(value);
+                }
+                snprintf(buf, sizeof(buf), (spec + conv).c_str(), (double) value);
+            } else {
+                // %n and unknown conversions are printed as they are
+                out.append(start, fmt - start);
+                continue;
+            }
+            out += ok ? buf : "?";
+        }
+        return out;
+    }
+
+    Lookup _lookup;
+    Output _output;
+    State _state;
+    size_t _length;
+    uint64_t _time;
+    std::string _text;
+    std::string _payload;
+};
+
+#endif /* MBED_TRACE_DECODER_H_ */
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Decode deferred mbed-trace output with the format strings of an ELF file.
+//
+//   trace_decoder [-t] firmware.elf [capture.bin]
+//
+// Reads the trace stream from the capture file, or from stdin, and prints
+// the rebuilt lines to stdout. -t prefixes each line with the record time.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include "TraceDecoder.h"
+
+struct Section {
+    uint64_t addr;
+    std::vector<char> data;
+};
+
+template <typename T>
+static bool read_at(const std::vector<char> &file, uint64_t offset, T *value)
+{
+    if (offset > file.size() || file.size() - offset < sizeof(T)) {
+        return false;
+    }
+    memcpy(value, &file[offset], sizeof(T));
+    return true;
+}
+
+static bool read_file(FILE *f, std::vector<char> &out)
+{
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        out.insert(out.end(), buf, buf + n);
+    }
+    return !ferror(f);
+}
+
+// Little endian ELF32 and ELF64 files only, like the targets that write the
+// records
+static bool load_section(const char *path, const char *name, Section &section)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return false;
+    }
+    std::vector<char> file;
+    bool ok = read_file(f, file);
+    fclose(f);
+    if (!ok || file.size() < 0x40 || memcmp(&file[0], "\x7f" "ELF", 4) != 0 || file[5] != 1) {
+        return false;
+    }
+
+    bool elf64 = file[4] == 2;
+    uint64_t shoff;
+    uint16_t shentsize, shnum, shstrndx;
+    if (elf64) {
+        read_at(file, 0x28, &shoff);
+        read_at(file, 0x3A, &shentsize);
+        read_at(file, 0x3C, &shnum);
+        read_at(file, 0x3E, &shstrndx);
+    } else {
+        uint32_t shoff32;
+        read_at(file, 0x20, &shoff32);
+        shoff = shoff32;
+        read_at(file, 0x2E, &shentsize);
+        read_at(file, 0x30, &shnum);
+        read_at(file, 0x32, &shstrndx);
+    }
+
+    // Name, address, offset and size of a section header
+    auto header = [&](uint16_t index, uint32_t *sh_name, uint64_t *addr, uint64_t *offset, uint64_t *size) {
+        uint64_t base = shoff + (uint64_t) index * shentsize;
+        if (elf64) {
+            return read_at(file, base, sh_name) && read_at(file, base + 0x10, addr) &&
+                   read_at(file, base + 0x18, offset) && read_at(file, base + 0x20, size);
+        }
+        uint32_t addr32, offset32, size32;
+        bool ok = read_at(file, base, sh_name) && read_at(file, base + 0x0C, &addr32) &&
+                  read_at(file, base + 0x10, &offset32) && read_at(file, base + 0x14, &size32);
+        *addr = addr32;
+        *offset = offset32;
+        *size = size32;
+        return ok;
+    };
+
+    uint32_t sh_name;
+    uint64_t addr, offset, size;
+    if (!header(shstrndx, &sh_name, &addr, &offset, &size) || offset > file.size()) {
+        return false;
+    }
+    uint64_t strtab = offset;
+    for (uint16_t i = 0; i < shnum; i++) {
+        if (!header(i, &sh_name, &addr, &offset, &size) || strtab + sh_name >= file.size()) {
+            continue;
+        }
+        if (file.size() - strtab - sh_name > strlen(name) &&
+                memcmp(&file[strtab + sh_name], name, strlen(name) + 1) == 0 &&
+                offset <= file.size() && size <= file.size() - offset) {
+            section.addr = addr;
+            section.data.assign(file.begin() + offset, file.begin() + offset + size);
+            // Keep a damaged last string from running off the end
+            section.data.push_back('\0');
+            section.data.push_back('\0');
+            section.data.push_back('\0');
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char **argv)
+{
+    bool times = false;
+    int arg = 1;
+    if (arg < argc && strcmp(argv[arg], "-t") == 0) {
+        times = true;
+        arg++;
+    }
+    if (arg >= argc || argc - arg > 2) {
+        fprintf(stderr, "usage: %s [-t] firmware.elf [capture.bin]\n", argv[0]);
+        return 2;
+    }
+
+    Section section;
+    if (!load_section(argv[arg], ".mbed_trace_fmt", section)) {
+        fprintf(stderr, "%s: no .mbed_trace_fmt section in %s\n", argv[0], argv[arg]);
+        return 1;
+    }
+
+    FILE *in = stdin;
+    if (arg + 1 < argc) {
+        in = fopen(argv[arg + 1], "rb");
+        if (!in) {
+            perror(argv[arg + 1]);
+            return 1;
+        }
+    }
+
+    TraceDecoder *decoder = NULL;
+    TraceDecoder dec([&section](uint64_t id) -> const char * {
+        if (id < section.addr || id - section.addr >= section.data.size() - 3) {
+            return NULL;
+        }
+        return &section.data[id - section.addr];
+    }, [&times, &decoder](const std::string &line) {
+        if (times) {
+            printf("%10llu ", (unsigned long long) decoder->time());
+        }
+        printf("%s\n", line.c_str());
+        fflush(stdout);
+    });
+    decoder = &dec;
+
+    // Byte by byte, so that lines of a live serial port show up at once
+    int c;
+    while ((c = getc(in)) != EOF) {
+        uint8_t byte = (uint8_t) c;
+        dec.feed(&byte, 1);
+    }
+    dec.flush();
+
+    if (in != stdin) {
+        fclose(in);
+    }
+    return 0;
+}
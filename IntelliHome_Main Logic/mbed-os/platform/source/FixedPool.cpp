@@ -0,0 +1,259 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2026 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "platform/FixedPool.h"
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_stats.h"
+
+namespace mbed {
+
+#define FREE_INDEX_MASK 0xFFFFu
+#define FREE_TAG_STEP   0x10000u
+
+// Pools reported by mbed_stats_pool_get_each, changed and walked inside a
+// critical section
+struct FixedPoolRegistry {
+    static FixedPoolBase *head;
+
+    static void add(FixedPoolBase *pool)
+    {
+        core_util_critical_section_enter();
+        pool->_next_pool = head;
+        head = pool;
+        core_util_critical_section_exit();
+    }
+
+    static void remove(FixedPoolBase *pool)
+    {
+        core_util_critical_section_enter();
+        for (FixedPoolBase **p = &head; *p; p = &(*p)->_next_pool) {
+            if (*p == pool) {
+                *p = pool->_next_pool;
+                break;
+            }
+        }
+        core_util_critical_section_exit();
+    }
+
+    static size_t get_each(mbed_stats_pool_t *stats, size_t count)
+    {
+        size_t i = 0;
+        core_util_critical_section_enter();
+        for (FixedPoolBase *pool = head; pool && i < count; pool = pool->_next_pool, i++) {
+            stats[i].block_size = pool->block_size();
+            stats[i].block_cnt = pool->capacity();
+            stats[i].current_cnt = pool->in_use();
+            stats[i].max_cnt = pool->max_in_use();
+            stats[i].alloc_fail_cnt = pool->fail_count();
+        }
+        core_util_critical_section_exit();
+        return i;
+    }
+};
+
+FixedPoolBase *FixedPoolRegistry::head = NULL;
+
+// A pool with static storage may be asked for a block by malloc before its
+// constructor runs. Its zero initialized head then reads as empty and the
+// request falls back to the heap.
+FixedPoolBase::FixedPoolBase(void *storage, uint32_t block_size, uint32_t block_count)
+    : _storage(static_cast<uint8_t *>(storage)), _block_size(block_size), _block_count(block_count),
+      _free_head(0), _in_use(0), _max_in_use(0), _fail_count(0), _next_pool(NULL)
+{
+    MBED_ASSERT(block_size >= sizeof(uint16_t) && block_size % 2 == 0);
+    MBED_ASSERT(block_count > 0 && block_count <= FREE_INDEX_MASK);
+
+    for (uint32_t i = 0; i < block_count - 1; i++) {
+        *link(i) = (uint16_t)(i + 2);
+    }
+    *link(block_count - 1) = 0;
+    core_util_atomic_store_u32(&_free_head, 1);
+
+#if MBED_POOL_STATS_ENABLED
+    FixedPoolRegistry::add(this);
+#endif
+}
+
+FixedPoolBase::~FixedPoolBase()
+{
+#if MBED_POOL_STATS_ENABLED
+    FixedPoolRegistry::remove(this);
+#endif
+}
+
+void *FixedPoolBase::try_alloc()
+{
+    uint32_t head = core_util_atomic_load_u32(&_free_head);
+    uint32_t index;
+    uint32_t next;
+    do {
+        index = head & FREE_INDEX_MASK;
+        if (index == 0) {
+            core_util_atomic_incr_u32(&_fail_count, 1);
+            return NULL;
+        }
+        // The block may be taken and written by a preempting context after
+        // this read, in which case the tag has moved and the swap fails
+        next = *link(index - 1);
+    } while (!core_util_atomic_cas_u32(&_free_head, &head, ((head + FREE_TAG_STEP) & ~FREE_INDEX_MASK) | next));
+
+    uint32_t used = core_util_atomic_incr_u32(&_in_use, 1);
+    uint32_t max = core_util_atomic_load_u32(&_max_in_use);
+    while (used > max && !core_util_atomic_cas_u32(&_max_in_use, &max, used)) {
+    }
+
+    return _storage + (index - 1) * _block_size;
+}
+
+void FixedPoolBase::free(void *block)
+{
+    if (block == NULL) {
+        return;
+    }
+    MBED_ASSERT(owns(block));
+
+    uint32_t index = (static_cast<uint8_t *>(block) - _storage) / _block_size;
+    uint32_t head = core_util_atomic_load_u32(&_free_head);
+    do {
+        *link(index) = (uint16_t)(head & FREE_INDEX_MASK);
+    } while (!core_util_atomic_cas_u32(&_free_head, &head, ((head + FREE_TAG_STEP) & ~FREE_INDEX_MASK) | (index + 1)));
+
+    core_util_atomic_decr_u32(&_in_use, 1);
+}
+
+bool FixedPoolBase::owns(const void *ptr) const
+{
+    const uint8_t *p = static_cast<const uint8_t *>(ptr);
+    if (p < _storage || p >= _storage + _block_count * _block_size) {
+        return false;
+    }
+    return (p - _storage) % _block_size == 0;
+}
+
+uint32_t FixedPoolBase::in_use() const
+{
+    return core_util_atomic_load_u32(&_in_use);
+}
+
+uint32_t FixedPoolBase::max_in_use() const
+{
+    return core_util_atomic_load_u32(&_max_in_use);
+}
+
+uint32_t FixedPoolBase::fail_count() const
+{
+    return core_util_atomic_load_u32(&_fail_count);
+}
+
+void *FixedPoolAllocator::try_alloc(size_t size)
+{
+    for (size_t i = 0; i < _count; i++) {
+        if (size <= _pools[i]->block_size()) {
+            void *block = _pools[i]->try_alloc();
+            if (block) {
+                return block;
+            }
+        }
+    }
+    return NULL;
+}
+
+bool FixedPoolAllocator::free(void *ptr)
+{
+    FixedPoolBase *pool = owner(ptr);
+    if (pool == NULL) {
+        return false;
+    }
+    pool->free(ptr);
+    return true;
+}
+
+FixedPoolBase *FixedPoolAllocator::owner(const void *ptr) const
+{
+    for (size_t i = 0; i < _count; i++) {
+        if (_pools[i]->owns(ptr)) {
+            return _pools[i];
+        }
+    }
+    return NULL;
+}
+
+} // namespace mbed
+
+/******************************************************************************/
+/* Pools behind malloc, used by mbed_alloc_wrappers.cpp                       */
+/******************************************************************************/
+
+#if MBED_CONF_PLATFORM_POOL_MALLOC_ENABLED
+
+static_assert(MBED_CONF_PLATFORM_POOL_MALLOC_16_COUNT + MBED_CONF_PLATFORM_POOL_MALLOC_32_COUNT +
+              MBED_CONF_PLATFORM_POOL_MALLOC_64_COUNT > 0,
+              "platform.pool-malloc-enabled needs at least one size class");
+
+#if MBED_CONF_PLATFORM_POOL_MALLOC_16_COUNT
+static mbed::FixedBlockPool<16, MBED_CONF_PLATFORM_POOL_MALLOC_16_COUNT> malloc_pool_16;
+#endif
+#if MBED_CONF_PLATFORM_POOL_MALLOC_32_COUNT
+static mbed::FixedBlockPool<32, MBED_CONF_PLATFORM_POOL_MALLOC_32_COUNT> malloc_pool_32;
+#endif
+#if MBED_CONF_PLATFORM_POOL_MALLOC_64_COUNT
+static mbed::FixedBlockPool<64, MBED_CONF_PLATFORM_POOL_MALLOC_64_COUNT> malloc_pool_64;
+#endif
+
+static mbed::FixedPoolBase *const malloc_pools[] = {
+#if MBED_CONF_PLATFORM_POOL_MALLOC_16_COUNT
+    &malloc_pool_16,
+#endif
+#if MBED_CONF_PLATFORM_POOL_MALLOC_32_COUNT
+    &malloc_pool_32,
+#endif
+#if MBED_CONF_PLATFORM_POOL_MALLOC_64_COUNT
+    &malloc_pool_64,
+#endif
+};
+
+static mbed::FixedPoolAllocator malloc_pool_allocator(malloc_pools, sizeof(malloc_pools) / sizeof(malloc_pools[0]));
+
+extern "C" void *mbed_pool_malloc(size_t size)
+{
+    return malloc_pool_allocator.try_alloc(size);
+}
+
+extern "C" size_t mbed_pool_block_size(const void *ptr)
+{
+    mbed::FixedPoolBase *pool = malloc_pool_allocator.owner(ptr);
+    return pool ? pool->block_size() : 0;
+}
+
+extern "C" bool mbed_pool_free(void *ptr)
+{
+    return malloc_pool_allocator.free(ptr);
+}
+
+#endif // MBED_CONF_PLATFORM_POOL_MALLOC_ENABLED
+
+size_t mbed_stats_pool_get_each(mbed_stats_pool_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_stats_pool_t));
+
+#if MBED_POOL_STATS_ENABLED
+    return mbed::FixedPoolRegistry::get_each(stats, count);
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,82 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2026 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "platform/PollEvent.h"
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_poll.h"
+
+namespace mbed {
+
+void PollEvent::set()
+{
+    core_util_atomic_store_bool(&_set, true);
+    poll_wake();
+
+    core_util_critical_section_enter();
+    Callback<void()> cb = _sigio_cb;
+    core_util_critical_section_exit();
+    if (cb) {
+        cb();
+    }
+}
+
+bool PollEvent::clear()
+{
+    return core_util_atomic_exchange_bool(&_set, false);
+}
+
+bool PollEvent::is_set() const
+{
+    return core_util_atomic_load_bool(&_set);
+}
+
+ssize_t PollEvent::read(void *, size_t)
+{
+    return -EINVAL;
+}
+
+ssize_t PollEvent::write(const void *, size_t)
+{
+    return -EINVAL;
+}
+
+off_t PollEvent::seek(off_t, int)
+{
+    return -ESPIPE;
+}
+
+int PollEvent::close()
+{
+    return 0;
+}
+
+short PollEvent::poll(short events) const
+{
+    return (events & POLLIN) && is_set() ? POLLIN : 0;
+}
+
+void PollEvent::sigio(Callback<void()> func)
+{
+    core_util_critical_section_enter();
+    _sigio_cb = func;
+    core_util_critical_section_exit();
+    if (func && is_set()) {
+        func();
+    }
+}
+
+} // namespace mbed
@@ -84,6 +84,16 @@ void mbed_stats_heap_get(mbed_stats_heap_t *stats)
 #endif
 }
 
+#if MBED_CONF_PLATFORM_POOL_MALLOC_ENABLED
+/* Fixed-block pools tried before the heap, see FixedPool.cpp. Their blocks
+   are reported by mbed_stats_pool_get_each instead of the heap stats. */
+extern "C" {
+    void *mbed_pool_malloc(size_t size);
+    size_t mbed_pool_block_size(const void *ptr);
+    bool mbed_pool_free(void *ptr);
+}
+#endif
+
 /******************************************************************************/
 /* GCC memory allocation wrappers                                             */
 /******************************************************************************/
@@ -112,6 +122,16 @@ extern "C" void *malloc_wrapper(struct _reent *r, size_t size, void *caller)
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
+#if MBED_CONF_PLATFORM_POOL_MALLOC_ENABLED
+    ptr = mbed_pool_malloc(size);
+    if (ptr != NULL) {
+#if MBED_MEM_TRACING_ENABLED
+        mbed_mem_trace_malloc(ptr, size, caller);
+        mbed_mem_trace_unlock();
+#endif
+        return ptr;
+    }
+#endif
 #if MBED_HEAP_STATS_ENABLED
     malloc_stats_mutex->lock();
     alloc_info_t *alloc_info = NULL;
@@ -149,6 +169,26 @@ extern "C" void *__wrap__realloc_r(struct _reent *r, void *ptr, size_t size)
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
+#if MBED_CONF_PLATFORM_POOL_MALLOC_ENABLED
+    // A pool block can't grow or shrink, move it
+    size_t block_size = mbed_pool_block_size(ptr);
+    if (block_size != 0) {
+        if (size == 0) {
+            free(ptr);
+        } else {
+            new_ptr = malloc(size);
+            if (new_ptr != NULL) {
+                memcpy(new_ptr, ptr, (block_size < size) ? block_size : size);
+                free(ptr);
+            }
+        }
+#if MBED_MEM_TRACING_ENABLED
+        mbed_mem_trace_realloc(new_ptr, ptr, size, MBED_CALLER_ADDR());
+        mbed_mem_trace_unlock();
+#endif
+        return new_ptr;
+    }
+#endif
 #if MBED_HEAP_STATS_ENABLED
     // Implement realloc_r with malloc and free.
     // The function realloc_r can't be used here directly since
@@ -196,6 +236,15 @@ extern "C" void free_wrapper(struct _reent *r, void *ptr, void *caller)
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
+#if MBED_CONF_PLATFORM_POOL_MALLOC_ENABLED
+    if (mbed_pool_free(ptr)) {
+#if MBED_MEM_TRACING_ENABLED
+        mbed_mem_trace_free(ptr, caller);
+        mbed_mem_trace_unlock();
+#endif
+        return;
+    }
+#endif
 #if MBED_HEAP_STATS_ENABLED
     malloc_stats_mutex->lock();
     alloc_info_t *alloc_info = NULL;
@@ -230,6 +279,19 @@ extern "C" void *__wrap__calloc_r(struct _reent *r, size_t nmemb, size_t size)
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
+#if MBED_CONF_PLATFORM_POOL_MALLOC_ENABLED
+    if (size == 0 || nmemb <= SIZE_MAX / size) {
+        ptr = mbed_pool_malloc(nmemb * size);
+    }
+    if (ptr != NULL) {
+        memset(ptr, 0, nmemb * size);
+#if MBED_MEM_TRACING_ENABLED
+        mbed_mem_trace_calloc(ptr, nmemb, size, MBED_CALLER_ADDR());
+        mbed_mem_trace_unlock();
+#endif
+        return ptr;
+    }
+#endif
 #if MBED_HEAP_STATS_ENABLED
     // Note - no lock needed since malloc is thread safe
 
@@ -279,8 +341,8 @@ extern "C" void *__wrap__memalign_r(struct _reent *r, size_t alignment, size_t b
 #define SUB_FREE        $Sub$$__iar_dlfree
 #endif
 
-/* Enable hooking of memory function only if tracing is also enabled */
-#if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED)
+/* Enable hooking of memory function only if tracing, stats or pools are also enabled */
+#if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED) || MBED_CONF_PLATFORM_POOL_MALLOC_ENABLED
 
 extern "C" {
     void *SUPER_MALLOC(size_t size);
@@ -302,6 +364,16 @@ extern "C" void *malloc_wrapper(size_t size, void *caller)
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
+#if MBED_CONF_PLATFORM_POOL_MALLOC_ENABLED
+    ptr = mbed_pool_malloc(size);
+    if (ptr != NULL) {
+#if MBED_MEM_TRACING_ENABLED
+        mbed_mem_trace_malloc(ptr, size, caller);
+        mbed_mem_trace_unlock();
+#endif
+        return ptr;
+    }
+#endif
 #if MBED_HEAP_STATS_ENABLED
     malloc_stats_mutex->lock();
     alloc_info_t *alloc_info = NULL;
@@ -340,6 +412,26 @@ extern "C" void *SUB_REALLOC(void *ptr, size_t size)
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
+#if MBED_CONF_PLATFORM_POOL_MALLOC_ENABLED
+    // A pool block can't grow or shrink, move it
+    size_t block_size = mbed_pool_block_size(ptr);
+    if (block_size != 0) {
+        if (size == 0) {
+            free(ptr);
+        } else {
+            new_ptr = malloc(size);
+            if (new_ptr != NULL) {
+                memcpy(new_ptr, ptr, (block_size < size) ? block_size : size);
+                free(ptr);
+            }
+        }
+#if MBED_MEM_TRACING_ENABLED
+        mbed_mem_trace_realloc(new_ptr, ptr, size, MBED_CALLER_ADDR());
+        mbed_mem_trace_unlock();
+#endif
+        return new_ptr;
+    }
+#endif
 #if MBED_HEAP_STATS_ENABLED
     // Note - no lock needed since malloc and free are thread safe
 
@@ -388,6 +480,19 @@ extern "C" void *SUB_CALLOC(size_t nmemb, size_t size)
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
+#if MBED_CONF_PLATFORM_POOL_MALLOC_ENABLED
+    if (size == 0 || nmemb <= SIZE_MAX / size) {
+        ptr = mbed_pool_malloc(nmemb * size);
+    }
+    if (ptr != NULL) {
+        memset(ptr, 0, nmemb * size);
+#if MBED_MEM_TRACING_ENABLED
+        mbed_mem_trace_calloc(ptr, nmemb, size, MBED_CALLER_ADDR());
+        mbed_mem_trace_unlock();
+#endif
+        return ptr;
+    }
+#endif
 #if MBED_HEAP_STATS_ENABLED
     // Note - no lock needed since malloc is thread safe
     ptr = malloc(nmemb * size);
@@ -424,6 +529,15 @@ extern "C" void free_wrapper(void *ptr, void *caller)
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
+#if MBED_CONF_PLATFORM_POOL_MALLOC_ENABLED
+    if (mbed_pool_free(ptr)) {
+#if MBED_MEM_TRACING_ENABLED
+        mbed_mem_trace_free(ptr, caller);
+        mbed_mem_trace_unlock();
+#endif
+        return;
+    }
+#endif
 #if MBED_HEAP_STATS_ENABLED
     malloc_stats_mutex->lock();
     alloc_info_t *alloc_info = NULL;
@@ -452,7 +566,7 @@ extern "C" void free_wrapper(void *ptr, void *caller)
 #endif // #if MBED_MEM_TRACING_ENABLED
 }
 
-#endif // #if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED)
+#endif // #if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED) || MBED_CONF_PLATFORM_POOL_MALLOC_ENABLED
 
 /******************************************************************************/
 /* Allocation wrappers for other toolchains are not supported yet             */
@@ -468,4 +582,8 @@ extern "C" void free_wrapper(void *ptr, void *caller)
 #error Heap statistics are not supported with the current toolchain.
 #endif
 
+#if MBED_CONF_PLATFORM_POOL_MALLOC_ENABLED
+#error Pool malloc is not supported with the current toolchain.
+#endif
+
 #endif // #if defined(TOOLCHAIN_GCC)
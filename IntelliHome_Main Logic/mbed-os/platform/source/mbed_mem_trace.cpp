@@ -151,3 +151,139 @@ void mbed_mem_trace_default_callback(uint8_t op, void *res, void *caller, ...)
     }
     va_end(va);
 }
+
+/******************************************************************************
+ * Binary tracer
+ *****************************************************************************/
+
+#if MBED_MEM_TRACING_ENABLED
+
+#include "platform/SPSCCircularBuffer.h"
+#include "platform/mbed_critical.h"
+
+#ifndef MBED_CONF_PLATFORM_MEMORY_TRACING_BUFFER_SIZE
+#define MBED_CONF_PLATFORM_MEMORY_TRACING_BUFFER_SIZE 1024
+#endif
+
+static_assert(MBED_CONF_PLATFORM_MEMORY_TRACING_BUFFER_SIZE >= MBED_MEM_TRACE_BINARY_RECORD_SIZE,
+              "platform.memory-tracing-buffer-size must hold at least one record");
+
+static void mem_trace_binary_default_write(const uint8_t *data, size_t len)
+{
+    fwrite(data, 1, len, stdout);
+    fflush(stdout);
+}
+
+/* Records may come from several contexts, so the producer side of the ring is
+ * serialized with a critical section. Only mbed_mem_trace_binary_drain reads. */
+static struct {
+    mbed::SPSCCircularBuffer<uint8_t, MBED_CONF_PLATFORM_MEMORY_TRACING_BUFFER_SIZE> ring;
+    void (*write_f)(const uint8_t *data, size_t len);
+    uint32_t (*time_f)(void);
+    uint16_t sequence;
+    uint32_t dropped;
+} mem_trace_binary = {
+    {},
+    mem_trace_binary_default_write,
+    NULL,
+    0,
+    0
+};
+
+static void mem_trace_put_u32(uint8_t *out, uint32_t value)
+{
+    out[0] = (uint8_t) value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+void mbed_mem_trace_binary_callback(uint8_t op, void *res, void *caller, ...)
+{
+    va_list va;
+    uint8_t record[MBED_MEM_TRACE_BINARY_RECORD_SIZE];
+    void *ptr = NULL;
+    size_t size = 0;
+
+    va_start(va, caller);
+    switch (op) {
+        case MBED_MEM_TRACE_MALLOC:
+            size = va_arg(va, size_t);
+            break;
+
+        case MBED_MEM_TRACE_REALLOC:
+            ptr = va_arg(va, void *);
+            size = va_arg(va, size_t);
+            break;
+
+        case MBED_MEM_TRACE_CALLOC:
+            size = va_arg(va, size_t);
+            size *= va_arg(va, size_t);
+            break;
+
+        case MBED_MEM_TRACE_FREE:
+            ptr = va_arg(va, void *);
+            break;
+    }
+    va_end(va);
+
+    record[0] = MBED_MEM_TRACE_BINARY_SYNC;
+    record[1] = op;
+    mem_trace_put_u32(&record[8], (uint32_t)(uintptr_t) res);
+    mem_trace_put_u32(&record[12], (uint32_t)(uintptr_t) ptr);
+    mem_trace_put_u32(&record[16], (uint32_t) size);
+    mem_trace_put_u32(&record[20], (uint32_t)(uintptr_t) caller);
+
+    core_util_critical_section_enter();
+    uint16_t sequence = mem_trace_binary.sequence++;
+    record[2] = (uint8_t) sequence;
+    record[3] = (uint8_t)(sequence >> 8);
+    mem_trace_put_u32(&record[4], mem_trace_binary.time_f ? mem_trace_binary.time_f() : 0);
+    if (MBED_CONF_PLATFORM_MEMORY_TRACING_BUFFER_SIZE - mem_trace_binary.ring.size() >= sizeof(record)) {
+        mem_trace_binary.ring.push(record, sizeof(record));
+    } else {
+        mem_trace_binary.dropped++;
+    }
+    core_util_critical_section_exit();
+}
+
+size_t mbed_mem_trace_binary_drain(size_t max)
+{
+    // Records are pushed whole, so stopping on a multiple of the record size
+    // leaves other output sharing the port between records
+    if (max % MBED_MEM_TRACE_BINARY_RECORD_SIZE) {
+        max += MBED_MEM_TRACE_BINARY_RECORD_SIZE - max % MBED_MEM_TRACE_BINARY_RECORD_SIZE;
+    }
+    size_t written = 0;
+    while (max == 0 || written < max) {
+        mbed::Span<const uint8_t> data = mem_trace_binary.ring.read_region();
+        if (data.empty()) {
+            break;
+        }
+        size_t len = data.size();
+        if (max && len > max - written) {
+            len = max - written;
+        }
+        mem_trace_binary.write_f(data.data(), len);
+        mem_trace_binary.ring.commit_read(len);
+        written += len;
+    }
+    return written;
+}
+
+void mbed_mem_trace_binary_output_function_set(void (*write_f)(const uint8_t *data, size_t len))
+{
+    mem_trace_binary.write_f = write_f ? write_f : mem_trace_binary_default_write;
+}
+
+void mbed_mem_trace_binary_time_function_set(uint32_t (*time_f)(void))
+{
+    mem_trace_binary.time_f = time_f;
+}
+
+uint32_t mbed_mem_trace_binary_dropped(void)
+{
+    return core_util_atomic_load_u32(&mem_trace_binary.dropped);
+}
+
+#endif /* MBED_MEM_TRACING_ENABLED */
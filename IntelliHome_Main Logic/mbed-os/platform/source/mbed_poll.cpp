@@ -17,9 +17,32 @@
 #include "mbed_poll.h"
 #include "FileHandle.h"
 #include "mbed_thread.h"
+#include "platform/mbed_atomic.h"
+#include "rtos/ThisThread.h"
 
 namespace mbed {
 
+// Thread sleeping in poll_wait(), woken by poll_wake()
+static osThreadId_t volatile poll_waiter;
+
+static int poll_scan(pollfh fhs[], unsigned nfhs)
+{
+    int count = 0;
+    for (unsigned n = 0; n < nfhs; n++) {
+        FileHandle *fh = fhs[n].fh;
+        short mask = fhs[n].events | POLLERR | POLLHUP | POLLNVAL;
+        if (fh) {
+            fhs[n].revents = fh->poll(mask) & mask;
+        } else {
+            fhs[n].revents = POLLNVAL;
+        }
+        if (fhs[n].revents) {
+            count++;
+        }
+    }
+    return count;
+}
+
 // timeout -1 forever, or milliseconds
 int poll(pollfh fhs[], unsigned nfhs, int timeout)
 {
@@ -40,18 +63,7 @@ int poll(pollfh fhs[], unsigned nfhs, int timeout)
     int count = 0;
     for (;;) {
         /* Scan the file handles */
-        for (unsigned n = 0; n < nfhs; n++) {
-            FileHandle *fh = fhs[n].fh;
-            short mask = fhs[n].events | POLLERR | POLLHUP | POLLNVAL;
-            if (fh) {
-                fhs[n].revents = fh->poll(mask) & mask;
-            } else {
-                fhs[n].revents = POLLNVAL;
-            }
-            if (fhs[n].revents) {
-                count++;
-            }
-        }
+        count = poll_scan(fhs, nfhs);
 
         if (count) {
             break;
@@ -68,4 +80,47 @@ int poll(pollfh fhs[], unsigned nfhs, int timeout)
     return count;
 }
 
+int poll_wait(pollfh fhs[], unsigned nfhs, int timeout)
+{
+    uint64_t start_time = 0;
+    if (timeout > 0) {
+        start_time = get_ms_count();
+    }
+
+    core_util_atomic_store_ptr(&poll_waiter, rtos::ThisThread::get_id());
+
+    int count = 0;
+    for (;;) {
+        // Cleared before the scan, so a change after the scan ends the sleep below
+        rtos::ThisThread::flags_clear(MBED_POLL_WAKE_FLAG);
+
+        count = poll_scan(fhs, nfhs);
+        if (count || timeout == 0) {
+            break;
+        }
+
+        rtos::Kernel::Clock::duration_u32 wait_time = rtos::Kernel::wait_for_u32_forever;
+        if (timeout > 0) {
+            int64_t elapsed = int64_t(get_ms_count() - start_time);
+            if (elapsed >= timeout) {
+                break;
+            }
+            wait_time = rtos::Kernel::Clock::duration_u32(uint32_t(timeout - elapsed));
+        }
+
+        rtos::ThisThread::flags_wait_any_for(MBED_POLL_WAKE_FLAG, wait_time);
+    }
+
+    core_util_atomic_store_ptr(&poll_waiter, nullptr);
+    return count;
+}
+
+void poll_wake()
+{
+    osThreadId_t waiter = core_util_atomic_load_ptr(&poll_waiter);
+    if (waiter) {
+        osThreadFlagsSet(waiter, MBED_POLL_WAKE_FLAG);
+    }
+}
+
 } // namespace mbed
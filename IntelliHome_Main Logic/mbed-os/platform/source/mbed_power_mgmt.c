@@ -34,9 +34,17 @@
 
 #if DEVICE_SLEEP
 
+// CPU statistics are timed with the low power ticker, or with the microsecond
+// ticker on targets without one.
+#if defined(MBED_CPU_STATS_ENABLED) && (DEVICE_LPTICKER || DEVICE_USTICKER)
+#define CPU_STATS_TICKER 1
+#else
+#define CPU_STATS_TICKER 0
+#endif
+
 // deep sleep locking counter. A target is allowed to deep sleep if counter == 0
 static uint16_t deep_sleep_lock = 0U;
-#if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER
+#if CPU_STATS_TICKER
 static us_timestamp_t sleep_time = 0;
 static us_timestamp_t deep_sleep_time = 0;
 
@@ -45,9 +53,13 @@ static const ticker_data_t *sleep_ticker = NULL;
 
 static inline us_timestamp_t read_us(void)
 {
-#if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER
+#if CPU_STATS_TICKER
     if (NULL == sleep_ticker) {
+#if DEVICE_LPTICKER
         sleep_ticker = get_lp_ticker_data();
+#else
+        sleep_ticker = get_us_ticker_data();
+#endif
     }
     return ticker_read_us(sleep_ticker);
 #else
@@ -57,7 +69,7 @@ static inline us_timestamp_t read_us(void)
 
 us_timestamp_t mbed_time_idle(void)
 {
-#if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER
+#if CPU_STATS_TICKER
     return (sleep_time + deep_sleep_time);
 #else
     return 0;
@@ -71,7 +83,7 @@ us_timestamp_t mbed_uptime(void)
 
 us_timestamp_t mbed_time_sleep(void)
 {
-#if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER
+#if CPU_STATS_TICKER
     return sleep_time;
 #else
     return 0;
@@ -80,7 +92,7 @@ us_timestamp_t mbed_time_sleep(void)
 
 us_timestamp_t mbed_time_deepsleep(void)
 {
-#if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER
+#if CPU_STATS_TICKER
     return deep_sleep_time;
 #else
     return 0;
@@ -239,7 +251,7 @@ void sleep_manager_sleep_auto(void)
     sleep_tracker_print_stats();
 #endif
     core_util_critical_section_enter();
-#if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER
+#if CPU_STATS_TICKER
     us_timestamp_t start = read_us();
     bool deep = false;
 #endif
@@ -249,7 +261,7 @@ void sleep_manager_sleep_auto(void)
     hal_sleep();
 #else
     if (sleep_manager_can_deep_sleep()) {
-#if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER
+#if CPU_STATS_TICKER
         deep = true;
 #endif
         hal_deepsleep();
@@ -258,7 +270,7 @@ void sleep_manager_sleep_auto(void)
     }
 #endif
 
-#if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER
+#if CPU_STATS_TICKER
     us_timestamp_t end = read_us();
     if (true == deep) {
         deep_sleep_time += end - start;
@@ -20,6 +20,7 @@
 #include <stdint.h>
 #include "cmsis.h"
 #include "hal/us_ticker_api.h"
+#include "platform/mbed_stats.h"
 
 /* This startup is for baremetal. There is no RTOS in baremetal,
  * therefore we protect this file with MBED_CONF_RTOS_PRESENT.
@@ -35,6 +36,24 @@ extern uint32_t mbed_heap_size;
 unsigned char *mbed_stack_isr_start = 0;
 uint32_t mbed_stack_isr_size = 0;
 
+#if defined(MBED_STACK_STATS_ENABLED)
+/* Fill the unused part of the stack with MBED_STACK_STATS_PAINT_VALUE so that
+ * mbed_stats_stack_get() can find the high water mark later on. Called once
+ * the stack limits are known, everything below the current frame is unused.
+ */
+static void mbed_stack_isr_paint(void)
+{
+    uint32_t *word = (uint32_t *)(((uint32_t) mbed_stack_isr_start + 3) & ~3UL);
+    uint32_t *end = (uint32_t *)((__get_MSP() - 64) & ~3UL);
+
+    while (word < end) {
+        *word++ = MBED_STACK_STATS_PAINT_VALUE;
+    }
+}
+#else
+#define mbed_stack_isr_paint()
+#endif
+
 /* mbed_main is a function that is called before main()
  * mbed_sdk_init() is also a function that is called before main(), but unlike
  * mbed_main(), it is not meant for user code, but for the SDK itself to perform
@@ -130,6 +149,7 @@ int $Sub$$main(void)
     mbed_stack_isr_size = (uint32_t) Image$$ARM_LIB_STACK$$ZI$$Length;
     mbed_heap_start = (unsigned char *) Image$$ARM_LIB_HEAP$$ZI$$Base;
     mbed_heap_size = (uint32_t) Image$$ARM_LIB_HEAP$$ZI$$Length;
+    mbed_stack_isr_paint();
 
 #if defined(__MICROLIB)
     // post stack/heap is not active in microlib
@@ -164,6 +184,7 @@ void software_init_hook(void)
     mbed_stack_isr_size = (uint32_t) &__StackTop - (uint32_t) &__StackLimit;
     mbed_heap_start = (unsigned char *) &__end__;
     mbed_heap_size = (uint32_t) &__HeapLimit - (uint32_t) &__end__;
+    mbed_stack_isr_paint();
 
     mbed_init();
     software_init_hook_rtos();
@@ -190,6 +211,7 @@ void __mbed_init(void)
 
     mbed_stack_isr_start = (unsigned char *)__section_begin("CSTACK");
     mbed_stack_isr_size = (uint32_t)__section_size("CSTACK");
+    mbed_stack_isr_paint();
 
     mbed_init();
     mbed_error_initialize();
@@ -24,8 +24,25 @@
 #include "device.h"
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "cmsis_os2.h"
-#elif defined(MBED_STACK_STATS_ENABLED) || defined(MBED_THREAD_STATS_ENABLED)
-#warning Statistics are currently not supported without the rtos.
+#elif defined(MBED_THREAD_STATS_ENABLED)
+#warning Thread statistics are currently not supported without the rtos.
+#endif
+
+#if defined(MBED_STACK_STATS_ENABLED) && !defined(MBED_CONF_RTOS_PRESENT)
+/* Without the rtos there is a single stack, painted at boot by mbed_sdk_boot.c */
+extern unsigned char *mbed_stack_isr_start;
+extern uint32_t mbed_stack_isr_size;
+
+static uint32_t isr_stack_used(void)
+{
+    const uint32_t *word = (const uint32_t *) mbed_stack_isr_start;
+    const uint32_t *end = (const uint32_t *)(mbed_stack_isr_start + mbed_stack_isr_size);
+
+    while (word < end && *word == MBED_STACK_STATS_PAINT_VALUE) {
+        word++;
+    }
+    return (uint32_t)((const unsigned char *) end - (const unsigned char *) word);
+}
 #endif
 
 #if defined(MBED_CPU_STATS_ENABLED) && (!DEVICE_SLEEP)
@@ -36,7 +53,7 @@ void mbed_stats_cpu_get(mbed_stats_cpu_t *stats)
 {
     MBED_ASSERT(stats != NULL);
     memset(stats, 0, sizeof(mbed_stats_cpu_t));
-#if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER && DEVICE_SLEEP
+#if defined(MBED_CPU_STATS_ENABLED) && (DEVICE_LPTICKER || DEVICE_USTICKER) && DEVICE_SLEEP
     stats->uptime = mbed_uptime();
     stats->idle_time = mbed_time_idle();
     stats->sleep_time = mbed_time_sleep();
@@ -45,6 +62,7 @@ void mbed_stats_cpu_get(mbed_stats_cpu_t *stats)
 }
 
 // note: mbed_stats_heap_get defined in mbed_alloc_wrappers.cpp
+// note: mbed_stats_pool_get_each defined in FixedPool.cpp
 void mbed_stats_stack_get(mbed_stats_stack_t *stats)
 {
     MBED_ASSERT(stats != NULL);
@@ -73,6 +91,12 @@ void mbed_stats_stack_get(mbed_stats_stack_t *stats)
     osKernelUnlock();
 
     free(threads);
+#elif defined(MBED_STACK_STATS_ENABLED)
+    if (mbed_stack_isr_start != NULL) {
+        stats->max_size = isr_stack_used();
+        stats->reserved_size = mbed_stack_isr_size;
+        stats->stack_cnt = 1;
+    }
 #endif
 }
 
@@ -105,6 +129,13 @@ size_t mbed_stats_stack_get_each(mbed_stats_stack_t *stats, size_t count)
     osKernelUnlock();
 
     free(threads);
+#elif defined(MBED_STACK_STATS_ENABLED)
+    if (count > 0 && mbed_stack_isr_start != NULL) {
+        stats[0].max_size = isr_stack_used();
+        stats[0].reserved_size = mbed_stack_isr_size;
+        stats[0].stack_cnt = 1;
+        i = 1;
+    }
 #endif
 
     return i;
@@ -16,6 +16,7 @@
  */
 
 #include "mbed_printf_implementation.h"
+#include "platform/mbed_format_fixed.h"
 
 #include <stdbool.h>
 #include <limits.h>
@@ -331,6 +332,115 @@ static void mbed_minimal_formatted_string_double(char *buffer, size_t length, in
 }
 #endif
 
+static const uint32_t powers_of_10[MBED_FORMAT_FIXED_MAX_DECIMALS + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+/**
+ * @brief      Round a fixed-point value to nearest, ties to even, like printf.
+ *
+ * @param      integer    The integer part of the absolute value.
+ * @param      decimal    The truncated decimal part, scaled by 10^decimals.
+ * @param[in]  decimals   The number of decimals.
+ * @param[in]  rest       The dropped part of the value, compared with half a unit of the last decimal (<0, 0, >0).
+ */
+static void mbed_minimal_round_fixed(uint32_t *integer, uint32_t *decimal, int decimals, int rest)
+{
+    bool odd = decimals ? (*decimal & 1) : (*integer & 1);
+
+    if (rest > 0 || (rest == 0 && odd)) {
+        *decimal += 1;
+        if (*decimal >= powers_of_10[decimals]) {
+            /* rounding carries over to the integer part (e.g. 1.96 with 1 decimal -> 2.0) */
+            *decimal = 0;
+            *integer += 1;
+        }
+    }
+}
+
+/**
+ * @brief      Write a rounded fixed-point value and NULL-terminate the buffer.
+ *
+ * @param      buffer     The buffer to store output.
+ * @param[in]  length     The length of the buffer.
+ * @param[in]  negative   Flag to prepend '-'.
+ * @param[in]  integer    The integer part of the absolute value.
+ * @param[in]  decimal    The decimal part, scaled by 10^decimals.
+ * @param[in]  decimals   The number of decimals.
+ *
+ * @return     Number of characters written.
+ */
+static int mbed_minimal_formatted_string_fixed(char *buffer, size_t length, bool negative, uint32_t integer, uint32_t decimal, int decimals)
+{
+    int result = 0;
+
+    /* Make sure that there's always space for the NULL terminator */
+    size_t space = length > 0 ? length - 1 : 0;
+
+    if (negative) {
+        mbed_minimal_putchar(buffer, space, &result, '-', NULL);
+    }
+    mbed_minimal_formatted_string_integer(buffer, space, &result, integer, INT_UNSIGNED, 0, false, NULL);
+    if (decimals > 0) {
+        mbed_minimal_putchar(buffer, space, &result, '.', NULL);
+        mbed_minimal_formatted_string_integer(buffer, space, &result, decimal, INT_UNSIGNED, decimals, true, NULL);
+    }
+
+    if (buffer && length > 0) {
+        buffer[(size_t)result <= space ? (size_t)result : space] = '\0';
+    }
+
+    return result;
+}
+
+int mbed_format_fixed(char *buffer, size_t length, int32_t value, int frac_bits, int decimals)
+{
+    if (frac_bits < 0 || frac_bits > 31 || decimals < 0 || decimals > MBED_FORMAT_FIXED_MAX_DECIMALS) {
+        return -1;
+    }
+
+    /* absolute value, INT32_MIN included */
+    uint32_t magnitude = value < 0 ? 0u - (uint32_t) value : (uint32_t) value;
+    uint32_t integer = magnitude >> frac_bits;
+    uint32_t decimal = 0;
+
+    if (frac_bits > 0) {
+        /* the fraction times 10^decimals fits 61 bits, a single long multiply */
+        uint64_t scaled = (uint64_t)(magnitude & ((1u << frac_bits) - 1)) * powers_of_10[decimals];
+        uint64_t half = (uint64_t) 1 << (frac_bits - 1);
+        uint64_t rest = scaled & ((half << 1) - 1);
+
+        decimal = (uint32_t)(scaled >> frac_bits);
+        mbed_minimal_round_fixed(&integer, &decimal, decimals, rest > half ? 1 : rest == half ? 0 : -1);
+    }
+
+    return mbed_minimal_formatted_string_fixed(buffer, length, value < 0, integer, decimal, decimals);
+}
+
+int mbed_format_scaled(char *buffer, size_t length, int32_t value, int scale, int decimals)
+{
+    if (scale < 0 || scale > MBED_FORMAT_FIXED_MAX_DECIMALS || decimals < 0 || decimals > MBED_FORMAT_FIXED_MAX_DECIMALS) {
+        return -1;
+    }
+
+    uint32_t magnitude = value < 0 ? 0u - (uint32_t) value : (uint32_t) value;
+    uint32_t integer = magnitude / powers_of_10[scale];
+    uint32_t fraction = magnitude % powers_of_10[scale];
+    uint32_t decimal;
+
+    if (decimals >= scale) {
+        decimal = fraction * powers_of_10[decimals - scale];
+    } else {
+        uint32_t drop = powers_of_10[scale - decimals];
+        uint32_t rest = (fraction % drop) * 2;
+
+        decimal = fraction / drop;
+        mbed_minimal_round_fixed(&integer, &decimal, decimals, rest > drop ? 1 : rest == drop ? 0 : -1);
+    }
+
+    return mbed_minimal_formatted_string_fixed(buffer, length, value < 0, integer, decimal, decimals);
+}
+
 /**
  * @brief      Print string with precision.
  *
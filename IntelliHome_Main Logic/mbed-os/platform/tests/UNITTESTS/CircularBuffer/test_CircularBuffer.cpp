@@ -129,3 +129,78 @@ TEST_F(TestCircularBuffer, writing_over_max_capacity)
         EXPECT_TRUE(0 == memcmp(test_numbers + 1, test_numbers_popped, TEST_BUFFER_SIZE));
     }
 }
+
+TEST_F(TestCircularBuffer, write_region_in_place)
+{
+    mbed::Span<int> region = buf->write_region();
+    EXPECT_EQ(region.size(), TEST_BUFFER_SIZE);
+
+    region[0] = 1;
+    region[1] = 2;
+    region[2] = 3;
+    buf->commit_write(3);
+    EXPECT_EQ(buf->size(), 3);
+
+    /* the region follows the committed elements */
+    EXPECT_EQ(buf->write_region().size(), TEST_BUFFER_SIZE - 3);
+
+    int item = 0;
+    for (int i = 1; i <= 3; i++) {
+        EXPECT_TRUE(buf->pop(item));
+        EXPECT_EQ(item, i);
+    }
+}
+
+TEST_F(TestCircularBuffer, write_region_stops_at_storage_end)
+{
+    const int test_numbers[TEST_BUFFER_SIZE] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    int test_numbers_popped[TEST_BUFFER_SIZE] = { 0 };
+
+    buf->push(test_numbers, 8);
+    buf->pop(test_numbers_popped, 4);
+
+    /* 2 free elements to the end of the storage, 4 more at its start */
+    mbed::Span<int> region = buf->write_region();
+    ASSERT_EQ(region.size(), 2);
+    region[0] = 9;
+    region[1] = 10;
+    buf->commit_write(2);
+
+    region = buf->write_region();
+    ASSERT_EQ(region.size(), 4);
+    region[0] = 11;
+    buf->commit_write(1);
+
+    EXPECT_EQ(buf->pop(test_numbers_popped, TEST_BUFFER_SIZE), 7);
+    const int expected[7] = { 5, 6, 7, 8, 9, 10, 11 };
+    EXPECT_TRUE(0 == memcmp(expected, test_numbers_popped, sizeof(expected)));
+}
+
+TEST_F(TestCircularBuffer, write_region_rewinds_when_empty)
+{
+    const int test_numbers[TEST_BUFFER_SIZE] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    int item = 0;
+
+    buf->push(test_numbers, 7);
+    while (buf->pop(item)) {
+    }
+
+    /* nothing is queued, the whole storage is contiguous again */
+    EXPECT_EQ(buf->write_region().size(), TEST_BUFFER_SIZE);
+}
+
+TEST_F(TestCircularBuffer, write_region_full)
+{
+    mbed::Span<int> region = buf->write_region();
+    for (int i = 0; i < TEST_BUFFER_SIZE; i++) {
+        region[i] = i;
+    }
+    buf->commit_write(TEST_BUFFER_SIZE);
+
+    EXPECT_TRUE(buf->full());
+    EXPECT_TRUE(buf->write_region().empty());
+
+    /* commit of nothing leaves the buffer as it is */
+    buf->commit_write(0);
+    EXPECT_EQ(buf->size(), TEST_BUFFER_SIZE);
+}
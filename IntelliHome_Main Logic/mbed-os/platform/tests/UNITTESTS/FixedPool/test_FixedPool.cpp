@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/FixedPool.h"
+#include "platform/mbed_stats.h"
+#include <algorithm>
+#include <chrono>
+#include <stdlib.h>
+
+using namespace mbed;
+
+extern "C" {
+    void *mbed_pool_malloc(size_t size);
+    size_t mbed_pool_block_size(const void *ptr);
+    bool mbed_pool_free(void *ptr);
+}
+
+struct Message {
+    Message(uint32_t id = 7) : id(id), value(1.5f) {}
+    uint32_t id;
+    float value;
+};
+
+#define TEST_POOL_SIZE (4)
+
+class TestFixedPool : public testing::Test {
+protected:
+    FixedPool<Message, TEST_POOL_SIZE> pool;
+};
+
+TEST_F(TestFixedPool, alloc_until_empty)
+{
+    Message *msgs[TEST_POOL_SIZE];
+    for (int i = 0; i < TEST_POOL_SIZE; i++) {
+        msgs[i] = pool.construct(i);
+        ASSERT_NE(nullptr, msgs[i]);
+        EXPECT_EQ((uint32_t)i, msgs[i]->id);
+        EXPECT_TRUE(pool.owns(msgs[i]));
+    }
+    EXPECT_EQ(nullptr, pool.construct());
+    EXPECT_EQ(nullptr, pool.try_alloc());
+    EXPECT_EQ((uint32_t)TEST_POOL_SIZE, pool.in_use());
+    EXPECT_EQ(2u, pool.fail_count());
+
+    // The last block freed is the next one handed out
+    pool.destroy(msgs[1]);
+    EXPECT_EQ((uint32_t)TEST_POOL_SIZE - 1, pool.in_use());
+    EXPECT_EQ(msgs[1], pool.construct(9));
+    EXPECT_EQ(9u, msgs[1]->id);
+
+    for (int i = 0; i < TEST_POOL_SIZE; i++) {
+        pool.destroy(msgs[i]);
+    }
+    EXPECT_EQ(0u, pool.in_use());
+    EXPECT_EQ((uint32_t)TEST_POOL_SIZE, pool.max_in_use());
+    pool.destroy(NULL);
+}
+
+TEST_F(TestFixedPool, calloc_and_owns)
+{
+    Message *msg = pool.try_alloc();
+    msg->id = 0xFFFFFFFF;
+    pool.free(msg);
+
+    msg = pool.try_calloc();
+    ASSERT_NE(nullptr, msg);
+    EXPECT_EQ(0u, msg->id);
+
+    Message outside;
+    EXPECT_FALSE(pool.owns(&outside));
+    EXPECT_FALSE(pool.owns(reinterpret_cast<uint8_t *>(msg) + 1));
+    EXPECT_EQ(sizeof(Message), pool.block_size());
+    EXPECT_EQ((uint32_t)TEST_POOL_SIZE, pool.capacity());
+    pool.free(msg);
+}
+
+TEST_F(TestFixedPool, allocator_size_classes)
+{
+    FixedBlockPool<16, 2> small;
+    FixedBlockPool<64, 1> large;
+    FixedPoolBase *const pools[] = { &small, &large };
+    FixedPoolAllocator allocator(pools, 2);
+
+    void *a = allocator.try_alloc(10);
+    void *b = allocator.try_alloc(16);
+    EXPECT_TRUE(small.owns(a));
+    EXPECT_TRUE(small.owns(b));
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(a) % 8);
+
+    // Spills into the larger class, then runs out
+    void *c = allocator.try_alloc(10);
+    EXPECT_TRUE(large.owns(c));
+    EXPECT_EQ(nullptr, allocator.try_alloc(10));
+    EXPECT_EQ(nullptr, allocator.try_alloc(65));
+    EXPECT_EQ(&large, allocator.owner(c));
+
+    int foreign;
+    EXPECT_FALSE(allocator.free(&foreign));
+    EXPECT_TRUE(allocator.free(a));
+    EXPECT_TRUE(allocator.free(b));
+    EXPECT_TRUE(allocator.free(c));
+    EXPECT_EQ(0u, small.in_use());
+    EXPECT_EQ(0u, large.in_use());
+}
+
+TEST_F(TestFixedPool, stats)
+{
+    Message *msg = pool.construct();
+    pool.construct();
+    pool.destroy(msg);
+
+    // The malloc size classes are registered as well
+    mbed_stats_pool_t stats[8];
+    size_t count = mbed_stats_pool_get_each(stats, 8);
+    EXPECT_EQ(4u, count);
+
+    // Newest pool first
+    EXPECT_EQ(sizeof(Message), stats[0].block_size);
+    EXPECT_EQ((uint32_t)TEST_POOL_SIZE, stats[0].block_cnt);
+    EXPECT_EQ(1u, stats[0].current_cnt);
+    EXPECT_EQ(2u, stats[0].max_cnt);
+    EXPECT_EQ(0u, stats[0].alloc_fail_cnt);
+
+    EXPECT_EQ(1u, mbed_stats_pool_get_each(stats, 1));
+}
+
+TEST_F(TestFixedPool, malloc_pools)
+{
+    void *p = mbed_pool_malloc(20);
+    ASSERT_NE(nullptr, p);
+    EXPECT_EQ(32u, mbed_pool_block_size(p));
+    EXPECT_EQ(nullptr, mbed_pool_malloc(65));
+
+    void *heap = malloc(20);
+    EXPECT_EQ(0u, mbed_pool_block_size(heap));
+    EXPECT_FALSE(mbed_pool_free(heap));
+    free(heap);
+
+    EXPECT_TRUE(mbed_pool_free(p));
+    EXPECT_FALSE(mbed_pool_free(NULL));
+}
+
+#define BENCH_OPS   1000000
+#define BENCH_LIVE  16
+
+// Deterministic sizes and slots for both allocators
+static uint32_t bench_rand(uint32_t *state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+static const size_t bench_sizes[] = { 12, 24, 48 };
+
+template <typename Alloc, typename Free>
+static long long bench_churn(Alloc alloc, Free release, size_t *peak_span, size_t *peak_live)
+{
+    void *live[BENCH_LIVE] = { 0 };
+    size_t sizes[BENCH_LIVE] = { 0 };
+    uint32_t state = 1;
+    *peak_span = 0;
+    *peak_live = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int op = 0; op < BENCH_OPS; op++) {
+        uint32_t r = bench_rand(&state);
+        int slot = r % BENCH_LIVE;
+        if (live[slot]) {
+            release(live[slot]);
+        }
+        sizes[slot] = bench_sizes[(r >> 4) % 3];
+        live[slot] = alloc(sizes[slot]);
+        if (live[slot] == NULL) {
+            ADD_FAILURE() << "allocation failed at op " << op;
+            break;
+        }
+
+        // Address space touched by the live blocks, sampled sparsely
+        if (peak_span && (op & 0x3FF) == 0) {
+            uintptr_t low = UINTPTR_MAX, high = 0;
+            size_t used = 0;
+            for (int i = 0; i < BENCH_LIVE; i++) {
+                if (live[i]) {
+                    low = std::min(low, (uintptr_t)live[i]);
+                    high = std::max(high, (uintptr_t)live[i] + sizes[i]);
+                    used += sizes[i];
+                }
+            }
+            *peak_span = std::max(*peak_span, (size_t)(high - low));
+            *peak_live = std::max(*peak_live, used);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < BENCH_LIVE; i++) {
+        if (live[i]) {
+            release(live[i]);
+        }
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+/** Benchmark the size class pools against the host malloc.
+ *
+ *  Both allocators serve the same random churn of up to BENCH_LIVE blocks of
+ *  12, 24 and 48 bytes. Each class has BENCH_LIVE blocks, so the pools can
+ *  never fail however the sizes interleave, while the footprint of malloc
+ *  depends on how its free space fragments. Latency and the address span of
+ *  the live blocks are printed but not asserted, since they depend on the
+ *  host allocator.
+ */
+TEST_F(TestFixedPool, benchmark_vs_malloc)
+{
+    FixedBlockPool<16, BENCH_LIVE> *p16 = new FixedBlockPool<16, BENCH_LIVE>;
+    FixedBlockPool<32, BENCH_LIVE> *p32 = new FixedBlockPool<32, BENCH_LIVE>;
+    FixedBlockPool<64, BENCH_LIVE> *p64 = new FixedBlockPool<64, BENCH_LIVE>;
+    FixedPoolBase *const pools[] = { p16, p32, p64 };
+    FixedPoolAllocator allocator(pools, 3);
+
+    size_t pool_span, pool_live, heap_span, heap_live;
+    long long pool_ns = bench_churn([&allocator](size_t size) {
+        return allocator.try_alloc(size);
+    }, [&allocator](void *ptr) {
+        allocator.free(ptr);
+    }, &pool_span, &pool_live);
+
+    long long heap_ns = bench_churn([](size_t size) {
+        return malloc(size);
+    }, [](void *ptr) {
+        free(ptr);
+    }, &heap_span, &heap_live);
+
+    EXPECT_EQ(0u, p16->fail_count() + p32->fail_count() + p64->fail_count());
+    EXPECT_EQ(0u, p16->in_use() + p32->in_use() + p64->in_use());
+
+    printf("pools %5.1f ns/op, malloc %5.1f ns/op; peak live %u bytes, "
+           "pools fixed at %u bytes, malloc spread over %u bytes\n",
+           (double)pool_ns / BENCH_OPS, (double)heap_ns / BENCH_OPS,
+           (unsigned)std::max(pool_live, heap_live), (unsigned)(BENCH_LIVE * (16 + 32 + 64)),
+           (unsigned)heap_span);
+
+    delete p64;
+    delete p32;
+    delete p16;
+}
@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/mbed_mem_trace.h"
+#include "MemTraceAnalyzer.h"
+#include <chrono>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string>
+
+// Ring size of this test, CMakeLists.txt
+static const size_t RING_RECORDS = 5;
+
+static std::string captured;
+static uint32_t fake_time;
+
+static void capture(const uint8_t *data, size_t len)
+{
+    captured.append(reinterpret_cast<const char *>(data), len);
+}
+
+static uint32_t time_source(void)
+{
+    return fake_time;
+}
+
+static void *addr(uintptr_t value)
+{
+    return reinterpret_cast<void *>(value);
+}
+
+class TestMemTrace : public testing::Test {
+protected:
+    void SetUp()
+    {
+        mbed_mem_trace_set_callback(mbed_mem_trace_binary_callback);
+        mbed_mem_trace_binary_output_function_set(capture);
+        mbed_mem_trace_binary_time_function_set(time_source);
+        mbed_mem_trace_binary_drain(0);
+        captured.clear();
+        fake_time = 0;
+    }
+
+    void TearDown()
+    {
+        mbed_mem_trace_set_callback(NULL);
+    }
+
+    MemTraceRecord record(size_t index)
+    {
+        MemTraceRecord rec = {};
+        std::string bytes = captured.substr(index * MBED_MEM_TRACE_BINARY_RECORD_SIZE, MBED_MEM_TRACE_BINARY_RECORD_SIZE);
+        EXPECT_EQ((size_t)MBED_MEM_TRACE_BINARY_RECORD_SIZE, bytes.size());
+        auto u32 = [&bytes](size_t offset) {
+            return (uint32_t)(uint8_t) bytes[offset] | (uint32_t)(uint8_t) bytes[offset + 1] << 8 |
+                   (uint32_t)(uint8_t) bytes[offset + 2] << 16 | (uint32_t)(uint8_t) bytes[offset + 3] << 24;
+        };
+        rec.op = bytes[1];
+        rec.sequence = (uint16_t) u32(2);
+        rec.time = u32(4);
+        rec.result = u32(8);
+        rec.ptr = u32(12);
+        rec.size = u32(16);
+        rec.caller = u32(20);
+        return rec;
+    }
+
+    MemTraceAnalyzer analyze(uint32_t slack = 16)
+    {
+        MemTraceAnalyzer heap(slack);
+        mbed_mem_trace_binary_drain(0);
+        heap.feed(reinterpret_cast<const uint8_t *>(captured.data()), captured.size());
+        return heap;
+    }
+};
+
+TEST_F(TestMemTrace, record_layout)
+{
+    fake_time = 0x12345678;
+    mbed_mem_trace_malloc(addr(0x20001000), 50, addr(0x0800600d));
+
+    EXPECT_EQ((size_t)MBED_MEM_TRACE_BINARY_RECORD_SIZE, mbed_mem_trace_binary_drain(0));
+    const uint8_t expected[] = {
+        MBED_MEM_TRACE_BINARY_SYNC, MBED_MEM_TRACE_MALLOC, 0, 0,
+        0x78, 0x56, 0x34, 0x12,
+        0x00, 0x10, 0x00, 0x20,
+        0x00, 0x00, 0x00, 0x00,
+        50, 0, 0, 0,
+        0x0d, 0x60, 0x00, 0x08
+    };
+    std::string bytes = captured;
+    // The sequence number runs on from the earlier tests
+    bytes[2] = bytes[3] = 0;
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(expected), sizeof expected), bytes);
+}
+
+TEST_F(TestMemTrace, operation_arguments)
+{
+    mbed_mem_trace_realloc(addr(0x20002000), addr(0x20001000), 80, addr(0x0800a001));
+    mbed_mem_trace_calloc(addr(0x20003000), 4, 10, addr(0x0800a002));
+    mbed_mem_trace_free(addr(0x20002000), addr(0x0800a003));
+    mbed_mem_trace_binary_drain(0);
+
+    MemTraceRecord realloc_rec = record(0);
+    EXPECT_EQ(MBED_MEM_TRACE_REALLOC, realloc_rec.op);
+    EXPECT_EQ(0x20002000u, realloc_rec.result);
+    EXPECT_EQ(0x20001000u, realloc_rec.ptr);
+    EXPECT_EQ(80u, realloc_rec.size);
+
+    MemTraceRecord calloc_rec = record(1);
+    EXPECT_EQ(MBED_MEM_TRACE_CALLOC, calloc_rec.op);
+    EXPECT_EQ(0u, calloc_rec.ptr);
+    EXPECT_EQ(40u, calloc_rec.size);
+    EXPECT_EQ((uint16_t)(realloc_rec.sequence + 1), calloc_rec.sequence);
+
+    MemTraceRecord free_rec = record(2);
+    EXPECT_EQ(MBED_MEM_TRACE_FREE, free_rec.op);
+    EXPECT_EQ(0u, free_rec.result);
+    EXPECT_EQ(0x20002000u, free_rec.ptr);
+    EXPECT_EQ(0u, free_rec.size);
+    EXPECT_EQ(0x0800a003u, free_rec.caller);
+}
+
+TEST_F(TestMemTrace, nested_operations_not_traced)
+{
+    // realloc may call malloc while the wrapper holds the trace lock
+    mbed_mem_trace_lock();
+    mbed_mem_trace_lock();
+    mbed_mem_trace_malloc(addr(0x20001000), 16, addr(0x0800a001));
+    mbed_mem_trace_unlock();
+    mbed_mem_trace_realloc(addr(0x20001000), addr(0x20000800), 16, addr(0x0800a002));
+    mbed_mem_trace_unlock();
+
+    EXPECT_EQ((size_t)MBED_MEM_TRACE_BINARY_RECORD_SIZE, mbed_mem_trace_binary_drain(0));
+    EXPECT_EQ(MBED_MEM_TRACE_REALLOC, record(0).op);
+}
+
+TEST_F(TestMemTrace, full_ring_counts_drops)
+{
+    uint32_t dropped = mbed_mem_trace_binary_dropped();
+    for (uint32_t i = 0; i < RING_RECORDS + 2; i++) {
+        mbed_mem_trace_malloc(addr(0x20001000 + i * 0x100), 16, addr(0x0800a001));
+    }
+    EXPECT_EQ(dropped + 2, mbed_mem_trace_binary_dropped());
+    EXPECT_EQ(RING_RECORDS * MBED_MEM_TRACE_BINARY_RECORD_SIZE, mbed_mem_trace_binary_drain(0));
+
+    mbed_mem_trace_free(addr(0x20001000), addr(0x0800a002));
+    MemTraceAnalyzer heap = analyze();
+    EXPECT_EQ(RING_RECORDS + 1, heap.records());
+    EXPECT_EQ(2u, heap.lost());
+    EXPECT_EQ(RING_RECORDS - 1, heap.live_blocks());
+}
+
+TEST_F(TestMemTrace, drain_limit)
+{
+    mbed_mem_trace_malloc(addr(0x20001000), 16, addr(0x0800a001));
+    mbed_mem_trace_free(addr(0x20001000), addr(0x0800a001));
+
+    // Rounded up to whole records
+    EXPECT_EQ((size_t)MBED_MEM_TRACE_BINARY_RECORD_SIZE, mbed_mem_trace_binary_drain(10));
+    EXPECT_EQ((size_t)MBED_MEM_TRACE_BINARY_RECORD_SIZE, captured.size());
+    EXPECT_EQ((size_t)MBED_MEM_TRACE_BINARY_RECORD_SIZE, mbed_mem_trace_binary_drain(MBED_MEM_TRACE_BINARY_RECORD_SIZE));
+    EXPECT_EQ(0u, mbed_mem_trace_binary_drain(0));
+    EXPECT_EQ(2u, analyze().records());
+}
+
+TEST_F(TestMemTrace, not_recorded_when_disabled)
+{
+    mbed_mem_trace_disable();
+    mbed_mem_trace_malloc(addr(0x20001000), 16, addr(0x0800a001));
+    mbed_mem_trace_enable();
+
+    EXPECT_EQ(0u, mbed_mem_trace_binary_drain(0));
+}
+
+TEST_F(TestMemTrace, live_heap_per_site)
+{
+    void *site_a = addr(0x0800a001);
+    void *site_b = addr(0x0800b001);
+    void *site_c = addr(0x0800c001);
+
+    mbed_mem_trace_malloc(addr(0x20001000), 32, site_a);
+    mbed_mem_trace_malloc(addr(0x20001100), 32, site_a);
+    mbed_mem_trace_malloc(addr(0x20001200), 100, site_b);
+    mbed_mem_trace_free(addr(0x20001000), site_c);
+    mbed_mem_trace_binary_drain(0);
+    mbed_mem_trace_realloc(addr(0x20001300), addr(0x20001200), 200, site_c);
+    mbed_mem_trace_malloc(addr(0x20001000), 32, site_a);
+    MemTraceAnalyzer heap = analyze();
+
+    EXPECT_EQ(6u, heap.records());
+    EXPECT_EQ(0u, heap.lost());
+    EXPECT_EQ(264u, heap.live());
+    EXPECT_EQ(3u, heap.live_blocks());
+    EXPECT_EQ(264u, heap.peak());
+    EXPECT_EQ(6u, heap.peak_record());
+
+    std::vector<MemTraceAnalyzer::Site> sites = heap.sites();
+    ASSERT_EQ(3u, sites.size());
+    // Largest peak first; frees and reallocs count against the allocating site
+    EXPECT_EQ(0x0800c001u, sites[0].caller);
+    EXPECT_EQ(200u, sites[0].peak);
+    EXPECT_EQ(0x0800b001u, sites[1].caller);
+    EXPECT_EQ(1u, sites[1].frees);
+    EXPECT_EQ(0u, sites[1].live);
+    EXPECT_EQ(100u, sites[1].peak);
+    EXPECT_EQ(0x0800a001u, sites[2].caller);
+    EXPECT_EQ(3u, sites[2].allocs);
+    EXPECT_EQ(1u, sites[2].frees);
+    EXPECT_EQ(96u, sites[2].bytes);
+    EXPECT_EQ(64u, sites[2].live);
+    EXPECT_EQ(2u, sites[2].live_blocks);
+    EXPECT_EQ(64u, sites[2].peak);
+}
+
+TEST_F(TestMemTrace, failures_and_unmatched_frees)
+{
+    void *site = addr(0x0800a001);
+
+    mbed_mem_trace_malloc(NULL, 4096, site);
+    mbed_mem_trace_calloc(NULL, 0, 8, site);
+    mbed_mem_trace_malloc(addr(0x20001000), 64, site);
+    mbed_mem_trace_realloc(NULL, addr(0x20001000), 8192, site);
+    mbed_mem_trace_binary_drain(0);
+    mbed_mem_trace_free(NULL, site);
+    mbed_mem_trace_free(addr(0x20000400), site);
+    MemTraceAnalyzer heap = analyze();
+
+    ASSERT_EQ(1u, heap.sites().size());
+    EXPECT_EQ(2u, heap.sites()[0].failures);
+    EXPECT_EQ(1u, heap.unmatched());
+    EXPECT_EQ(64u, heap.live());
+
+    // realloc to 0 frees the block
+    captured.clear();
+    mbed_mem_trace_realloc(NULL, addr(0x20001000), 0, site);
+    mbed_mem_trace_binary_drain(0);
+    heap.feed(reinterpret_cast<const uint8_t *>(captured.data()), captured.size());
+    EXPECT_EQ(0u, heap.live());
+    EXPECT_EQ(2u, heap.sites()[0].failures);
+}
+
+TEST_F(TestMemTrace, fragmentation)
+{
+    void *site = addr(0x0800a001);
+
+    mbed_mem_trace_malloc(addr(0x1000), 32, site);
+    // 8 bytes after the first block, a header rather than a hole
+    mbed_mem_trace_malloc(addr(0x1028), 32, site);
+    mbed_mem_trace_malloc(addr(0x1100), 64, site);
+    mbed_mem_trace_malloc(addr(0x1400), 16, site);
+    MemTraceAnalyzer heap = analyze();
+
+    MemTraceAnalyzer::Fragmentation frag = heap.fragmentation();
+    EXPECT_EQ(0x410u, frag.extent);
+    EXPECT_EQ(144u, frag.live);
+    EXPECT_EQ(2u, frag.holes);
+    EXPECT_EQ(184u + 704u, frag.free);
+    EXPECT_EQ(704u, frag.largest);
+    EXPECT_EQ(20u, frag.percent);
+
+    // With no slack the header counts as a hole
+    EXPECT_EQ(3u, analyze(0).fragmentation().holes);
+}
+
+TEST_F(TestMemTrace, other_output_skipped)
+{
+    captured = "boot\r\n";
+    mbed_mem_trace_malloc(addr(0x20001000), 16, addr(0x0800a001));
+    mbed_mem_trace_binary_drain(0);
+    // A sync byte that does not start a record
+    captured += "\x1c" "?" "abcdefghijklmnopqrstuvwxyz";
+    // Deferred trace records and drop markers, whose bytes look like a record
+    captured += std::string("\x1e\x1a\x1c\x00", 4) + std::string(24, '\0');
+    captured += std::string("\x1d\x9c\x00", 3);
+    mbed_mem_trace_malloc(addr(0x20001100), 16, addr(0x0800a001));
+    MemTraceAnalyzer heap = analyze();
+
+    EXPECT_EQ(2u, heap.records());
+    EXPECT_EQ(0u, heap.lost());
+    EXPECT_EQ(6u + 28u + 28u + 3u, heap.skipped());
+    EXPECT_EQ(32u, heap.live());
+}
+
+TEST_F(TestMemTrace, timeline_across_time_wrap)
+{
+    fake_time = 0xFFFFFF00;
+    mbed_mem_trace_malloc(addr(0x20001000), 16, addr(0x0800a001));
+    fake_time = 0xFFFFFF80;
+    // Changes nothing, no sample
+    mbed_mem_trace_free(NULL, addr(0x0800a001));
+    fake_time = 0x100;
+    mbed_mem_trace_malloc(addr(0x20001100), 48, addr(0x0800a001));
+    fake_time = 0x200;
+    mbed_mem_trace_free(addr(0x20001000), addr(0x0800a001));
+    MemTraceAnalyzer heap = analyze();
+
+    const std::vector<MemTraceAnalyzer::Sample> &timeline = heap.timeline();
+    ASSERT_EQ(3u, timeline.size());
+    EXPECT_EQ(0xFFFFFF00u, timeline[0].time);
+    EXPECT_EQ(16u, timeline[0].live);
+    EXPECT_EQ(0x100000100u, timeline[1].time);
+    EXPECT_EQ(64u, timeline[1].live);
+    EXPECT_EQ(2u, timeline[1].live_blocks);
+    EXPECT_EQ(0x100000200u, timeline[2].time);
+    EXPECT_EQ(48u, timeline[2].live);
+    EXPECT_EQ(0x100000100u, heap.peak_time());
+}
+
+#define BENCH_OPS 100000
+
+static size_t text_bytes;
+static size_t record_bytes;
+
+// The lines of mbed_mem_trace_default_callback, formatted into a buffer
+static void text_callback(uint8_t op, void *res, void *caller, ...)
+{
+    char line[64];
+    va_list va;
+    va_start(va, caller);
+    if (op == MBED_MEM_TRACE_MALLOC) {
+        text_bytes += snprintf(line, sizeof line, MBED_MEM_DEFAULT_TRACER_PREFIX "m:%p;%p-%u\n",
+                               res, caller, (unsigned) va_arg(va, size_t));
+    } else {
+        text_bytes += snprintf(line, sizeof line, MBED_MEM_DEFAULT_TRACER_PREFIX "f:%p;%p-%p\n",
+                               res, caller, va_arg(va, void *));
+    }
+    va_end(va);
+}
+
+static void count_record(const uint8_t *data, size_t len)
+{
+    record_bytes += len;
+}
+
+/** Benchmark the binary callback against the text lines of the default one
+ *
+ *  The text callback formats the default callback's lines without printing
+ *  them, which leaves out the cost of the console itself. The binary records
+ *  are drained into a counting output after every operation. Both the time
+ *  per operation and the bytes per operation sent to the output are printed;
+ *  only the bytes are asserted, since time depends on the host.
+ */
+TEST_F(TestMemTrace, benchmark_vs_text)
+{
+    auto run = [](mbed_mem_trace_cb_t cb, bool drain) {
+        mbed_mem_trace_set_callback(cb);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < BENCH_OPS; i += 2) {
+            void *ptr = addr(0x20001000 + (i & 0xFF) * 8);
+            mbed_mem_trace_malloc(ptr, 24 + (i & 31), addr(0x0800600d));
+            mbed_mem_trace_free(ptr, addr(0x0800602f));
+            if (drain) {
+                mbed_mem_trace_binary_drain(0);
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        return (long long) std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    };
+
+    mbed_mem_trace_binary_output_function_set(count_record);
+    text_bytes = 0;
+    record_bytes = 0;
+    long long text_ns = run(text_callback, false);
+    long long binary_ns = run(mbed_mem_trace_binary_callback, true);
+
+    printf("text %5.1f ns/op %4.1f bytes/op, binary %5.1f ns/op %4.1f bytes/op\n",
+           (double) text_ns / BENCH_OPS, (double) text_bytes / BENCH_OPS,
+           (double) binary_ns / BENCH_OPS, (double) record_bytes / BENCH_OPS);
+
+    EXPECT_EQ((size_t) BENCH_OPS * MBED_MEM_TRACE_BINARY_RECORD_SIZE, record_bytes);
+    EXPECT_LT(record_bytes, text_bytes);
+}
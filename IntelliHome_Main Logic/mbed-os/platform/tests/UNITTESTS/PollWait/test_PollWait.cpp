@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/mbed_poll.h"
+#include "platform/PollEvent.h"
+#include "platform/mbed_thread.h"
+#include "rtos/ThisThread.h"
+#include <functional>
+
+using namespace mbed;
+
+// A fake thread: the thread flags and a millisecond clock, where sleeping
+// runs the one pending "interrupt" when its time comes
+namespace {
+uint32_t flags;
+uint64_t now_ms;
+unsigned sleeps;
+uint64_t irq_at_ms;
+std::function<void()> irq;
+
+void at_ms(uint64_t time, std::function<void()> handler)
+{
+    irq_at_ms = time;
+    irq = handler;
+}
+}
+
+extern "C" uint64_t get_ms_count(void)
+{
+    return now_ms;
+}
+
+extern "C" void thread_sleep_for(uint32_t millisec)
+{
+    now_ms += millisec;
+}
+
+extern "C" uint32_t osThreadFlagsSet(osThreadId_t, uint32_t set)
+{
+    flags |= set;
+    return flags;
+}
+
+namespace rtos {
+
+osThreadId_t ThisThread::get_id()
+{
+    return (osThreadId_t) 1;
+}
+
+uint32_t ThisThread::flags_clear(uint32_t clear)
+{
+    uint32_t old = flags;
+    flags &= ~clear;
+    return old;
+}
+
+uint32_t ThisThread::flags_wait_any_for(uint32_t wanted, Kernel::Clock::duration_u32 rel_time, bool clear)
+{
+    if (!(flags & wanted)) {
+        sleeps++;
+        uint64_t wake_ms = rel_time == Kernel::wait_for_u32_forever ? UINT64_MAX : now_ms + rel_time.count();
+        if (irq && irq_at_ms <= wake_ms) {
+            now_ms = irq_at_ms;
+            std::function<void()> handler = irq;
+            irq = nullptr;
+            handler();
+        } else {
+            now_ms = wake_ms;
+        }
+    }
+    uint32_t result = flags & wanted;
+    if (clear) {
+        flags &= ~result;
+    }
+    return result;
+}
+
+}
+
+// A serial port whose receive interrupt calls the sigio callback
+class FakePort : public FileHandle {
+public:
+    ssize_t read(void *, size_t) override
+    {
+        readable = false;
+        return 1;
+    }
+    ssize_t write(const void *, size_t size) override
+    {
+        return size;
+    }
+    off_t seek(off_t, int) override
+    {
+        return -ESPIPE;
+    }
+    int close() override
+    {
+        return 0;
+    }
+    short poll(short events) const override
+    {
+        return (events & POLLIN) && readable ? POLLIN : 0;
+    }
+    void sigio(Callback<void()> func) override
+    {
+        cb = func;
+    }
+    void receive()
+    {
+        readable = true;
+        if (cb) {
+            cb();
+        }
+    }
+
+    bool readable = false;
+    Callback<void()> cb;
+};
+
+class TestPollWait : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        flags = 0;
+        now_ms = 1000;
+        sleeps = 0;
+        irq = nullptr;
+        port.sigio(poll_wake);
+    }
+
+    FakePort port;
+    PollEvent motion;
+};
+
+TEST_F(TestPollWait, ready_without_sleeping)
+{
+    port.readable = true;
+    pollfh fhs[] = {{&port, POLLIN}};
+    EXPECT_EQ(1, poll_wait(fhs, 1, 500));
+    EXPECT_EQ(POLLIN, fhs[0].revents);
+    EXPECT_EQ(0u, sleeps);
+}
+
+TEST_F(TestPollWait, sleeps_until_sigio)
+{
+    at_ms(1030, [this] { port.receive(); });
+    pollfh fhs[] = {{&port, POLLIN}, {&motion, POLLIN}};
+    EXPECT_EQ(1, poll_wait(fhs, 2, 500));
+    EXPECT_EQ(POLLIN, fhs[0].revents);
+    EXPECT_EQ(0, fhs[1].revents);
+    EXPECT_EQ(1030u, now_ms);
+    EXPECT_EQ(1u, sleeps);
+}
+
+TEST_F(TestPollWait, sleeps_until_timeout)
+{
+    pollfh fhs[] = {{&port, POLLIN}};
+    EXPECT_EQ(0, poll_wait(fhs, 1, 500));
+    EXPECT_EQ(0, fhs[0].revents);
+    EXPECT_EQ(1500u, now_ms);
+    EXPECT_EQ(1u, sleeps);
+}
+
+TEST_F(TestPollWait, zero_timeout_does_not_sleep)
+{
+    pollfh fhs[] = {{&port, POLLIN}};
+    EXPECT_EQ(0, poll_wait(fhs, 1, 0));
+    EXPECT_EQ(0u, sleeps);
+}
+
+TEST_F(TestPollWait, pin_event)
+{
+    at_ms(1200, [this] { motion.set(); });
+    pollfh fhs[] = {{&port, POLLIN}, {&motion, POLLIN}};
+    EXPECT_EQ(1, poll_wait(fhs, 2, -1));
+    EXPECT_EQ(0, fhs[0].revents);
+    EXPECT_EQ(POLLIN, fhs[1].revents);
+    EXPECT_EQ(1200u, now_ms);
+
+    // Stays ready until cleared
+    EXPECT_EQ(1, poll_wait(fhs, 2, 0));
+    EXPECT_TRUE(motion.clear());
+    EXPECT_FALSE(motion.clear());
+    EXPECT_EQ(0, poll_wait(fhs, 2, 0));
+}
+
+TEST_F(TestPollWait, unrelated_wake_keeps_deadline)
+{
+    // A wake for a handle outside the set rescans and sleeps again until the deadline
+    at_ms(1100, [] { poll_wake(); });
+    pollfh fhs[] = {{&port, POLLIN}};
+    EXPECT_EQ(0, poll_wait(fhs, 1, 500));
+    EXPECT_EQ(1500u, now_ms);
+    EXPECT_EQ(2u, sleeps);
+}
+
+// Receives on another port while it is scanned, after that port was scanned
+class RacingHandle : public FakePort {
+public:
+    short poll(short events) const override
+    {
+        other->receive();
+        return 0;
+    }
+
+    FakePort *other = nullptr;
+};
+
+TEST_F(TestPollWait, wake_between_scan_and_sleep)
+{
+    // The wake flag set after the scan ends the sleep at once and the
+    // rescan finds the data
+    RacingHandle racer;
+    racer.other = &port;
+    pollfh fhs[] = {{&port, POLLIN}, {&racer, POLLIN}};
+    EXPECT_EQ(1, poll_wait(fhs, 2, 500));
+    EXPECT_EQ(POLLIN, fhs[0].revents);
+    EXPECT_EQ(1000u, now_ms);
+    EXPECT_EQ(0u, sleeps);
+}
+
+TEST_F(TestPollWait, no_wake_outside_poll_wait)
+{
+    port.receive();
+    EXPECT_EQ(0u, flags);
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/SPSCCircularBuffer.h"
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#define TEST_BUFFER_SIZE (10)
+
+class TestSPSCCircularBuffer : public testing::Test {
+protected:
+    mbed::SPSCCircularBuffer<int, TEST_BUFFER_SIZE> buf;
+};
+
+TEST_F(TestSPSCCircularBuffer, push_pop)
+{
+    int item = 0;
+    EXPECT_TRUE(buf.empty());
+    EXPECT_TRUE(buf.push(1));
+    EXPECT_EQ(1u, buf.size());
+    EXPECT_TRUE(buf.peek(item));
+    EXPECT_EQ(1, item);
+    EXPECT_TRUE(buf.pop(item));
+    EXPECT_EQ(1, item);
+    EXPECT_FALSE(buf.pop(item));
+    EXPECT_TRUE(buf.empty());
+}
+
+TEST_F(TestSPSCCircularBuffer, full_keeps_oldest)
+{
+    for (int i = 0; i < TEST_BUFFER_SIZE; i++) {
+        EXPECT_TRUE(buf.push(i));
+    }
+    EXPECT_TRUE(buf.full());
+    EXPECT_FALSE(buf.push(-1));
+
+    const int more[3] = { -1, -2, -3 };
+    EXPECT_EQ(0u, buf.push(more, 3));
+
+    int item = 0;
+    EXPECT_TRUE(buf.pop(item));
+    EXPECT_EQ(0, item);
+    EXPECT_EQ(1u, buf.push(more, 3));
+    EXPECT_TRUE(buf.full());
+}
+
+TEST_F(TestSPSCCircularBuffer, push_pop_multiple)
+{
+    const int test_numbers[TEST_BUFFER_SIZE] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+    /* this will check pushing and popping across the buffer end */
+    for (int i = 1; i <= TEST_BUFFER_SIZE; i++) {
+        int test_numbers_popped[TEST_BUFFER_SIZE] = { 0 };
+        EXPECT_EQ((uint32_t)i, buf.push(mbed::make_Span(test_numbers, i)));
+        EXPECT_EQ((uint32_t)i, buf.size());
+        mbed::Span<int> popped = buf.pop(mbed::make_Span(test_numbers_popped, TEST_BUFFER_SIZE));
+        EXPECT_EQ(i, popped.size());
+        EXPECT_EQ(0u, buf.size());
+        EXPECT_TRUE(0 == memcmp(test_numbers, test_numbers_popped, i * sizeof(int)));
+    }
+}
+
+TEST_F(TestSPSCCircularBuffer, regions)
+{
+    // Move the indices to the middle so that the free space wraps
+    for (int i = 0; i < 6; i++) {
+        buf.push(i);
+    }
+    int item;
+    for (int i = 0; i < 6; i++) {
+        buf.pop(item);
+    }
+
+    mbed::Span<int> space = buf.write_region();
+    ASSERT_EQ(4, space.size());
+    for (int i = 0; i < 4; i++) {
+        space[i] = 100 + i;
+    }
+    buf.commit_write(4);
+
+    space = buf.write_region();
+    ASSERT_EQ(6, space.size());
+    space[0] = 104;
+    space[1] = 105;
+    buf.commit_write(2);
+
+    mbed::Span<const int> data = buf.read_region();
+    ASSERT_EQ(4, data.size());
+    EXPECT_EQ(100, data[0]);
+    buf.commit_read(3);
+
+    data = buf.read_region();
+    ASSERT_EQ(1, data.size());
+    EXPECT_EQ(103, data[0]);
+    buf.commit_read(1);
+
+    data = buf.read_region();
+    ASSERT_EQ(2, data.size());
+    EXPECT_EQ(104, data[0]);
+    EXPECT_EQ(105, data[1]);
+
+    buf.reset();
+    EXPECT_TRUE(buf.empty());
+    EXPECT_EQ(0, buf.read_region().size());
+}
+
+TEST_F(TestSPSCCircularBuffer, small_counter)
+{
+    mbed::SPSCCircularBuffer<uint8_t, 127, uint8_t> small;
+    uint8_t item;
+    for (int round = 0; round < 600; round++) {
+        EXPECT_TRUE(small.push((uint8_t)round));
+        EXPECT_TRUE(small.pop(item));
+        EXPECT_EQ((uint8_t)round, item);
+    }
+    EXPECT_TRUE(small.empty());
+}
+
+#define BENCH_ITEMS 1000000
+#define BENCH_CHUNK 64
+
+typedef mbed::SPSCCircularBuffer<uint32_t, 256> BenchBuffer;
+
+template <typename Producer, typename Consumer>
+static long long bench_two_threads(Producer produce, Consumer consume)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer(produce);
+    consume();
+    producer.join();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+/** Benchmark moving items between two threads.
+ *
+ *  A producer thread pushes BENCH_ITEMS sequence numbers and the test thread
+ *  pops them, one at a time and in chunks of BENCH_CHUNK. A CircularBuffer
+ *  behind a std::mutex stands in for the critical section version. Every
+ *  item must arrive once and in order; the time per item is printed but not
+ *  asserted.
+ */
+TEST_F(TestSPSCCircularBuffer, benchmark_two_threads)
+{
+    BenchBuffer *spsc = new BenchBuffer;
+    uint32_t errors = 0;
+
+    long long single = bench_two_threads([spsc] {
+        for (uint32_t i = 0; i < BENCH_ITEMS;) {
+            if (spsc->push(i)) {
+                i++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }, [spsc, &errors] {
+        for (uint32_t expected = 0; expected < BENCH_ITEMS;) {
+            uint32_t item;
+            if (spsc->pop(item)) {
+                errors += item != expected++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    EXPECT_EQ(0u, errors);
+    EXPECT_TRUE(spsc->empty());
+
+    long long bulk = bench_two_threads([spsc] {
+        uint32_t chunk[BENCH_CHUNK];
+        for (uint32_t i = 0; i < BENCH_ITEMS;) {
+            uint32_t n = 0;
+            while (n < BENCH_CHUNK && i + n < BENCH_ITEMS) {
+                chunk[n] = i + n;
+                n++;
+            }
+            uint32_t pushed = spsc->push(mbed::make_Span(chunk, n));
+            if (pushed == 0) {
+                std::this_thread::yield();
+            }
+            i += pushed;
+        }
+    }, [spsc, &errors] {
+        for (uint32_t expected = 0; expected < BENCH_ITEMS;) {
+            // Zero copy: check the items where they lie
+            mbed::Span<const uint32_t> data = spsc->read_region();
+            if (data.empty()) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (uint32_t item : data) {
+                errors += item != expected++;
+            }
+            spsc->commit_read(data.size());
+        }
+    });
+    EXPECT_EQ(0u, errors);
+    delete spsc;
+
+    mbed::CircularBuffer<uint32_t, 256> *locked = new mbed::CircularBuffer<uint32_t, 256>;
+    std::mutex lock;
+    long long mutex = bench_two_threads([locked, &lock] {
+        for (uint32_t i = 0; i < BENCH_ITEMS;) {
+            bool pushed = false;
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                if (!locked->full()) {
+                    locked->push(i++);
+                    pushed = true;
+                }
+            }
+            if (!pushed) {
+                std::this_thread::yield();
+            }
+        }
+    }, [locked, &lock, &errors] {
+        for (uint32_t expected = 0; expected < BENCH_ITEMS;) {
+            uint32_t item;
+            bool popped;
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                popped = locked->pop(item);
+            }
+            if (popped) {
+                errors += item != expected++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    EXPECT_EQ(0u, errors);
+    delete locked;
+
+    printf("SPSC single %5.1f ns/item, SPSC bulk %5.1f ns/item, mutex CircularBuffer %5.1f ns/item\n",
+           (double)single / BENCH_ITEMS, (double)bulk / BENCH_ITEMS, (double)mutex / BENCH_ITEMS);
+}
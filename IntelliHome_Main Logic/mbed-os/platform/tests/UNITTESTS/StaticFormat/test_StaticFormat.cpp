@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/StaticFormat.h"
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <string>
+
+using namespace mbed;
+
+extern "C" int mbed_minimal_formatted_string(char *buffer, size_t length, const char *format, va_list arguments, FILE *stream);
+
+static int minimal_snprintf(char *buffer, size_t length, const char *format, ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+    int n = mbed_minimal_formatted_string(buffer, length, format, arguments, nullptr);
+    va_end(arguments);
+    return n;
+}
+
+template<typename Format, typename... Args>
+static std::string run(Format format, Args... args)
+{
+    char buffer[Format::template max_size<Args...>() + 1];
+    size_t len = format(buffer, args...);
+    EXPECT_LE(len, Format::template max_size<Args...>());
+    return std::string(buffer, len);
+}
+
+TEST(TestStaticFormat, integers)
+{
+    EXPECT_EQ("x=42.", run(MBED_STATIC_FORMAT("x=%d."), 42));
+    EXPECT_EQ("-7 7", run(MBED_STATIC_FORMAT("%i %u"), -7, 7u));
+    EXPECT_EQ("-2147483648", run(MBED_STATIC_FORMAT("%d"), INT32_MIN));
+    EXPECT_EQ("18446744073709551615", run(MBED_STATIC_FORMAT("%u"), UINT64_MAX));
+    EXPECT_EQ("-9223372036854775808", run(MBED_STATIC_FORMAT("%d"), INT64_MIN));
+    EXPECT_EQ("1,0", run(MBED_STATIC_FORMAT("%d,%d"), true, false));
+    EXPECT_EQ("ff FF 0", run(MBED_STATIC_FORMAT("%x %X %x"), (uint8_t) 255, 255u, 0u));
+    EXPECT_EQ("deadbeef", run(MBED_STATIC_FORMAT("%x"), 0xDEADBEEFu));
+    EXPECT_EQ("A", run(MBED_STATIC_FORMAT("%c"), 'A'));
+    EXPECT_EQ("-128 255", run(MBED_STATIC_FORMAT("%d %u"), (int8_t) -128, (uint8_t) 255));
+}
+
+TEST(TestStaticFormat, padding)
+{
+    EXPECT_EQ("  12|12  |0012", run(MBED_STATIC_FORMAT("%4d|%-4d|%04d"), 12, 12, 12));
+    EXPECT_EQ(" -12|-12 |-012", run(MBED_STATIC_FORMAT("%4d|%-4d|%04d"), -12, -12, -12));
+    EXPECT_EQ("00ab", run(MBED_STATIC_FORMAT("%04x"), 0xABu));
+    EXPECT_EQ("12345", run(MBED_STATIC_FORMAT("%3d"), 12345));
+    EXPECT_EQ(" 12.3| 12.3|012.3|12.3 ", run(MBED_STATIC_FORMAT("%5.1f|%5.1f|%05.1f|%-5.1f"),
+                                           Scaled<1>(123), Fixed<4>(197), Scaled<2>(1234), Scaled<1>(123)));
+}
+
+TEST(TestStaticFormat, strings)
+{
+    EXPECT_EQ("hello", run(MBED_STATIC_FORMAT("%.16s"), "hello"));
+    EXPECT_EQ("hel", run(MBED_STATIC_FORMAT("%.3s"), "hello"));
+    EXPECT_EQ("   hi|hi   |", run(MBED_STATIC_FORMAT("%5.5s|%-5.5s|"), "hi", "hi"));
+
+    // An LCD line: padded and cut to 16 characters
+    EXPECT_EQ("ALARM! ENTER PIN", run(MBED_STATIC_FORMAT("%-16.16s"), "ALARM! ENTER PIN TOO LONG"));
+    EXPECT_EQ("AWAY - ECO      ", run(MBED_STATIC_FORMAT("%-16.16s"), "AWAY - ECO"));
+
+    char name[] = "mutable";
+    EXPECT_EQ("mutable", run(MBED_STATIC_FORMAT("%.8s"), name));
+}
+
+TEST(TestStaticFormat, literals)
+{
+    EXPECT_EQ("", run(MBED_STATIC_FORMAT("")));
+    EXPECT_EQ("plain text\r\n", run(MBED_STATIC_FORMAT("plain text\r\n")));
+    EXPECT_EQ("100%", run(MBED_STATIC_FORMAT("%d%%"), 100));
+    EXPECT_EQ("%%", run(MBED_STATIC_FORMAT("%%%%")));
+}
+
+TEST(TestStaticFormat, scaled)
+{
+    EXPECT_EQ("23.5", run(MBED_STATIC_FORMAT("%.1f"), Scaled<1>(235)));
+    EXPECT_EQ("-23.5", run(MBED_STATIC_FORMAT("%.1f"), Scaled<1>(-235)));
+    EXPECT_EQ("12.340", run(MBED_STATIC_FORMAT("%.3f"), Scaled<2>(1234)));
+    EXPECT_EQ("20.0", run(MBED_STATIC_FORMAT("%.1f"), Scaled<2>(1996)));
+    EXPECT_EQ("23.000000", run(MBED_STATIC_FORMAT("%f"), Scaled<0>(23)));
+    EXPECT_EQ("-0.0", run(MBED_STATIC_FORMAT("%.1F"), Scaled<2>(-4)));
+    EXPECT_EQ("2", run(MBED_STATIC_FORMAT("%.0f"), Scaled<1>(25)));
+    EXPECT_EQ("0.2 0.4", run(MBED_STATIC_FORMAT("%.1f %.1f"), Scaled<2>(15), Scaled<2>(35)));
+    EXPECT_EQ("-2147483648.0", run(MBED_STATIC_FORMAT("%.1f"), Scaled<0>(INT32_MIN)));
+}
+
+TEST(TestStaticFormat, fixed_matches_printf)
+{
+    auto format2 = MBED_STATIC_FORMAT("%.2f");
+    auto format9 = MBED_STATIC_FORMAT("%.9f");
+    auto format0 = MBED_STATIC_FORMAT("%.0f");
+    uint32_t seed = 1;
+    for (int i = 0; i < 20000; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        int32_t value = (int32_t) seed >> (i % 17);
+        char expected[48];
+
+        snprintf(expected, sizeof(expected), "%.2f", std::ldexp((double) value, -16));
+        ASSERT_EQ(expected, run(format2, Fixed<16>(value))) << value;
+        snprintf(expected, sizeof(expected), "%.9f", std::ldexp((double) value, -31));
+        ASSERT_EQ(expected, run(format9, Fixed<31>(value))) << value;
+        snprintf(expected, sizeof(expected), "%.0f", std::ldexp((double) value, -3));
+        ASSERT_EQ(expected, run(format0, Fixed<3>(value))) << value;
+    }
+}
+
+TEST(TestStaticFormat, max_size_is_exact)
+{
+    auto format = MBED_STATIC_FORMAT("[%d|%u|%x|%.4s|%.1f|%.2f|%c]");
+    using Format = decltype(format);
+    constexpr size_t size = Format::max_size<int32_t, uint16_t, uint32_t, const char *, Scaled<1>, Fixed<16>, char>();
+    static_assert(size == 8 + 11 + 5 + 8 + 4 + 12 + 9 + 1, "bound of the format");
+
+    // The largest values reach the bound
+    char buffer[size];
+    EXPECT_EQ(size, format(buffer, INT32_MIN, (uint16_t) 65535, 0xFFFFFFFFu, "abcdef",
+                           Scaled<1>(INT32_MIN), Fixed<16>(INT32_MIN), 'z'));
+    EXPECT_EQ("[-2147483648|65535|ffffffff|abcd|-214748364.8|-32768.00|z]", std::string(buffer, size));
+
+    auto width = MBED_STATIC_FORMAT("%8d");
+    static_assert(decltype(width)::max_size<uint8_t>() == 8, "width is the bound");
+    auto sign = MBED_STATIC_FORMAT("%.0f");
+    static_assert(decltype(sign)::max_size<Fixed<31>>() == 2, "sign and one digit");
+}
+
+TEST(TestStaticFormat, spans)
+{
+    auto format = MBED_STATIC_FORMAT("%d,%d");
+
+    char big[32];
+    EXPECT_EQ(6u, format(Span<char>(big, sizeof(big)), 12, 345));
+    EXPECT_EQ("12,345", std::string(big, 6));
+
+    // A small dynamic span gets the start of the output
+    char small[4] = { 'x', 'x', 'x', 'x' };
+    EXPECT_EQ(3u, format(Span<char>(small, 3), 12, 345));
+    EXPECT_EQ("12,x", std::string(small, 4));
+
+    // Two int32_t and a comma need 23 characters at most
+    char exact[23];
+    EXPECT_EQ(8u, format(Span<char, 23>(exact), -1, -2345));
+    EXPECT_EQ("-1,-2345", std::string(exact, 8));
+}
+
+#define BENCH_FRAMES 100000
+
+namespace {
+/* Telemetry frame of the application, from the integer readings the values come from */
+struct telemetry {
+    int temp;
+    int humidity;
+    uint16_t rain;
+    int raining;
+    uint32_t dist_mm;
+};
+
+telemetry reading(int i)
+{
+    return { 20 + (i & 15), 40 + (i & 31), (uint16_t)(i * 7919), i & 1, 1000u + (i & 1023) };
+}
+}
+
+/** Benchmark the telemetry frame of the application with the three formatters.
+ *
+ *  The host C library and the minimal printf parse the format for every
+ *  frame and take floats; StaticFormat takes the integer readings. The
+ *  StaticFormat frames must match the C library ones; the time per frame is
+ *  printed but not asserted, since it depends on the host and the
+ *  optimization level.
+ */
+TEST(TestStaticFormat, benchmark_telemetry_frame)
+{
+    auto frame = MBED_STATIC_FORMAT("%.1f,%.1f,%.2f,%d,%.1f,%d,%d,%d\r\n");
+    char expected[80];
+    char line[80];
+
+    for (int i = 0; i < BENCH_FRAMES; i += 97) {
+        telemetry t = reading(i);
+        int len = snprintf(expected, sizeof(expected), "%.1f,%.1f,%.2f,%d,%.1f,%d,%d,%d\r\n",
+                           (float) t.temp, (float) t.humidity, t.rain / 65536.0f, t.raining, t.dist_mm / 10.0f, 1, 0, 0);
+        size_t n = frame(line, Scaled<0>(t.temp), Scaled<0>(t.humidity), Fixed<16>(t.rain), t.raining,
+                         Scaled<1>(t.dist_mm), true, false, false);
+        ASSERT_EQ(std::string(expected, len), std::string(line, n));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_FRAMES; i++) {
+        telemetry t = reading(i);
+        snprintf(line, sizeof(line), "%.1f,%.1f,%.2f,%d,%.1f,%d,%d,%d\r\n",
+                 (float) t.temp, (float) t.humidity, t.rain / 65536.0f, t.raining, t.dist_mm / 10.0f, 1, 0, 0);
+    }
+    auto libc_end = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_FRAMES; i++) {
+        telemetry t = reading(i);
+        minimal_snprintf(line, sizeof(line), "%.1f,%.1f,%.2f,%d,%.1f,%d,%d,%d\r\n",
+                         (float) t.temp, (float) t.humidity, t.rain / 65536.0f, t.raining, t.dist_mm / 10.0f, 1, 0, 0);
+    }
+    auto minimal_end = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_FRAMES; i++) {
+        telemetry t = reading(i);
+        frame(line, Scaled<0>(t.temp), Scaled<0>(t.humidity), Fixed<16>(t.rain), t.raining,
+              Scaled<1>(t.dist_mm), true, false, false);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    using std::chrono::nanoseconds;
+    using std::chrono::duration_cast;
+    printf("snprintf %5.1f ns/frame, minimal printf %5.1f ns/frame, StaticFormat %5.1f ns/frame\n",
+           (double) duration_cast<nanoseconds>(libc_end - start).count() / BENCH_FRAMES,
+           (double) duration_cast<nanoseconds>(minimal_end - libc_end).count() / BENCH_FRAMES,
+           (double) duration_cast<nanoseconds>(end - minimal_end).count() / BENCH_FRAMES);
+}
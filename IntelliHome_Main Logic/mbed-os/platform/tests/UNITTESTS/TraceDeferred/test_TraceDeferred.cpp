@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define TRACE_GROUP "test"
+
+#include "gtest/gtest.h"
+#include "mbed-trace/mbed_trace.h"
+#include "TraceDecoder.h"
+#include "platform/mbed_mem_trace.h"
+#include "MemTraceAnalyzer.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+static std::string captured;
+static uint32_t fake_time;
+
+static void capture(const uint8_t *data, size_t len)
+{
+    captured.append(reinterpret_cast<const char *>(data), len);
+}
+
+static uint32_t time_source(void)
+{
+    return fake_time;
+}
+
+class TestTraceDeferred : public testing::Test {
+protected:
+    void SetUp()
+    {
+        mbed_trace_config_set(TRACE_ACTIVE_LEVEL_ALL);
+        mbed_trace_deferred_output_function_set(capture);
+        mbed_trace_deferred_time_function_set(time_source);
+        mbed_trace_deferred_drain(0);
+        captured.clear();
+        fake_time = 0;
+    }
+
+    // On the host the string id is the address of the call site string
+    std::vector<std::string> decode()
+    {
+        std::vector<std::string> lines;
+        TraceDecoder decoder([](uint64_t id) {
+            return reinterpret_cast<const char *>(static_cast<uintptr_t>(id));
+        }, [&lines](const std::string &line) {
+            lines.push_back(line);
+        });
+        mbed_trace_deferred_drain(0);
+        decoder.feed(reinterpret_cast<const uint8_t *>(captured.data()), captured.size());
+        decoder.flush();
+        captured.clear();
+        return lines;
+    }
+};
+
+TEST_F(TestTraceDeferred, round_trip)
+{
+    fake_time = 100;
+    tr_info("T=%.1f C H=%d %% dist=%u mm", 23.5f, 41, 1234u);
+    fake_time = 350;
+    tr_warn("%s at %p, %d %lld", "link", (void *)0x1234, -7, -123456789012LL);
+    tr_error("%04x %c %hhu %5s|%-3d|", 0xab, 'Z', (unsigned char)200, "ab", 5);
+    tr_debug("no args");
+
+    std::vector<std::string> lines = decode();
+    ASSERT_EQ(4u, lines.size());
+    EXPECT_EQ("[INFO][test]: T=23.5 C H=41 % dist=1234 mm", lines[0]);
+    EXPECT_EQ("[WARN][test]: link at 0x1234, -7 -123456789012", lines[1]);
+    EXPECT_EQ("[ERR ][test]: 00ab Z 200    ab|5  |", lines[2]);
+    EXPECT_EQ("[DBG ][test]: no args", lines[3]);
+}
+
+TEST_F(TestTraceDeferred, text_passes_through)
+{
+    captured = "boot\r\n";
+    tr_info("up");
+    mbed_trace_deferred_drain(0);
+    captured += "plain";
+
+    std::vector<std::string> lines = decode();
+    ASSERT_EQ(3u, lines.size());
+    EXPECT_EQ("boot", lines[0]);
+    EXPECT_EQ("[INFO][test]: up", lines[1]);
+    EXPECT_EQ("plain", lines[2]);
+}
+
+TEST_F(TestTraceDeferred, heap_records_skipped)
+{
+    // A record of mbed_mem_trace_binary_callback inside a text line
+    captured = "pl";
+    captured += '\x1c';
+    captured += std::string(23, '\n');
+    captured += "ain\n";
+    tr_info("up");
+
+    std::vector<std::string> lines = decode();
+    ASSERT_EQ(2u, lines.size());
+    EXPECT_EQ("plain", lines[0]);
+    EXPECT_EQ("[INFO][test]: up", lines[1]);
+}
+
+TEST_F(TestTraceDeferred, level_filter)
+{
+    mbed_trace_config_set(TRACE_ACTIVE_LEVEL_WARN);
+    tr_debug("hidden");
+    tr_info("hidden");
+    tr_warn("shown");
+    tr_error("shown");
+
+    std::vector<std::string> lines = decode();
+    ASSERT_EQ(2u, lines.size());
+    EXPECT_EQ("[WARN][test]: shown", lines[0]);
+    EXPECT_EQ("[ERR ][test]: shown", lines[1]);
+}
+
+TEST_F(TestTraceDeferred, long_string_is_cut)
+{
+    std::string name(100, 'x');
+    tr_info("%s %d", name.c_str(), 5);
+
+    std::vector<std::string> lines = decode();
+    ASSERT_EQ(1u, lines.size());
+    // The string fills the record, the argument after it is lost
+    std::string expected = "[INFO][test]: ";
+    EXPECT_EQ(0u, lines[0].find(expected + "xxxx"));
+    EXPECT_EQ(" ?", lines[0].substr(lines[0].size() - 2));
+    EXPECT_LT(lines[0].size(), expected.size() + MBED_TRACE_DEFERRED_RECORD_SIZE);
+}
+
+TEST_F(TestTraceDeferred, full_ring_counts_drops)
+{
+    uint32_t dropped = mbed_trace_deferred_dropped();
+    int recorded = 0;
+    while (mbed_trace_deferred_dropped() == dropped) {
+        tr_info("n=%d", recorded++);
+    }
+    tr_info("lost");
+    EXPECT_EQ(dropped + 2, mbed_trace_deferred_dropped());
+
+    // The oldest records are kept, the marker goes out with the next one
+    std::vector<std::string> lines = decode();
+    ASSERT_EQ((size_t) recorded - 1, lines.size());
+    EXPECT_EQ("[INFO][test]: n=0", lines[0]);
+
+    tr_info("after");
+    lines = decode();
+    ASSERT_EQ(2u, lines.size());
+    EXPECT_EQ("[dropped 2 trace records]", lines[0]);
+    EXPECT_EQ("[INFO][test]: after", lines[1]);
+}
+
+TEST_F(TestTraceDeferred, drain_limit)
+{
+    tr_info("limit %d", 1);
+    tr_info("limit %d", 2);
+    // Stops at the end of the record it is in
+    size_t first = mbed_trace_deferred_drain(5);
+    ASSERT_GE(captured.size(), 2u);
+    EXPECT_EQ(2u + (uint8_t) captured[1], first);
+    EXPECT_EQ(first, captured.size());
+    EXPECT_EQ(first, mbed_trace_deferred_drain(1));
+    EXPECT_EQ(0u, mbed_trace_deferred_drain(0));
+
+    std::vector<std::string> lines = decode();
+    ASSERT_EQ(2u, lines.size());
+    EXPECT_EQ("[INFO][test]: limit 1", lines[0]);
+    EXPECT_EQ("[INFO][test]: limit 2", lines[1]);
+}
+
+/** Trace and heap records drained in turns to one port, as the application's main loop does
+ *
+ *  Each drain stops at the end of a record, so both decoders find all of
+ *  their records in the shared stream.
+ */
+TEST_F(TestTraceDeferred, interleaved_with_heap_records)
+{
+    mbed_mem_trace_set_callback(mbed_mem_trace_binary_callback);
+    mbed_mem_trace_binary_output_function_set(capture);
+    mbed_mem_trace_binary_drain(0);
+    captured.clear();
+
+    const int samples = 40;
+    for (int i = 0; i < samples; i++) {
+        tr_info("sample %d of %s", i, "forty");
+        mbed_mem_trace_malloc(reinterpret_cast<void *>(0x20001000 + i * 64), 32 + i,
+                              reinterpret_cast<void *>(0x0800a000 + i % 3));
+        if (i % 2) {
+            mbed_mem_trace_free(reinterpret_cast<void *>(0x20001000 + (i - 1) * 64),
+                                reinterpret_cast<void *>(0x0800a010));
+        }
+        mbed_trace_deferred_drain(16);
+        mbed_mem_trace_binary_drain(48);
+    }
+    while (mbed_trace_deferred_drain(16) + mbed_mem_trace_binary_drain(48) != 0) {
+    }
+    mbed_mem_trace_set_callback(NULL);
+    EXPECT_EQ(0u, mbed_mem_trace_binary_dropped());
+
+    MemTraceAnalyzer heap(16);
+    heap.feed(reinterpret_cast<const uint8_t *>(captured.data()), captured.size());
+    EXPECT_EQ((uint32_t)(samples + samples / 2), heap.records());
+    EXPECT_EQ(0u, heap.lost());
+    EXPECT_EQ((uint32_t)(samples / 2), heap.live_blocks());
+    EXPECT_EQ(captured.size() - heap.records() * MBED_MEM_TRACE_BINARY_RECORD_SIZE, heap.skipped());
+
+    std::vector<std::string> lines = decode();
+    ASSERT_EQ((size_t) samples, lines.size());
+    for (int i = 0; i < samples; i++) {
+        EXPECT_EQ("[INFO][test]: sample " + std::to_string(i) + " of forty", lines[i]);
+    }
+}
+
+TEST_F(TestTraceDeferred, time_deltas)
+{
+    TraceDecoder decoder([](uint64_t id) {
+        return reinterpret_cast<const char *>(static_cast<uintptr_t>(id));
+    }, [](const std::string &) {
+    });
+
+    fake_time = 0xFFFFFF00;
+    tr_info("before wrap");
+    fake_time = 0x100;
+    tr_info("after wrap");
+    mbed_trace_deferred_drain(0);
+    decoder.feed(reinterpret_cast<const uint8_t *>(captured.data()), captured.size());
+    EXPECT_EQ(0xFFFFFF00ull + 0x200, decoder.time());
+}
+
+#define BENCH_LINES 200000
+
+static size_t formatted_bytes;
+
+static void count_line(const char *line)
+{
+    formatted_bytes += strlen(line) + 2;
+}
+
+static size_t record_bytes;
+
+static void count_record(const uint8_t *, size_t len)
+{
+    record_bytes += len;
+}
+
+/** Benchmark a telemetry line formatted by mbed_tracef against a deferred record.
+ *
+ *  mbed_tracef formats into its line buffer and hands the text to a print
+ *  function that only counts it. The deferred call stores a record and the
+ *  ring is drained into a counting output after every call. Both the time
+ *  per line and the bytes per line sent to the output are printed; only the
+ *  bytes are asserted, since time depends on the host and the optimization
+ *  level. The string id is a full host address here, where a target build
+ *  with the section at address 0 needs one or two bytes.
+ */
+TEST_F(TestTraceDeferred, benchmark_vs_mbed_tracef)
+{
+    ASSERT_EQ(0, mbed_trace_init());
+    mbed_trace_config_set(TRACE_MODE_PLAIN | TRACE_ACTIVE_LEVEL_ALL);
+    mbed_trace_print_function_set(count_line);
+    mbed_trace_deferred_output_function_set(count_record);
+
+    formatted_bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_LINES; i++) {
+        mbed_tracef(TRACE_LEVEL_INFO, TRACE_GROUP, "T=%.1f C H=%d %% dist=%u mm", 23.5f + (i & 7), 41, 1234u + i);
+    }
+    auto mid = std::chrono::steady_clock::now();
+
+    record_bytes = 0;
+    for (int i = 0; i < BENCH_LINES; i++) {
+        tr_info("T=%.1f C H=%d %% dist=%u mm", 23.5f + (i & 7), 41, 1234u + i);
+        mbed_trace_deferred_drain(0);
+    }
+    auto end = std::chrono::steady_clock::now();
+    mbed_trace_free();
+
+    long long formatted_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(mid - start).count();
+    long long deferred_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - mid).count();
+    printf("mbed_tracef %5.1f ns/line %4.1f bytes/line, deferred %5.1f ns/line %4.1f bytes/line\n",
+           (double)formatted_ns / BENCH_LINES, (double)formatted_bytes / BENCH_LINES,
+           (double)deferred_ns / BENCH_LINES, (double)record_bytes / BENCH_LINES);
+
+    EXPECT_LT(record_bytes, formatted_bytes);
+}
@@ -24,34 +24,55 @@ bool core_util_atomic_flag_test_and_set(volatile core_util_atomic_flag *flagPtr)
 
 bool core_util_atomic_cas_u8(volatile uint8_t *ptr, uint8_t *expectedCurrentValue, uint8_t desiredValue)
 {
-    return false;
+    if (*ptr != *expectedCurrentValue) {
+        *expectedCurrentValue = *ptr;
+        return false;
+    }
+    *ptr = desiredValue;
+    return true;
 }
 
 bool core_util_atomic_cas_u16(volatile uint16_t *ptr, uint16_t *expectedCurrentValue, uint16_t desiredValue)
 {
-    return false;
+    if (*ptr != *expectedCurrentValue) {
+        *expectedCurrentValue = *ptr;
+        return false;
+    }
+    *ptr = desiredValue;
+    return true;
 }
 
 
 bool core_util_atomic_cas_u32(volatile uint32_t *ptr, uint32_t *expectedCurrentValue, uint32_t desiredValue)
 {
-    return false;
+    if (*ptr != *expectedCurrentValue) {
+        *expectedCurrentValue = *ptr;
+        return false;
+    }
+    *ptr = desiredValue;
+    return true;
 }
 
 
 uint8_t core_util_atomic_exchange_u8(volatile uint8_t *ptr, uint8_t desiredValue)
 {
-    return 0;
+    uint8_t v = *ptr;
+    *ptr = desiredValue;
+    return v;
 }
 
 uint16_t core_util_atomic_exchange_u16(volatile uint16_t *ptr, uint16_t desiredValue)
 {
-    return 0;
+    uint16_t v = *ptr;
+    *ptr = desiredValue;
+    return v;
 }
 
 uint32_t core_util_atomic_exchange_u32(volatile uint32_t *ptr, uint32_t desiredValue)
 {
-    return 0;
+    uint32_t v = *ptr;
+    *ptr = desiredValue;
+    return v;
 }
 
 
@@ -213,7 +234,12 @@ uint64_t core_util_atomic_exchange_u64(volatile uint64_t *valuePtr, uint64_t des
 
 bool core_util_atomic_cas_u64(volatile uint64_t *ptr, uint64_t *expectedCurrentValue, uint64_t desiredValue)
 {
-    return false;
+    if (*ptr != *expectedCurrentValue) {
+        *expectedCurrentValue = *ptr;
+        return false;
+    }
+    *ptr = desiredValue;
+    return true;
 }
 
 bool core_util_atomic_compare_exchange_weak_u64(volatile uint64_t *ptr, uint64_t *expectedCurrentValue, uint64_t desiredValue)
@@ -29,4 +29,14 @@ int poll(pollfh fhs[], unsigned nfhs, int timeout)
     return mbed_poll_stub::int_value;
 }
 
+int poll_wait(pollfh fhs[], unsigned nfhs, int timeout)
+{
+    fhs->revents = mbed_poll_stub::revents_value;
+    return mbed_poll_stub::int_value;
+}
+
+void poll_wake()
+{
+}
+
 }
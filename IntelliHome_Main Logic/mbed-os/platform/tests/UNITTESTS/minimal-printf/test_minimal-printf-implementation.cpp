@@ -15,9 +15,11 @@
  * limitations under the License.
  */
 
+#include <chrono>
 #include <cmath>
 #include <cstdarg>
 #include "gtest/gtest.h"
+#include "platform/mbed_format_fixed.h"
 
 /* "mbed_printf_implementation.h" does not declare it as extern "C", so pull it in manually */
 extern "C" int mbed_minimal_formatted_string(char *buffer, size_t length, const char *format, va_list arguments, FILE *stream);
@@ -40,6 +42,15 @@ namespace
 
         return std::string(buffer);
     }
+
+    int format_into(char *buffer, size_t length, const char *fmt, ...)
+    {
+        va_list arguments;
+        va_start(arguments, fmt);
+        int n = mbed_minimal_formatted_string(buffer, length, fmt, arguments, nullptr);
+        va_end(arguments);
+        return n;
+    }
 }
 
 TEST(minimal_printf, floats)
@@ -142,3 +153,197 @@ TEST(minimal_printf, padding)
     EXPECT_EQ("-012.3", format("%06.1f", -12.345));
 }
 
+
+namespace
+{
+    std::string fixed(int32_t value, int frac_bits, int decimals)
+    {
+        char buffer[32];
+        int n = mbed_format_fixed(buffer, sizeof(buffer), value, frac_bits, decimals);
+        return n < 0 ? "error" : std::string(buffer);
+    }
+
+    std::string scaled(int32_t value, int scale, int decimals)
+    {
+        char buffer[32];
+        int n = mbed_format_scaled(buffer, sizeof(buffer), value, scale, decimals);
+        return n < 0 ? "error" : std::string(buffer);
+    }
+}
+
+TEST(minimal_printf, format_fixed)
+{
+    EXPECT_EQ("1.50", fixed(0x18000, 16, 2));
+    EXPECT_EQ("-1.5", fixed(-0x18000, 16, 1));
+    EXPECT_EQ("0.999985", fixed(0xFFFF, 16, 6));
+    EXPECT_EQ("1.00", fixed(0xFFFF, 16, 2));
+    EXPECT_EQ("-0.0", fixed(-1, 16, 1));
+    EXPECT_EQ("42", fixed(42, 0, 0));
+    EXPECT_EQ("42.000", fixed(42, 0, 3));
+    EXPECT_EQ("-1.000000000", fixed(INT32_MIN, 31, 9));
+    EXPECT_EQ("-2147483648", fixed(INT32_MIN, 0, 0));
+
+    /* ties go to even, like printf */
+    EXPECT_EQ("0.2", fixed(1, 2, 1));
+    EXPECT_EQ("0.8", fixed(3, 2, 1));
+    EXPECT_EQ("2", fixed(5, 1, 0));
+    EXPECT_EQ("4", fixed(7, 1, 0));
+
+    EXPECT_EQ("error", fixed(1, 32, 1));
+    EXPECT_EQ("error", fixed(1, 16, 10));
+}
+
+TEST(minimal_printf, format_fixed_matches_printf)
+{
+    uint32_t seed = 1;
+    for (int i = 0; i < 20000; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        int32_t value = (int32_t) seed >> (i % 17);
+        int frac_bits = i % 32;
+        int decimals = (i / 32) % (MBED_FORMAT_FIXED_MAX_DECIMALS + 1);
+
+        /* the value is exact in a double, and glibc prints it exactly rounded */
+        char expected[48];
+        snprintf(expected, sizeof(expected), "%.*f", decimals, std::ldexp((double) value, -frac_bits));
+        ASSERT_EQ(expected, fixed(value, frac_bits, decimals)) << value << " / 2^" << frac_bits;
+    }
+}
+
+TEST(minimal_printf, format_scaled)
+{
+    EXPECT_EQ("23.5", scaled(235, 1, 1));
+    EXPECT_EQ("-23.5", scaled(-235, 1, 1));
+    EXPECT_EQ("12.340", scaled(1234, 2, 3));
+    EXPECT_EQ("12.3", scaled(1234, 2, 1));
+    EXPECT_EQ("12.4", scaled(1236, 2, 1));
+    EXPECT_EQ("0.05", scaled(5, 2, 2));
+    EXPECT_EQ("-0.0", scaled(-4, 2, 1));
+    EXPECT_EQ("20.0", scaled(1996, 2, 1));
+    EXPECT_EQ("-2.147483648", scaled(INT32_MIN, 9, 9));
+    EXPECT_EQ("7", scaled(7, 0, 0));
+
+    /* ties go to even */
+    EXPECT_EQ("0.2", scaled(15, 2, 1));
+    EXPECT_EQ("0.2", scaled(25, 2, 1));
+    EXPECT_EQ("0.4", scaled(35, 2, 1));
+    EXPECT_EQ("2", scaled(25, 1, 0));
+
+    EXPECT_EQ("error", scaled(1, 10, 1));
+    EXPECT_EQ("error", scaled(1, 1, -1));
+}
+
+TEST(minimal_printf, format_fixed_truncates)
+{
+    char buffer[5] = "xxxx";
+    EXPECT_EQ(6, mbed_format_scaled(buffer, sizeof(buffer), -12345, 2, 1));
+    EXPECT_STREQ("-123", buffer);
+
+    EXPECT_EQ(4, mbed_format_fixed(buffer, 1, 0x18000, 16, 2));
+    EXPECT_STREQ("", buffer);
+
+    EXPECT_EQ(4, mbed_format_fixed(nullptr, 0, 0x18000, 16, 2));
+}
+
+#define BENCH_LINES 100000
+
+namespace
+{
+    /* Telemetry line of the application, from the integer readings the values come from */
+    struct telemetry {
+        int temp;
+        int humidity;
+        uint16_t rain;
+        int dist_tenths_mm;
+        int raining;
+    };
+
+    telemetry reading(int i)
+    {
+        return { 20 + (i & 15), 40 + (i & 31), (uint16_t)(i * 7919), 1000 + (i & 1023), i & 1 };
+    }
+
+    void float_line(char *line, size_t size, const telemetry &t)
+    {
+        snprintf(line, size, "%.1f,%.1f,%.2f,%d,%.1f,%d,%d,%d\r\n",
+                 (float) t.temp, (float) t.humidity, t.rain / 65536.0f, t.raining, t.dist_tenths_mm / 10.0f, 1, 0, 0);
+    }
+
+    void fixed_line(char *line, size_t size, const telemetry &t)
+    {
+        size_t len = mbed_format_scaled(line, size, t.temp, 0, 1);
+        len += format_into(line + len, size - len, ",");
+        len += mbed_format_scaled(line + len, size - len, t.humidity, 0, 1);
+        len += format_into(line + len, size - len, ",");
+        len += mbed_format_fixed(line + len, size - len, t.rain, 16, 2);
+        len += format_into(line + len, size - len, ",%d,", t.raining);
+        len += mbed_format_scaled(line + len, size - len, t.dist_tenths_mm, 1, 1);
+        format_into(line + len, size - len, ",%d,%d,%d\r\n", 1, 0, 0);
+    }
+
+    /* Line sent while the alarm is armed, the readings left at "0.0" */
+    void float_alarm_line(char *line, size_t size, const telemetry &t, int home, int ac)
+    {
+        snprintf(line, size, "0.0,0.0,0.0,0,%.1f,%d,1,%d\r\n", t.dist_tenths_mm / 10.0f, home, ac);
+    }
+
+    void fixed_alarm_line(char *line, size_t size, const telemetry &t, int home, int ac)
+    {
+        size_t len = format_into(line, size, "0.0,0.0,0.0,0,");
+        len += mbed_format_scaled(line + len, size - len, t.dist_tenths_mm, 1, 1);
+        format_into(line + len, size - len, ",%d,1,%d\r\n", home, ac);
+    }
+}
+
+/** Test that the alarm line keeps its text with the integer formatter.
+ *
+ *  Given the readings and states of the alarm line.
+ *  When the line is formatted with the host C library and with the fixed point
+ *  formatter.
+ *  Then both give the same text, with "0.0" for the rain field.
+ */
+TEST(minimal_printf, telemetry_alarm_line)
+{
+    char expected[64];
+    char line[64];
+
+    for (int i = 0; i < 4096; i += 13) {
+        float_alarm_line(expected, sizeof(expected), reading(i), i & 1, (i >> 1) & 1);
+        fixed_alarm_line(line, sizeof(line), reading(i), i & 1, (i >> 1) & 1);
+        ASSERT_STREQ(expected, line);
+        ASSERT_EQ(0, strncmp(line, "0.0,0.0,0.0,0,", 14));
+    }
+}
+
+/** Benchmark a telemetry line of the application with %.1f against the integer formatter.
+ *
+ *  The float line is formatted by the host C library, the fixed one by
+ *  mbed_format_scaled/mbed_format_fixed for the decimal values and the
+ *  minimal printf for the rest. Both must give the same text; only that is
+ *  asserted, since the time depends on the host and the optimization level.
+ */
+TEST(minimal_printf, benchmark_telemetry_line)
+{
+    char expected[64];
+    char line[64];
+
+    for (int i = 0; i < BENCH_LINES; i += 97) {
+        float_line(expected, sizeof(expected), reading(i));
+        fixed_line(line, sizeof(line), reading(i));
+        ASSERT_STREQ(expected, line);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_LINES; i++) {
+        float_line(line, sizeof(line), reading(i));
+    }
+    auto mid = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_LINES; i++) {
+        fixed_line(line, sizeof(line), reading(i));
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    long long float_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(mid - start).count();
+    long long fixed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - mid).count();
+    printf("%%.1f line %5.1f ns, fixed-point line %5.1f ns\n",
+           (double) float_ns / BENCH_LINES, (double) fixed_ns / BENCH_LINES);
+}
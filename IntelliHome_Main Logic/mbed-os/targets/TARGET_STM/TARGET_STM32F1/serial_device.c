@@ -31,6 +31,7 @@
 #if DEVICE_SERIAL
 
 #include "serial_api_hal.h"
+#include "hal/serial_dma_api.h"
 
 #if defined(TARGET_STM32F103xG)
 #define UART_NUM (5)
@@ -43,6 +44,12 @@ UART_HandleTypeDef uart_handlers[UART_NUM];
 
 static uart_irq_handler irq_handler;
 
+#if DEVICE_SERIAL_DMA
+static uintptr_t serial_dma_ids[UART_NUM] = {0};
+static uint16_t serial_dma_rx_size[UART_NUM];
+static serial_dma_irq_handler dma_irq_handler;
+#endif
+
 // Defined in serial_api.c
 extern int8_t get_uart_index(UARTName uart_name);
 
@@ -74,6 +81,16 @@ static void uart_irq(UARTName uart_name)
                 }
             }
         }
+#if DEVICE_SERIAL_DMA
+        if (__HAL_UART_GET_FLAG(huart, UART_FLAG_IDLE) != RESET) {
+            if (__HAL_UART_GET_IT_SOURCE(huart, UART_IT_IDLE) != RESET) {
+                __HAL_UART_CLEAR_IDLEFLAG(huart);
+                if (serial_dma_ids[id] != 0) {
+                    dma_irq_handler(serial_dma_ids[id], SERIAL_DMA_EVENT_RX);
+                }
+            }
+        }
+#endif
     }
 }
 
@@ -120,47 +137,52 @@ void serial_irq_handler(serial_t *obj, uart_irq_handler handler, uint32_t id)
     serial_irq_ids[obj_s->index] = id;
 }
 
-void serial_irq_set(serial_t *obj, SerialIrq irq, uint32_t enable)
+static void uart_irq_vector(UARTName uart_name, IRQn_Type *irq_n, uint32_t *vector)
 {
-    struct serial_s *obj_s = SERIAL_S(obj);
-    UART_HandleTypeDef *huart = &uart_handlers[obj_s->index];
-    IRQn_Type irq_n = (IRQn_Type)0;
-    uint32_t vector = 0;
-
 #if defined(USART1_BASE)
-    if (obj_s->uart == UART_1) {
-        irq_n = USART1_IRQn;
-        vector = (uint32_t)&uart1_irq;
+    if (uart_name == UART_1) {
+        *irq_n = USART1_IRQn;
+        *vector = (uint32_t)&uart1_irq;
     }
 #endif
 
 #if defined(USART2_BASE)
-    if (obj_s->uart == UART_2) {
-        irq_n = USART2_IRQn;
-        vector = (uint32_t)&uart2_irq;
+    if (uart_name == UART_2) {
+        *irq_n = USART2_IRQn;
+        *vector = (uint32_t)&uart2_irq;
     }
 #endif
 
 #if defined(USART3_BASE)
-    if (obj_s->uart == UART_3) {
-        irq_n = USART3_IRQn;
-        vector = (uint32_t)&uart3_irq;
+    if (uart_name == UART_3) {
+        *irq_n = USART3_IRQn;
+        *vector = (uint32_t)&uart3_irq;
     }
 #endif
 
 #if defined(USART4_BASE)
-    if (obj_s->uart == UART_4) {
-        irq_n = USART4_IRQn;
-        vector = (uint32_t)&uart4_irq;
+    if (uart_name == UART_4) {
+        *irq_n = USART4_IRQn;
+        *vector = (uint32_t)&uart4_irq;
     }
 #endif
 
 #if defined(USART5_BASE)
-    if (obj_s->uart == UART_5) {
-        irq_n = USART5_IRQn;
-        vector = (uint32_t)&uart5_irq;
+    if (uart_name == UART_5) {
+        *irq_n = USART5_IRQn;
+        *vector = (uint32_t)&uart5_irq;
     }
 #endif
+}
+
+void serial_irq_set(serial_t *obj, SerialIrq irq, uint32_t enable)
+{
+    struct serial_s *obj_s = SERIAL_S(obj);
+    UART_HandleTypeDef *huart = &uart_handlers[obj_s->index];
+    IRQn_Type irq_n = (IRQn_Type)0;
+    uint32_t vector = 0;
+
+    uart_irq_vector(obj_s->uart, &irq_n, &vector);
 
     if (enable) {
         if (irq == RxIrq) {
@@ -187,6 +209,13 @@ void serial_irq_set(serial_t *obj, SerialIrq irq, uint32_t enable)
             }
         }
 
+#if DEVICE_SERIAL_DMA
+        // The idle line interrupt of DMA reception shares the vector
+        if (huart->Instance->CR1 & USART_CR1_IDLEIE) {
+            all_disabled = 0;
+        }
+#endif
+
         if (all_disabled) {
             NVIC_DisableIRQ(irq_n);
         }
@@ -241,6 +270,238 @@ void serial_break_set(serial_t *obj)
     HAL_LIN_SendBreak(huart);
 }
 
+#if DEVICE_SERIAL_DMA
+
+/******************************************************************************
+ * DMA RECEPTION/TRANSMISSION
+ ******************************************************************************/
+
+/* DMA1 requests of the USARTs, RM0008 table 78. UART4 and UART5 are not
+ * supported: only UART4 has requests, on DMA2. */
+typedef struct {
+    DMA_Channel_TypeDef *rx;
+    DMA_Channel_TypeDef *tx;
+    IRQn_Type rx_irq;
+    IRQn_Type tx_irq;
+    void (*rx_vector)(void);
+    void (*tx_vector)(void);
+    uint8_t rx_shift; // position of the channel flags in ISR and IFCR
+    uint8_t tx_shift;
+} serial_dma_channels_t;
+
+#define DMA_FLAGS_SHIFT(channel) (4 * ((channel) - 1))
+
+static void dma_rx_irq(UARTName uart_name, uint8_t shift)
+{
+    int8_t id = get_uart_index(uart_name);
+    uint32_t flags = DMA1->ISR >> shift;
+
+    DMA1->IFCR = (DMA_IFCR_CGIF1 | DMA_IFCR_CTCIF1 | DMA_IFCR_CHTIF1 | DMA_IFCR_CTEIF1) << shift;
+    if ((id >= 0) && (serial_dma_ids[id] != 0) && (flags & (DMA_ISR_HTIF1 | DMA_ISR_TCIF1))) {
+        dma_irq_handler(serial_dma_ids[id], SERIAL_DMA_EVENT_RX);
+    }
+}
+
+static void dma_tx_irq(UARTName uart_name, DMA_Channel_TypeDef *channel, uint8_t shift)
+{
+    int8_t id = get_uart_index(uart_name);
+    uint32_t flags = DMA1->ISR >> shift;
+
+    DMA1->IFCR = (DMA_IFCR_CGIF1 | DMA_IFCR_CTCIF1 | DMA_IFCR_CHTIF1 | DMA_IFCR_CTEIF1) << shift;
+    if (flags & (DMA_ISR_TCIF1 | DMA_ISR_TEIF1)) {
+        channel->CCR &= ~DMA_CCR_EN;
+        if ((id >= 0) && (serial_dma_ids[id] != 0)) {
+            dma_irq_handler(serial_dma_ids[id], SERIAL_DMA_EVENT_TX_DONE);
+        }
+    }
+}
+
+#if defined(USART1_BASE)
+static void uart1_dma_rx_irq(void)
+{
+    dma_rx_irq(UART_1, DMA_FLAGS_SHIFT(5));
+}
+
+static void uart1_dma_tx_irq(void)
+{
+    dma_tx_irq(UART_1, DMA1_Channel4, DMA_FLAGS_SHIFT(4));
+}
+#endif
+
+#if defined(USART2_BASE)
+static void uart2_dma_rx_irq(void)
+{
+    dma_rx_irq(UART_2, DMA_FLAGS_SHIFT(6));
+}
+
+static void uart2_dma_tx_irq(void)
+{
+    dma_tx_irq(UART_2, DMA1_Channel7, DMA_FLAGS_SHIFT(7));
+}
+#endif
+
+#if defined(USART3_BASE)
+static void uart3_dma_rx_irq(void)
+{
+    dma_rx_irq(UART_3, DMA_FLAGS_SHIFT(3));
+}
+
+static void uart3_dma_tx_irq(void)
+{
+    dma_tx_irq(UART_3, DMA1_Channel2, DMA_FLAGS_SHIFT(2));
+}
+#endif
+
+static const serial_dma_channels_t *serial_dma_channels(UARTName uart_name)
+{
+#if defined(USART1_BASE)
+    static const serial_dma_channels_t uart1_dma = {
+        DMA1_Channel5, DMA1_Channel4, DMA1_Channel5_IRQn, DMA1_Channel4_IRQn,
+        &uart1_dma_rx_irq, &uart1_dma_tx_irq,
+        DMA_FLAGS_SHIFT(5), DMA_FLAGS_SHIFT(4)
+    };
+    if (uart_name == UART_1) {
+        return &uart1_dma;
+    }
+#endif
+
+#if defined(USART2_BASE)
+    static const serial_dma_channels_t uart2_dma = {
+        DMA1_Channel6, DMA1_Channel7, DMA1_Channel6_IRQn, DMA1_Channel7_IRQn,
+        &uart2_dma_rx_irq, &uart2_dma_tx_irq,
+        DMA_FLAGS_SHIFT(6), DMA_FLAGS_SHIFT(7)
+    };
+    if (uart_name == UART_2) {
+        return &uart2_dma;
+    }
+#endif
+
+#if defined(USART3_BASE)
+    static const serial_dma_channels_t uart3_dma = {
+        DMA1_Channel3, DMA1_Channel2, DMA1_Channel3_IRQn, DMA1_Channel2_IRQn,
+        &uart3_dma_rx_irq, &uart3_dma_tx_irq,
+        DMA_FLAGS_SHIFT(3), DMA_FLAGS_SHIFT(2)
+    };
+    if (uart_name == UART_3) {
+        return &uart3_dma;
+    }
+#endif
+
+    MBED_ASSERT(0);
+    return NULL;
+}
+
+void serial_dma_handler(serial_t *obj, serial_dma_irq_handler handler, uintptr_t id)
+{
+    struct serial_s *obj_s = SERIAL_S(obj);
+
+    dma_irq_handler = handler;
+    serial_dma_ids[obj_s->index] = id;
+}
+
+void serial_dma_rx_start(serial_t *obj, uint8_t *buffer, size_t size)
+{
+    struct serial_s *obj_s = SERIAL_S(obj);
+    UART_HandleTypeDef *huart = &uart_handlers[obj_s->index];
+    const serial_dma_channels_t *dma = serial_dma_channels(obj_s->uart);
+    IRQn_Type irq_n = (IRQn_Type)0;
+    uint32_t vector = 0;
+
+    MBED_ASSERT(size > 0 && size <= 0xFFFF);
+    if (dma == NULL) {
+        return;
+    }
+
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    // Circular transfer from DR, interrupting at half and whole ring
+    dma->rx->CCR = 0;
+    DMA1->IFCR = (DMA_IFCR_CGIF1 | DMA_IFCR_CTCIF1 | DMA_IFCR_CHTIF1 | DMA_IFCR_CTEIF1) << dma->rx_shift;
+    dma->rx->CPAR = (uint32_t)&huart->Instance->DR;
+    dma->rx->CMAR = (uint32_t)buffer;
+    dma->rx->CNDTR = size;
+    serial_dma_rx_size[obj_s->index] = size;
+    NVIC_SetVector(dma->rx_irq, (uint32_t)dma->rx_vector);
+    NVIC_EnableIRQ(dma->rx_irq);
+    dma->rx->CCR = DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_EN;
+    SET_BIT(huart->Instance->CR3, USART_CR3_DMAR);
+
+    // The end of a burst is reported by the idle line interrupt
+    __HAL_UART_CLEAR_IDLEFLAG(huart);
+    __HAL_UART_ENABLE_IT(huart, UART_IT_IDLE);
+    uart_irq_vector(obj_s->uart, &irq_n, &vector);
+    NVIC_SetVector(irq_n, vector);
+    NVIC_EnableIRQ(irq_n);
+}
+
+size_t serial_dma_rx_head(serial_t *obj)
+{
+    struct serial_s *obj_s = SERIAL_S(obj);
+    const serial_dma_channels_t *dma = serial_dma_channels(obj_s->uart);
+
+    // CNDTR counts down to 1 then reloads the ring size
+    return serial_dma_rx_size[obj_s->index] - dma->rx->CNDTR;
+}
+
+void serial_dma_rx_stop(serial_t *obj)
+{
+    struct serial_s *obj_s = SERIAL_S(obj);
+    UART_HandleTypeDef *huart = &uart_handlers[obj_s->index];
+    const serial_dma_channels_t *dma = serial_dma_channels(obj_s->uart);
+    IRQn_Type irq_n = (IRQn_Type)0;
+    uint32_t vector = 0;
+
+    if (dma == NULL) {
+        return;
+    }
+
+    __HAL_UART_DISABLE_IT(huart, UART_IT_IDLE);
+    CLEAR_BIT(huart->Instance->CR3, USART_CR3_DMAR);
+    dma->rx->CCR = 0;
+    NVIC_DisableIRQ(dma->rx_irq);
+
+    uart_irq_vector(obj_s->uart, &irq_n, &vector);
+    if ((huart->Instance->CR1 & (USART_CR1_RXNEIE | USART_CR1_TXEIE)) == 0) {
+        NVIC_DisableIRQ(irq_n);
+    }
+}
+
+void serial_dma_tx_start(serial_t *obj, const uint8_t *data, size_t length)
+{
+    struct serial_s *obj_s = SERIAL_S(obj);
+    UART_HandleTypeDef *huart = &uart_handlers[obj_s->index];
+    const serial_dma_channels_t *dma = serial_dma_channels(obj_s->uart);
+
+    MBED_ASSERT(length > 0 && length <= 0xFFFF);
+    if (dma == NULL) {
+        return;
+    }
+
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    dma->tx->CCR = 0;
+    DMA1->IFCR = (DMA_IFCR_CGIF1 | DMA_IFCR_CTCIF1 | DMA_IFCR_CHTIF1 | DMA_IFCR_CTEIF1) << dma->tx_shift;
+    dma->tx->CPAR = (uint32_t)&huart->Instance->DR;
+    dma->tx->CMAR = (uint32_t)data;
+    dma->tx->CNDTR = length;
+    NVIC_SetVector(dma->tx_irq, (uint32_t)dma->tx_vector);
+    NVIC_EnableIRQ(dma->tx_irq);
+    SET_BIT(huart->Instance->CR3, USART_CR3_DMAT);
+    dma->tx->CCR = DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_TCIE | DMA_CCR_TEIE | DMA_CCR_EN;
+}
+
+int serial_dma_tx_active(serial_t *obj)
+{
+    struct serial_s *obj_s = SERIAL_S(obj);
+    const serial_dma_channels_t *dma = serial_dma_channels(obj_s->uart);
+
+    // CNDTR reaches 0 before the interrupt disables the channel, so this
+    // also works from a critical section
+    return (dma != NULL) && (dma->tx->CCR & DMA_CCR_EN) && (dma->tx->CNDTR != 0);
+}
+
+#endif /* DEVICE_SERIAL_DMA */
+
 #if DEVICE_SERIAL_ASYNCH
 
 /******************************************************************************
@@ -87,6 +87,85 @@ static inline int gpio_is_connected(const gpio_t *obj)
     return obj->pin != (PinName)NC;
 }
 
+/*
+ * Whole port accesses for the drivers which know their pins at compile time,
+ * see drivers/Gpio.h. With a constant port the register address is folded so
+ * gpio_port_set_reset() is a single store to BSRR and gpio_port_read() a single
+ * load of IDR. The port clock is enabled by gpio_init() of its pins.
+ */
+#define GPIO_PORT_ACCESS 1
+
+static inline GPIO_TypeDef *gpio_port_regs(PortName port)
+{
+    switch (port) {
+        case PortA:
+            return GPIOA;
+        case PortB:
+            return GPIOB;
+#if defined(GPIOC_BASE)
+        case PortC:
+            return GPIOC;
+#endif
+#if defined(GPIOD_BASE)
+        case PortD:
+            return GPIOD;
+#endif
+#if defined(GPIOE_BASE)
+        case PortE:
+            return GPIOE;
+#endif
+#if defined(GPIOF_BASE)
+        case PortF:
+            return GPIOF;
+#endif
+#if defined(GPIOG_BASE)
+        case PortG:
+            return GPIOG;
+#endif
+#if defined(GPIOH_BASE)
+        case PortH:
+            return GPIOH;
+#endif
+#if defined(GPIOI_BASE)
+        case PortI:
+            return GPIOI;
+#endif
+#if defined(GPIOJ_BASE)
+        case PortJ:
+            return GPIOJ;
+#endif
+#if defined(GPIOK_BASE)
+        case PortK:
+            return GPIOK;
+#endif
+        default:
+            MBED_ASSERT(0);
+            return NULL;
+    }
+}
+
+/* Drive the pins of set high and the pins of reset low in one atomic store,
+ * a pin in both masks is set */
+static inline void gpio_port_set_reset(PortName port, uint32_t set, uint32_t reset)
+{
+#if defined(DUAL_CORE) && (TARGET_STM32H7)
+    while (LL_HSEM_1StepLock(HSEM, CFG_HW_GPIO_SEMID)) {
+    }
+#endif /* DUAL_CORE */
+
+    gpio_port_regs(port)->BSRR = (set & 0xFFFF) | (reset << 16);
+
+#if defined(DUAL_CORE) && (TARGET_STM32H7)
+    LL_HSEM_ReleaseLock(HSEM, CFG_HW_GPIO_SEMID, HSEM_CR_COREID_CURRENT);
+#endif /* DUAL_CORE */
+}
+
+/* Levels of all the pins of the port */
+static inline uint32_t gpio_port_read(PortName port)
+{
+    return gpio_port_regs(port)->IDR;
+}
+
 
 #ifdef __cplusplus
 }
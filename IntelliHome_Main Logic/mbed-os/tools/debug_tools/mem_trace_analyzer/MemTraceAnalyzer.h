@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2026 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file MemTraceAnalyzer.h
+ * Host side analysis of the binary mbed_mem_trace records.
+ *
+ * Replays the records written by mbed_mem_trace_binary_drain() to rebuild the
+ * live heap: its size over time, the peak use of each call site and how the
+ * free space between live blocks is fragmented. See mbed_mem_trace.h for the
+ * record format.
+ */
+#ifndef MBED_MEM_TRACE_ANALYZER_H_
+#define MBED_MEM_TRACE_ANALYZER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "platform/mbed_mem_trace.h"
+
+/** One decoded record */
+struct MemTraceRecord {
+    uint8_t op;
+    uint16_t sequence;
+    uint32_t time;
+    uint32_t result;
+    uint32_t ptr;
+    uint32_t size;
+    uint32_t caller;
+};
+
+class MemTraceAnalyzer {
+public:
+    /** Heap use of the blocks allocated by one caller */
+    struct Site {
+        uint32_t caller;
+        uint32_t allocs;
+        uint32_t frees;
+        uint32_t failures;
+        uint64_t bytes;         // sum of the sizes allocated
+        uint32_t live;          // bytes allocated and not freed
+        uint32_t live_blocks;
+        uint32_t peak;          // largest value of live
+    };
+
+    /** Heap use after an operation that changed it */
+    struct Sample {
+        uint64_t time;
+        uint32_t live;
+        uint32_t live_blocks;
+    };
+
+    /** Free space between the live blocks */
+    struct Fragmentation {
+        uint32_t extent;        // from the lowest live block to the end of the highest
+        uint32_t live;
+        uint32_t free;          // bytes in holes
+        uint32_t holes;
+        uint32_t largest;       // largest hole
+        unsigned percent;       // share of the free space outside the largest hole
+    };
+
+    /** Create an analyzer
+     *
+     *  @param slack gaps of up to this many bytes between two blocks are taken
+     *               as allocator headers and padding rather than holes
+     */
+    MemTraceAnalyzer(uint32_t slack = 16) :
+        _slack(slack), _state(TEXT), _trace_left(0), _started(false), _last_sequence(0), _time_high(0), _last_time(0),
+        _records(0), _lost(0), _unmatched(0), _skipped(0),
+        _live(0), _peak(0), _peak_time(0), _peak_record(0)
+    {
+    }
+
+    /** Decode the next bytes of the stream
+     *
+     *  Bytes outside records, for example text or deferred mbed-trace records
+     *  on the same port, are skipped.
+     */
+    void feed(const uint8_t *data, size_t len)
+    {
+        for (size_t i = 0; i < len; i++) {
+            feed(data[i]);
+        }
+    }
+
+    /** Apply one record to the heap */
+    void record(const MemTraceRecord &rec)
+    {
+        if (_started) {
+            _lost += (uint16_t)(rec.sequence - _last_sequence - 1);
+            if (rec.time < _last_time) {
+                _time_high += (uint64_t) 1 << 32;
+            }
+        }
+        _started = true;
+        _last_sequence = rec.sequence;
+        _last_time = rec.time;
+        _records++;
+        uint64_t now = _time_high + rec.time;
+
+        switch (rec.op) {
+            case MBED_MEM_TRACE_MALLOC:
+            case MBED_MEM_TRACE_CALLOC:
+                if (rec.result) {
+                    allocated(rec.result, rec.size, rec.caller);
+                } else if (rec.size) {
+                    _sites[rec.caller].failures++;
+                }
+                break;
+
+            case MBED_MEM_TRACE_REALLOC:
+                if (rec.result) {
+                    if (rec.ptr) {
+                        freed(rec.ptr);
+                    }
+                    allocated(rec.result, rec.size, rec.caller);
+                } else if (rec.size == 0) {
+                    // realloc(ptr, 0) frees the block
+                    freed(rec.ptr);
+                } else {
+                    _sites[rec.caller].failures++;
+                }
+                break;
+
+            case MBED_MEM_TRACE_FREE:
+                if (rec.ptr) {
+                    freed(rec.ptr);
+                }
+                break;
+        }
+
+        if (_timeline.empty() || _timeline.back().live != _live ||
+                _timeline.back().live_blocks != _blocks.size()) {
+            _timeline.push_back({now, _live, (uint32_t) _blocks.size()});
+        }
+        if (_live > _peak) {
+            _peak = _live;
+            _peak_time = now;
+            _peak_record = _records;
+        }
+    }
+
+    /** Call sites, the largest peak first */
+    std::vector<Site> sites() const
+    {
+        std::vector<Site> sites;
+        for (const auto &site : _sites) {
+            sites.push_back(site.second);
+            sites.back().caller = site.first;
+        }
+        std::stable_sort(sites.begin(), sites.end(), [](const Site &a, const Site &b) {
+            return a.peak > b.peak;
+        });
+        return sites;
+    }
+
+    /** Fragmentation of the live heap now */
+    Fragmentation fragmentation() const
+    {
+        Fragmentation frag = {0, _live, 0, 0, 0, 0};
+        if (_blocks.empty()) {
+            return frag;
+        }
+        uint32_t end = _blocks.begin()->first;
+        for (const auto &block : _blocks) {
+            if (block.first > end && block.first - end > _slack) {
+                uint32_t hole = block.first - end;
+                frag.free += hole;
+                frag.holes++;
+                frag.largest = std::max(frag.largest, hole);
+            }
+            end = std::max(end, block.first + block.second.size);
+        }
+        frag.extent = end - _blocks.begin()->first;
+        if (frag.free) {
+            frag.percent = (unsigned)((uint64_t)(frag.free - frag.largest) * 100 / frag.free);
+        }
+        return frag;
+    }
+
+    /** Heap use after each record that changed it */
+    const std::vector<Sample> &timeline() const
+    {
+        return _timeline;
+    }
+
+    /** Records applied */
+    uint32_t records() const
+    {
+        return _records;
+    }
+
+    /** Records missing from the sequence, dropped on the device or lost on the way */
+    uint32_t lost() const
+    {
+        return _lost;
+    }
+
+    /** Frees and reallocs of blocks allocated before the trace started, or by lost records */
+    uint32_t unmatched() const
+    {
+        return _unmatched;
+    }
+
+    /** Bytes found outside records */
+    uint32_t skipped() const
+    {
+        return _skipped;
+    }
+
+    /** Bytes allocated and not freed */
+    uint32_t live() const
+    {
+        return _live;
+    }
+
+    /** Number of blocks allocated and not freed */
+    uint32_t live_blocks() const
+    {
+        return (uint32_t) _blocks.size();
+    }
+
+    /** Largest live(), when it was reached and after how many records */
+    uint32_t peak() const
+    {
+        return _peak;
+    }
+
+    uint64_t peak_time() const
+    {
+        return _peak_time;
+    }
+
+    uint32_t peak_record() const
+    {
+        return _peak_record;
+    }
+
+private:
+    struct Block {
+        uint32_t size;
+        uint32_t caller;
+    };
+
+    enum State { TEXT, RECORD, TRACE_LENGTH, TRACE_PAYLOAD, TRACE_DROPPED };
+
+    // Deferred mbed-trace records may share the port, their payload could
+    // pass for a heap record. See mbed-trace/mbed_trace_deferred.h
+    static const uint8_t TRACE_SYNC = 0x1E;
+    static const uint8_t TRACE_DROPPED_MARKER = 0x1D;
+
+    void feed(uint8_t byte)
+    {
+        switch (_state) {
+            case TEXT:
+                if (byte == MBED_MEM_TRACE_BINARY_SYNC) {
+                    _pending.assign(1, byte);
+                    _state = RECORD;
+                    return;
+                }
+                if (byte == TRACE_SYNC) {
+                    _state = TRACE_LENGTH;
+                } else if (byte == TRACE_DROPPED_MARKER) {
+                    _state = TRACE_DROPPED;
+                }
+                break;
+            case RECORD:
+                _pending.push_back(byte);
+                if (_pending.size() == MBED_MEM_TRACE_BINARY_RECORD_SIZE) {
+                    _state = TEXT;
+                    decode();
+                }
+                return;
+            case TRACE_LENGTH:
+                _trace_left = byte;
+                _state = _trace_left ? TRACE_PAYLOAD : TEXT;
+                break;
+            case TRACE_PAYLOAD:
+                if (--_trace_left == 0) {
+                    _state = TEXT;
+                }
+                break;
+            case TRACE_DROPPED:
+                if ((byte & 0x80) == 0) {
+                    _state = TEXT;
+                }
+                break;
+        }
+        _skipped++;
+    }
+
+    void decode()
+    {
+        if (_pending[1] <= MBED_MEM_TRACE_FREE) {
+            MemTraceRecord rec;
+            rec.op = _pending[1];
+            rec.sequence = (uint16_t)(_pending[2] | _pending[3] << 8);
+            rec.time = u32(4);
+            rec.result = u32(8);
+            rec.ptr = u32(12);
+            rec.size = u32(16);
+            rec.caller = u32(20);
+            record(rec);
+            return;
+        }
+        // Not a record after all, look for the next sync byte in what was taken
+        std::vector<uint8_t> rest(_pending.begin() + 1, _pending.end());
+        _skipped++;
+        for (uint8_t b : rest) {
+            feed(b);
+        }
+    }
+
+    uint32_t u32(size_t offset) const
+    {
+        return (uint32_t) _pending[offset] | (uint32_t) _pending[offset + 1] << 8 |
+               (uint32_t) _pending[offset + 2] << 16 | (uint32_t) _pending[offset + 3] << 24;
+    }
+
+    void allocated(uint32_t ptr, uint32_t size, uint32_t caller)
+    {
+        // Still there when its free was lost
+        if (_blocks.count(ptr)) {
+            freed(ptr);
+        }
+        _blocks[ptr] = {size, caller};
+        _live += size;
+
+        Site &site = _sites[caller];
+        site.allocs++;
+        site.bytes += size;
+        site.live += size;
+        site.live_blocks++;
+        site.peak = std::max(site.peak, site.live);
+    }
+
+    void freed(uint32_t ptr)
+    {
+        auto block = _blocks.find(ptr);
+        if (block == _blocks.end()) {
+            _unmatched++;
+            return;
+        }
+        Site &site = _sites[block->second.caller];
+        site.frees++;
+        site.live -= block->second.size;
+        site.live_blocks--;
+        _live -= block->second.size;
+        _blocks.erase(block);
+    }
+
+    uint32_t _slack;
+    State _state;
+    uint8_t _trace_left;
+    std::vector<uint8_t> _pending;
+    bool _started;
+    uint16_t _last_sequence;
+    uint64_t _time_high;
+    uint32_t _last_time;
+
+    uint32_t _records;
+    uint32_t _lost;
+    uint32_t _unmatched;
+    uint32_t _skipped;
+
+    std::map<uint32_t, Block> _blocks;
+    std::map<uint32_t, Site> _sites;
+    std::vector<Sample> _timeline;
+    uint32_t _live;
+    uint32_t _peak;
+    uint64_t _peak_time;
+    uint32_t _peak_record;
+};
+
+#endif /* MBED_MEM_TRACE_ANALYZER_H_ */
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// Analyze binary mbed_mem_trace records.
+//
+//   mem_trace_analyzer [-t] [-s slack] [capture.bin]
+//
+// Reads the records from the capture file, or from stdin, and prints the heap
+// use of each call site and the fragmentation of the heap at its peak and at
+// the end. -t prints the live heap after each change instead, as CSV.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "MemTraceAnalyzer.h"
+
+static void print_fragmentation(const char *name, const MemTraceAnalyzer::Fragmentation &frag)
+{
+    printf("%-8s %10lu %10lu %10lu %6lu %10lu %4u%%\n", name,
+           (unsigned long) frag.extent, (unsigned long) frag.live, (unsigned long) frag.free,
+           (unsigned long) frag.holes, (unsigned long) frag.largest, frag.percent);
+}
+
+int main(int argc, char **argv)
+{
+    bool timeline = false;
+    uint32_t slack = 16;
+    int arg = 1;
+    while (arg < argc && argv[arg][0] == '-' && argv[arg][1]) {
+        if (strcmp(argv[arg], "-t") == 0) {
+            timeline = true;
+            arg++;
+        } else if (strcmp(argv[arg], "-s") == 0 && arg + 1 < argc) {
+            slack = strtoul(argv[arg + 1], NULL, 0);
+            arg += 2;
+        } else {
+            break;
+        }
+    }
+    if (argc - arg > 1 || (arg < argc && argv[arg][0] == '-')) {
+        fprintf(stderr, "usage: %s [-t] [-s slack] [capture.bin]\n", argv[0]);
+        return 2;
+    }
+
+    FILE *in = stdin;
+    if (arg < argc) {
+        in = fopen(argv[arg], "rb");
+        if (!in) {
+            perror(argv[arg]);
+            return 1;
+        }
+    }
+    std::vector<uint8_t> capture;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0) {
+        capture.insert(capture.end(), buf, buf + n);
+    }
+    if (in != stdin) {
+        fclose(in);
+    }
+
+    MemTraceAnalyzer heap(slack);
+    heap.feed(capture.data(), capture.size());
+
+    if (timeline) {
+        printf("time,live,blocks\n");
+        for (const auto &sample : heap.timeline()) {
+            printf("%llu,%lu,%lu\n", (unsigned long long) sample.time,
+                   (unsigned long) sample.live, (unsigned long) sample.live_blocks);
+        }
+        return 0;
+    }
+
+    printf("records %lu, lost %lu, unmatched frees %lu, skipped bytes %lu\n",
+           (unsigned long) heap.records(), (unsigned long) heap.lost(),
+           (unsigned long) heap.unmatched(), (unsigned long) heap.skipped());
+    if (heap.lost()) {
+        printf("records were lost, the figures below are approximate\n");
+    }
+    printf("live %lu bytes in %lu blocks, peak %lu bytes at time %llu (record %lu)\n\n",
+           (unsigned long) heap.live(), (unsigned long) heap.live_blocks(),
+           (unsigned long) heap.peak(), (unsigned long long) heap.peak_time(),
+           (unsigned long) heap.peak_record());
+
+    printf("%-10s %8s %8s %8s %10s %8s %8s\n", "caller", "allocs", "frees", "failures", "bytes", "live", "peak");
+    for (const auto &site : heap.sites()) {
+        printf("0x%08lx %8lu %8lu %8lu %10llu %8lu %8lu\n", (unsigned long) site.caller,
+               (unsigned long) site.allocs, (unsigned long) site.frees, (unsigned long) site.failures,
+               (unsigned long long) site.bytes, (unsigned long) site.live, (unsigned long) site.peak);
+    }
+
+    // Replay up to the peak for the fragmentation at that point
+    MemTraceAnalyzer at_peak(slack);
+    for (size_t i = 0; i < capture.size() && at_peak.records() < heap.peak_record(); i++) {
+        at_peak.feed(&capture[i], 1);
+    }
+
+    printf("\n%-8s %10s %10s %10s %6s %10s %5s\n", "heap", "extent", "live", "free", "holes", "largest", "frag");
+    print_fragmentation("at peak", at_peak.fragmentation());
+    print_fragmentation("at end", heap.fragmentation());
+    return 0;
+}
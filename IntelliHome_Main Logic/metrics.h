@@ -0,0 +1,71 @@
+/*  file : metrics.h
+ *	On-device metrics registry: counters, gauges and fixed-bucket histograms.
+ *	Each field is updated atomically, so updates are safe from tasks and ISRs.
+ *	A histogram update touches a bucket, the count and the max separately, so
+ *	a snapshot taken meanwhile may be torn: the count can differ from the sum
+ *	of the buckets by the updates in flight.
+ *	See metrics_utilities.cpp for the binary dump format.
+ */
+#ifndef METRICS_H
+#define METRICS_H
+#include <stddef.h>
+#include <stdint.h>
+
+enum metric_counter {
+    COUNTER_LOOPS,          // Main loop iterations
+    COUNTER_ECHO_EDGES,     // Ultrasonic echo interrupts
+    COUNTER_BT_BYTES,       // Bytes read from the Bluetooth UART
+    COUNTER_BT_OVERRUNS,    // Bluetooth bytes overwritten in the DMA ring
+    COUNTER_VOICE_BYTES,    // Bytes read from the voice module UART
+    COUNTER_VOICE_OVERRUNS, // Voice module bytes lost to UART or ring overruns
+    COUNTER_DHT_OK,         // Successful DHT11 reads
+    COUNTER_DHT_TIMEOUTS,   // DHT11 reads that timed out
+    COUNTER_DHT_CHECKSUMS,  // DHT11 reads with a checksum mismatch
+    COUNTER_LOG_APPENDS,    // Records written to the sensor log
+    COUNTER_LOG_ERRORS,     // Failed sensor log writes
+    COUNTER_COUNT
+};
+
+enum metric_gauge {
+    GAUGE_DISTANCE_MM,      // Last ultrasonic distance
+    GAUGE_HEAP_CURRENT,     // mbed_stats_heap_get, filled in on dump
+    GAUGE_HEAP_MAX,
+    GAUGE_HEAP_FAILS,
+    GAUGE_STACK_MAX,        // mbed_stats_stack_get, filled in on dump
+    GAUGE_STACK_SIZE,
+    GAUGE_UPTIME_MS,        // mbed_stats_cpu_get, filled in on dump
+    GAUGE_SLEEP_MS,
+    GAUGE_ECHO_OVERRUNS,    // Echo edges dropped by the capture ring
+    GAUGE_POOL_PEAK,        // mbed_stats_pool_get_each, peak blocks summed over pools
+    GAUGE_POOL_FAILS,       // Requests that found a pool size class full
+    GAUGE_COUNT
+};
+
+enum metric_histogram {
+    HISTOGRAM_LOOP_US,      // Main loop pass time, from wake up to sleep
+    HISTOGRAM_DHT_US,       // Blocking part of a DHT11 read
+    HISTOGRAM_COUNT
+};
+
+// Bucket i of a histogram counts values whose bit length after the
+// histogram's shift is i, the last bucket also takes everything larger.
+#define METRIC_BUCKETS 12
+
+// Length of the snapshot written by metrics_dump: a 5 byte header, a word per
+// counter and gauge, and count, max and the buckets of each histogram
+constexpr size_t METRICS_DUMP_SIZE = 5 + 4 * (COUNTER_COUNT + GAUGE_COUNT) +
+                                     4 * HISTOGRAM_COUNT * (2 + METRIC_BUCKETS);
+
+/* add to a counter */
+extern void metrics_count(int counter, uint32_t n = 1);
+
+/* set a gauge */
+extern void metrics_gauge(int gauge, uint32_t value);
+
+/* record one value into a histogram */
+extern void metrics_observe(int histogram, uint32_t value);
+
+/* refresh the mbed_stats gauges and write a binary snapshot, returns its length */
+extern size_t metrics_dump(uint8_t *buffer, size_t size);
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * File:   metrics utilities.cpp
+ * Lock-free metrics registry, dumped in binary over Bluetooth
+ */
+#undef __ARM_FP
+
+#include "mbed.h"
+#include "metrics.h"
+
+// Histogram resolution: values are shifted right before bucketing
+static const uint8_t histogramShift[HISTOGRAM_COUNT] = {
+    6,  // HISTOGRAM_LOOP_US: 64 us .. 65 ms
+    8,  // HISTOGRAM_DHT_US: 256 us .. 262 ms
+};
+
+struct metric_histogram_data {
+    uint32_t count;
+    uint32_t max;
+    uint32_t buckets[METRIC_BUCKETS];
+};
+
+// The header stores each count in a byte, frames carry a 16 bit length
+static_assert(COUNTER_COUNT <= 0xFF && GAUGE_COUNT <= 0xFF && HISTOGRAM_COUNT <= 0xFF &&
+              METRIC_BUCKETS <= 0xFF, "metric counts must fit the dump header");
+static_assert(METRICS_DUMP_SIZE <= 0xFFFF, "metrics dump must fit a frame");
+
+static uint32_t counters[COUNTER_COUNT];
+static uint32_t gauges[GAUGE_COUNT];
+static metric_histogram_data histograms[HISTOGRAM_COUNT];
+
+void metrics_count(int counter, uint32_t n)
+{
+    core_util_atomic_incr_u32(&counters[counter], n);
+}
+
+void metrics_gauge(int gauge, uint32_t value)
+{
+    core_util_atomic_store_u32(&gauges[gauge], value);
+}
+
+void metrics_observe(int histogram, uint32_t value)
+{
+    metric_histogram_data *h = &histograms[histogram];
+
+    uint32_t scaled = value >> histogramShift[histogram];
+    int bucket = 0;
+    while (scaled != 0 && bucket < METRIC_BUCKETS - 1) {
+        scaled >>= 1;
+        bucket++;
+    }
+    core_util_atomic_incr_u32(&h->buckets[bucket], 1);
+    core_util_atomic_incr_u32(&h->count, 1);
+
+    uint32_t max = core_util_atomic_load_u32(&h->max);
+    while (value > max && !core_util_atomic_compare_exchange_weak_u32(&h->max, &max, value)) {
+    }
+}
+
+//---- Little endian helper for the dump ----------------------------------------
+static uint8_t *put_u32(uint8_t *p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+    return p + 4;
+}
+
+/* Snapshot layout, all words little endian:
+ *   version (1 byte), counter count, gauge count, histogram count, bucket count
+ *   counters     one word each
+ *   gauges       one word each
+ *   histograms   count, max, then one word per bucket
+ * Counters and histograms are not reset by a dump.
+ */
+size_t metrics_dump(uint8_t *buffer, size_t size)
+{
+    if (size < METRICS_DUMP_SIZE) return 0;
+
+    mbed_stats_heap_t heap;
+    mbed_stats_heap_get(&heap);
+    metrics_gauge(GAUGE_HEAP_CURRENT, heap.current_size);
+    metrics_gauge(GAUGE_HEAP_MAX, heap.max_size);
+    metrics_gauge(GAUGE_HEAP_FAILS, heap.alloc_fail_cnt);
+
+    mbed_stats_pool_t pools[4];
+    size_t poolCount = mbed_stats_pool_get_each(pools, 4);
+    uint32_t poolPeak = 0, poolFails = 0;
+    for (size_t i = 0; i < poolCount; i++) {
+        poolPeak += pools[i].max_cnt;
+        poolFails += pools[i].alloc_fail_cnt;
+    }
+    metrics_gauge(GAUGE_POOL_PEAK, poolPeak);
+    metrics_gauge(GAUGE_POOL_FAILS, poolFails);
+
+    mbed_stats_stack_t stack;
+    mbed_stats_stack_get(&stack);
+    metrics_gauge(GAUGE_STACK_MAX, stack.max_size);
+    metrics_gauge(GAUGE_STACK_SIZE, stack.reserved_size);
+
+    mbed_stats_cpu_t cpu;
+    mbed_stats_cpu_get(&cpu);
+    metrics_gauge(GAUGE_UPTIME_MS, (uint32_t)(cpu.uptime / 1000));
+    metrics_gauge(GAUGE_SLEEP_MS, (uint32_t)(cpu.sleep_time / 1000));
+
+    uint8_t *p = buffer;
+    *p++ = 1;
+    *p++ = COUNTER_COUNT;
+    *p++ = GAUGE_COUNT;
+    *p++ = HISTOGRAM_COUNT;
+    *p++ = METRIC_BUCKETS;
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        p = put_u32(p, core_util_atomic_load_u32(&counters[i]));
+    }
+    for (int i = 0; i < GAUGE_COUNT; i++) {
+        p = put_u32(p, core_util_atomic_load_u32(&gauges[i]));
+    }
+    for (int i = 0; i < HISTOGRAM_COUNT; i++) {
+        p = put_u32(p, core_util_atomic_load_u32(&histograms[i].count));
+        p = put_u32(p, core_util_atomic_load_u32(&histograms[i].max));
+        for (int b = 0; b < METRIC_BUCKETS; b++) {
+            p = put_u32(p, core_util_atomic_load_u32(&histograms[i].buckets[b]));
+        }
+    }
+    return p - buffer;
+}
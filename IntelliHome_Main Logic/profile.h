@@ -0,0 +1,83 @@
+/*  file : profile.h
+ *	Cycle-accurate profiling of the main loop stages.
+ *	On Cortex-M the DWT cycle counter is used, on the host std::chrono
+ *	nanoseconds stand in for cycles. With the app.profile-enabled config
+ *	option set to false every call below compiles to nothing.
+ *	Only use it from the main loop, the statistics are not ISR safe.
+ */
+#ifndef PROFILE_H
+#define PROFILE_H
+#include <stddef.h>
+#include <stdint.h>
+
+enum profile_site {
+    PROFILE_LOOP,           // Whole main loop pass, from wake up to sleep
+    PROFILE_RANGING,        // Ultrasonic trigger pulse
+    PROFILE_INTRUDER,       // Intruder detection rules
+    PROFILE_UART,           // Bluetooth and voice command parsing
+    PROFILE_DHT,            // DHT11 acquisition
+    PROFILE_RULES,          // Rain, light and temperature rules
+    PROFILE_LCD,            // LCD refresh
+    PROFILE_SITE_COUNT
+};
+
+// Bucket i of a site counts samples whose bit length after PROFILE_SHIFT is
+// i, the last bucket also takes everything larger. With a 72 MHz clock this
+// spans 256 cycles (3.5 us) to 8.4 M cycles (116 ms).
+#define PROFILE_BUCKETS 16
+#define PROFILE_SHIFT 8
+
+// Length of one site snapshot written by profile_dump
+#define PROFILE_DUMP_SIZE (8 + 4 * (5 + PROFILE_BUCKETS))
+
+#if MBED_CONF_APP_PROFILE_ENABLED
+
+/* enable the cycle counter - call before anything else */
+extern void profile_init(void);
+
+/* current cycle count, wraps around */
+extern uint32_t profile_cycles(void);
+
+/* record the cycles spent in one pass through a site */
+extern void profile_record(int site, uint32_t cycles);
+
+/* write a binary snapshot of one site, returns its length */
+extern size_t profile_dump(int site, uint8_t *buffer, size_t size);
+
+/* print every site in cycles and microseconds to the console; the console
+ * also carries the binary deferred trace and heap trace records, so drain
+ * those rings first or the text lands inside a partly written record */
+extern void profile_print(void);
+
+/* clear all statistics */
+extern void profile_reset(void);
+
+// Measures the enclosing block from here to its closing brace
+class ProfileScope
+{
+public:
+ProfileScope(int site) : _site(site), _start(profile_cycles()) {}
+~ProfileScope() { profile_record(_site, profile_cycles() - _start); }
+private:
+int _site;
+uint32_t _start;
+};
+
+#define PROFILE_JOIN2(a, b) a##b
+#define PROFILE_JOIN(a, b) PROFILE_JOIN2(a, b)
+#define PROFILE_SCOPE(site) ProfileScope PROFILE_JOIN(profileScope, __LINE__)(site)
+
+#else
+
+inline void profile_init(void) {}
+inline uint32_t profile_cycles(void) { return 0; }
+inline void profile_record(int, uint32_t) {}
+inline size_t profile_dump(int, uint8_t *, size_t) { return 0; }
+inline void profile_print(void) {}
+inline void profile_reset(void) {}
+
+#define PROFILE_SCOPE(site)
+
+#endif
+
+#endif
@@ -0,0 +1,135 @@
+/*
+ * File:   profile utilities.cpp
+ * Per-stage cycle statistics of the main loop
+ */
+#undef __ARM_FP
+
+#include "mbed.h"
+#include "profile.h"
+#include <string.h>
+
+#if MBED_CONF_APP_PROFILE_ENABLED
+
+#if defined(DWT) && !defined(UNITTEST)
+#define PROFILE_CLOCK_HZ SystemCoreClock
+#else
+#include <chrono>
+#define PROFILE_CLOCK_HZ 1000000000UL
+#endif
+
+struct profile_site_data {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t buckets[PROFILE_BUCKETS];
+};
+
+static profile_site_data sites[PROFILE_SITE_COUNT];
+
+static const char *const siteNames[PROFILE_SITE_COUNT] = {
+    "loop", "ranging", "intruder", "uart", "dht11", "rules", "lcd"
+};
+
+void profile_init(void)
+{
+#if defined(DWT) && !defined(UNITTEST)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    profile_reset();
+}
+
+uint32_t profile_cycles(void)
+{
+#if defined(DWT) && !defined(UNITTEST)
+    return DWT->CYCCNT;
+#else
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void profile_record(int site, uint32_t cycles)
+{
+    profile_site_data *s = &sites[site];
+
+    uint32_t scaled = cycles >> PROFILE_SHIFT;
+    int bucket = 0;
+    while (scaled != 0 && bucket < PROFILE_BUCKETS - 1) {
+        scaled >>= 1;
+        bucket++;
+    }
+    s->buckets[bucket]++;
+    s->count++;
+    s->total += cycles;
+    if (cycles < s->min) s->min = cycles;
+    if (cycles > s->max) s->max = cycles;
+}
+
+void profile_reset(void)
+{
+    memset(sites, 0, sizeof(sites));
+    for (int i = 0; i < PROFILE_SITE_COUNT; i++) {
+        sites[i].min = UINT32_MAX;
+    }
+}
+
+//---- Little endian helper for the dump ----------------------------------------
+static uint8_t *put_u32(uint8_t *p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+    return p + 4;
+}
+
+/* Snapshot layout of one site, all words little endian:
+ *   version (1 byte), site, bucket count, shift
+ *   clock in Hz  one word, cycles per second of the counter
+ *   count, min, max, total (low and high word), then one word per bucket
+ * A site without samples reports min 0xFFFFFFFF.
+ */
+size_t profile_dump(int site, uint8_t *buffer, size_t size)
+{
+    if (site < 0 || site >= PROFILE_SITE_COUNT || size < PROFILE_DUMP_SIZE) return 0;
+    const profile_site_data *s = &sites[site];
+
+    uint8_t *p = buffer;
+    *p++ = 1;
+    *p++ = (uint8_t)site;
+    *p++ = PROFILE_BUCKETS;
+    *p++ = PROFILE_SHIFT;
+    p = put_u32(p, PROFILE_CLOCK_HZ);
+    p = put_u32(p, s->count);
+    p = put_u32(p, s->min);
+    p = put_u32(p, s->max);
+    p = put_u32(p, (uint32_t)s->total);
+    p = put_u32(p, (uint32_t)(s->total >> 32));
+    for (int b = 0; b < PROFILE_BUCKETS; b++) {
+        p = put_u32(p, s->buckets[b]);
+    }
+    return p - buffer;
+}
+
+// Plain printf to the console: only call with the binary trace rings drained
+void profile_print(void)
+{
+    uint32_t mhz = PROFILE_CLOCK_HZ / 1000000;
+
+    printf("site      count      min      avg      max  (cycles, max us)\n");
+    for (int i = 0; i < PROFILE_SITE_COUNT; i++) {
+        const profile_site_data *s = &sites[i];
+        if (s->count == 0) continue;
+        // Minimal printf does not pad strings, so the name is padded here
+        printf("%s%.*s %6lu %8lu %8lu %8lu  %lu\n", siteNames[i],
+               (int)(8 - strnlen(siteNames[i], 8)), "        ",
+               (unsigned long)s->count, (unsigned long)s->min,
+               (unsigned long)(s->total / s->count), (unsigned long)s->max,
+               (unsigned long)(s->max / mhz));
+    }
+}
+
+#endif
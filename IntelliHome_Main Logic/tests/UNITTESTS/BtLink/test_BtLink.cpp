@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "BtLink.h"
+#include "mbed_poll_stub.h"
+#include <deque>
+#include <string>
+#include <vector>
+
+using namespace mbed;
+
+static const int rates[BT_LINK_RATE_COUNT] = BT_LINK_RATES;
+
+/* HC-05 on the other end of the UART, speaking its AT dialect
+ *
+ * It answers AT commands only while its KEY pin is high and the UART runs at
+ * its rate, anything else is lost or goes to the paired phone. AT+RESET
+ * completes when KEY next changes or the next byte arrives: the module then
+ * comes back at the rate set by AT+UART, or in full command mode at 38400 if
+ * KEY is still high, as the real module does when KEY is held at power up.
+ */
+class FakeHc05 : public FileHandle {
+public:
+    FakeHc05(int baud) : baud(baud) {}
+
+    ssize_t read(void *buffer, size_t size) override
+    {
+        if (rx.empty()) {
+            return -EAGAIN;
+        }
+        size_t n = 0;
+        for (; n < size && !rx.empty(); n++) {
+            static_cast<uint8_t *>(buffer)[n] = rx.front();
+            rx.pop_front();
+        }
+        return n;
+    }
+
+    ssize_t write(const void *buffer, size_t size) override
+    {
+        reboot();
+        const char *data = static_cast<const char *>(buffer);
+        for (size_t i = 0; i < size; i++) {
+            if (!present || !key || uartBaud != baud) {
+                continue;
+            }
+            line += data[i];
+            if (line.size() >= 2 && line.compare(line.size() - 2, 2, "\r\n") == 0) {
+                command(line.substr(0, line.size() - 2));
+                line.clear();
+            }
+        }
+        return size;
+    }
+
+    off_t seek(off_t offset, int whence) override
+    {
+        return -ESPIPE;
+    }
+
+    int close() override
+    {
+        return 0;
+    }
+
+    short poll(short events) const override
+    {
+        return (rx.empty() ? 0 : POLLIN) | POLLOUT;
+    }
+
+    void set_baud(int rate)
+    {
+        uartBaud = rate;
+        bauds.push_back(rate);
+        // Whatever was on the line at the old rate is garbage now
+        line.clear();
+    }
+
+    void set_key(int level)
+    {
+        key = level != 0;
+        keyChanges++;
+        reboot();
+    }
+
+    int baud;                   // Rate of the module's UART
+    int storedBaud = 0;         // Rate set by AT+UART, applied on reset
+    bool present = true;        // Powered and wired
+    bool key = true;            // KEY level, high for command mode
+    bool rejectUart = false;    // Answers ERROR to AT+UART
+    bool keepsRate = false;     // Acks AT+UART but keeps its rate
+    int bootCommandsLost = 0;   // Commands missed after a reset while it boots
+
+    int uartBaud = 0;
+    std::vector<int> bauds;     // Every rate the MCU set
+    std::vector<std::string> commands;
+    int keyChanges = 0;
+
+private:
+    void command(const std::string &cmd)
+    {
+        if (deaf > 0) {
+            deaf--;
+            return;
+        }
+        commands.push_back(cmd);
+        int rate, stop, parity;
+        if (cmd == "AT") {
+            answer("OK");
+        } else if (sscanf(cmd.c_str(), "AT+UART=%d,%d,%d", &rate, &stop, &parity) == 3) {
+            if (rejectUart) {
+                answer("ERROR:(1D)");
+            } else {
+                storedBaud = rate;
+                answer("OK");
+            }
+        } else if (cmd == "AT+RESET") {
+            answer("OK");
+            resetting = true;
+        } else {
+            answer("ERROR:(0)");
+        }
+    }
+
+    void answer(const char *text)
+    {
+        for (const char *c = text; *c; c++) {
+            rx.push_back(*c);
+        }
+        rx.push_back('\r');
+        rx.push_back('\n');
+    }
+
+    void reboot()
+    {
+        if (!resetting) {
+            return;
+        }
+        resetting = false;
+        deaf = bootCommandsLost;
+        rx.clear();
+        if (key) {
+            baud = 38400;
+        } else if (storedBaud != 0 && !keepsRate) {
+            baud = storedBaud;
+        }
+    }
+
+    std::deque<uint8_t> rx;
+    std::string line;
+    bool resetting = false;
+    int deaf = 0;
+};
+
+class TestBtLink : public testing::Test {
+protected:
+    void SetUp()
+    {
+        // Everything is ready at once, an empty fake reads as a timeout
+        mbed_poll_stub::revents_value = POLLIN | POLLOUT;
+        mbed_poll_stub::int_value = 1;
+    }
+
+    void TearDown()
+    {
+        mbed_poll_stub::revents_value = POLLOUT;
+        mbed_poll_stub::int_value = 0;
+    }
+
+    int setup(FakeHc05 &module, int storedBaud, int wantedBaud, bool keyWired = true)
+    {
+        BtLink link(&module, callback(&module, &FakeHc05::set_baud),
+                    keyWired ? callback(&module, &FakeHc05::set_key) : Callback<void(int)>());
+        int baud = link.setup(storedBaud, wantedBaud);
+        found = link.found();
+        changed = link.changed();
+        return baud;
+    }
+
+    bool found = false;
+    bool changed = false;
+};
+
+TEST_F(TestBtLink, factory_default_moved_to_wanted_rate)
+{
+    FakeHc05 module(9600);
+    module.key = false;
+
+    EXPECT_EQ(115200, setup(module, 0, 115200));
+    EXPECT_TRUE(found);
+    EXPECT_TRUE(changed);
+    EXPECT_EQ(115200, module.baud);
+    EXPECT_EQ(115200, module.uartBaud);
+    EXPECT_FALSE(module.key);
+    ASSERT_EQ(4u, module.commands.size());
+    EXPECT_EQ("AT", module.commands[0]);
+    EXPECT_EQ("AT+UART=115200,0,0", module.commands[1]);
+    EXPECT_EQ("AT+RESET", module.commands[2]);
+    // Checked again at the new rate
+    EXPECT_EQ("AT", module.commands[3]);
+}
+
+TEST_F(TestBtLink, already_at_wanted_rate)
+{
+    FakeHc05 module(115200);
+    module.key = false;
+
+    EXPECT_EQ(115200, setup(module, 115200, 115200));
+    EXPECT_TRUE(found);
+    EXPECT_FALSE(changed);
+    ASSERT_EQ(1u, module.commands.size());
+    EXPECT_EQ("AT", module.commands[0]);
+    EXPECT_EQ(std::vector<int>({ 115200 }), module.bauds);
+    EXPECT_FALSE(module.key);
+}
+
+TEST_F(TestBtLink, detects_every_rate)
+{
+    for (int i = 0; i < BT_LINK_RATE_COUNT; i++) {
+        FakeHc05 module(rates[i]);
+        module.key = false;
+
+        EXPECT_EQ(rates[i], setup(module, 0, rates[i])) << rates[i];
+        EXPECT_TRUE(found) << rates[i];
+        EXPECT_FALSE(changed) << rates[i];
+        // The default first, then the list in order up to the module's rate
+        EXPECT_EQ(9600, module.bauds.front()) << rates[i];
+        EXPECT_EQ((size_t)(i + 1), module.bauds.size()) << rates[i];
+    }
+}
+
+TEST_F(TestBtLink, stored_rate_tried_first)
+{
+    FakeHc05 module(460800);
+    module.key = false;
+
+    EXPECT_EQ(460800, setup(module, 460800, 460800));
+    EXPECT_EQ(std::vector<int>({ 460800 }), module.bauds);
+
+    // A stale stored rate falls back to the list
+    FakeHc05 moved(57600);
+    moved.key = false;
+    EXPECT_EQ(57600, setup(moved, 230400, 57600));
+    EXPECT_TRUE(found);
+    EXPECT_EQ(230400, moved.bauds.front());
+    EXPECT_EQ(std::vector<int>({ 230400, 9600, 38400, 57600 }), moved.bauds);
+}
+
+TEST_F(TestBtLink, rate_refused)
+{
+    FakeHc05 module(38400);
+    module.key = false;
+    module.rejectUart = true;
+
+    EXPECT_EQ(38400, setup(module, 0, 115200));
+    EXPECT_TRUE(found);
+    EXPECT_FALSE(changed);
+    EXPECT_EQ(38400, module.uartBaud);
+}
+
+TEST_F(TestBtLink, rate_not_taken_found_again)
+{
+    FakeHc05 module(57600);
+    module.key = false;
+    module.keepsRate = true;
+
+    EXPECT_EQ(57600, setup(module, 57600, 230400));
+    EXPECT_TRUE(found);
+    EXPECT_FALSE(changed);
+    EXPECT_EQ(57600, module.uartBaud);
+    // After the failed check at 230400 the rates were probed again
+    EXPECT_EQ(230400, module.bauds[1]);
+    EXPECT_EQ(57600, module.bauds.back());
+}
+
+TEST_F(TestBtLink, slow_reboot_found_by_probing)
+{
+    // Misses the check right after the reset, then answers at the new rate
+    FakeHc05 module(9600);
+    module.key = false;
+    module.bootCommandsLost = 1;
+
+    EXPECT_EQ(460800, setup(module, 0, 460800));
+    EXPECT_TRUE(found);
+    EXPECT_TRUE(changed);
+    EXPECT_EQ(460800, module.baud);
+    EXPECT_EQ(460800, module.uartBaud);
+    EXPECT_EQ(std::vector<int>({ 9600, 460800, 460800 }), module.bauds);
+}
+
+TEST_F(TestBtLink, no_module)
+{
+    FakeHc05 module(9600);
+    module.present = false;
+
+    EXPECT_EQ(57600, setup(module, 57600, 115200));
+    EXPECT_FALSE(found);
+    EXPECT_FALSE(changed);
+    EXPECT_EQ(57600, module.uartBaud);
+    // Every rate was tried once, then the UART went back to the stored one
+    EXPECT_EQ((size_t)BT_LINK_RATE_COUNT + 1, module.bauds.size());
+
+    FakeHc05 unset(9600);
+    unset.present = false;
+    EXPECT_EQ(9600, setup(unset, 0, 115200));
+    EXPECT_FALSE(found);
+    EXPECT_EQ(9600, unset.uartBaud);
+}
+
+TEST_F(TestBtLink, key_not_connected_data_mode)
+{
+    // KEY low on the module and not driven: the commands go to the phone
+    FakeHc05 module(115200);
+    module.key = false;
+
+    EXPECT_EQ(115200, setup(module, 115200, 230400, false));
+    EXPECT_FALSE(found);
+    EXPECT_FALSE(changed);
+    EXPECT_EQ(115200, module.uartBaud);
+    EXPECT_TRUE(module.commands.empty());
+    EXPECT_EQ(0, module.keyChanges);
+}
+
+TEST_F(TestBtLink, key_not_connected_held_high)
+{
+    // KEY strapped high: full command mode at 38400 whatever AT+UART says
+    FakeHc05 module(38400);
+    module.key = true;
+
+    EXPECT_EQ(38400, setup(module, 0, 115200, false));
+    EXPECT_TRUE(found);
+    EXPECT_FALSE(changed);
+    EXPECT_EQ(38400, module.uartBaud);
+    EXPECT_EQ(115200, module.storedBaud);
+    EXPECT_EQ(0, module.keyChanges);
+}
@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "SensorLog.h"
+#include "blockdevice/HeapBlockDevice.h"
+#include "blockdevice/FlashSimBlockDevice.h"
+#include "blockdevice/ProfilingBlockDevice.h"
+#include <chrono>
+#include <string.h>
+
+using namespace mbed;
+
+// Eight 256 byte erase blocks: a 12 byte segment header and 20 records each
+#define SEGMENT_SIZE 256
+#define SEGMENTS 8
+#define HEADER_SIZE 12
+#define RECORDS_PER_SEGMENT ((SEGMENT_SIZE - HEADER_SIZE) / sizeof(SensorRecord))
+
+static SensorRecord sample(uint32_t timestamp)
+{
+    SensorRecord record;
+    record.timestamp = timestamp;
+    record.temperature = (int8_t)(20 + timestamp % 10);
+    record.humidity = (uint8_t)(40 + timestamp % 7);
+    record.light = (uint16_t)(timestamp * 3);
+    record.rain = (uint16_t)(timestamp * 5);
+    record.flags = (uint8_t)(timestamp & 0x0F);
+    record.check = 0;
+    return record;
+}
+
+class TestSensorLog : public testing::Test {
+protected:
+    TestSensorLog() :
+        heap(SEGMENT_SIZE * SEGMENTS, 1, 4, SEGMENT_SIZE),
+        flash(&heap, 0xFF),
+        log(nullptr)
+    {
+    }
+
+    void SetUp()
+    {
+        mount();
+    }
+
+    void TearDown()
+    {
+        delete log;
+    }
+
+    // A new SensorLog on the same device, as after a reset
+    void mount()
+    {
+        delete log;
+        log = new SensorLog(&flash);
+        ASSERT_EQ(0, log->init());
+    }
+
+    // Records with timestamps first, first + step, ...
+    void append(uint32_t count, uint32_t first = 1000, uint32_t step = 10)
+    {
+        for (uint32_t i = 0; i < count; i++) {
+            SensorRecord record = sample(first + i * step);
+            ASSERT_EQ(0, log->append(record));
+        }
+    }
+
+    bd_addr_t slot_address(uint32_t segment, uint32_t slot)
+    {
+        return (bd_addr_t)segment * SEGMENT_SIZE + HEADER_SIZE + (bd_addr_t)slot * sizeof(SensorRecord);
+    }
+
+    // Power lost while a segment was started: erased, header half programmed
+    void tear_header(uint32_t segment)
+    {
+        const uint32_t magic = 0x31474C53;
+        ASSERT_EQ(0, flash.erase((bd_addr_t)segment * SEGMENT_SIZE, SEGMENT_SIZE));
+        ASSERT_EQ(0, flash.program(&magic, (bd_addr_t)segment * SEGMENT_SIZE, sizeof(magic)));
+    }
+
+    // Position of the first valid record at or after a position
+    uint32_t first_valid_from(uint32_t position)
+    {
+        SensorRecord record;
+        while (position < log->size() && log->read(position, record) != 0) {
+            position++;
+        }
+        return position;
+    }
+
+    // What seek() must find, by reading every record
+    uint32_t linear_seek(uint32_t timestamp)
+    {
+        SensorRecord record;
+        for (uint32_t position = 0; position < log->size(); position++) {
+            if (log->read(position, record) == 0 && record.timestamp >= timestamp) {
+                return position;
+            }
+        }
+        return log->size();
+    }
+
+    HeapBlockDevice heap;
+    FlashSimBlockDevice flash;
+    SensorLog *log;
+};
+
+TEST_F(TestSensorLog, empty)
+{
+    SensorRecord record;
+
+    EXPECT_EQ(0u, log->size());
+    EXPECT_EQ(0u, log->lastTimestamp());
+    EXPECT_EQ(0u, log->seek(1234));
+    EXPECT_EQ(-1, log->read(0, record));
+}
+
+TEST_F(TestSensorLog, append_read_back)
+{
+    append(50);
+
+    ASSERT_EQ(50u, log->size());
+    for (uint32_t i = 0; i < 50; i++) {
+        SensorRecord record;
+        SensorRecord expected = sample(1000 + i * 10);
+        ASSERT_EQ(0, log->read(i, record));
+        EXPECT_EQ(expected.timestamp, record.timestamp);
+        EXPECT_EQ(expected.temperature, record.temperature);
+        EXPECT_EQ(expected.light, record.light);
+        EXPECT_EQ(expected.rain, record.rain);
+        EXPECT_EQ(expected.flags, record.flags);
+    }
+    EXPECT_EQ(1490u, log->lastTimestamp());
+}
+
+TEST_F(TestSensorLog, timestamps_never_decrease)
+{
+    SensorRecord first = sample(500);
+    SensorRecord late = sample(400);
+    SensorRecord record;
+
+    ASSERT_EQ(0, log->append(first));
+    ASSERT_EQ(0, log->append(late));
+    EXPECT_EQ(500u, late.timestamp);
+    ASSERT_EQ(0, log->read(1, record));
+    EXPECT_EQ(500u, record.timestamp);
+}
+
+TEST_F(TestSensorLog, rotation_erases_oldest)
+{
+    const uint32_t total = SEGMENTS * RECORDS_PER_SEGMENT + 30;
+    append(total);
+
+    // The first two segments were erased again and reused
+    uint32_t expected = (SEGMENTS - 1) * RECORDS_PER_SEGMENT + 10;
+    ASSERT_EQ(expected, log->size());
+    SensorRecord record;
+    ASSERT_EQ(0, log->read(0, record));
+    EXPECT_EQ(1000u + (total - expected) * 10, record.timestamp);
+    ASSERT_EQ(0, log->read(expected - 1, record));
+    EXPECT_EQ(1000u + (total - 1) * 10, record.timestamp);
+    EXPECT_EQ(2u, log->stats().maxErases);
+}
+
+TEST_F(TestSensorLog, remount)
+{
+    append(45);
+    mount();
+
+    EXPECT_EQ(45u, log->size());
+    EXPECT_EQ(1440u, log->lastTimestamp());
+
+    append(5, 2000);
+    mount();
+    EXPECT_EQ(50u, log->size());
+    SensorRecord record;
+    ASSERT_EQ(0, log->read(45, record));
+    EXPECT_EQ(2000u, record.timestamp);
+}
+
+TEST_F(TestSensorLog, remount_after_rotation)
+{
+    const uint32_t total = SEGMENTS * RECORDS_PER_SEGMENT * 3 + 7;
+    append(total);
+    uint32_t size = log->size();
+    mount();
+
+    EXPECT_EQ(size, log->size());
+    SensorRecord record;
+    ASSERT_EQ(0, log->read(0, record));
+    EXPECT_EQ(1000u + (total - size) * 10, record.timestamp);
+    EXPECT_EQ(1000u + (total - 1) * 10, log->lastTimestamp());
+    EXPECT_EQ(4u, log->stats().maxErases);
+}
+
+TEST_F(TestSensorLog, torn_record_skipped)
+{
+    append(25);
+    // Power lost while the 26th record was programmed
+    SensorRecord torn = sample(1250);
+    torn.check = 0x5A;
+    ASSERT_EQ(0, flash.program(&torn, slot_address(1, 5), 4));
+    mount();
+
+    ASSERT_EQ(26u, log->size());
+    SensorRecord record;
+    EXPECT_EQ(-1, log->read(25, record));
+    EXPECT_EQ(1240u, log->lastTimestamp());
+
+    append(1, 1260);
+    ASSERT_EQ(0, log->read(26, record));
+    EXPECT_EQ(1260u, record.timestamp);
+    EXPECT_EQ(26u, log->seek(1245));
+}
+
+TEST_F(TestSensorLog, torn_segment_header)
+{
+    append(2 * RECORDS_PER_SEGMENT);
+    tear_header(2);
+    mount();
+
+    EXPECT_EQ(2 * RECORDS_PER_SEGMENT, log->size());
+    EXPECT_EQ(1000u + (2 * RECORDS_PER_SEGMENT - 1) * 10, log->lastTimestamp());
+
+    // The torn segment is started again
+    append(1, 5000);
+    mount();
+    ASSERT_EQ(2 * RECORDS_PER_SEGMENT + 1, log->size());
+    SensorRecord record;
+    ASSERT_EQ(0, log->read(2 * RECORDS_PER_SEGMENT, record));
+    EXPECT_EQ(5000u, record.timestamp);
+}
+
+TEST_F(TestSensorLog, torn_segment_header_when_full)
+{
+    // The oldest segment was erased for reuse when the power went
+    append(SEGMENTS * RECORDS_PER_SEGMENT);
+    tear_header(0);
+    mount();
+
+    ASSERT_EQ((SEGMENTS - 1) * RECORDS_PER_SEGMENT, log->size());
+    SensorRecord record;
+    ASSERT_EQ(0, log->read(0, record));
+    EXPECT_EQ(1000u + RECORDS_PER_SEGMENT * 10, record.timestamp);
+
+    append(1, 9000);
+    EXPECT_EQ((SEGMENTS - 1) * RECORDS_PER_SEGMENT + 1, log->size());
+    mount();
+    EXPECT_EQ(9000u, log->lastTimestamp());
+}
+
+TEST_F(TestSensorLog, seek)
+{
+    append(SEGMENTS * RECORDS_PER_SEGMENT + 30);
+    uint32_t size = log->size();
+    SensorRecord oldest;
+    ASSERT_EQ(0, log->read(0, oldest));
+
+    EXPECT_EQ(0u, log->seek(0));
+    EXPECT_EQ(0u, log->seek(oldest.timestamp));
+    EXPECT_EQ(1u, log->seek(oldest.timestamp + 1));
+    EXPECT_EQ(size - 1, log->seek(log->lastTimestamp()));
+    EXPECT_EQ(size, log->seek(log->lastTimestamp() + 1));
+    for (uint32_t t = oldest.timestamp - 5; t <= log->lastTimestamp() + 5; t += 5) {
+        ASSERT_EQ(linear_seek(t), log->seek(t)) << "timestamp " << t;
+    }
+}
+
+TEST_F(TestSensorLog, seek_equal_timestamps_across_segments)
+{
+    // The last 5 records of the first segment and the whole second one share a time
+    append(RECORDS_PER_SEGMENT - 5, 100, 1);
+    append(5 + RECORDS_PER_SEGMENT, 500, 0);
+    append(10, 600, 1);
+
+    EXPECT_EQ(RECORDS_PER_SEGMENT - 5, log->seek(500));
+    EXPECT_EQ(2 * RECORDS_PER_SEGMENT, log->seek(501));
+}
+
+TEST_F(TestSensorLog, seek_across_erased_segment)
+{
+    append(5 * RECORDS_PER_SEGMENT + 4);
+    // Every record of the third segment lost, its header kept
+    SensorRecord erased;
+    memset(&erased, 0xFF, sizeof(erased));
+    for (uint32_t slot = 0; slot < RECORDS_PER_SEGMENT; slot++) {
+        ASSERT_EQ(0, heap.program(&erased, slot_address(2, slot), sizeof(erased)));
+    }
+    mount();
+    ASSERT_EQ(5 * RECORDS_PER_SEGMENT + 4, log->size());
+
+    uint32_t last = log->lastTimestamp();
+    for (uint32_t t = 990; t <= last + 10; t += 5) {
+        uint32_t position = log->seek(t);
+        // Lands on the lost records or the first record at or after t
+        ASSERT_EQ(linear_seek(t), first_valid_from(position)) << "timestamp " << t;
+        if (position > 0 && position <= log->size()) {
+            SensorRecord record;
+            if (log->read(position - 1, record) == 0) {
+                EXPECT_LT(record.timestamp, t);
+            }
+        }
+    }
+}
+
+TEST_F(TestSensorLog, write_amplification)
+{
+    const uint32_t total = SEGMENTS * RECORDS_PER_SEGMENT * 2 + 5;
+    append(total);
+
+    // One header per started segment on top of the records
+    const SensorLogStats &stats = log->stats();
+    uint32_t segments_started = (total + RECORDS_PER_SEGMENT - 1) / RECORDS_PER_SEGMENT;
+    EXPECT_EQ(total, stats.appended);
+    EXPECT_EQ(total * sizeof(SensorRecord) + segments_started * HEADER_SIZE, stats.programmed);
+    EXPECT_EQ(segments_started * SEGMENT_SIZE, stats.erased);
+}
+
+#define BENCH_RECORDS 20000
+#define BENCH_SEEKS 2000
+
+/** Benchmark appends and seeks on a heap device and on simulated flash
+ *
+ *  Simulated flash checks that every program lands on erased bytes and
+ *  erases by programming the erase value, like internal flash. Appends run
+ *  through many rotations of the 32 KB device. The bytes the seeks read are
+ *  counted with a ProfilingBlockDevice. Write amplification is the bytes
+ *  programmed and erased per byte of record appended. Only the counts are
+ *  asserted, the times depend on the host.
+ */
+TEST_F(TestSensorLog, benchmark)
+{
+    const bd_size_t device_size = SENSOR_LOG_MAX_SEGMENTS * 1024;
+
+    for (int simulated = 0; simulated < 2; simulated++) {
+        HeapBlockDevice bench_heap(device_size, 1, 4, 1024);
+        FlashSimBlockDevice bench_flash(&bench_heap, 0xFF);
+        ProfilingBlockDevice profile(simulated ? (BlockDevice *)&bench_flash : (BlockDevice *)&bench_heap);
+        SensorLog bench_log(&profile);
+        ASSERT_EQ(0, bench_log.init());
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < BENCH_RECORDS; i++) {
+            SensorRecord record = sample(i * 60);
+            ASSERT_EQ(0, bench_log.append(record));
+        }
+        auto mid = std::chrono::steady_clock::now();
+
+        SensorRecord oldest;
+        ASSERT_EQ(0, bench_log.read(0, oldest));
+        uint32_t span = bench_log.lastTimestamp() - oldest.timestamp;
+        profile.reset();
+        uint32_t found = 0;
+        for (uint32_t i = 0; i < BENCH_SEEKS; i++) {
+            found += bench_log.seek(oldest.timestamp + (uint32_t)((uint64_t)span * i / BENCH_SEEKS)) < bench_log.size();
+        }
+        auto end = std::chrono::steady_clock::now();
+        bd_size_t seek_reads = profile.get_read_count();
+
+        const SensorLogStats &stats = bench_log.stats();
+        double amplification = (double)(stats.programmed + stats.erased) / (stats.appended * sizeof(SensorRecord));
+        double append_ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(mid - start).count() / BENCH_RECORDS;
+        double seek_ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - mid).count() / BENCH_SEEKS;
+        printf("%s: append %6.1f ns, seek %6.1f ns reading %5.1f bytes, %lu records, "
+               "programmed %.3f and erased %.3f bytes per record byte\n",
+               simulated ? "FlashSimBlockDevice" : "HeapBlockDevice   ", append_ns, seek_ns,
+               (double)seek_reads / BENCH_SEEKS, (unsigned long)bench_log.size(),
+               (double)stats.programmed / (stats.appended * sizeof(SensorRecord)),
+               (double)stats.erased / (stats.appended * sizeof(SensorRecord)));
+
+        EXPECT_EQ(BENCH_SEEKS, found);
+        // Two binary searches: at most log2(85) + 1 record reads in one segment
+        EXPECT_LE(seek_reads, (bd_size_t)BENCH_SEEKS * 8 * sizeof(SensorRecord));
+        EXPECT_LT(amplification, 1.1 + 1024.0 / (85 * sizeof(SensorRecord)));
+    }
+}
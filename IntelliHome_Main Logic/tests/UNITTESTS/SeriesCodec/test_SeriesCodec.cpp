@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2026, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "SeriesCodec.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+// Count and the first record, stored as is
+#define HEADER_BITS (16 + 32 + 8 + 8 + 16 + 16 + 8)
+
+static SensorRecord make(uint32_t timestamp, int8_t temperature = 25, uint8_t humidity = 50,
+                         uint16_t light = 1000, uint16_t rain = 200, uint8_t flags = 0)
+{
+    SensorRecord record;
+    memset(&record, 0, sizeof(record));
+    record.timestamp = timestamp;
+    record.temperature = temperature;
+    record.humidity = humidity;
+    record.light = light;
+    record.rain = rain;
+    record.flags = flags;
+    return record;
+}
+
+static uint32_t zigzag(int32_t value)
+{
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+// Bits the layout in SeriesCodec.h gives a timestamp delta-of-delta
+static size_t timestamp_bits(int32_t deltaOfDelta)
+{
+    uint32_t value = zigzag(deltaOfDelta);
+    if (value == 0) return 1;
+    if (value < (1u << 7)) return 2 + 7;
+    if (value < (1u << 9)) return 3 + 9;
+    if (value < (1u << 12)) return 4 + 12;
+    return 4 + 32;
+}
+
+// Bits the layout in SeriesCodec.h gives a value delta
+static size_t value_bits(int32_t delta)
+{
+    uint32_t value = zigzag(delta);
+    if (value == 0) return 1;
+    if (value < (1u << 3)) return 2 + 3;
+    if (value < (1u << 8)) return 3 + 8;
+    return 3 + 17;
+}
+
+static void expect_equal(const SensorRecord &expected, const SensorRecord &actual, size_t index)
+{
+    EXPECT_EQ(expected.timestamp, actual.timestamp) << "record " << index;
+    EXPECT_EQ(expected.temperature, actual.temperature) << "record " << index;
+    EXPECT_EQ(expected.humidity, actual.humidity) << "record " << index;
+    EXPECT_EQ(expected.light, actual.light) << "record " << index;
+    EXPECT_EQ(expected.rain, actual.rain) << "record " << index;
+    EXPECT_EQ(expected.flags, actual.flags) << "record " << index;
+    EXPECT_EQ(0, actual.check) << "record " << index;
+}
+
+// Encodes the records in one block, decodes them and compares
+static size_t round_trip(const std::vector<SensorRecord> &records, size_t size = 1024)
+{
+    std::vector<uint8_t> buffer(size);
+    SeriesEncoder encoder(buffer.data(), buffer.size());
+    for (size_t i = 0; i < records.size(); i++) {
+        EXPECT_TRUE(encoder.append(records[i])) << "record " << i;
+    }
+    size_t used = encoder.finish();
+    EXPECT_EQ(records.size(), encoder.count());
+
+    SeriesDecoder decoder(buffer.data(), used);
+    EXPECT_EQ(records.size(), decoder.count());
+    SensorRecord record;
+    for (size_t i = 0; i < records.size(); i++) {
+        if (!decoder.next(record)) {
+            ADD_FAILURE() << "record " << i << " not decoded";
+            return used;
+        }
+        expect_equal(records[i], record, i);
+    }
+    EXPECT_FALSE(decoder.next(record));
+    return used;
+}
+
+TEST(SeriesCodec, empty_block)
+{
+    uint8_t buffer[16];
+    SeriesEncoder encoder(buffer, sizeof(buffer));
+    EXPECT_EQ(2u, encoder.finish());
+
+    SeriesDecoder decoder(buffer, 2);
+    SensorRecord record;
+    EXPECT_EQ(0, decoder.count());
+    EXPECT_FALSE(decoder.next(record));
+}
+
+TEST(SeriesCodec, first_record_stored_as_is)
+{
+    std::vector<SensorRecord> records = { make(0xDEADBEEF, -40, 255, 65535, 0, 0xFF) };
+    EXPECT_EQ((size_t)HEADER_BITS / 8, round_trip(records));
+}
+
+TEST(SeriesCodec, timestamp_bucket_boundaries)
+{
+    // Delta-of-delta on either side of each bucket, both signs
+    const int32_t deltas[] = { 0, -1, 1, -64, 63, 64, -65, -256, 255, 256, -257,
+                               -2048, 2047, 2048, -2049, 1000000, -1000000
+                             };
+    for (int32_t deltaOfDelta : deltas) {
+        const uint32_t start = 100000000;
+        const uint32_t delta = 60;
+        std::vector<SensorRecord> records = {
+            make(start), make(start + delta), make(start + 2 * delta + deltaOfDelta)
+        };
+        size_t bits = HEADER_BITS + 2 * (4 * value_bits(0) + 1);
+        bits += timestamp_bits(delta) + timestamp_bits(deltaOfDelta);
+        EXPECT_EQ((bits + 7) / 8, round_trip(records)) << "delta-of-delta " << deltaOfDelta;
+    }
+}
+
+TEST(SeriesCodec, value_bucket_boundaries)
+{
+    // Deltas on either side of each bucket, both signs
+    const int32_t deltas[] = { 0, -1, 1, -4, 3, 4, -5, -128, 127, 128, -129, 1000, -1000 };
+    for (int32_t delta : deltas) {
+        std::vector<SensorRecord> records = {
+            make(1000, 0, 128, 30000, 30000),
+            make(1060, 0, 128, (uint16_t)(30000 + delta), (uint16_t)(30000 - delta)),
+        };
+        size_t bits = HEADER_BITS + timestamp_bits(60) + 2 * value_bits(0);
+        bits += value_bits(delta) + value_bits(-delta) + 1;
+        EXPECT_EQ((bits + 7) / 8, round_trip(records)) << "delta " << delta;
+    }
+}
+
+TEST(SeriesCodec, full_scale_deltas)
+{
+    // +-65535 on the 16 bit readings, +-255 on the 8 bit ones
+    std::vector<SensorRecord> records = {
+        make(0, -128, 0, 0, 65535),
+        make(1, 127, 255, 65535, 0),
+        make(2, -128, 0, 0, 65535),
+        make(3, 127, 255, 65535, 0, 0xFF),
+        make(4, 0, 0, 0, 0, 0x00),
+    };
+    round_trip(records);
+}
+
+TEST(SeriesCodec, timestamp_wrap)
+{
+    std::vector<SensorRecord> records = {
+        make(0xFFFFFFF0), make(0xFFFFFFFA), make(0x00000004), make(0x0000000E),
+        make(0x80000000), make(0x80000000), make(0xFFFFFFFF), make(0x00000000),
+    };
+    round_trip(records);
+}
+
+TEST(SeriesCodec, flags)
+{
+    std::vector<SensorRecord> records;
+    for (uint32_t i = 0; i < 40; i++) {
+        records.push_back(make(i * 60, 25, 50, 1000, 200, (uint8_t)(i % 5 == 0 ? i : 0)));
+    }
+    round_trip(records);
+}
+
+TEST(SeriesCodec, buffer_too_short_for_one_record)
+{
+    // The first record and the count need 13 bytes
+    const size_t sizes[] = { 0, 1, 2, 12 };
+    for (size_t size : sizes) {
+        uint8_t buffer[16];
+        memset(buffer, 0xA5, sizeof(buffer));
+        SeriesEncoder encoder(buffer, size);
+        EXPECT_FALSE(encoder.append(make(1000))) << "size " << size;
+        EXPECT_EQ(0, encoder.count());
+        size_t used = encoder.finish();
+        EXPECT_LE(used, size);
+        for (size_t i = size; i < sizeof(buffer); i++) {
+            EXPECT_EQ(0xA5, buffer[i]) << "size " << size << ", byte " << i;
+        }
+        SeriesDecoder decoder(buffer, used);
+        SensorRecord record;
+        EXPECT_FALSE(decoder.next(record));
+    }
+
+    uint8_t buffer[13];
+    SeriesEncoder encoder(buffer, sizeof(buffer));
+    EXPECT_TRUE(encoder.append(make(1000)));
+    EXPECT_FALSE(encoder.append(make(1000)));
+    EXPECT_EQ(sizeof(buffer), encoder.finish());
+    SeriesDecoder decoder(buffer, sizeof(buffer));
+    SensorRecord record;
+    EXPECT_EQ(1, decoder.count());
+    EXPECT_TRUE(decoder.next(record));
+    EXPECT_EQ(1000u, record.timestamp);
+}
+
+TEST(SeriesCodec, full_block_rolls_back)
+{
+    // Alternating full scale readings until the block is full
+    uint8_t buffer[64];
+    SeriesEncoder encoder(buffer, sizeof(buffer));
+    std::vector<SensorRecord> appended;
+    for (uint32_t i = 0;; i++) {
+        SensorRecord record = make(i * 7919, (int8_t)(i & 1 ? 100 : -100), 0,
+                                   (uint16_t)(i & 1 ? 65535 : 0), 0, (uint8_t)i);
+        if (!encoder.append(record)) break;
+        appended.push_back(record);
+    }
+    // A small record may still fit in what the big one left
+    SensorRecord small = appended.back();
+    small.timestamp += appended.back().timestamp - appended[appended.size() - 2].timestamp;
+    bool fitted = encoder.append(small);
+    if (fitted) appended.push_back(small);
+
+    size_t used = encoder.finish();
+    EXPECT_LE(used, sizeof(buffer));
+    SeriesDecoder decoder(buffer, used);
+    ASSERT_EQ(appended.size(), decoder.count());
+    SensorRecord record;
+    for (size_t i = 0; i < appended.size(); i++) {
+        ASSERT_TRUE(decoder.next(record));
+        expect_equal(appended[i], record, i);
+    }
+    EXPECT_FALSE(decoder.next(record));
+}
+
+TEST(SeriesCodec, truncated_block)
+{
+    std::vector<SensorRecord> records;
+    for (uint32_t i = 0; i < 20; i++) {
+        records.push_back(make(i * 60, (int8_t)(20 + i % 3), 50, (uint16_t)(1000 + i * 37), 200));
+    }
+    uint8_t buffer[256];
+    SeriesEncoder encoder(buffer, sizeof(buffer));
+    for (const SensorRecord &record : records) {
+        ASSERT_TRUE(encoder.append(record));
+    }
+    size_t used = encoder.finish();
+
+    SeriesDecoder decoder(buffer, used - 4);
+    SensorRecord record;
+    uint16_t decoded = 0;
+    while (decoder.next(record)) {
+        expect_equal(records[decoded], record, decoded);
+        decoded++;
+    }
+    EXPECT_EQ(20, decoder.count());
+    EXPECT_LT(decoded, 20);
+    EXPECT_GT(decoded, 0);
+}
+
+// A trace as logged by logSample(): timestamp,temperature,humidity,light,rain,flags
+// per line, as decoded from a bulk history download
+static bool load_trace(const char *path, std::vector<SensorRecord> &trace)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL) return false;
+    unsigned long timestamp;
+    int temperature, humidity, light, rain, flags;
+    while (fscanf(file, "%lu,%d,%d,%d,%d,%d", &timestamp, &temperature, &humidity, &light, &rain, &flags) == 6) {
+        trace.push_back(make((uint32_t)timestamp, (int8_t)temperature, (uint8_t)humidity,
+                             (uint16_t)light, (uint16_t)rain, (uint8_t)flags));
+    }
+    fclose(file);
+    return !trace.empty();
+}
+
+// Two days of a sample a minute with the behaviour of the real sensors: the
+// DHT11 reports whole degrees and percent that follow the time of day, the
+// LDR follows daylight with ADC noise, the rain sensor sits high and dry
+// apart from one shower, and the loop period jitters by a second or two.
+static void generate_trace(std::vector<SensorRecord> &trace)
+{
+    uint32_t seed = 1;
+    auto noise = [&seed](int range) {
+        seed = seed * 1103515245 + 12345;
+        return (int)((seed >> 16) % (2 * range + 1)) - range;
+    };
+    uint32_t timestamp = 1760000000;
+    for (int i = 0; i < 2 * 24 * 60; i++) {
+        double day = (i % (24 * 60)) / (24.0 * 60.0);
+        double sun = sin(2 * M_PI * (day - 0.25));
+        bool shower = i > 1800 && i < 1900;
+        int temperature = (int)lround(27 + 4 * sun);
+        int humidity = (int)lround(65 - 15 * sun + (shower ? 20 : 0));
+        int light = sun > 0 ? (int)(52000 * sun) + noise(300) : 600 + noise(40);
+        int rain = (shower ? 21000 : 61000) + noise(150);
+        uint8_t flags = (shower ? SENSOR_FLAG_RAINING : 0) | (day > 0.3 && day < 0.75 ? 0 : SENSOR_FLAG_PERSON_HOME);
+        trace.push_back(make(timestamp, (int8_t)temperature, (uint8_t)humidity, (uint16_t)light, (uint16_t)rain, flags));
+        timestamp += 60 + (noise(4) == 0 ? noise(2) : 0);
+    }
+}
+
+#define BENCH_ROUNDS 50
+
+/** Benchmark the codec on a sensor trace, in the 128 byte blocks of a history download
+ *
+ *  The trace is read from the file named by SERIES_TRACE when it is set, or
+ *  generated. The compression ratio is the SensorLog record size over the
+ *  encoded size. Only the round trip is asserted, the times depend on the host.
+ */
+TEST(SeriesCodec, benchmark)
+{
+    std::vector<SensorRecord> trace;
+    const char *path = getenv("SERIES_TRACE");
+    bool recorded = path != NULL && load_trace(path, trace);
+    if (!recorded) generate_trace(trace);
+
+    std::vector<uint8_t> blocks;
+    std::vector<size_t> sizes;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        blocks.clear();
+        sizes.clear();
+        size_t position = 0;
+        while (position < trace.size()) {
+            uint8_t block[128];
+            SeriesEncoder encoder(block, sizeof(block));
+            while (position < trace.size() && encoder.append(trace[position])) position++;
+            size_t used = encoder.finish();
+            blocks.insert(blocks.end(), block, block + used);
+            sizes.push_back(used);
+        }
+    }
+    auto mid = std::chrono::steady_clock::now();
+
+    size_t decoded = 0;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        decoded = 0;
+        const uint8_t *block = blocks.data();
+        for (size_t size : sizes) {
+            SeriesDecoder decoder(block, size);
+            SensorRecord record;
+            while (decoder.next(record)) {
+                if (round == 0) expect_equal(trace[decoded], record, decoded);
+                decoded++;
+            }
+            block += size;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double records = (double)trace.size() * BENCH_ROUNDS;
+    double encode_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(mid - start).count() / records;
+    double decode_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - mid).count() / records;
+    printf("%s trace of %lu records: %lu bytes in %lu blocks, ratio %.2f, %.2f bits per record, "
+           "encode %.1f ns and decode %.1f ns per record\n",
+           recorded ? "recorded" : "generated", (unsigned long)trace.size(), (unsigned long)blocks.size(),
+           (unsigned long)sizes.size(), (double)trace.size() * sizeof(SensorRecord) / blocks.size(),
+           blocks.size() * 8.0 / trace.size(), encode_ns, decode_ns);
+
+    EXPECT_EQ(trace.size(), decoded);
+}